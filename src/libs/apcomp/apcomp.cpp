@@ -16,6 +16,8 @@ namespace apcomp
 {
 
 static int g_mpi_comm_id = -1;
+static int g_transport_color_bits = 32;
+static int g_transport_depth_bits = 32;
 
 
 //---------------------------------------------------------------------------//
@@ -126,6 +128,43 @@ mpi_size()
 #endif
 //---------------------------------------------------------------------------//
 
+//---------------------------------------------------------------------------//
+void
+transport_color_bits(int bits)
+{
+  if(bits != 8 && bits != 16 && bits != 32)
+  {
+    std::stringstream msg;
+    msg<<"APComp: transport color bits must be 8, 16 or 32, not "<<bits;
+    throw Error(msg.str());
+  }
+  g_transport_color_bits = bits;
+}
+
+int
+transport_color_bits()
+{
+  return g_transport_color_bits;
+}
+
+void
+transport_depth_bits(int bits)
+{
+  if(bits != 16 && bits != 24 && bits != 32)
+  {
+    std::stringstream msg;
+    msg<<"APComp: transport depth bits must be 16, 24 or 32, not "<<bits;
+    throw Error(msg.str());
+  }
+  g_transport_depth_bits = bits;
+}
+
+int
+transport_depth_bits()
+{
+  return g_transport_depth_bits;
+}
+
 //---------------------------------------------------------------------------//
 bool
 mpi_enabled()
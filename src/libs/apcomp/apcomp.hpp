@@ -22,6 +22,20 @@ namespace apcomp
   APCOMP_API void mpi_comm(int mpi_comm_id);
   APCOMP_API int  mpi_comm();
 
+  // Precision of the data sent between ranks while compositing. 32 (the
+  // default) sends floats unchanged.
+  //   color bits (8 or 16): fixed point colors of volume partials
+  //   depth bits (16 or 24): quantized gl (0-1) depths of zbuffer
+  //                          surface images
+  // World depths, partial depths, and the depths of images blended by
+  // depth or visibility order, are always sent exactly. These only apply
+  // to APComp (used by Devil Ray), not to the VTK-h compositor, and Ascent
+  // does not set them: call them directly before rendering.
+  APCOMP_API void transport_color_bits(int bits);
+  APCOMP_API int  transport_color_bits();
+  APCOMP_API void transport_depth_bits(int bits);
+  APCOMP_API int  transport_depth_bits();
+
   APCOMP_API std::string about();
 }
 #endif
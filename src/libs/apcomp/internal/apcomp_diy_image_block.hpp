@@ -9,8 +9,10 @@
 
 #include <apcomp/apcomp_config.h>
 
+#include <apcomp/apcomp.hpp>
 #include <apcomp/image.hpp>
 #include <apcomp/scalar_image.hpp>
+#include <apcomp/internal/apcomp_diy_quantize.hpp>
 #include <diy/master.hpp>
 
 namespace apcomp
@@ -149,7 +151,12 @@ struct Serialization<apcomp::Image>
     apcompdiy::save(bb, image.m_bounds.m_max_y);
 
     apcompdiy::save(bb, image.m_pixels);
-    apcompdiy::save(bb, image.m_depths);
+    // images blended in depth or visibility order keep exact depths
+    const bool zbuffer = image.m_composite_order == -1 && !image.m_has_transparency;
+    apcomp::save_depths(bb,
+                        image.m_depths,
+                        image.m_gl_depth,
+                        zbuffer ? apcomp::transport_depth_bits() : 32);
     apcompdiy::save(bb, image.m_orig_rank);
     apcompdiy::save(bb, image.m_composite_order);
   }
@@ -167,7 +174,7 @@ struct Serialization<apcomp::Image>
     apcompdiy::load(bb, image.m_bounds.m_max_y);
 
     apcompdiy::load(bb, image.m_pixels);
-    apcompdiy::load(bb, image.m_depths);
+    apcomp::load_depths(bb, image.m_depths);
     apcompdiy::load(bb, image.m_orig_rank);
     apcompdiy::load(bb, image.m_composite_order);
   }
@@ -9,6 +9,8 @@
 
 #include <apcomp/apcomp_config.h>
 
+#include <apcomp/apcomp.hpp>
+#include <apcomp/internal/apcomp_diy_quantize.hpp>
 #include <diy/master.hpp>
 
 #include <apcomp/absorption_partial.hpp>
@@ -93,6 +95,21 @@ struct AddBlock
 //-------------------------------Serialization Specializations--------------------------------
 namespace apcompdiy {
 
+// volume partials are sent with apcomp::transport_color_bits precision
+template<typename FloatType>
+struct Serialization<std::vector<apcomp::VolumePartial<FloatType>>>
+{
+  static void save(BinaryBuffer& bb, const std::vector<apcomp::VolumePartial<FloatType>> &partials)
+  {
+    apcomp::save_partials(bb, partials, apcomp::transport_color_bits());
+  }
+
+  static void load(BinaryBuffer& bb, std::vector<apcomp::VolumePartial<FloatType>> &partials)
+  {
+    apcomp::load_partials(bb, partials);
+  }
+};
+
 template<>
 struct Serialization<apcomp::AbsorptionPartial<double>>
 {
@@ -0,0 +1,250 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#ifndef APCOMP_DIY_QUANTIZE_HPP
+#define APCOMP_DIY_QUANTIZE_HPP
+
+#include <apcomp/apcomp_config.h>
+
+#include <apcomp/volume_partial.hpp>
+#include <diy/serialization.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+//
+// Reduced precision transport of compositing data, see
+// apcomp::transport_color_bits and apcomp::transport_depth_bits.
+//
+namespace apcomp
+{
+
+namespace detail
+{
+
+inline void write_code(unsigned char *dest, unsigned int code, const int bytes)
+{
+  for(int b = 0; b < bytes; ++b)
+  {
+    dest[b] = static_cast<unsigned char>(code >> (8 * b));
+  }
+}
+
+inline unsigned int read_code(const unsigned char *src, const int bytes)
+{
+  unsigned int code = 0;
+  for(int b = 0; b < bytes; ++b)
+  {
+    code |= static_cast<unsigned int>(src[b]) << (8 * b);
+  }
+  return code;
+}
+
+} // namespace detail
+
+//
+// Only gl depths are quantized, on the fixed range [0, 1] shared by all
+// ranks, so a depth decoded and sent again in a later round keeps its
+// code and the depth order of two images never depends on which message
+// carried them. World depths have no range known to every rank and are
+// always sent exactly. The largest code marks background pixels (gl depths
+// outside [0, 1]), which are restored to the first background value found.
+//
+inline void save_depths(apcompdiy::BinaryBuffer &bb,
+                        const std::vector<float> &depths,
+                        const bool gl_depth,
+                        int bits)
+{
+  if(!gl_depth)
+  {
+    bits = 32;
+  }
+  apcompdiy::save(bb, bits);
+  if(bits == 32)
+  {
+    apcompdiy::save(bb, depths);
+    return;
+  }
+
+  const size_t size = depths.size();
+  const float lo = 0.f;
+  const float hi = 1.f;
+  float background = 2.f;
+
+  for(size_t i = 0; i < size; ++i)
+  {
+    const float depth = depths[i];
+    if(!(depth >= 0.f && depth <= 1.f))
+    {
+      background = depth;
+      break;
+    }
+  }
+
+  const int bytes = bits / 8;
+  const unsigned int max_code = (1u << bits) - 1u;
+  const double scale = (max_code - 1) / (static_cast<double>(hi) - lo);
+
+  std::vector<unsigned char> codes(size * bytes);
+#ifdef APCOMP_OPENMP_ENABLED
+  #pragma omp parallel for
+#endif
+  for(size_t i = 0; i < size; ++i)
+  {
+    const float depth = depths[i];
+    unsigned int code = max_code;
+    if(depth >= 0.f && depth <= 1.f)
+    {
+      code = static_cast<unsigned int>((depth - static_cast<double>(lo)) * scale + 0.5);
+      code = std::min(code, max_code - 1u);
+    }
+    detail::write_code(&codes[i * bytes], code, bytes);
+  }
+
+  apcompdiy::save(bb, size);
+  apcompdiy::save(bb, lo);
+  apcompdiy::save(bb, hi);
+  apcompdiy::save(bb, background);
+  if(size > 0)
+  {
+    bb.save_binary(reinterpret_cast<const char*>(&codes[0]), codes.size());
+  }
+}
+
+inline void load_depths(apcompdiy::BinaryBuffer &bb,
+                        std::vector<float> &depths)
+{
+  int bits;
+  apcompdiy::load(bb, bits);
+  if(bits == 32)
+  {
+    apcompdiy::load(bb, depths);
+    return;
+  }
+
+  size_t size;
+  float lo, hi, background;
+  apcompdiy::load(bb, size);
+  apcompdiy::load(bb, lo);
+  apcompdiy::load(bb, hi);
+  apcompdiy::load(bb, background);
+
+  const int bytes = bits / 8;
+  const unsigned int max_code = (1u << bits) - 1u;
+  const double step = (static_cast<double>(hi) - lo) / (max_code - 1);
+
+  std::vector<unsigned char> codes(size * bytes);
+  if(size > 0)
+  {
+    bb.load_binary(reinterpret_cast<char*>(&codes[0]), codes.size());
+  }
+  depths.resize(size);
+#ifdef APCOMP_OPENMP_ENABLED
+  #pragma omp parallel for
+#endif
+  for(size_t i = 0; i < size; ++i)
+  {
+    const unsigned int code = detail::read_code(&codes[i * bytes], bytes);
+    depths[i] = code == max_code ? background : static_cast<float>(lo + code * step);
+  }
+}
+
+//
+// Volume partials keep their pixel ids and depths exact, since the
+// partials of each pixel are sorted by depth, and send the premultiplied
+// color and alpha as fixed point.
+//
+template<typename FloatType>
+void save_partials(apcompdiy::BinaryBuffer &bb,
+                   const std::vector<VolumePartial<FloatType>> &partials,
+                   const int bits)
+{
+  const size_t size = partials.size();
+  apcompdiy::save(bb, size);
+  apcompdiy::save(bb, bits);
+  if(size == 0)
+  {
+    return;
+  }
+  if(bits == 32)
+  {
+    apcompdiy::save(bb, &partials[0], size);
+    return;
+  }
+
+  const int bytes = bits / 8;
+  const int record = sizeof(int) + sizeof(float) + 4 * bytes;
+  const float max_code = static_cast<float>((1u << bits) - 1u);
+  std::vector<unsigned char> buffer(size * record);
+#ifdef APCOMP_OPENMP_ENABLED
+  #pragma omp parallel for
+#endif
+  for(size_t i = 0; i < size; ++i)
+  {
+    const VolumePartial<FloatType> &partial = partials[i];
+    unsigned char *dest = &buffer[i * record];
+    std::memcpy(dest, &partial.m_pixel_id, sizeof(int));
+    std::memcpy(dest + sizeof(int), &partial.m_depth, sizeof(float));
+    dest += sizeof(int) + sizeof(float);
+    const float values[4] = {partial.m_pixel[0],
+                             partial.m_pixel[1],
+                             partial.m_pixel[2],
+                             partial.m_alpha};
+    for(int c = 0; c < 4; ++c)
+    {
+      const float value = std::min(std::max(values[c], 0.f), 1.f);
+      const unsigned int code = static_cast<unsigned int>(value * max_code + 0.5f);
+      detail::write_code(dest + c * bytes, code, bytes);
+    }
+  }
+  bb.save_binary(reinterpret_cast<const char*>(&buffer[0]), buffer.size());
+}
+
+template<typename FloatType>
+void load_partials(apcompdiy::BinaryBuffer &bb,
+                   std::vector<VolumePartial<FloatType>> &partials)
+{
+  size_t size;
+  int bits;
+  apcompdiy::load(bb, size);
+  apcompdiy::load(bb, bits);
+  partials.resize(size);
+  if(size == 0)
+  {
+    return;
+  }
+  if(bits == 32)
+  {
+    apcompdiy::load(bb, &partials[0], size);
+    return;
+  }
+
+  const int bytes = bits / 8;
+  const int record = sizeof(int) + sizeof(float) + 4 * bytes;
+  const float inv_max_code = 1.f / static_cast<float>((1u << bits) - 1u);
+  std::vector<unsigned char> buffer(size * record);
+  bb.load_binary(reinterpret_cast<char*>(&buffer[0]), buffer.size());
+#ifdef APCOMP_OPENMP_ENABLED
+  #pragma omp parallel for
+#endif
+  for(size_t i = 0; i < size; ++i)
+  {
+    VolumePartial<FloatType> &partial = partials[i];
+    const unsigned char *src = &buffer[i * record];
+    std::memcpy(&partial.m_pixel_id, src, sizeof(int));
+    std::memcpy(&partial.m_depth, src + sizeof(int), sizeof(float));
+    src += sizeof(int) + sizeof(float);
+    partial.m_pixel[0] = detail::read_code(src, bytes) * inv_max_code;
+    partial.m_pixel[1] = detail::read_code(src + bytes, bytes) * inv_max_code;
+    partial.m_pixel[2] = detail::read_code(src + 2 * bytes, bytes) * inv_max_code;
+    partial.m_alpha    = detail::read_code(src + 3 * bytes, bytes) * inv_max_code;
+  }
+}
+
+} // namespace apcomp
+
+#endif
@@ -25,6 +25,7 @@
 // ascent includes
 //-----------------------------------------------------------------------------
 #include <ascent_logging.hpp>
+#include <ascent_async_writer.hpp>
 
 #include <fstream>
 
@@ -51,12 +52,16 @@ void hola(const std::string &source,
     if(source == "relay/blueprint/mesh")
     {
 	std::string root_file = options["root_file"].as_string();
+	// keep io off the main thread while extracts write in the background
+	AsyncWriter::instance().run_io([&]()
+	{
 #if defined(ASCENT_MPI_ENABLED)
-	MPI_Comm comm  = MPI_Comm_f2c(options["mpi_comm"].to_int());
-	conduit::relay::mpi::io::blueprint::load_mesh(root_file,data,comm);
+	    MPI_Comm comm  = MPI_Comm_f2c(options["mpi_comm"].to_int());
+	    conduit::relay::mpi::io::blueprint::load_mesh(root_file,data,comm);
 #else
-	conduit::relay::io::blueprint::load_mesh(root_file,data);
+	    conduit::relay::io::blueprint::load_mesh(root_file,data);
 #endif
+	});
     }
     else if(source == "hola_mpi")
     {
@@ -286,26 +286,25 @@ std::shared_ptr<VTKHCollection> DataObject::as_vtkh_collection()
     }
 
     bool zero_copy = true;
-    conduit::Node n_poly;
-    conduit::Node *to_vtkh = nullptr;
+    std::shared_ptr<conduit::Node> to_vtkh;
     
     if (m_low_bp != nullptr)
     {
       if (Transmogrifier::is_poly(*m_low_bp))
       {
-        Transmogrifier::to_poly(*m_low_bp, n_poly);
-        to_vtkh = &n_poly;
+        to_vtkh = std::make_shared<conduit::Node>();
+        Transmogrifier::to_poly(*m_low_bp, *to_vtkh);
         zero_copy = false;
       }
       else
       {
-        to_vtkh = &(*m_low_bp);
+        to_vtkh = m_low_bp;
       }
     }
 
-    // convert to vtkh
+    // convert to vtkh, fields are converted on first use
     std::shared_ptr<VTKHCollection>
-      vtkh_dset(VTKHDataAdapter::BlueprintToVTKHCollection(*to_vtkh, zero_copy));
+      vtkh_dset(VTKHDataAdapter::BlueprintToLazyVTKHCollection(to_vtkh, zero_copy));
 
     m_vtkh = vtkh_dset;
     
@@ -441,8 +440,35 @@ std::string DataObject::source_string() const
   return res;
 }
 
+//-----------------------------------------------------------------------------
+conduit::index_t DataObject::bytes() const
+{
+  conduit::index_t res = 0;
+  if(m_low_bp != nullptr)
+  {
+    res += m_low_bp->total_bytes_allocated();
+  }
+  // low and high order may be the same node
+  if(m_high_bp != nullptr && m_high_bp != m_low_bp)
+  {
+    res += m_high_bp->total_bytes_allocated();
+  }
+  return res;
+}
+
 //-----------------------------------------------------------------------------
 };
 //-----------------------------------------------------------------------------
 // -- end ascent:: --
 //-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+namespace flow
+{
+template <>
+conduit::index_t DataWrapper<ascent::DataObject>::bytes() const
+{
+  const ascent::DataObject *data_object = value<ascent::DataObject>();
+  return data_object != nullptr ? data_object->bytes() : 0;
+}
+};
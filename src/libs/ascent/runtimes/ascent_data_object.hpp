@@ -16,6 +16,7 @@
 
 #include <ascent.hpp>
 #include <conduit.hpp>
+#include <flow_data.hpp>
 #include <memory>
 
 //-----------------------------------------------------------------------------
@@ -73,6 +74,9 @@ public:
   std::shared_ptr<conduit::Node>  as_node();          // just return the coduit node
   DataObject::Source              source() const;
   std::string source_string() const;
+  // bytes held by the blueprint representations. vtkh and dray
+  // data are not counted, and neither is sharing with other objects
+  conduit::index_t bytes() const;
 protected:
   std::shared_ptr<conduit::Node>  m_low_bp;
   std::shared_ptr<conduit::Node>  m_high_bp;
@@ -89,7 +93,15 @@ protected:
 
 //-----------------------------------------------------------------------------
 };
-#endif
 //-----------------------------------------------------------------------------
 // -- end ascent:: --
 //-----------------------------------------------------------------------------
+
+// lets the flow workspace estimate the size of filter outputs
+namespace flow
+{
+template <>
+conduit::index_t DataWrapper<ascent::DataObject>::bytes() const;
+};
+
+#endif
@@ -45,12 +45,16 @@
 #include <ascent_transmogrifier.hpp>
 #include <ascent_data_object.hpp>
 #include <ascent_data_logger.hpp>
+#include <ascent_async_writer.hpp>
+#include <png_utils/ascent_image_encoder.hpp>
 
 #if defined(ASCENT_VTKM_ENABLED)
 #include <vtkm/cont/Error.h>
 #include <vtkh/vtkh.hpp>
 #include <vtkh/Error.hpp>
 #include <vtkh/Logger.hpp>
+#include <vtkh/rendering/RayTracer.hpp>
+#include <vtkh/compositing/Compositor.hpp>
 
 #ifdef VTKM_CUDA
 #include <vtkm/cont/cuda/ChooseCudaDevice.h>
@@ -59,6 +63,13 @@
 
 #if defined(ASCENT_DRAY_ENABLED)
 #include <dray/dray.hpp>
+#include <dray/array_registry.hpp>
+#include <dray/utils/data_logger.hpp>
+#include <dray/queries/point_locator.hpp>
+#endif
+
+#if defined(ASCENT_PYTHON_ENABLED)
+#include <flow_python_script_filter.hpp>
 #endif
 using namespace conduit;
 using namespace std;
@@ -91,6 +102,96 @@ class InfoHandler
 
 int InfoHandler::m_rank = 0;
 
+//-----------------------------------------------------------------------------
+// -- begin ascent::detail --
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+//-----------------------------------------------------------------------------
+// forwards vtkh and dray log entries into flow's tracer
+//-----------------------------------------------------------------------------
+void
+record_trace_event(int phase,
+                   const char *name,
+                   double value,
+                   const char *category)
+{
+    if(phase == flow::Trace::BEGIN)
+    {
+        flow::Trace::begin(name, category);
+    }
+    else if(phase == flow::Trace::END)
+    {
+        flow::Trace::end(name, category);
+    }
+    else
+    {
+        flow::Trace::counter(name, value, category);
+    }
+}
+
+#if defined(ASCENT_VTKM_ENABLED)
+//-----------------------------------------------------------------------------
+void
+vtkh_trace_event(int phase, const char *name, double value)
+{
+    record_trace_event(phase, name, value, "vtkh");
+}
+
+//-----------------------------------------------------------------------------
+// triangles and bvhs are shared by all scenes in an execute, but they
+// hold on to that cycle's data, so drop them however the execute ends
+//-----------------------------------------------------------------------------
+struct GeometryCacheGuard
+{
+    ~GeometryCacheGuard()
+    {
+        vtkh::RayTracer::ClearGeometryCache();
+    }
+};
+#endif
+
+#ifdef ASCENT_MPI_ENABLED
+//-----------------------------------------------------------------------------
+// memory aware schedules must agree on all ranks, since filters make
+// collective calls
+//-----------------------------------------------------------------------------
+void
+max_output_bytes(std::vector<conduit::index_t> &bytes)
+{
+    if(bytes.empty())
+    {
+        return;
+    }
+    std::vector<conduit::int64> local(bytes.begin(), bytes.end());
+    std::vector<conduit::int64> global(local.size());
+    MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+    MPI_Allreduce(&local[0],
+                  &global[0],
+                  (int) local.size(),
+                  MPI_INT64_T,
+                  MPI_MAX,
+                  mpi_comm);
+    bytes.assign(global.begin(), global.end());
+}
+#endif
+
+#if defined(ASCENT_DRAY_ENABLED)
+//-----------------------------------------------------------------------------
+void
+dray_trace_event(int phase, const char *name, double value)
+{
+    record_trace_event(phase, name, value, "dray");
+}
+#endif
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::detail --
+//-----------------------------------------------------------------------------
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 //
@@ -104,9 +205,16 @@ AscentRuntime::AscentRuntime()
 :Runtime(),
  m_refinement_level(2), // default refinement level for high order meshes
  m_rank(0),
+ m_publish_checked(false),
+ m_domain_offset(0),
  m_default_output_dir("."),
  m_session_name("ascent_session"),
- m_field_filtering(false)
+ m_field_filtering(false),
+ m_trace(false),
+ m_trace_held(false),
+ m_trace_prefix("ascent_trace"),
+ m_trace_count(0),
+ m_async_writer(false)
 {
     m_ghost_fields.append() = "ascent_ghosts";
     flow::filters::register_builtin();
@@ -139,6 +247,7 @@ AscentRuntime::Initialize(const conduit::Node &options)
     }
 
     flow::Workspace::set_default_mpi_comm(options["mpi_comm"].to_int());
+    flow::Workspace::set_output_bytes_reducer(detail::max_output_bytes);
 #if defined(ASCENT_VTKM_ENABLED)
     vtkh::Initialize();
     vtkh::SetMPICommHandle(options["mpi_comm"].to_int());
@@ -170,6 +279,13 @@ AscentRuntime::Initialize(const conduit::Node &options)
     // set a info handler so we only display messages on rank 0;
     conduit::utils::set_info_handler(InfoHandler::info_handler);
     AllocationManager::set_conduit_mem_handlers();
+
+    // async extracts of all open runtimes share one writer
+    if(!m_async_writer)
+    {
+        AsyncWriter::instance().attach();
+        m_async_writer = true;
+    }
 #ifdef VTKM_CUDA
 
     bool sel_cuda_device = true;
@@ -267,6 +383,48 @@ AscentRuntime::Initialize(const conduit::Node &options)
         ASCENT_ERROR("'refinement_level' must be greater than 0");
       }
     }
+
+    if(options.has_path("refinement_mode"))
+    {
+      const std::string mode = options["refinement_mode"].as_string();
+      if(mode == "adaptive")
+      {
+#if defined(ASCENT_DRAY_ENABLED)
+        Transmogrifier::m_adaptive_refinement = true;
+#else
+        ASCENT_ERROR("'refinement_mode' 'adaptive' requires Devil Ray");
+#endif
+      }
+      else if(mode == "uniform")
+      {
+        Transmogrifier::m_adaptive_refinement = false;
+      }
+      else
+      {
+        ASCENT_ERROR("'refinement_mode' must be 'uniform' or 'adaptive'"
+                     <<" not '"<<mode<<"'");
+      }
+    }
+
+    if(options.has_path("refinement_tolerance"))
+    {
+      const double tolerance = options["refinement_tolerance"].to_float64();
+      if(tolerance <= 0)
+      {
+        ASCENT_ERROR("'refinement_tolerance' must be greater than 0");
+      }
+      Transmogrifier::m_refinement_tolerance = tolerance;
+    }
+
+    if(options.has_path("refinement_element_budget"))
+    {
+      const long long budget = options["refinement_element_budget"].to_int64();
+      if(budget < 0)
+      {
+        ASCENT_ERROR("'refinement_element_budget' must not be negative");
+      }
+      Transmogrifier::m_refinement_budget = budget;
+    }
 #endif
     if(options.has_path("default_dir"))
     {
@@ -282,6 +440,18 @@ AscentRuntime::Initialize(const conduit::Node &options)
 
     m_runtime_options = options;
 
+    if(options.has_path("trace/enabled"))
+    {
+      m_trace = options["trace/enabled"].as_string() == "true";
+    }
+
+    if(options.has_path("trace/file_prefix"))
+    {
+      m_trace_prefix = options["trace/file_prefix"].as_string();
+    }
+
+    EnableTracing(m_trace);
+
     // NOTE:
     // if both ghost_field_name and ghost_field_names
     // are present, ghost_field_names is used
@@ -373,6 +543,17 @@ AscentRuntime::Initialize(const conduit::Node &options)
       }
     }
 
+    if(options.has_path("memory_aware_schedule"))
+    {
+      m_workspace.enable_memory_aware_schedule(
+        options["memory_aware_schedule"].as_string() == "true");
+    }
+
+    if(options.has_child("image_encoding"))
+    {
+      ImageEncoder::SetDefaultOptions(options["image_encoding"]);
+    }
+
     Node msg;
     ascent::about(msg["about"]);
     msg["options"] = options;
@@ -467,13 +648,131 @@ AscentRuntime::AddPublishedMeshInfo()
     m_info["published_mesh_info/total_bytes_compact_per_rank"] = src_tbytes;
 #endif
 
+    // false if the last publish reused the domain id and ghost checks
+    m_info["published_mesh_info/checked"] = m_publish_checked ? "true" : "false";
+
 }
 
 
+//-----------------------------------------------------------------------------
+void
+AscentRuntime::AddMemoryInfo()
+{
+    conduit::Node &mem_info = m_info["memory"];
+    HostMemory::info(mem_info["ascent/host"]);
+#if defined(ASCENT_DEVICE_ENABLED)
+    DeviceMemory::info(mem_info["ascent/device"]);
+#endif
+#if defined(ASCENT_DRAY_ENABLED)
+    mem_info["dray/number_of_arrays"] = dray::ArrayRegistry::number_of_arrays();
+    mem_info["dray/host/usage"] = (uint64) dray::ArrayRegistry::host_usage();
+    mem_info["dray/host/pool/current_size"]
+      = (uint64) dray::ArrayRegistry::host_pool_size();
+    mem_info["dray/host/pool/high_water"]
+      = (uint64) dray::ArrayRegistry::host_pool_high_water();
+    mem_info["dray/device/usage"] = (uint64) dray::ArrayRegistry::device_usage();
+    mem_info["dray/device/pool/current_size"]
+      = (uint64) dray::ArrayRegistry::device_pool_size();
+    mem_info["dray/device/pool/high_water"]
+      = (uint64) dray::ArrayRegistry::device_pool_high_water();
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Tracing is process wide, it stays on while any runtime asked for it.
+// Each runtime holds at most one reference.
+//-----------------------------------------------------------------------------
+void
+AscentRuntime::EnableTracing(bool on)
+{
+    static int trace_refs = 0;
+    if(on == m_trace_held)
+    {
+        return;
+    }
+    m_trace_held = on;
+    trace_refs += on ? 1 : -1;
+
+    // only the first and the last reference change anything
+    if(trace_refs != (on ? 1 : 0))
+    {
+        return;
+    }
+
+    flow::Trace::enable(on);
+#if defined(ASCENT_VTKM_ENABLED)
+    vtkh::DataLogger::SetTraceCallback(on ? detail::vtkh_trace_event : nullptr);
+#endif
+#if defined(ASCENT_DRAY_ENABLED)
+    dray::DataLogger::set_trace_callback(on ? detail::dray_trace_event : nullptr);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+void
+AscentRuntime::SaveTrace()
+{
+    std::vector<flow::Trace::Event> events;
+    flow::Trace::flush(events);
+
+    int trace_id = m_trace_count;
+    if(Metadata::n_metadata.has_path("cycle"))
+    {
+      trace_id = Metadata::n_metadata["cycle"].to_int32();
+    }
+    m_trace_count++;
+
+    std::string file_name = conduit_fmt::format("{}_{:06d}_{:06d}.json",
+                                                m_trace_prefix,
+                                                trace_id,
+                                                m_rank);
+    file_name = conduit::utils::join_file_path(m_default_output_dir,file_name);
+
+    flow::Trace::write_chrome_trace(events, m_rank, file_name);
+
+    Node &trace_info = m_info["trace"];
+    trace_info["file"] = file_name;
+    trace_info["number_of_events"] = (int64) events.size();
+    trace_info["dropped_events"] = (int64) flow::Trace::number_of_dropped_events();
+    flow::Trace::summary(events, trace_info["summary"]);
+}
+
 //-----------------------------------------------------------------------------
 void
 AscentRuntime::Cleanup()
 {
+    // finish any extracts still writing in the background. The writer
+    // keeps running while other runtimes use it
+    if(m_async_writer)
+    {
+        m_async_writer = false;
+        AsyncWriter::instance().detach();
+    }
+
+    Transmogrifier::clear_cache();
+
+#if defined(ASCENT_DRAY_ENABLED)
+    // probe locations kept between cycles
+    dray::PointLocator::clear_cache();
+#endif
+
+#if defined(ASCENT_PYTHON_ENABLED)
+    // python scripts kept compiled between executions
+    flow::filters::PythonScript::clear_compiled_scripts();
+#endif
+
+#if defined(ASCENT_VTKM_ENABLED)
+    // ray tracing geometry kept for the current execute
+    vtkh::RayTracer::ClearGeometryCache();
+#endif
+
+#if defined(ASCENT_VTKM_ENABLED) && defined(ASCENT_MPI_ENABLED)
+    // the node communicators and windows used for compositing
+    vtkh::Compositor::ReleaseSharedMemory();
+#endif
+
+    EnableTracing(false);
+
     if(m_runtime_options.has_child("timings") &&
        m_runtime_options["timings"].as_string() == "true")
     {
@@ -498,18 +797,130 @@ AscentRuntime::Cleanup()
 void
 AscentRuntime::Publish(const conduit::Node &data)
 {
+    flow::TraceScope trace_scope("publish", "ascent");
 
     blueprint::mesh::to_multi_domain(data, m_source);
-    EnsureDomainIds();
-    // filter out default ghost name and
-    // check if user provided ghost names are actually there
-    VerifyGhosts();
+
+    // ghost fields painted for the last publish's nestsets are not
+    // part of this data, start again from the verified ones
+    if(!m_publish_signature.dtype().is_empty())
+    {
+      m_ghost_fields = m_verified_ghost_fields;
+    }
+
+    // the domain id and ghost checks are collective, only run
+    // them when the domain layout changed on some rank
+    conduit::Node signature;
+    PublishSignature(m_ghost_fields, signature);
+    conduit::Node diff_info;
+    int changed = m_publish_signature.diff(signature, diff_info) ? 1 : 0;
+#ifdef ASCENT_MPI_ENABLED
+    MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+    MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_INT, MPI_MAX, mpi_comm);
+#endif
+
+    m_publish_checked = changed != 0;
+    if(changed)
+    {
+      // filter out default ghost name and
+      // check if user provided ghost names are actually there
+      VerifyGhosts();
+      // the next publish is compared against the verified ghost
+      // fields. Domain ids are left out, as the user gave them
+      PublishSignature(m_ghost_fields, signature);
+      EnsureDomainIds();
+      m_publish_signature = signature;
+      m_verified_ghost_fields = m_ghost_fields;
+    }
+    else
+    {
+      // same layout, so the same ids are generated
+      const int num_domains = m_source.number_of_children();
+      for(int i = 0; i < num_domains; ++i)
+      {
+        conduit::Node &dom = m_source.child(i);
+        if(!dom.has_path("state/domain_id"))
+        {
+          dom["state/domain_id"] = m_domain_offset + i;
+        }
+      }
+    }
     // if nestsets are present, augment current ghost fields
     // for zones masked by finer levels. If no ghosts are present
     // we create them
     PaintNestsets();
 }
 
+//-----------------------------------------------------------------------------
+// everything the domain id and ghost checks look at: the ghost field
+// names, and per domain its id, which ghost fields it has (and their
+// topologies), its topologies and its nestsets
+//-----------------------------------------------------------------------------
+void
+AscentRuntime::PublishSignature(const conduit::Node &ghost_fields,
+                                conduit::Node &signature)
+{
+    signature.reset();
+    signature["ghost_fields"].set(ghost_fields);
+    conduit::Node &domains = signature["domains"];
+    domains.set(DataType::list());
+
+    const int num_ghosts = ghost_fields.number_of_children();
+    const int num_domains = m_source.number_of_children();
+    for(int i = 0; i < num_domains; ++i)
+    {
+      const conduit::Node &dom = m_source.child(i);
+      conduit::Node &dom_sig = domains.append();
+
+      if(dom.has_path("state/domain_id"))
+      {
+        dom_sig["id"] = dom["state/domain_id"].to_int64();
+      }
+
+      conduit::Node &ghosts = dom_sig["ghosts"];
+      ghosts.set(DataType::list());
+      for(int g = 0; g < num_ghosts; ++g)
+      {
+        const std::string fpath = "fields/" + ghost_fields.child(g).as_string();
+        std::string topo;
+        if(dom.has_path(fpath + "/topology") &&
+           dom[fpath + "/topology"].dtype().is_string())
+        {
+          topo = dom[fpath + "/topology"].as_string();
+        }
+        ghosts.append() = dom.has_path(fpath) ? "+" + topo : "-";
+      }
+
+      conduit::Node &topos = dom_sig["topologies"];
+      topos.set(DataType::list());
+      if(dom.has_child("topologies"))
+      {
+        const std::vector<std::string> topo_names = dom["topologies"].child_names();
+        for(auto topo_name : topo_names)
+        {
+          topos.append() = topo_name;
+        }
+      }
+
+      if(dom.has_child("nestsets"))
+      {
+        const conduit::Node &nestsets = dom["nestsets"];
+        const std::vector<std::string> nest_names = nestsets.child_names();
+        for(int n = 0; n < nestsets.number_of_children(); ++n)
+        {
+          const conduit::Node &nestset = nestsets.child(n);
+          conduit::Node &nest_sig = dom_sig["nestsets"].append();
+          nest_sig["name"] = nest_names[n];
+          if(nestset.has_path("topology") &&
+             nestset["topology"].dtype().is_string())
+          {
+            nest_sig["topology"] = nestset["topology"].as_string();
+          }
+        }
+      }
+    }
+}
+
 //-----------------------------------------------------------------------------
 void
 AscentRuntime::EnsureDomainIds()
@@ -604,6 +1015,8 @@ AscentRuntime::EnsureDomainIds()
     {
       domain_offset += domains_per_rank[i];
     }
+    // reused by publishes with the same layout
+    m_domain_offset = domain_offset;
     int total_domains = 0;
     for(int i = 0; i < comm_size; i++)
     {
@@ -762,6 +1175,10 @@ AscentRuntime::CreateDefaultFilters()
     //
     conduit::Node params;
     params["protocol"] = "mesh";
+    if(m_runtime_options.has_path("verify/full_frequency"))
+    {
+      params["full_frequency"] = m_runtime_options["verify/full_frequency"];
+    }
     m_workspace.graph().add_filter("blueprint_verify", // registered filter name
                                    "verify",           // "unique" filter name
                                    params);
@@ -796,6 +1213,14 @@ AscentRuntime::CreateDefaultFilters()
       threshold_params["field"] = ghost_fields[i];
       threshold_params["min_value"] = 0;
       threshold_params["max_value"] = 1;
+      if(m_runtime_options.has_path("static_ghosts"))
+      {
+        threshold_params["static_ghosts"] = m_runtime_options["static_ghosts"];
+      }
+      if(m_runtime_options.has_path("static_topology"))
+      {
+        threshold_params["static_topology"] = m_runtime_options["static_topology"];
+      }
 
       m_workspace.graph().add_filter("vtkh_ghost_stripper",
                                      filter_name,
@@ -1440,6 +1865,8 @@ AscentRuntime::PopulateMetadata()
   Metadata::n_metadata["ghost_field"] = m_ghost_fields;
   Metadata::n_metadata["default_dir"] = m_default_output_dir;
   Metadata::n_metadata["comments"] = m_comments;
+  // lets renders keep their encoded pngs around for streaming
+  Metadata::n_metadata["web/stream"] = m_web_interface.Enabled() ? "true" : "false";
 
 }
 //-----------------------------------------------------------------------------
@@ -1965,6 +2392,10 @@ AscentRuntime::Execute(const conduit::Node &actions)
 
     m_workspace.enable_timings(log_timings);
 
+#if defined(ASCENT_VTKM_ENABLED)
+    detail::GeometryCacheGuard geometry_cache_guard;
+#endif
+
     // catch any errors that come up here and forward
     // them up as a conduit error
 
@@ -1972,6 +2403,7 @@ AscentRuntime::Execute(const conduit::Node &actions)
     try
     {
         ResetInfo();
+        flow::Trace::begin("execute", "ascent");
         AddPublishedMeshInfo();
 
         conduit::Node diff_info;
@@ -2043,6 +2475,7 @@ AscentRuntime::Execute(const conduit::Node &actions)
 #endif
         // now execute the data flow graph
         m_workspace.execute();
+        m_workspace.schedule_info(m_info["flow_graph/schedule"]);
 
 #if defined(ASCENT_VTKM_ENABLED)
         if(log_timings)
@@ -2085,11 +2518,30 @@ AscentRuntime::Execute(const conduit::Node &actions)
           runtime::expressions::ExpressionEval::get_last(m_info["expressions"]);
         }
 
+        // give back cached temporaries we did not need this cycle
+        // and report allocator statistics
+        HostMemory::trim();
+        AddMemoryInfo();
+
+        flow::Trace::end("execute", "ascent");
+        if(m_trace)
+        {
+          SaveTrace();
+        }
+
         // add flow graphviz details to info
         m_info["flow_graph_dot"]      = m_workspace.graph().to_dot();
         m_info["flow_graph_dot_html"] = m_workspace.graph().to_dot_html();
 
-        m_web_interface.PushRenders(render_file_names);
+        if(m_workspace.registry().has_entry("image_buffers"))
+        {
+          Node *image_buffers = m_workspace.registry().fetch<Node>("image_buffers");
+          m_web_interface.PushRenders(render_file_names, *image_buffers);
+        }
+        else
+        {
+          m_web_interface.PushRenders(render_file_names);
+        }
 
         Node msg;
         msg["info"].set_external(m_info);
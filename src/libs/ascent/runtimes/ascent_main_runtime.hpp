@@ -76,6 +76,12 @@ private:
     int               m_refinement_level;
     int               m_rank;
     conduit::Node     m_ghost_fields; // a list of strings
+    // domain layout seen by the last publish that ran the collective
+    // domain id and ghost checks, and their results
+    conduit::Node     m_publish_signature;
+    conduit::Node     m_verified_ghost_fields;
+    bool              m_publish_checked;
+    int               m_domain_offset;
     std::string       m_default_output_dir;
 
     std::string       m_session_name;
@@ -85,10 +91,23 @@ private:
     bool              m_field_filtering;
     std::set<std::string> m_field_list;
 
+    // trace events from ascent, flow, vtkh and dray (option "trace")
+    bool              m_trace;
+    // true while this runtime keeps process wide tracing on
+    bool              m_trace_held;
+    std::string       m_trace_prefix;
+    int               m_trace_count;
+
+    // attached to the shared async extract writer
+    bool              m_async_writer;
+
     conduit::Node     m_comments;
 
     void              ResetInfo();
     void              AddPublishedMeshInfo();
+    void              AddMemoryInfo();
+    void              EnableTracing(bool on);
+    void              SaveTrace();
 
     flow::Workspace   m_workspace;
     conduit::Node CreateDefaultFilters();
@@ -129,6 +148,8 @@ private:
 
     void BuildGraph(const conduit::Node &actions);
     void EnsureDomainIds();
+    void PublishSignature(const conduit::Node &ghost_fields,
+                          conduit::Node &signature);
     void PopulateMetadata();
 
     std::string GetDefaultImagePrefix(const std::string scene);
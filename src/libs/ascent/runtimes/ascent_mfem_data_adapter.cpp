@@ -12,14 +12,19 @@
 //-----------------------------------------------------------------------------
 #include "ascent_mfem_data_adapter.hpp"
 
+#include <ascent_config.h>
 #include <ascent_logging.hpp>
 
 // standard lib includes
+#include <exception>
 #include <iostream>
 #include <string.h>
 #include <limits.h>
 #include <cstdlib>
 #include <sstream>
+#include <map>
+#include <memory>
+#include <set>
 
 // third party includes
 #include <conduit_blueprint.hpp>
@@ -39,6 +44,199 @@ using namespace conduit;
 namespace ascent
 {
 
+//-----------------------------------------------------------------------------
+// -- begin ascent::detail --
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+//-----------------------------------------------------------------------------
+// fnv-1a
+//-----------------------------------------------------------------------------
+void
+hash_bytes(const void *data, size_t size, conduit::uint64 &hash)
+{
+  const unsigned char *bytes = static_cast<const unsigned char*>(data);
+  for(size_t i = 0; i < size; ++i)
+  {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+}
+
+//-----------------------------------------------------------------------------
+// hash of everything the dof layouts depend on: the connectivity, element
+// types and the basis of the nodes, but not where the mesh is
+//-----------------------------------------------------------------------------
+conduit::uint64
+topology_hash(mfem::Mesh *mesh)
+{
+  conduit::uint64 hash = 14695981039346656037ULL;
+
+  const int dims[4] = {mesh->Dimension(),
+                       mesh->SpaceDimension(),
+                       mesh->GetNE(),
+                       mesh->GetNV()};
+  hash_bytes(dims, sizeof(dims), hash);
+
+  for(int e = 0; e < mesh->GetNE(); ++e)
+  {
+    const mfem::Element *elem = mesh->GetElement(e);
+    const int geom = elem->GetGeometryType();
+    hash_bytes(&geom, sizeof(int), hash);
+    hash_bytes(elem->GetVertices(), sizeof(int) * elem->GetNVertices(), hash);
+  }
+
+  const mfem::GridFunction *nodes = mesh->GetNodes();
+  if(nodes != nullptr)
+  {
+    const mfem::FiniteElementSpace *fes = nodes->FESpace();
+    const std::string basis = fes->FEColl()->Name();
+    hash_bytes(basis.c_str(), basis.size(), hash);
+    const int layout[3] = {fes->GetVDim(), fes->GetOrdering(), nodes->Size()};
+    hash_bytes(layout, sizeof(layout), hash);
+  }
+
+  return hash;
+}
+
+//-----------------------------------------------------------------------------
+// hash of the vertex and node positions
+//-----------------------------------------------------------------------------
+conduit::uint64
+geometry_hash(mfem::Mesh *mesh)
+{
+  conduit::uint64 hash = 14695981039346656037ULL;
+  for(int v = 0; v < mesh->GetNV(); ++v)
+  {
+    hash_bytes(mesh->GetVertex(v), sizeof(double) * mesh->SpaceDimension(), hash);
+  }
+
+  const mfem::GridFunction *nodes = mesh->GetNodes();
+  if(nodes != nullptr)
+  {
+    hash_bytes(nodes->HostRead(), sizeof(double) * nodes->Size(), hash);
+  }
+  return hash;
+}
+
+//-----------------------------------------------------------------------------
+// the high and low order spaces for one field basis and the operator
+// that maps between them
+//-----------------------------------------------------------------------------
+struct LinearizeLayout
+{
+  bool node_centered;
+  std::unique_ptr<mfem::FiniteElementCollection> ho_col;
+  std::unique_ptr<mfem::FiniteElementSpace>      ho_fes;
+  std::unique_ptr<mfem::FiniteElementCollection> lo_col;
+  std::unique_ptr<mfem::FiniteElementSpace>      lo_fes;
+  mfem::OperatorHandle                           hi_to_lo;
+};
+
+//-----------------------------------------------------------------------------
+// Everything Linearize can reuse for a domain while its mesh topology is
+// unchanged. The transfer operators reference the high order space, which
+// lives on the mesh passed in for the current cycle. We keep our own copy
+// of the high order mesh (and spaces on it) so the operators stay valid
+// after the caller's data goes away. The dof layout and the transfer
+// operators (interpolation in reference space) only depend on the mesh
+// topology and the basis, so a new cycle's grid functions can be applied
+// to the cached operators directly. A mesh that only moved keeps the
+// operators and just gets new refined coordinates.
+//-----------------------------------------------------------------------------
+struct LinearizeEntry
+{
+  conduit::uint64 topology_hash = 0;
+  conduit::uint64 geometry_hash = 0;
+  int refinement = 0;
+  std::unique_ptr<mfem::Mesh> ho_mesh;
+  std::unique_ptr<mfem::Mesh> lo_mesh;
+  // blueprint version of the refined mesh
+  conduit::Node n_mesh;
+  std::map<std::string, std::unique_ptr<LinearizeLayout>> layouts;
+
+  void reset(mfem::Mesh *mesh,
+             conduit::uint64 topo_hash,
+             conduit::uint64 geom_hash,
+             int ref)
+  {
+    layouts.clear();
+    topology_hash = topo_hash;
+    geometry_hash = geom_hash;
+    refinement = ref;
+    ho_mesh.reset(new mfem::Mesh(*mesh, true));
+    // refine the mesh and convert to blueprint
+    lo_mesh.reset(new mfem::Mesh(
+      mfem::Mesh::MakeRefined(*ho_mesh, ref, mfem::BasisType::GaussLobatto)));
+    n_mesh.reset();
+    MFEMDataAdapter::MeshToBlueprintMesh(lo_mesh.get(), n_mesh);
+  }
+
+  // the spaces and operators stay on the meshes they were built on,
+  // only the output takes the coordinates of the moved mesh
+  void update_geometry(mfem::Mesh *mesh, conduit::uint64 geom_hash)
+  {
+    geometry_hash = geom_hash;
+    mfem::Mesh moved =
+      mfem::Mesh::MakeRefined(*mesh, refinement, mfem::BasisType::GaussLobatto);
+    n_mesh.reset();
+    MFEMDataAdapter::MeshToBlueprintMesh(&moved, n_mesh);
+  }
+
+  LinearizeLayout &layout(const mfem::FiniteElementSpace *fes)
+  {
+    const std::string basis(fes->FEColl()->Name());
+    std::ostringstream oss;
+    oss << basis << "_" << fes->GetVDim() << "_" << fes->GetOrdering();
+    std::unique_ptr<LinearizeLayout> &res = layouts[oss.str()];
+    if(res)
+    {
+      return *res;
+    }
+
+    res.reset(new LinearizeLayout);
+    res->ho_col.reset(mfem::FiniteElementCollection::New(basis.c_str()));
+    res->ho_fes.reset(new mfem::FiniteElementSpace(ho_mesh.get(),
+                                                   res->ho_col.get(),
+                                                   fes->GetVDim(),
+                                                   fes->GetOrdering()));
+    // we only have L2 or H1 at this point
+    res->node_centered = basis.find("H1_") != std::string::npos;
+    if(res->node_centered)
+    {
+      res->lo_col.reset(new mfem::LinearFECollection);
+    }
+    else
+    {
+      int  p = 0; // single scalar
+      res->lo_col.reset(new mfem::L2_FECollection(p, ho_mesh->Dimension(), 1));
+    }
+    res->lo_fes.reset(new mfem::FiniteElementSpace(lo_mesh.get(),
+                                                   res->lo_col.get(),
+                                                   fes->GetVDim()));
+    res->lo_fes->GetTransferOperator(*res->ho_fes, res->hi_to_lo);
+    return *res;
+  }
+};
+
+//-----------------------------------------------------------------------------
+// domain id and its occurrence
+//-----------------------------------------------------------------------------
+typedef std::pair<int,int> LinearizeKey;
+
+std::map<LinearizeKey, LinearizeEntry> &
+linearize_cache()
+{
+  static std::map<LinearizeKey, LinearizeEntry> cache;
+  return cache;
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::detail --
+//-----------------------------------------------------------------------------
+
 MFEMDataSet::MFEMDataSet()
   : m_cycle(0)
 {
@@ -294,80 +492,160 @@ void
 MFEMDataAdapter::Linearize(MFEMDomains *ho_domains, conduit::Node &output, const int refinement)
 {
   const int n_doms = ho_domains->m_data_sets.size();
+  std::map<detail::LinearizeKey, detail::LinearizeEntry> &cache = detail::linearize_cache();
+
+  // first pass (serial): refine any domain whose mesh changed and set up
+  // the transfer operators. mfem's geometry refiner is shared, so this
+  // part can't run concurrently
+  std::vector<std::vector<detail::LinearizeLayout*>> layouts(n_doms);
+  std::set<detail::LinearizeKey> active_domains;
 
   output.reset();
   for(int i = 0; i < n_doms; ++i)
   {
+    const int domain_id = ho_domains->m_domain_ids[i];
+    // domain ids should be unique, but don't let duplicates share an entry
+    detail::LinearizeKey key(domain_id, 0);
+    while(active_domains.find(key) != active_domains.end())
+    {
+      key.second++;
+    }
+    active_domains.insert(key);
 
     conduit::Node &n_dset = output.append();
-    n_dset["state/domain_id"] = int(ho_domains->m_domain_ids[i]);
+    n_dset["state/domain_id"] = domain_id;
     n_dset["state/cycle"] = int(ho_domains->m_data_sets[i]->cycle());
     n_dset["state/time"] = double(ho_domains->m_data_sets[i]->time());
 
     // get the high order data
     mfem::Mesh *ho_mesh = ho_domains->m_data_sets[i]->get_mesh();
-    const mfem::FiniteElementSpace *ho_fes_space = ho_mesh->GetNodalFESpace();
-    const mfem::FiniteElementCollection *ho_fes_col = ho_fes_space->FEColl();
-    // refine the mesh and convert to blueprint
-    mfem::Mesh lo_mesh = mfem::Mesh::MakeRefined(*ho_mesh, refinement, mfem::BasisType::GaussLobatto);
+    const conduit::uint64 topology_hash = detail::topology_hash(ho_mesh);
+    const conduit::uint64 geometry_hash = detail::geometry_hash(ho_mesh);
 
-    MeshToBlueprintMesh(&lo_mesh, n_dset);
+    detail::LinearizeEntry &entry = cache[key];
+    if(entry.ho_mesh == nullptr ||
+       entry.topology_hash != topology_hash ||
+       entry.refinement != refinement)
+    {
+      entry.reset(ho_mesh, topology_hash, geometry_hash, refinement);
+    }
+    else if(entry.geometry_hash != geometry_hash)
+    {
+      entry.update_geometry(ho_mesh, geometry_hash);
+    }
 
-    int conn_size = n_dset["topologies/main/elements/connectivity"].dtype().number_of_elements();
+    // the refined mesh is the same every cycle unless the mesh moved
+    n_dset.update(entry.n_mesh);
 
+    // make sure the output tree exists before going parallel
     conduit::Node &n_fields = n_dset["fields"];
     auto field_map = ho_domains->m_data_sets[i]->get_field_map();
-
     for(auto it = field_map.begin(); it != field_map.end(); ++it)
     {
-
       mfem::GridFunction *ho_gf = it->second;
-      std::string basis(ho_gf->FESpace()->FEColl()->Name());
-      // we only have L2 or H2 at this point
-      bool node_centered = basis.find("H1_") != std::string::npos;
-
       mfem::FiniteElementSpace *ho_fes = ho_gf->FESpace();
       if(ho_fes == nullptr)
       {
         ASCENT_ERROR("Linearize: high order gf finite element space is null")
       }
-      // create the low order grid function
-      mfem::FiniteElementCollection *lo_col = nullptr;
-      if(node_centered)
+
+      detail::LinearizeLayout &layout = entry.layout(ho_fes);
+      if(layout.ho_fes->GetVSize() != ho_gf->Size())
       {
-        lo_col = new mfem::LinearFECollection;
+        ASCENT_ERROR("Linearize: field '"<<it->first<<"' has "
+                     <<ho_gf->Size()<<" values, expected "
+                     <<layout.ho_fes->GetVSize());
       }
-      else
+      layouts[i].push_back(&layout);
+      n_fields[it->first];
+    }
+  }
+
+  // drop domains we did not see this time around
+  for(auto it = cache.begin(); it != cache.end();)
+  {
+    if(active_domains.find(it->first) == active_domains.end())
+    {
+      it = cache.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  // second pass: project the fields, each domain only touches its
+  // own cache entry and output node. exceptions cannot leave the
+  // parallel region, so the first error is kept and raised after it
+  bool failed = false;
+  std::string error_msg;
+#ifdef ASCENT_OPENMP_ENABLED
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for(int i = 0; i < n_doms; ++i)
+  {
+    try
+    {
+      conduit::Node &n_fields = output.child(i)["fields"];
+      auto field_map = ho_domains->m_data_sets[i]->get_field_map();
+      int f = 0;
+      for(auto it = field_map.begin(); it != field_map.end(); ++it, ++f)
       {
-        int  p = 0; // single scalar
-        lo_col = new mfem::L2_FECollection(p, ho_mesh->Dimension(), 1);
+        detail::LinearizeLayout &layout = *layouts[i][f];
+        // transform the higher order function to a low order function
+        mfem::GridFunction lo_gf(layout.lo_fes.get());
+        layout.hi_to_lo.Ptr()->Mult(*it->second, lo_gf);
+        // extract field
+        conduit::Node &n_field = n_fields[it->first];
+        GridFunctionToBlueprintField(&lo_gf, n_field);
+        // we only have L2 or H1 at this point
+        if(layout.node_centered)
+        {
+          n_field["association"] = "vertex";
+        }
+        else
+        {
+          n_field["association"] = "element";
+        }
       }
-      mfem::FiniteElementSpace *lo_fes = new mfem::FiniteElementSpace(&lo_mesh, lo_col, ho_fes->GetVDim());
-      mfem::GridFunction *lo_gf = new mfem::GridFunction(lo_fes);
-      // transform the higher order function to a low order function somehow
-      mfem::OperatorHandle hi_to_lo;
-      lo_fes->GetTransferOperator(*ho_fes, hi_to_lo);
-      hi_to_lo.Ptr()->Mult(*ho_gf, *lo_gf);
-      // extract field
-      conduit::Node &n_field = n_fields[it->first];
-      GridFunctionToBlueprintField(lo_gf, n_field);
-      // all supported grid functions coming out of mfem end up being associtated with vertices
-      if(node_centered)
+    }
+    catch(const std::exception &e)
+    {
+#ifdef ASCENT_OPENMP_ENABLED
+#pragma omp critical(ascent_mfem_linearize_error)
+#endif
       {
-        n_field["association"] = "vertex";
+        if(!failed)
+        {
+          failed = true;
+          error_msg = e.what();
+        }
       }
-      else
+    }
+    catch(...)
+    {
+#ifdef ASCENT_OPENMP_ENABLED
+#pragma omp critical(ascent_mfem_linearize_error)
+#endif
       {
-        n_field["association"] = "element";
+        if(!failed)
+        {
+          failed = true;
+          error_msg = "unknown error";
+        }
       }
-
-      delete lo_col;
-      delete lo_fes;
-      delete lo_gf;
     }
+  }
 
+  if(failed)
+  {
+    ASCENT_ERROR("Linearize: failed to project fields: "<<error_msg);
+  }
+
+  for(int i = 0; i < n_doms; ++i)
+  {
     conduit::Node info;
-    bool success = conduit::blueprint::verify("mesh",n_dset,info);
+    bool success = conduit::blueprint::verify("mesh",output.child(i),info);
     if(!success)
     {
       info.print();
@@ -377,6 +655,12 @@ MFEMDataAdapter::Linearize(MFEMDomains *ho_domains, conduit::Node &output, const
   //output.schema().print();
 }
 
+void
+MFEMDataAdapter::ClearLinearizeCache()
+{
+  detail::linearize_cache().clear();
+}
+
 void
 MFEMDataAdapter::GridFunctionToBlueprintField(mfem::GridFunction *gf,
                                               Node &n_field,
@@ -89,7 +89,13 @@ public:
 
     static bool IsHighOrder(const conduit::Node &n);
 
+    // refines each high order domain and projects its fields onto the
+    // refined (linear) mesh. The refined mesh and the transfer operators
+    // are kept per domain id and reused while the domain's mesh is
+    // unchanged, so later cycles only project the fields.
     static void Linearize(MFEMDomains *ho_domains, conduit::Node &output, const int refinement);
+    // drops the refined meshes and operators kept by Linearize
+    static void ClearLinearizeCache();
 
     static void GridFunctionToBlueprintField(mfem::GridFunction *gf,
                                             conduit::Node &out,
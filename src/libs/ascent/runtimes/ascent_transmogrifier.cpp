@@ -20,6 +20,12 @@
 #include <conduit_blueprint.hpp>
 #include <algorithm>
 
+#if defined(ASCENT_DRAY_ENABLED)
+#include <dray/filters/adaptive_linearize.hpp>
+#include <dray/io/blueprint_low_order.hpp>
+#include <dray/io/blueprint_reader.hpp>
+#endif
+
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
 //-----------------------------------------------------------------------------
@@ -27,6 +33,60 @@ namespace ascent
 {
 
 int Transmogrifier::m_refinement_level = 3;
+bool Transmogrifier::m_adaptive_refinement = false;
+double Transmogrifier::m_refinement_tolerance = 0.001;
+long long Transmogrifier::m_refinement_budget = 0;
+
+#if defined(ASCENT_DRAY_ENABLED)
+//-----------------------------------------------------------------------------
+// -- begin ascent::detail --
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+conduit::Node* adaptive_low_order(conduit::Node &dataset)
+{
+  dray::Collection ho_dset;
+  const int num_domains = dataset.number_of_children();
+  for(int i = 0; i < num_domains; ++i)
+  {
+    dray::DataSet dom = dray::BlueprintReader::blueprint_to_dray(dataset.child(i));
+    ho_dset.add_domain(dom);
+  }
+
+  dray::AdaptiveLinearize linearize;
+  linearize.max_level(Transmogrifier::m_refinement_level);
+  linearize.tolerance(Transmogrifier::m_refinement_tolerance);
+  linearize.element_budget(Transmogrifier::m_refinement_budget);
+  dray::Collection lo_dset = linearize.execute(ho_dset);
+
+  conduit::Node *res = new conduit::Node;
+  for(int i = 0; i < num_domains; ++i)
+  {
+    const conduit::Node &ho_dom = dataset.child(i);
+    dray::DataSet dom = lo_dset.domain(i);
+
+    conduit::Node dray_rep, bp_dom;
+    dom.to_node(dray_rep);
+    dray::BlueprintLowOrder::to_blueprint(dray_rep, bp_dom);
+
+    // to_blueprint points at dray's arrays, take a copy
+    conduit::Node &lo_dom = res->append();
+    lo_dom.set(bp_dom);
+    if(ho_dom.has_child("state"))
+    {
+      lo_dom["state"].set(ho_dom["state"]);
+    }
+    lo_dom["state/domain_id"] = dom.domain_id();
+  }
+  return res;
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::detail --
+//-----------------------------------------------------------------------------
+#endif
 
 bool Transmogrifier::is_high_order(const conduit::Node &doms)
 {
@@ -57,6 +117,12 @@ conduit::Node* Transmogrifier::low_order(conduit::Node &dataset)
   {
     ASCENT_ERROR("low_order requires high order data");
   }
+#if defined(ASCENT_DRAY_ENABLED)
+  if(m_adaptive_refinement)
+  {
+    return detail::adaptive_low_order(dataset);
+  }
+#endif
 #if defined(ASCENT_MFEM_ENABLED)
   MFEMDomains *domains = MFEMDataAdapter::BlueprintToMFEMDataSet(dataset);
   conduit::Node *lo_dset = new conduit::Node;
@@ -71,6 +137,13 @@ conduit::Node* Transmogrifier::low_order(conduit::Node &dataset)
 #endif
 }
 
+void Transmogrifier::clear_cache()
+{
+#if defined(ASCENT_MFEM_ENABLED)
+  MFEMDataAdapter::ClearLinearizeCache();
+#endif
+}
+
 bool Transmogrifier::is_poly(const conduit::Node &doms)
 {
   const int num_domains = doms.number_of_children();
@@ -28,9 +28,19 @@ class Transmogrifier
 public:
 // refinement level for high order data
 static int m_refinement_level;
+// when true, each element is refined just enough to bring its estimated
+// error under m_refinement_tolerance (never more than m_refinement_level)
+static bool m_adaptive_refinement;
+static double m_refinement_tolerance;
+// max number of linear elements (over all ranks) adaptive refinement
+// can create, 0 means no limit
+static long long m_refinement_budget;
 
 static conduit::Node* low_order(conduit::Node &dataset);
 
+// releases the refined meshes low_order keeps between cycles
+static void clear_cache();
+
 static bool is_high_order(const conduit::Node &doms);
 
 static bool is_poly(const conduit::Node &doms);
@@ -12,6 +12,7 @@
 //-----------------------------------------------------------------------------
 
 #include "ascent_vtkh_collection.hpp"
+#include "ascent_vtkh_data_adapter.hpp"
 #include "ascent_mpi_utils.hpp"
 #include "ascent_logging.hpp"
 
@@ -84,6 +85,162 @@ void VTKHCollection::add(vtkh::DataSet &dataset, const std::string topology_name
   m_datasets[topology_name] = dataset;
 }
 
+void VTKHCollection::lazy_source(std::shared_ptr<conduit::Node> source,
+                                 bool zero_copy)
+{
+  m_lazy_source = source;
+  m_lazy_zero_copy = zero_copy;
+}
+
+void VTKHCollection::add_lazy_fields(const std::string topology_name,
+                                     const std::vector<LazyDomain> &domains,
+                                     const std::set<std::string> &field_names)
+{
+  if(m_datasets.count(topology_name) == 0)
+  {
+    ASCENT_ERROR("VTKH collection does not have topology '"<<topology_name<<"'");
+  }
+
+  if(field_names.empty())
+  {
+    return;
+  }
+
+  if(domains.size() != m_datasets[topology_name].GetNumberOfDomains())
+  {
+    ASCENT_ERROR("VTKH collection lazy field domains do not match topology '"
+                 <<topology_name<<"'");
+  }
+
+  m_lazy_domains[topology_name] = domains;
+  m_lazy_fields[topology_name].insert(field_names.begin(), field_names.end());
+}
+
+void VTKHCollection::carry_lazy_fields(const VTKHCollection &source,
+                                       const std::string topology_name)
+{
+  auto lazy_it = source.m_lazy_fields.find(topology_name);
+  if(lazy_it == source.m_lazy_fields.end() ||
+     m_datasets.count(topology_name) == 0)
+  {
+    return;
+  }
+
+  const vtkh::DataSet &dataset = m_datasets[topology_name];
+  std::set<std::string> field_names;
+  for(auto name_it = lazy_it->second.begin();
+      name_it != lazy_it->second.end();
+      ++name_it)
+  {
+    if(!dataset.FieldExists(*name_it))
+    {
+      field_names.insert(*name_it);
+    }
+  }
+
+  if(field_names.empty())
+  {
+    return;
+  }
+
+  // every pending field of a collection comes from the same source
+  m_lazy_source = source.m_lazy_source;
+  m_lazy_zero_copy = source.m_lazy_zero_copy;
+  add_lazy_fields(topology_name,
+                  source.m_lazy_domains.at(topology_name),
+                  field_names);
+}
+
+int VTKHCollection::number_of_lazy_fields() const
+{
+  int count = 0;
+  for(auto it = m_lazy_fields.begin(); it != m_lazy_fields.end(); ++it)
+  {
+    count += it->second.size();
+  }
+  return count;
+}
+
+bool VTKHCollection::has_lazy_field(const std::string &field_name,
+                                    std::string &topology_name) const
+{
+  for(auto it = m_lazy_fields.begin(); it != m_lazy_fields.end(); ++it)
+  {
+    if(it->second.count(field_name) != 0)
+    {
+      topology_name = it->first;
+      return true;
+    }
+  }
+  return false;
+}
+
+void VTKHCollection::convert_lazy_fields(const std::string &topology_name)
+{
+  auto lazy_it = m_lazy_fields.find(topology_name);
+  if(lazy_it == m_lazy_fields.end())
+  {
+    return;
+  }
+  // copy, since conversion removes entries from the pending set
+  std::vector<std::string> field_names(lazy_it->second.begin(),
+                                       lazy_it->second.end());
+  convert_lazy_fields(topology_name, field_names);
+}
+
+void VTKHCollection::convert_lazy_fields(const std::string &topology_name,
+                                         const std::vector<std::string> &field_names)
+{
+  auto lazy_it = m_lazy_fields.find(topology_name);
+  if(lazy_it == m_lazy_fields.end())
+  {
+    return;
+  }
+
+  std::set<std::string> &pending = lazy_it->second;
+  const std::vector<LazyDomain> &domains = m_lazy_domains[topology_name];
+  vtkh::DataSet &dataset = m_datasets[topology_name];
+
+  for(size_t f = 0; f < field_names.size(); ++f)
+  {
+    const std::string &field_name = field_names[f];
+    if(pending.erase(field_name) == 0)
+    {
+      // unknown or already converted
+      continue;
+    }
+
+    for(size_t i = 0; i < domains.size(); ++i)
+    {
+      const conduit::Node &dom = m_lazy_source->child(domains[i].m_index);
+      if(!dom.has_child("fields") || !dom["fields"].has_child(field_name))
+      {
+        continue;
+      }
+
+      VTKHDataAdapter::AddBlueprintField(field_name,
+                                         dom["fields"][field_name],
+                                         topology_name,
+                                         domains[i].m_neles,
+                                         domains[i].m_nverts,
+                                         &dataset.GetDomain(i),
+                                         m_lazy_zero_copy);
+    }
+  }
+
+  if(pending.empty())
+  {
+    m_lazy_fields.erase(lazy_it);
+    m_lazy_domains.erase(topology_name);
+  }
+
+  if(m_lazy_fields.empty())
+  {
+    // nothing left to convert, let go of the source
+    m_lazy_source.reset();
+  }
+}
+
 bool VTKHCollection::has_topology(const std::string name) const
 {
   bool has_topo = m_datasets.count(name) != 0;
@@ -103,6 +260,11 @@ std::string VTKHCollection::field_topology(const std::string field_name) {
       break;
     }
   }
+
+  if(topo_name == "")
+  {
+    has_lazy_field(field_name, topo_name);
+  }
 #if defined(ASCENT_MPI_ENABLED)
   // if the topology does not exist on this rank,
   // but exists somewhere, we need to figure out what
@@ -149,6 +311,11 @@ bool VTKHCollection::has_field(const std::string field_name) const
     }
   }
 
+  if(!has)
+  {
+    std::string topo_name;
+    has = has_lazy_field(field_name, topo_name);
+  }
 
   return detail::global_has(has);
 }
@@ -242,6 +409,15 @@ VTKHCollection::dataset_by_topology(const std::string topology_name)
   // this will return a empty dataset if this rank
   // does not actually have this topo, but it exists
   // globally
+  convert_lazy_fields(topology_name);
+  return m_datasets[topology_name];
+}
+
+vtkh::DataSet&
+VTKHCollection::dataset_by_topology(const std::string topology_name,
+                                    const std::vector<std::string> &field_names)
+{
+  convert_lazy_fields(topology_name, field_names);
   return m_datasets[topology_name];
 }
 
@@ -276,6 +452,11 @@ std::vector<std::string> VTKHCollection::field_names() const
     }
   }
 
+  for(auto it = m_lazy_fields.begin(); it != m_lazy_fields.end(); ++it)
+  {
+    names.insert(it->second.begin(), it->second.end());
+  }
+
   gather_strings(names);
   std::vector<std::string> res(names.size());
   std::copy(names.begin(), names.end(), res.begin());
@@ -290,6 +471,7 @@ VTKHCollection::by_domain_id()
   for(auto it = m_datasets.begin(); it != m_datasets.end(); ++it)
   {
     const std::string topo_name = it->first;
+    convert_lazy_fields(topo_name);
     vtkh::DataSet &vtkh_dataset = it->second;
 
     std::vector<vtkm::Id> domain_ids = vtkh_dataset.GetDomainIds();
@@ -321,6 +503,8 @@ VTKHCollection* VTKHCollection::copy_without_topology(const std::string topology
 
   VTKHCollection *copy = new VTKHCollection(*this);
   copy->m_datasets.erase(topology_name);
+  copy->m_lazy_fields.erase(topology_name);
+  copy->m_lazy_domains.erase(topology_name);
 
   return copy;
 }
@@ -343,6 +527,7 @@ std::string VTKHCollection::summary() const
 }
 
 VTKHCollection::VTKHCollection()
+  : m_lazy_zero_copy(false)
 {
 
 }
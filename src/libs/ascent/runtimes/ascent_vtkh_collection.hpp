@@ -15,7 +15,10 @@
 
 #include <ascent_exports.h>
 #include <vtkh/DataSet.hpp>
+#include <conduit.hpp>
 #include <map>
+#include <memory>
+#include <set>
 
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
@@ -33,14 +36,60 @@ namespace ascent
 // From a vtkm point of view, each topology and associated fields are
 // a distinct data set and can be treated as such within pipelines.
 //
+// Fields can be converted lazily: the collection remembers which
+// blueprint fields belong to each topology and only wraps them as vtkm
+// fields when a consumer asks for the data set.
+//
 class ASCENT_API VTKHCollection
 {
+public:
+  // where to find the blueprint fields of a single domain of a
+  // topology, in the same order as the domains of the vtkh data set
+  struct LazyDomain
+  {
+    conduit::index_t m_index; // child index in the source node
+    int              m_neles;
+    int              m_nverts;
+  };
 protected:
   std::map<std::string, vtkh::DataSet> m_datasets;
+
+  // blueprint source and state for fields that have not been converted
+  std::shared_ptr<conduit::Node>                  m_lazy_source;
+  bool                                            m_lazy_zero_copy;
+  std::map<std::string, std::vector<LazyDomain>>  m_lazy_domains;
+  std::map<std::string, std::set<std::string>>    m_lazy_fields;
+
+  // converts the requested fields of the topology if they are pending
+  void convert_lazy_fields(const std::string &topology_name,
+                           const std::vector<std::string> &field_names);
+  // converts every pending field of the topology
+  void convert_lazy_fields(const std::string &topology_name);
+  // returns true if the field is pending on this rank
+  bool has_lazy_field(const std::string &field_name,
+                      std::string &topology_name) const;
 public:
   VTKHCollection();
   void add(vtkh::DataSet &dataset, const std::string topology_name);
 
+  // set the blueprint source that backs lazily converted fields
+  void lazy_source(std::shared_ptr<conduit::Node> source, bool zero_copy);
+  // register fields of a topology whose conversion is deferred.
+  // the topology must already have been added
+  void add_lazy_fields(const std::string topology_name,
+                       const std::vector<LazyDomain> &domains,
+                       const std::set<std::string> &field_names);
+
+  // registers the fields of the topology still pending in source, so
+  // they can be converted later. Use this when a filter only added
+  // fields to the topology and kept its domains and cells as they were.
+  // Fields that already exist in this collection are not registered.
+  void carry_lazy_fields(const VTKHCollection &source,
+                         const std::string topology_name);
+
+  // returns the number of local fields still waiting to be converted
+  int number_of_lazy_fields() const;
+
   // returns true if the topology exists on any rank
   bool has_topology(const std::string name) const;
 
@@ -55,9 +104,16 @@ public:
   std::string field_topology(const std::string field_name);
 
   // returns an empty dataset if topology does not exist on
-  // this rank
+  // this rank. All fields of the topology are converted, which
+  // filters that map every field onto new cells need.
   vtkh::DataSet &dataset_by_topology(const std::string topology_name);
 
+  // same as above, but only converts the listed fields. Fields that
+  // were already converted remain in the dataset. Use this when the
+  // consumer only needs a known set of fields (e.g., a plot)
+  vtkh::DataSet &dataset_by_topology(const std::string topology_name,
+                                     const std::vector<std::string> &field_names);
+
   vtkm::Bounds global_bounds() const;
 
   // returns the local topology names
@@ -497,6 +497,30 @@ bool allEqual(std::vector<T> const &v)
 }
 
 };
+//
+// returns true if AddBlueprintField knows how to convert the
+// field for the given topology. Fields with an association
+// AddField can't handle are an error, just like when they are
+// converted eagerly.
+//
+bool is_convertible_field(const conduit::Node &n_field,
+                          const std::string &field_name,
+                          const std::string &topo_name)
+{
+  if(n_field["topology"].as_string() != topo_name)
+  {
+    return false;
+  }
+
+  const std::string assoc_str = n_field["association"].as_string();
+  if(assoc_str != "vertex" && assoc_str != "element")
+  {
+    ASCENT_ERROR("Cannot add field association "<<assoc_str<<" from field "<<field_name);
+  }
+
+  return n_field["values"].number_of_children() <= 3;
+}
+
 //-----------------------------------------------------------------------------
 // -- end detail:: --
 //-----------------------------------------------------------------------------
@@ -508,6 +532,27 @@ bool allEqual(std::vector<T> const &v)
 VTKHCollection*
 VTKHDataAdapter::BlueprintToVTKHCollection(const conduit::Node &n,
                                            bool zero_copy)
+{
+    return ConvertBlueprintToVTKHCollection(n, zero_copy, false);
+}
+
+//-----------------------------------------------------------------------------
+VTKHCollection*
+VTKHDataAdapter::BlueprintToLazyVTKHCollection(std::shared_ptr<conduit::Node> n,
+                                               bool zero_copy)
+{
+    VTKHCollection *res = ConvertBlueprintToVTKHCollection(*n, zero_copy, true);
+    // the collection keeps the source alive until every deferred
+    // field has been converted
+    res->lazy_source(n, zero_copy);
+    return res;
+}
+
+//-----------------------------------------------------------------------------
+VTKHCollection*
+VTKHDataAdapter::ConvertBlueprintToVTKHCollection(const conduit::Node &n,
+                                                  bool zero_copy,
+                                                  bool lazy_fields)
 {
     // We must separate different topologies into
     // different vtkh data sets
@@ -519,6 +564,9 @@ VTKHDataAdapter::BlueprintToVTKHCollection(const conduit::Node &n,
 
     VTKHCollection *res = new VTKHCollection();
     std::map<std::string, vtkh::DataSet> datasets;
+    // bookkeeping for deferred field conversion
+    std::map<std::string, std::vector<VTKHCollection::LazyDomain>> lazy_domains;
+    std::map<std::string, std::set<std::string>> lazy_names;
     vtkm::UInt64 cycle = 0;
     double time = 0;
     std::vector<vtkm::UInt64> allCycles;
@@ -550,9 +598,38 @@ VTKHDataAdapter::BlueprintToVTKHCollection(const conduit::Node &n,
       for(int t = 0; t < topo_names.size(); ++t)
       {
         const std::string topo_name = topo_names[t];
-        vtkm::cont::DataSet *dset = BlueprintToVTKmDataSet(dom, zero_copy, topo_name);
+        int neles  = 0;
+        int nverts = 0;
+        vtkm::cont::DataSet *dset = BlueprintToVTKmDataSet(dom,
+                                                           zero_copy,
+                                                           topo_name,
+                                                           !lazy_fields,
+                                                           neles,
+                                                           nverts);
         datasets[topo_name].AddDomain(*dset,domain_id);
         delete dset;
+
+        if(lazy_fields)
+        {
+          VTKHCollection::LazyDomain lazy_dom;
+          lazy_dom.m_index  = i;
+          lazy_dom.m_neles  = neles;
+          lazy_dom.m_nverts = nverts;
+          lazy_domains[topo_name].push_back(lazy_dom);
+
+          if(dom.has_child("fields"))
+          {
+            NodeConstIterator itr = dom["fields"].children();
+            while(itr.has_next())
+            {
+              const Node &n_field = itr.next();
+              if(detail::is_convertible_field(n_field, itr.name(), topo_name))
+              {
+                lazy_names[topo_name].insert(itr.name());
+              }
+            }
+          }
+        }
       }
     }
 
@@ -575,6 +652,12 @@ VTKHDataAdapter::BlueprintToVTKHCollection(const conduit::Node &n,
     for(auto dset_it : datasets)
     {
       res->add(dset_it.second, dset_it.first);
+      if(lazy_fields)
+      {
+        res->add_lazy_fields(dset_it.first,
+                             lazy_domains[dset_it.first],
+                             lazy_names[dset_it.first]);
+      }
     }
 
     return res;
@@ -634,7 +717,26 @@ VTKHDataAdapter::VTKmDataSetToVTKHDataSet(vtkm::cont::DataSet *dset)
 vtkm::cont::DataSet *
 VTKHDataAdapter::BlueprintToVTKmDataSet(const Node &node,
                                         bool zero_copy,
-                                        const std::string &topo_name_str)
+                                        const std::string &topo_name)
+{
+    int neles  = 0;
+    int nverts = 0;
+    return BlueprintToVTKmDataSet(node,
+                                  zero_copy,
+                                  topo_name,
+                                  true,
+                                  neles,
+                                  nverts);
+}
+
+//-----------------------------------------------------------------------------
+vtkm::cont::DataSet *
+VTKHDataAdapter::BlueprintToVTKmDataSet(const Node &node,
+                                        bool zero_copy,
+                                        const std::string &topo_name_str,
+                                        bool add_fields,
+                                        int &neles,
+                                        int &nverts)
 {
     vtkm::cont::DataSet * result = NULL;
 
@@ -654,8 +756,8 @@ VTKHDataAdapter::BlueprintToVTKmDataSet(const Node &node,
     string coords_name   = n_topo["coordset"].as_string();
     const Node &n_coords = node["coordsets"][coords_name];
 
-    int neles  = 0;
-    int nverts = 0;
+    neles  = 0;
+    nverts = 0;
 
     if( mesh_type ==  "uniform")
     {
@@ -713,63 +815,20 @@ VTKHDataAdapter::BlueprintToVTKmDataSet(const Node &node,
     }
 
 
-    if(node.has_child("fields"))
+    if(add_fields && node.has_child("fields"))
     {
         // add all of the fields:
         NodeConstIterator itr = node["fields"].children();
-	std::string field_name;
         while(itr.has_next())
         {
-
             const Node &n_field = itr.next();
-            field_name = itr.name();
-            if(n_field["topology"].as_string() != topo_name)
-            {
-              // these are not the fields we are looking for
-              continue;
-            }
-
-            // skip vector fields for now, we need to add
-            // more logic to AddField
-            const int num_children = n_field["values"].number_of_children();
-
-            if(num_children == 0 || num_children == 1)
-            {
-
-                AddField(field_name,
-                         n_field,
-                         topo_name,
-                         neles,
-                         nverts,
-                         result,
-                         zero_copy);
-            }
-            else if(num_children == 2 )
-            {
-              AddVectorField(field_name,
-                             n_field,
-                             topo_name,
-                             neles,
-                             nverts,
-                             result,
-                             2,
-                             zero_copy);
-            }
-            else if(num_children == 3 )
-            {
-              AddVectorField(field_name,
-                             n_field,
-                             topo_name,
-                             neles,
-                             nverts,
-                             result,
-                             3,
-                             zero_copy);
-            }
-            else
-            {
-              ASCENT_INFO("skipping field "<<field_name<<" with "<<num_children<<" comps");
-            }
+            AddBlueprintField(itr.name(),
+                              n_field,
+                              topo_name,
+                              neles,
+                              nverts,
+                              result,
+                              zero_copy);
         }
     }
     return result;
@@ -1457,6 +1516,65 @@ VTKHDataAdapter::UnstructuredBlueprintToVTKmDataSet
     return result;
 }
 
+//-----------------------------------------------------------------------------
+void
+VTKHDataAdapter::AddBlueprintField(const std::string &field_name,
+                                   const conduit::Node &n_field,
+                                   const std::string &topo_name,
+                                   int neles,
+                                   int nverts,
+                                   vtkm::cont::DataSet *dset,
+                                   bool zero_copy)
+{
+    if(n_field["topology"].as_string() != topo_name)
+    {
+      // these are not the fields we are looking for
+      return;
+    }
+
+    // skip vector fields for now, we need to add
+    // more logic to AddField
+    const int num_children = n_field["values"].number_of_children();
+
+    if(num_children == 0 || num_children == 1)
+    {
+
+        AddField(field_name,
+                 n_field,
+                 topo_name,
+                 neles,
+                 nverts,
+                 dset,
+                 zero_copy);
+    }
+    else if(num_children == 2 )
+    {
+      AddVectorField(field_name,
+                     n_field,
+                     topo_name,
+                     neles,
+                     nverts,
+                     dset,
+                     2,
+                     zero_copy);
+    }
+    else if(num_children == 3 )
+    {
+      AddVectorField(field_name,
+                     n_field,
+                     topo_name,
+                     neles,
+                     nverts,
+                     dset,
+                     3,
+                     zero_copy);
+    }
+    else
+    {
+      ASCENT_INFO("skipping field "<<field_name<<" with "<<num_children<<" comps");
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 void
@@ -38,6 +38,7 @@ class DataSet;
 // conduit includes
 #include <conduit.hpp>
 
+#include <memory>
 
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
@@ -61,6 +62,15 @@ public:
     //
     static VTKHCollection* BlueprintToVTKHCollection(const conduit::Node &n,
                                                      bool zero_copy);
+
+    //
+    // Same as above, but only topologies and coordinates are converted
+    // up front. Fields are converted the first time a consumer asks
+    // for them (see VTKHCollection::dataset_by_topology). The collection
+    // holds a reference to "n" until all fields have been converted.
+    //
+    static VTKHCollection* BlueprintToLazyVTKHCollection(std::shared_ptr<conduit::Node> n,
+                                                         bool zero_copy);
     // convert blueprint data to a vtkh Data Set
     // assumes "n" conforms to the mesh blueprint
     //
@@ -97,7 +107,32 @@ public:
     static void              VTKHCollectionToBlueprintDataSet(VTKHCollection *collection,
                                                               conduit::Node &node,
                                                               bool zero_copy = false);
+
+    // adds a single blueprint field to a vtkm data set, dispatching
+    // to the scalar or vector conversion. Fields that do not belong
+    // to the topology or cannot be represented are skipped
+    static void              AddBlueprintField(const std::string &field_name,
+                                               const conduit::Node &n_field,
+                                               const std::string &topo_name,
+                                               int neles,
+                                               int nverts,
+                                               vtkm::cont::DataSet *dset,
+                                               bool zero_copy);
 private:
+    static VTKHCollection* ConvertBlueprintToVTKHCollection(const conduit::Node &n,
+                                                            bool zero_copy,
+                                                            bool lazy_fields);
+
+    // neles and nverts are set to the number of elements and vertices
+    // of the converted topology. Fields are only added if add_fields is
+    // true
+    static vtkm::cont::DataSet  *BlueprintToVTKmDataSet(const conduit::Node &n,
+                                                        bool zero_copy,
+                                                        const std::string &topo_name,
+                                                        bool add_fields,
+                                                        int &neles,
+                                                        int &nverts);
+
     // helpers for specific conversion cases
     static vtkm::cont::DataSet  *UniformBlueprintToVTKmDataSet(const std::string &coords_name,
                                                                const conduit::Node &n_coords,
@@ -41,6 +41,7 @@
 
 #if defined(ASCENT_DRAY_ENABLED)
 #include <dray/queries/lineout.hpp>
+#include <dray/queries/point_locator.hpp>
 #endif
 
 #include <conduit_relay.hpp>
@@ -3913,6 +3914,25 @@ ExprMeshLineout::execute()
 
   lineout.add_line(start, end);
 
+  // the same lineout usually runs every cycle on a static mesh, so keep
+  // the sample locations around and only evaluate the fields again.
+  // lineouts on different topologies need their own locations.
+  std::string locator_key = "lineout";
+  if(collection->local_size() > 0)
+  {
+    locator_key += "_" + collection->domain(0).mesh()->name();
+  }
+  for(int i = 0; i < 3; ++i)
+  {
+    locator_key += "_" + std::to_string(p_start[i]);
+  }
+  for(int i = 0; i < 3; ++i)
+  {
+    locator_key += "_" + std::to_string(p_end[i]);
+  }
+  locator_key += "_" + std::to_string(samples);
+  lineout.locator(&dray::PointLocator::find(locator_key));
+
   dray::Lineout::Result res = lineout.execute(*collection);
   (*output)["type"] = "lineout";
   (*output)["attrs/empty_value/value"] = double(res.m_empty_val);
@@ -8,7 +8,11 @@
 #include <umpire/util/MemoryResourceTraits.hpp>
 #include <umpire/strategy/DynamicPoolList.hpp>
 #endif
+#include <algorithm>
 #include <cstring> // memcpy
+#include <cstdlib> // malloc
+#include <mutex>
+#include <vector>
 #include <conduit.hpp>
 
 #if defined(ASCENT_HIP_ENABLED)
@@ -87,6 +91,20 @@ AllocationManager::device_allocator_id()
   return m_device_allocator_id;
 }
 
+//-----------------------------------------------------------------------------
+bool
+AllocationManager::has_host_allocator()
+{
+  return m_host_allocator_id != -1;
+}
+
+//-----------------------------------------------------------------------------
+bool
+AllocationManager::has_device_allocator()
+{
+  return m_device_allocator_id != -1;
+}
+
 //-----------------------------------------------------------------------------
 bool
 AllocationManager::set_host_allocator_id(int id)
@@ -246,6 +264,232 @@ AllocationManager::set_conduit_mem_handlers()
 #endif
 }
 
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+// Host Memory Pool
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// -- begin detail:: --
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+// every block is prefixed with a header that remembers its size class.
+// 64 bytes keeps the user pointer aligned as well as malloc aligns.
+const size_t POOL_HEADER_BYTES = 64;
+// smallest block is 2^6 bytes, largest pooled block is 2^28 bytes (256MB)
+// larger requests bypass the free lists
+const int POOL_MIN_CLASS = 6;
+const int POOL_MAX_CLASS = 28;
+const int POOL_UNPOOLED  = -1;
+
+struct PoolBlockHeader
+{
+  int    m_size_class;
+  size_t m_bytes;
+};
+
+class HostPoolState
+{
+public:
+  std::mutex                       m_mutex;
+  std::vector<std::vector<void*>>  m_free_lists;
+  size_t m_bytes_in_use;
+  size_t m_bytes_cached;
+  size_t m_high_water;
+  // peak in-use bytes since the last trim
+  size_t m_cycle_high_water;
+  size_t m_hits;
+  size_t m_misses;
+  size_t m_bytes_trimmed;
+
+  HostPoolState()
+   : m_free_lists(POOL_MAX_CLASS + 1),
+     m_bytes_in_use(0),
+     m_bytes_cached(0),
+     m_high_water(0),
+     m_cycle_high_water(0),
+     m_hits(0),
+     m_misses(0),
+     m_bytes_trimmed(0)
+  {}
+
+  // frees cached blocks, largest first, until at most
+  // keep_bytes are cached. must hold the mutex
+  void release_blocks(size_t keep_bytes)
+  {
+    for(int c = POOL_MAX_CLASS; c >= POOL_MIN_CLASS; --c)
+    {
+      std::vector<void*> &free_list = m_free_lists[c];
+      const size_t block_bytes = size_t(1) << c;
+      while(!free_list.empty() && m_bytes_cached > keep_bytes)
+      {
+        free(free_list.back());
+        free_list.pop_back();
+        m_bytes_cached  -= block_bytes;
+        m_bytes_trimmed += block_bytes;
+      }
+    }
+  }
+};
+
+HostPoolState &host_pool()
+{
+  // intentionally never destroyed: static conduit nodes may return
+  // memory to the pool during program teardown
+  static HostPoolState *state = new HostPoolState();
+  return *state;
+}
+
+int pool_size_class(size_t bytes)
+{
+  int size_class = POOL_MIN_CLASS;
+  while(size_class <= POOL_MAX_CLASS && (size_t(1) << size_class) < bytes)
+  {
+    size_class++;
+  }
+  return size_class > POOL_MAX_CLASS ? POOL_UNPOOLED : size_class;
+}
+
+} // namespace detail
+//-----------------------------------------------------------------------------
+// -- end detail:: --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void *
+HostMemoryPool::allocate(size_t bytes)
+{
+  detail::HostPoolState &pool = detail::host_pool();
+  const int size_class = detail::pool_size_class(bytes);
+  const size_t block_bytes = size_class == detail::POOL_UNPOOLED
+                             ? bytes : size_t(1) << size_class;
+
+  void *block = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(pool.m_mutex);
+    if(size_class != detail::POOL_UNPOOLED &&
+       !pool.m_free_lists[size_class].empty())
+    {
+      block = pool.m_free_lists[size_class].back();
+      pool.m_free_lists[size_class].pop_back();
+      pool.m_bytes_cached -= block_bytes;
+      pool.m_hits++;
+    }
+    else
+    {
+      pool.m_misses++;
+    }
+
+    pool.m_bytes_in_use += block_bytes;
+    pool.m_high_water = std::max(pool.m_high_water, pool.m_bytes_in_use);
+    pool.m_cycle_high_water = std::max(pool.m_cycle_high_water,
+                                       pool.m_bytes_in_use);
+  }
+
+  if(block == nullptr)
+  {
+    block = malloc(block_bytes + detail::POOL_HEADER_BYTES);
+    if(block == nullptr)
+    {
+      std::lock_guard<std::mutex> lock(pool.m_mutex);
+      pool.m_bytes_in_use -= block_bytes;
+      ASCENT_ERROR("HostMemoryPool: failed to allocate "<<bytes<<" bytes");
+    }
+  }
+
+  detail::PoolBlockHeader *header = static_cast<detail::PoolBlockHeader*>(block);
+  header->m_size_class = size_class;
+  header->m_bytes = block_bytes;
+
+  return static_cast<char*>(block) + detail::POOL_HEADER_BYTES;
+}
+
+//-----------------------------------------------------------------------------
+void
+HostMemoryPool::deallocate(void *data_ptr)
+{
+  if(data_ptr == nullptr)
+  {
+    return;
+  }
+
+  void *block = static_cast<char*>(data_ptr) - detail::POOL_HEADER_BYTES;
+  detail::PoolBlockHeader *header = static_cast<detail::PoolBlockHeader*>(block);
+  const int size_class = header->m_size_class;
+  const size_t block_bytes = header->m_bytes;
+
+  detail::HostPoolState &pool = detail::host_pool();
+  {
+    std::lock_guard<std::mutex> lock(pool.m_mutex);
+    pool.m_bytes_in_use -= block_bytes;
+    if(size_class != detail::POOL_UNPOOLED)
+    {
+      pool.m_free_lists[size_class].push_back(block);
+      pool.m_bytes_cached += block_bytes;
+      return;
+    }
+  }
+
+  free(block);
+}
+
+//-----------------------------------------------------------------------------
+void
+HostMemoryPool::trim()
+{
+  detail::HostPoolState &pool = detail::host_pool();
+  std::lock_guard<std::mutex> lock(pool.m_mutex);
+  // keep enough cached memory to reach last cycle's peak again
+  const size_t keep_bytes = pool.m_cycle_high_water - pool.m_bytes_in_use;
+  pool.release_blocks(keep_bytes);
+  pool.m_cycle_high_water = pool.m_bytes_in_use;
+}
+
+//-----------------------------------------------------------------------------
+void
+HostMemoryPool::release()
+{
+  detail::HostPoolState &pool = detail::host_pool();
+  std::lock_guard<std::mutex> lock(pool.m_mutex);
+  pool.release_blocks(0);
+}
+
+//-----------------------------------------------------------------------------
+size_t
+HostMemoryPool::bytes_in_use()
+{
+  detail::HostPoolState &pool = detail::host_pool();
+  std::lock_guard<std::mutex> lock(pool.m_mutex);
+  return pool.m_bytes_in_use;
+}
+
+//-----------------------------------------------------------------------------
+size_t
+HostMemoryPool::bytes_cached()
+{
+  detail::HostPoolState &pool = detail::host_pool();
+  std::lock_guard<std::mutex> lock(pool.m_mutex);
+  return pool.m_bytes_cached;
+}
+
+//-----------------------------------------------------------------------------
+void
+HostMemoryPool::info(conduit::Node &out)
+{
+  out.reset();
+  detail::HostPoolState &pool = detail::host_pool();
+  std::lock_guard<std::mutex> lock(pool.m_mutex);
+  out["bytes_in_use"]  = (conduit::uint64) pool.m_bytes_in_use;
+  out["bytes_cached"]  = (conduit::uint64) pool.m_bytes_cached;
+  out["high_water"]    = (conduit::uint64) pool.m_high_water;
+  out["hits"]          = (conduit::uint64) pool.m_hits;
+  out["misses"]        = (conduit::uint64) pool.m_misses;
+  out["bytes_trimmed"] = (conduit::uint64) pool.m_bytes_trimmed;
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 // Host Memory
@@ -267,7 +511,7 @@ HostMemory::allocate(size_t bytes)
   umpire::Allocator host_allocator = rm.getAllocator (allocator_id);
   return host_allocator.allocate(bytes);
 #else
-  return malloc(bytes);
+  return HostMemoryPool::allocate(bytes);
 #endif
 }
 
@@ -290,7 +534,44 @@ HostMemory::deallocate(void *data_ptr)
   umpire::Allocator host_allocator = rm.getAllocator (allocator_id);
   host_allocator.deallocate(data_ptr);
 #else
-  return free(data_ptr);
+  HostMemoryPool::deallocate(data_ptr);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+void
+HostMemory::trim()
+{
+#if !defined(ASCENT_UMPIRE_ENABLED)
+  // the umpire pool manages its own blocks
+  HostMemoryPool::trim();
+#endif
+}
+
+//-----------------------------------------------------------------------------
+void
+HostMemory::info(conduit::Node &out)
+{
+  out.reset();
+  out["total_bytes_allocated"] = (conduit::uint64) m_total_bytes_alloced;
+  out["allocations"]           = (conduit::uint64) m_alloc_count;
+  out["deallocations"]         = (conduit::uint64) m_free_count;
+#if defined(ASCENT_UMPIRE_ENABLED)
+  out["allocator"] = "umpire";
+  out["pool/current_size"] = (conduit::uint64) 0;
+  out["pool/high_water"]   = (conduit::uint64) 0;
+  // don't create the pool just to report on it
+  if(AllocationManager::has_host_allocator())
+  {
+    auto &rm = umpire::ResourceManager::getInstance ();
+    const int allocator_id = AllocationManager::host_allocator_id();
+    umpire::Allocator host_allocator = rm.getAllocator (allocator_id);
+    out["pool/current_size"] = (conduit::uint64) host_allocator.getCurrentSize();
+    out["pool/high_water"]   = (conduit::uint64) host_allocator.getHighWatermark();
+  }
+#else
+  out["allocator"] = "size_class_pool";
+  HostMemoryPool::info(out["pool"]);
 #endif
 }
 
@@ -355,6 +636,30 @@ DeviceMemory::deallocate(void *data_ptr)
 }
 
 
+//-----------------------------------------------------------------------------
+void
+DeviceMemory::info(conduit::Node &out)
+{
+  out.reset();
+  out["total_bytes_allocated"] = (conduit::uint64) m_total_bytes_alloced;
+  out["allocations"]           = (conduit::uint64) m_alloc_count;
+  out["deallocations"]         = (conduit::uint64) m_free_count;
+#if defined(ASCENT_DEVICE_ENABLED) && defined(ASCENT_UMPIRE_ENABLED)
+  out["allocator"] = "umpire";
+  out["pool/current_size"] = (conduit::uint64) 0;
+  out["pool/high_water"]   = (conduit::uint64) 0;
+  // don't create the pool just to report on it
+  if(AllocationManager::has_device_allocator())
+  {
+    auto &rm = umpire::ResourceManager::getInstance ();
+    const int allocator_id = AllocationManager::device_allocator_id();
+    umpire::Allocator device_allocator = rm.getAllocator (allocator_id);
+    out["pool/current_size"] = (conduit::uint64) device_allocator.getCurrentSize();
+    out["pool/high_water"]   = (conduit::uint64) device_allocator.getHighWatermark();
+  }
+#endif
+}
+
 //-----------------------------------------------------------------------------
 void
 DeviceMemory::is_device_ptr(const void *ptr, bool &is_gpu, bool &is_unified)
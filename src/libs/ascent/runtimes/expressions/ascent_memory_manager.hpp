@@ -29,6 +29,11 @@ public:
   /// If Umpire is disabled, an error is thrown
   static int  device_allocator_id();
 
+  /// true once a host (or device) allocator was created or set,
+  /// checking does not create one
+  static bool has_host_allocator();
+  static bool has_device_allocator();
+
   /// set umpire host allocator from outside ascent via id
   /// Throws an error if Umpire is disabled
   static bool set_host_allocator_id(int id);
@@ -58,10 +63,37 @@ private:
 
 };
 
+//-----------------------------------------------------------------------------
+/// Size-class caching allocator for host memory (singleton)
+///  Requests are rounded up to a power of two and freed blocks are kept
+///  in per size-class free lists, so temporaries that are allocated and
+///  released many times per cycle do not page fault fresh memory.
+///  Thread-safe. Used by HostMemory when Umpire is disabled.
+//-----------------------------------------------------------------------------
+class ASCENT_API HostMemoryPool
+{
+public:
+  static void *allocate(size_t bytes);
+  static void  deallocate(void *data_ptr);
+
+  /// Release cached blocks beyond what was needed to cover the peak
+  /// usage since the last trim. Called between cycles.
+  static void  trim();
+  /// Release all cached blocks back to the system
+  static void  release();
+
+  /// bytes handed out and not yet returned
+  static size_t bytes_in_use();
+  /// bytes held in the free lists
+  static size_t bytes_cached();
+
+  static void  info(conduit::Node &out);
+};
+
 //-----------------------------------------------------------------------------
 /// Host Memory allocation / deallocation interface (singleton)
 ///  Uses AllocationManager::host_allocator_id() when Umpire is enabled,
-///  Uses malloc/free when Umpire is disabled. 
+///  Uses HostMemoryPool when Umpire is disabled.
 //-----------------------------------------------------------------------------
 struct ASCENT_API HostMemory
 {
@@ -69,6 +101,11 @@ struct ASCENT_API HostMemory
   static void *allocate(size_t items, size_t item_size);
   static void  deallocate(void *data_ptr);
 
+  /// trims cached host memory between cycles
+  static void  trim();
+  /// allocation counts and pool statistics
+  static void  info(conduit::Node &out);
+
 private:
   static size_t m_total_bytes_alloced;
   static size_t m_alloc_count;
@@ -89,6 +126,9 @@ struct ASCENT_API DeviceMemory
   static bool is_device_ptr(const void *ptr);
   static void is_device_ptr(const void *ptr, bool &is_gpu, bool &is_unified);
 
+  /// allocation counts and pool statistics
+  static void info(conduit::Node &out);
+
 private:
   static size_t m_total_bytes_alloced;
   static size_t m_alloc_count;
@@ -571,7 +571,8 @@ void ascent::runtime::filters::BFlowIso::execute()
     ASCENT_ERROR("BFlowIso cannot find the given field");
   }
   std::string topo_name = collection->field_topology(field_name);
-  vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+  std::vector<std::string> used_fields(1, field_name);
+  vtkh::DataSet &data = collection->dataset_by_topology(topo_name, used_fields);
 
   bflow_iso::IsoSurfaceData iso_surf_data;
   iso_surf_data.m_DataSet = &data;
@@ -13,6 +13,9 @@
 
 #include "ascent_runtime_blueprint_filters.hpp"
 
+#include <map>
+#include <vector>
+
 //-----------------------------------------------------------------------------
 // thirdparty includes
 //-----------------------------------------------------------------------------
@@ -78,6 +81,126 @@ namespace runtime
 namespace filters
 {
 
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::filters::detail --
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+//-----------------------------------------------------------------------------
+// fingerprints of the domains that passed verification last time, they
+// live across cycles (and graph rebuilds) for the whole process
+struct VerifyCache
+{
+    std::map<index_t, uint64> m_fingerprints;
+    index_t                   m_count = 0;
+    // domains fully verified by the last execution on this rank
+    index_t                   m_verified = 0;
+};
+
+VerifyCache &
+verify_cache()
+{
+    static VerifyCache cache;
+    return cache;
+}
+
+//-----------------------------------------------------------------------------
+// FNV-1a
+void
+hash_bytes(const void *data, size_t num_bytes, uint64 &hash)
+{
+    const unsigned char *bytes = static_cast<const unsigned char*>(data);
+    for(size_t i = 0; i < num_bytes; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+}
+
+//-----------------------------------------------------------------------------
+template<typename T>
+void
+hash_value(const T &value, uint64 &hash)
+{
+    hash_bytes(&value, sizeof(T), hash);
+}
+
+//-----------------------------------------------------------------------------
+// Cheap structural fingerprint of a tree: names, dtypes, strings and
+// scalar values are hashed by content, arrays only by length, layout and
+// address. Verify only looks at the structure, so a tree with the same
+// fingerprint will verify the same way. Scalars under "state" (cycle,
+// time, ...) change every publish and are only hashed by dtype.
+//-----------------------------------------------------------------------------
+void
+fingerprint(const Node &node, uint64 &hash, bool scalar_values)
+{
+    const DataType &dtype = node.dtype();
+    hash_value(dtype.id(), hash);
+
+    if(dtype.is_object())
+    {
+        NodeConstIterator itr = node.children();
+        while(itr.has_next())
+        {
+            const Node &child = itr.next();
+            const std::string name = itr.name();
+            hash_bytes(name.c_str(), name.size(), hash);
+            fingerprint(child, hash, scalar_values && name != "state");
+        }
+    }
+    else if(dtype.is_list())
+    {
+        hash_value(node.number_of_children(), hash);
+        NodeConstIterator itr = node.children();
+        while(itr.has_next())
+        {
+            fingerprint(itr.next(), hash, scalar_values);
+        }
+    }
+    else if(dtype.is_string())
+    {
+        const std::string value = node.as_string();
+        hash_bytes(value.c_str(), value.size(), hash);
+    }
+    else if(!dtype.is_empty())
+    {
+        const index_t num_elements = dtype.number_of_elements();
+        hash_value(num_elements, hash);
+        hash_value(dtype.stride(), hash);
+        hash_value(dtype.endianness(), hash);
+        if(num_elements == 1)
+        {
+            if(scalar_values)
+            {
+                hash_bytes(node.element_ptr(0), dtype.element_bytes(), hash);
+            }
+        }
+        else
+        {
+            const void *ptr = node.element_ptr(0);
+            hash_value(ptr, hash);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+uint64
+fingerprint(const std::string &protocol, const Node &node)
+{
+    uint64 hash = 14695981039346656037ULL;
+    hash_bytes(protocol.c_str(), protocol.size(), hash);
+    fingerprint(node, hash, true);
+    return hash;
+}
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::filters::detail --
+//-----------------------------------------------------------------------------
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 // BlueprintVerify
@@ -95,6 +218,13 @@ BlueprintVerify::~BlueprintVerify()
 // empty
 }
 
+//-----------------------------------------------------------------------------
+index_t
+BlueprintVerify::last_verified_domains()
+{
+    return detail::verify_cache().m_verified;
+}
+
 //-----------------------------------------------------------------------------
 void
 BlueprintVerify::declare_interface(Node &i)
@@ -118,6 +248,8 @@ BlueprintVerify::verify_params(const conduit::Node &params,
         info["errors"].append() = "Missing required string parameter 'protocol'";
     }
 
+    res &= check_numeric("full_frequency",params, info, false);
+
     return res;
 }
 
@@ -137,6 +269,19 @@ BlueprintVerify::execute()
     DataObject *d_input = input<DataObject>(0);
     std::shared_ptr<conduit::Node> n_input = d_input->as_node();
 
+    // full verification of every domain is forced every
+    // full_frequency executions (0 means only when a domain changes)
+    int full_frequency = 0;
+    if(params().has_path("full_frequency"))
+    {
+        full_frequency = params()["full_frequency"].to_int32();
+    }
+
+    detail::VerifyCache &cache = detail::verify_cache();
+    cache.m_count++;
+    const bool force_full = full_frequency > 0 &&
+                            cache.m_count % full_frequency == 0;
+
     // some MPI tasks may not have data, that is fine
     // but blueprint verify will fail, so if the
     // input node is empty skip verify
@@ -146,47 +291,74 @@ BlueprintVerify::execute()
     std::string verify_err_msg = "";
     if(!n_input->dtype().is_empty())
     {
-        if(!conduit::blueprint::verify(protocol,
-                                       *n_input,
-                                       v_info))
+        // verify domains one at a time so that unchanged domains
+        // can be skipped
+        std::vector<const Node*> domains;
+        if(protocol == "mesh" && conduit::blueprint::mesh::is_multi_domain(*n_input))
         {
-            verify_err_msg = v_info.to_yaml();
-            local_verify_err = 1;
+            const index_t num_domains = n_input->number_of_children();
+            for(index_t i = 0; i < num_domains; ++i)
+            {
+                domains.push_back(&n_input->child(i));
+            }
         }
         else
+        {
+            domains.push_back(n_input.get());
+        }
+
+        std::map<index_t, uint64> fingerprints;
+        cache.m_verified = 0;
+        const index_t num_domains = domains.size();
+        for(index_t i = 0; i < num_domains && local_verify_err == 0; ++i)
+        {
+            const uint64 print = detail::fingerprint(protocol, *domains[i]);
+            auto cached = cache.m_fingerprints.find(i);
+            if(force_full ||
+               cached == cache.m_fingerprints.end() ||
+               cached->second != print)
+            {
+                cache.m_verified++;
+                if(!conduit::blueprint::verify(protocol,
+                                               *domains[i],
+                                               v_info))
+                {
+                    verify_err_msg = v_info.to_yaml();
+                    local_verify_err = 1;
+                }
+            }
+            fingerprints[i] = print;
+        }
+
+        if(local_verify_err == 0)
         {
             local_verify_ok = 1;
+            cache.m_fingerprints.swap(fingerprints);
+        }
+        else
+        {
+            cache.m_fingerprints.clear();
         }
     }
 
     // make sure some MPI task actually had bp data
 #ifdef ASCENT_MPI_ENABLED
-    // reduce flag for some valid data
-    int global_verify_ok = 0;
+    // reduce flags for some valid data and for errors
+    int local_flags[2] = {local_verify_ok, local_verify_err};
+    int global_flags[2] = {0, 0};
     MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
-    MPI_Allreduce((void *)(&local_verify_ok),
-                  (void *)(&global_verify_ok),
-                  1,
-                  MPI_INT,
-                  MPI_SUM,
-                  mpi_comm);
-    local_verify_ok = global_verify_ok;
-
-    // reduce flag for errors
-    int global_verify_err = 0;
-    MPI_Allreduce((void *)(&local_verify_err),
-                  (void *)(&global_verify_err),
-                  1,
+    MPI_Allreduce((void *)(local_flags),
+                  (void *)(global_flags),
+                  2,
                   MPI_INT,
                   MPI_SUM,
                   mpi_comm);
-    local_verify_err = global_verify_err;
-
-
+    local_verify_ok = global_flags[0];
+    local_verify_err = global_flags[1];
 #endif
 
     // check for an error on any rank
-    if(local_verify_err == 1)
+    if(local_verify_err > 0)
     {
         if(verify_err_msg != "")
         {
@@ -54,6 +54,10 @@ public:
     virtual bool   verify_params(const conduit::Node &params,
                                  conduit::Node &info);
     virtual void   execute();
+
+    // domains this rank verified (instead of skipping them as
+    // unchanged) in the last execution
+    static conduit::index_t last_verified_domains();
 };
 
 //-----------------------------------------------------------------------------
@@ -198,6 +198,7 @@ dray_load_balance_surprises(const conduit::Node &load_balance)
   valid_paths.push_back("factor");
   valid_paths.push_back("threshold");
   valid_paths.push_back("use_prefix");
+  valid_paths.push_back("use_timings");
 
   surprises += surprise_check(valid_paths, load_balance);
 
@@ -1869,6 +1870,7 @@ DRayVolume::execute()
         float piece_factor = 0.75f;
         float threshold = 2.0f;
         bool prefix = true;
+        bool timings = false;
         if(load.has_path("factor"))
         {
           piece_factor = load["factor"].to_float32();
@@ -1882,9 +1884,15 @@ DRayVolume::execute()
         {
           prefix = load["use_prefix"].as_string() != "false";
         }
+
+        if(load.has_path("use_timings"))
+        {
+          timings = load["use_timings"].as_string() == "true";
+        }
         dray::VolumeBalance balancer;
         balancer.threshold(threshold);
         balancer.prefix_balancing(prefix);
+        balancer.use_timings(timings);
         balancer.piece_factor(piece_factor);
 
         // We should have at least one camera so just use that for load
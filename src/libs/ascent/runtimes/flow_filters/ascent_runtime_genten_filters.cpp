@@ -33,6 +33,7 @@
 // ascent includes
 //-----------------------------------------------------------------------------
 #include <ascent_logging.hpp>
+#include <ascent_async_writer.hpp>
 #include <ascent_metadata.hpp>
 #include <runtimes/ascent_data_object.hpp>
 #include <ascent_runtime_param_check.hpp>
@@ -165,9 +166,13 @@ namespace detail
         info.print();
       }
 
-      conduit::relay::io::blueprint::save_mesh(output,
-                                               output_path + "_small",
-                                               "hdf5");
+      // keep io off the main thread while extracts write in the background
+      AsyncWriter::instance().run_io([&]()
+      {
+        conduit::relay::io::blueprint::save_mesh(output,
+                                                 output_path + "_small",
+                                                 "hdf5");
+      });
     }
 
 
@@ -588,16 +593,20 @@ Learn::execute()
       info.print();
     }
 
+    // keep io off the main thread while extracts write in the background
+    AsyncWriter::instance().run_io([&]()
+    {
 #ifdef ASCENT_MPI_ENABLED
-    conduit::relay::mpi::io::blueprint::save_mesh(*n_input,
-                                                  output_path,
-                                                  "hdf5",
-                                                  mpi_comm);
+      conduit::relay::mpi::io::blueprint::save_mesh(*n_input,
+                                                    output_path,
+                                                    "hdf5",
+                                                    mpi_comm);
 #else
-    conduit::relay::io::blueprint::save_mesh(*n_input,
-                                             output_path,
-                                             "hdf5");
+      conduit::relay::io::blueprint::save_mesh(*n_input,
+                                               output_path,
+                                               "hdf5");
 #endif
+    });
 
     // add in the spatial metric
     for(int i = 0; i < num_domains; ++i)
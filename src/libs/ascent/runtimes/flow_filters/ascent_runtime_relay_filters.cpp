@@ -41,6 +41,7 @@
 #include <ascent_mpi_utils.hpp>
 #include <ascent_runtime_utils.hpp>
 #include <ascent_runtime_param_check.hpp>
+#include <ascent_async_writer.hpp>
 #include "ascent_transmogrifier.hpp"
 
 #include <flow_graph.hpp>
@@ -56,8 +57,12 @@
 #endif
 
 // std includes
+#include <algorithm>
+#include <iomanip>
 #include <limits>
+#include <memory>
 #include <set>
+#include <sstream>
 
 using namespace std;
 using namespace conduit;
@@ -396,6 +401,396 @@ post_filter_check_for_data(const conduit::Node &output)
   }
 }
 
+//-----------------------------------------------------------------------------
+// returns the blueprint file protocol a relay extract protocol maps to,
+// or an empty string if the protocol is not a blueprint protocol
+//-----------------------------------------------------------------------------
+std::string
+blueprint_protocol(const std::string &protocol)
+{
+#if defined(ASCENT_HDF5_ENABLED)
+  if(protocol == "blueprint" ||
+     protocol == "blueprint/mesh/hdf5" ||
+     protocol == "hdf5")
+  {
+    return "hdf5";
+  }
+#endif
+  if(protocol == "blueprint" ||
+     protocol == "blueprint/mesh/yaml" ||
+     protocol == "yaml")
+  {
+    return "yaml";
+  }
+  if(protocol == "blueprint/mesh/json" || protocol == "json")
+  {
+    return "json";
+  }
+  return "";
+}
+
+//-----------------------------------------------------------------------------
+// returns the root file a blueprint save of data to path creates, or an
+// empty string if no rank has any domains (nothing is saved).
+// Must be called on all ranks of mpi_comm_id.
+//-----------------------------------------------------------------------------
+std::string
+blueprint_root_file(const conduit::Node &data,
+                    const std::string &path,
+                    int mpi_comm_id)
+{
+  // -2: no domains, -1: domains without a cycle, otherwise the cycle
+  int cycle = -2;
+  if(blueprint::mesh::number_of_domains(data) > 0)
+  {
+    const conduit::Node &dom = blueprint::mesh::is_multi_domain(data) ?
+                               data.child(0) : data;
+    cycle = dom.has_path("state/cycle") ? dom["state/cycle"].to_int() : -1;
+  }
+#ifdef ASCENT_MPI_ENABLED
+  int local_cycle = cycle;
+  MPI_Allreduce(&local_cycle,
+                &cycle,
+                1,
+                MPI_INT,
+                MPI_MAX,
+                MPI_Comm_f2c(mpi_comm_id));
+#else
+  (void) mpi_comm_id;
+#endif
+
+  if(cycle == -2)
+  {
+    return "";
+  }
+
+  // same naming as the blueprint save: the cycle suffix is only
+  // added if the mesh has one
+  std::ostringstream root_file;
+  root_file << path;
+  if(cycle >= 0)
+  {
+    root_file << ".cycle_" << std::setw(6) << std::setfill('0') << cycle;
+  }
+  root_file << ".root";
+  return root_file.str();
+}
+
+#ifdef ASCENT_MPI_ENABLED
+//-----------------------------------------------------------------------------
+// The node-local groups that aggregate their domains onto one writer.
+// Building them takes collectives over the whole job, so they are kept
+// until the ascent communicator or the writers per node change.
+//-----------------------------------------------------------------------------
+struct AggregationGroup
+{
+  int      m_source_comm_id    = -1;
+  int      m_writers_per_node  = -1;
+  MPI_Comm m_group_comm        = MPI_COMM_NULL;
+  int      m_num_writers       = 0;
+};
+
+//-----------------------------------------------------------------------------
+AggregationGroup &
+aggregation_group(int writers_per_node)
+{
+  static AggregationGroup group;
+
+  const int source_comm_id = Workspace::default_mpi_comm();
+  if(group.m_group_comm != MPI_COMM_NULL &&
+     group.m_source_comm_id == source_comm_id &&
+     group.m_writers_per_node == writers_per_node)
+  {
+    return group;
+  }
+
+  if(group.m_group_comm != MPI_COMM_NULL)
+  {
+    MPI_Comm_free(&group.m_group_comm);
+  }
+
+  MPI_Comm mpi_comm = MPI_Comm_f2c(source_comm_id);
+  int rank;
+  MPI_Comm_rank(mpi_comm, &rank);
+
+  MPI_Comm node_comm;
+  MPI_Comm_split_type(mpi_comm,
+                      MPI_COMM_TYPE_SHARED,
+                      rank,
+                      MPI_INFO_NULL,
+                      &node_comm);
+  int node_rank, node_size;
+  MPI_Comm_rank(node_comm, &node_rank);
+  MPI_Comm_size(node_comm, &node_size);
+
+  const int node_writers = std::max(1, std::min(writers_per_node, node_size));
+  const int node_group = (node_rank * node_writers) / node_size;
+
+  MPI_Comm_split(node_comm, node_group, node_rank, &group.m_group_comm);
+  MPI_Comm_free(&node_comm);
+
+  int group_rank;
+  MPI_Comm_rank(group.m_group_comm, &group_rank);
+  int local_writer = group_rank == 0 ? 1 : 0;
+  MPI_Allreduce(&local_writer,
+                &group.m_num_writers,
+                1,
+                MPI_INT,
+                MPI_SUM,
+                mpi_comm);
+
+  group.m_source_comm_id = source_comm_id;
+  group.m_writers_per_node = writers_per_node;
+  return group;
+}
+
+//-----------------------------------------------------------------------------
+// MPI counts are ints, so large buffers move in chunks
+//-----------------------------------------------------------------------------
+const uint64 max_message_bytes = 1 << 30;
+
+//-----------------------------------------------------------------------------
+void
+send_bytes(const void *data, uint64 num_bytes, int dest, MPI_Comm comm)
+{
+  const char *ptr = static_cast<const char*>(data);
+  for(uint64 offset = 0; offset < num_bytes; offset += max_message_bytes)
+  {
+    const int count = (int) std::min(max_message_bytes, num_bytes - offset);
+    MPI_Send(ptr + offset, count, MPI_BYTE, dest, 0, comm);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void
+recv_bytes(void *data, uint64 num_bytes, int source, MPI_Comm comm)
+{
+  char *ptr = static_cast<char*>(data);
+  for(uint64 offset = 0; offset < num_bytes; offset += max_message_bytes)
+  {
+    const int count = (int) std::min(max_message_bytes, num_bytes - offset);
+    MPI_Recv(ptr + offset, count, MPI_BYTE, source, 0, comm, MPI_STATUS_IGNORE);
+  }
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// Gathers the domains of groups of node-local ranks onto one writer rank
+// per group, so fewer, larger writes hit the file system. Each node is
+// split into writers_per_node groups of consecutive node-local ranks.
+// Each rank sends its domains as one compact buffer that the writer
+// receives in place, the writer's own domains are not copied.
+// Returns the global number of writers.
+//-----------------------------------------------------------------------------
+int
+aggregate_domains(conduit::Node &input,
+                  conduit::Node &output,
+                  int writers_per_node)
+{
+  output.reset();
+
+  // a list of domains, even if we only have one
+  Node local_doms;
+  if(blueprint::mesh::is_multi_domain(input))
+  {
+    const int num_domains = input.number_of_children();
+    for(int i = 0; i < num_domains; ++i)
+    {
+      local_doms.append().set_external(input.child(i));
+    }
+  }
+  else if(input.dtype().is_object())
+  {
+    local_doms.append().set_external(input);
+  }
+
+#ifdef ASCENT_MPI_ENABLED
+  AggregationGroup &group = aggregation_group(writers_per_node);
+  MPI_Comm group_comm = group.m_group_comm;
+  int group_rank, group_size;
+  MPI_Comm_rank(group_comm, &group_rank);
+  MPI_Comm_size(group_comm, &group_size);
+
+  Node packed;
+  std::string schema;
+  // {schema bytes, data bytes}
+  uint64 sizes[2] = {0, 0};
+  if(group_rank != 0 && local_doms.number_of_children() > 0)
+  {
+    local_doms.compact_to(packed);
+    schema = packed.schema().to_json();
+    sizes[0] = schema.size();
+    sizes[1] = packed.total_bytes_compact();
+  }
+
+  std::vector<uint64> all_sizes(group_rank == 0 ? 2 * group_size : 0);
+  MPI_Gather(sizes,
+             2,
+             MPI_UINT64_T,
+             all_sizes.data(),
+             2,
+             MPI_UINT64_T,
+             0,
+             group_comm);
+
+  if(group_rank != 0)
+  {
+    if(sizes[0] > 0)
+    {
+      send_bytes(schema.data(), sizes[0], 0, group_comm);
+      send_bytes(packed.contiguous_data_ptr(), sizes[1], 0, group_comm);
+    }
+    return group.m_num_writers;
+  }
+
+  const int num_local = local_doms.number_of_children();
+  for(int i = 0; i < num_local; ++i)
+  {
+    output.append().set_external(local_doms.child(i));
+  }
+
+  for(int r = 1; r < group_size; ++r)
+  {
+    const uint64 schema_bytes = all_sizes[2 * r];
+    const uint64 data_bytes = all_sizes[2 * r + 1];
+    if(schema_bytes == 0)
+    {
+      continue;
+    }
+
+    std::string rank_schema(schema_bytes, ' ');
+    recv_bytes(&rank_schema[0], schema_bytes, r, group_comm);
+
+    // the compact schema allocates one block we can receive into
+    Node rank_doms;
+    rank_doms.set_schema(conduit::Schema(rank_schema));
+    recv_bytes(rank_doms.contiguous_data_ptr(), data_bytes, r, group_comm);
+
+    const int num_domains = rank_doms.number_of_children();
+    for(int i = 0; i < num_domains; ++i)
+    {
+      output.append().move(rank_doms.child(i));
+    }
+  }
+  return group.m_num_writers;
+#else
+  (void) writers_per_node;
+  output.set_external(input);
+  return 1;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// MPI reduction of {bytes, seconds} pairs: sums the bytes, takes the max
+// of the seconds
+//-----------------------------------------------------------------------------
+#ifdef ASCENT_MPI_ENABLED
+void
+sum_bytes_max_time(void *in, void *inout, int *len, MPI_Datatype *)
+{
+  const float64 *src = static_cast<const float64*>(in);
+  float64 *dest = static_cast<float64*>(inout);
+  for(int i = 0; i + 1 < *len; i += 2)
+  {
+    dest[i] += src[i];
+    dest[i + 1] = std::max(dest[i + 1], src[i + 1]);
+  }
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// Reduces the write stats of all ranks with a single collective: the total
+// bytes written and the time of the slowest rank
+//-----------------------------------------------------------------------------
+void
+global_write_stats(uint64 local_bytes,
+                   float64 local_time,
+                   uint64 &bytes,
+                   float64 &time)
+{
+  bytes = local_bytes;
+  time = local_time;
+#ifdef ASCENT_MPI_ENABLED
+  static MPI_Op stats_op = MPI_OP_NULL;
+  if(stats_op == MPI_OP_NULL)
+  {
+    MPI_Op_create(&sum_bytes_max_time, 1, &stats_op);
+  }
+  float64 local_stats[2] = {(float64) local_bytes, local_time};
+  float64 stats[2];
+  MPI_Allreduce(local_stats,
+                stats,
+                2,
+                MPI_DOUBLE,
+                stats_op,
+                MPI_Comm_f2c(Workspace::default_mpi_comm()));
+  bytes = (uint64) stats[0];
+  time = stats[1];
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// writes the selected data with the requested protocol
+//-----------------------------------------------------------------------------
+void
+save_selection(const conduit::Node &data,
+               const std::string &path,
+               const std::string &protocol,
+               int num_files,
+               const conduit::Node &extra_opts,
+               int mpi_comm_id,
+               std::string &result_path)
+{
+    if(protocol.empty())
+    {
+        conduit::relay::io::save(data,path);
+        result_path = path;
+    }
+#if defined(ASCENT_HDF5_ENABLED)
+    else if( protocol == "blueprint" ||
+             protocol == "blueprint/mesh/hdf5" ||
+             protocol == "hdf5")
+    {
+        mesh_blueprint_save(data,
+                            path,
+                            "hdf5",
+                            num_files,
+                            extra_opts,
+                            result_path,
+                            mpi_comm_id);
+    }
+#endif
+    else if( protocol == "blueprint" ||
+             protocol == "blueprint/mesh/yaml" ||
+             protocol == "yaml")
+    {
+        mesh_blueprint_save(data,
+                            path,
+                            "yaml",
+                            num_files,
+                            extra_opts,
+                            result_path,
+                            mpi_comm_id);
+
+    }
+    else if( protocol == "blueprint/mesh/json" || protocol == "json")
+    {
+        mesh_blueprint_save(data,
+                            path,
+                            "json",
+                            num_files,
+                            extra_opts,
+                            result_path,
+                            mpi_comm_id);
+
+    }
+    else
+    {
+        conduit::relay::io::save(data,path,protocol);
+        result_path = path;
+    }
+}
+
 //-----------------------------------------------------------------------------
 };
 //-----------------------------------------------------------------------------
@@ -471,6 +866,32 @@ verify_io_params(const conduit::Node &params,
         }
     }
 
+    if( params.has_child("aggregation") )
+    {
+        //
+        // Aggregation Example:
+        //
+        // aggregation:
+        //   writers_per_node: 2
+        //
+        res &= check_object("aggregation",
+                            params,
+                            info,
+                            false);
+
+        res &= check_numeric("aggregation/writers_per_node",
+                             params,
+                             info,
+                             false);
+
+        if(params.has_path("aggregation/writers_per_node") &&
+           params["aggregation/writers_per_node"].to_int() < 1)
+        {
+            info["errors"].append() = "'aggregation/writers_per_node' must be at least 1";
+            res = false;
+        }
+    }
+
 #if defined(ASCENT_HDF5_ENABLED)
     if( params.has_child("hdf5_options") )
     {
@@ -543,6 +964,9 @@ verify_io_params(const conduit::Node &params,
     }
 #endif
 
+    res &= check_string("async", params, info, false);
+    res &= check_numeric("max_in_flight", params, info, false);
+
     std::vector<std::string> valid_paths;
     std::vector<std::string> ignore_paths;
     valid_paths.push_back("path");
@@ -551,6 +975,9 @@ verify_io_params(const conduit::Node &params,
     valid_paths.push_back("fields");
     valid_paths.push_back("num_files");
     valid_paths.push_back("refinement_level");
+    valid_paths.push_back("aggregation/writers_per_node");
+    valid_paths.push_back("async");
+    valid_paths.push_back("max_in_flight");
     ignore_paths.push_back("fields");
     ignore_paths.push_back("topologies");
 #if defined(ASCENT_HDF5_ENABLED)
@@ -577,10 +1004,27 @@ void mesh_blueprint_save(const Node &data,
                          const Node &extra_opts,
                          std::string &root_file_out)
 {
-    bool has_data = blueprint::mesh::number_of_domains(data) > 0;
-    has_data = global_someone_agrees(has_data);
+    mesh_blueprint_save(data,
+                        path,
+                        file_protocol,
+                        num_files,
+                        extra_opts,
+                        root_file_out,
+                        Workspace::default_mpi_comm());
+}
+
+//-----------------------------------------------------------------------------
+void mesh_blueprint_save(const Node &data,
+                         const std::string &path,
+                         const std::string &file_protocol,
+                         int num_files,
+                         const Node &extra_opts,
+                         std::string &root_file_out,
+                         int mpi_comm_id)
+{
+    root_file_out = detail::blueprint_root_file(data, path, mpi_comm_id);
 
-    if(!has_data)
+    if(root_file_out.empty())
     {
       ASCENT_INFO("Blueprint save: no valid data exists. Skipping save");
       return;
@@ -610,19 +1054,34 @@ void mesh_blueprint_save(const Node &data,
     }
 #endif
 
+    // the hdf5 options are global, so a failed save must still restore
+    // them before the next write (possibly another extract's task)
+    try
+    {
 #ifdef ASCENT_MPI_ENABLED
-    MPI_Comm mpi_comm = MPI_Comm_f2c(Workspace::default_mpi_comm());
-    conduit::relay::mpi::io::blueprint::save_mesh(data,
-                                                  path,
-                                                  file_protocol,
-                                                  opts,
-                                                  mpi_comm);
+        MPI_Comm mpi_comm = MPI_Comm_f2c(mpi_comm_id);
+        conduit::relay::mpi::io::blueprint::save_mesh(data,
+                                                      path,
+                                                      file_protocol,
+                                                      opts,
+                                                      mpi_comm);
 #else
-    conduit::relay::io::blueprint::save_mesh(data,
-                                             path,
-                                             file_protocol,
-                                             opts);
+        conduit::relay::io::blueprint::save_mesh(data,
+                                                 path,
+                                                 file_protocol,
+                                                 opts);
 #endif
+    }
+    catch(...)
+    {
+#ifdef ASCENT_HDF5_ENABLED
+        if(using_hdf5_opts)
+        {
+            conduit::relay::io::hdf5_set_options(hdf5_opts_orig);
+        }
+#endif
+        throw;
+    }
 
 #ifdef ASCENT_HDF5_ENABLED
     if(using_hdf5_opts)
@@ -830,51 +1289,119 @@ RelayIOSave::execute()
     }
 #endif
 
-    std::string result_path;
-    if(protocol.empty())
+    // aggregation only applies to the blueprint (multi-file) protocols
+    bool aggregate = params().has_path("aggregation") &&
+                     !detail::blueprint_protocol(protocol).empty();
+
+    const uint64 local_bytes = selected.total_bytes_compact();
+    flow::Timer write_timer;
+
+    int num_writers = mpi_size();
+    Node aggregated;
+    if(aggregate)
     {
-        conduit::relay::io::save(selected,path);
-        result_path = path;
+        int writers_per_node = 1;
+        if(params().has_path("aggregation/writers_per_node"))
+        {
+            writers_per_node = params()["aggregation/writers_per_node"].to_int();
+        }
+        num_writers = detail::aggregate_domains(selected,
+                                                aggregated,
+                                                writers_per_node);
+        // by default, each writer produces a single file
+        if(num_files == -1)
+        {
+            num_files = num_writers;
+        }
     }
-#if defined(ASCENT_HDF5_ENABLED)
-    else if( protocol == "blueprint" ||
-             protocol == "blueprint/mesh/hdf5" ||
-             protocol == "hdf5")
+    else
     {
-        mesh_blueprint_save(selected,
-                            path,
-                            "hdf5",
-                            num_files,
-                            extra_opts,
-                            result_path);
+        aggregated.set_external(selected);
     }
-#endif
-    else if( protocol == "blueprint" ||
-             protocol == "blueprint/mesh/yaml" ||
-             protocol == "yaml")
-    {
-        mesh_blueprint_save(selected,
-                            path,
-                            "yaml",
-                            num_files,
-                            extra_opts,
-                            result_path);
 
+    bool async = params().has_path("async") &&
+                 params()["async"].as_string() == "true";
+    if(async && !AsyncWriter::supported())
+    {
+        ASCENT_INFO("relay_io_save: 'async' requires MPI_THREAD_MULTIPLE. "
+                    "Writing synchronously.");
+        async = false;
     }
-    else if( protocol == "blueprint/mesh/json" || protocol == "json")
+
+    AsyncWriter &writer = AsyncWriter::instance();
+    std::string result_path;
+    if(async)
     {
-        mesh_blueprint_save(selected,
-                            path,
-                            "json",
-                            num_files,
-                            extra_opts,
-                            result_path);
+        int max_in_flight = 2;
+        if(params().has_path("max_in_flight"))
+        {
+            max_in_flight = params()["max_in_flight"].to_int();
+        }
+        const int comm_id = writer.mpi_comm_id();
+
+        // stage a compact copy of just the selection, so the simulation
+        // is free to modify its data while we write
+        std::shared_ptr<Node> staged = std::make_shared<Node>();
+        aggregated.compact_to(*staged);
+
+        if(detail::blueprint_protocol(protocol).empty())
+        {
+            result_path = path;
+        }
+        else
+        {
+            // the write hasn't happened yet, but we know where it goes
+            result_path = detail::blueprint_root_file(aggregated,
+                                                      path,
+                                                      Workspace::default_mpi_comm());
+        }
 
+        // the task owns its copy of the hdf5 options, they are only
+        // applied while its own write runs
+        AsyncWriter::Task task = [staged, path, protocol, num_files, extra_opts, comm_id]()
+        {
+            std::string unused;
+            detail::save_selection(*staged,
+                                   path,
+                                   protocol,
+                                   num_files,
+                                   extra_opts,
+                                   comm_id,
+                                   unused);
+        };
+
+        if(!detail::blueprint_protocol(protocol).empty())
+        {
+            // blueprint saves are collective
+            task = AsyncWriter::collective(task, comm_id);
+        }
+        writer.submit(task, max_in_flight);
+    }
+    else if(writer.is_active())
+    {
+        // other extracts are writing in the background, queue behind them
+        // so all ranks issue the collectives in the same order
+        const int comm_id = writer.mpi_comm_id();
+        writer.run_io([&]()
+        {
+            detail::save_selection(aggregated,
+                                   path,
+                                   protocol,
+                                   num_files,
+                                   extra_opts,
+                                   comm_id,
+                                   result_path);
+        });
     }
     else
     {
-        conduit::relay::io::save(selected,path,protocol);
-        result_path = path;
+        detail::save_selection(aggregated,
+                               path,
+                               protocol,
+                               num_files,
+                               extra_opts,
+                               Workspace::default_mpi_comm(),
+                               result_path);
     }
 
     // add this to the extract results in the registry
@@ -888,11 +1415,29 @@ RelayIOSave::execute()
 
     conduit::Node *extract_list = graph().workspace().registry().fetch<Node>("extract_list");
 
+    // the slowest rank determines when the extract is done. For async
+    // extracts this only covers staging the data
+    uint64 write_bytes = 0;
+    float64 write_time = 0.0;
+    detail::global_write_stats(local_bytes,
+                               write_timer.elapsed(),
+                               write_bytes,
+                               write_time);
+
     Node &einfo = extract_list->append();
     einfo["type"] = "relay";
     if(!protocol.empty())
         einfo["protocol"] = protocol;
     einfo["path"] = result_path;
+    einfo["write/bytes"] = write_bytes;
+    einfo["write/time"] = write_time;
+    einfo["write/bandwidth"] = write_time > 0.0 ? write_bytes / write_time : 0.0;
+    einfo["write/num_writers"] = aggregate ? num_writers : mpi_size();
+    if(async)
+    {
+        einfo["write/async"] = "true";
+        einfo["write/in_flight"] = writer.in_flight();
+    }
 }
 
 
@@ -943,14 +1488,18 @@ RelayIOLoad::execute()
 
     Node *res = new Node();
 
-    if(protocol.empty())
-    {
-        conduit::relay::io::load(path,*res);
-    }
-    else
+    // keep io off the main thread while extracts write in the background
+    AsyncWriter::instance().run_io([&]()
     {
-        conduit::relay::io::load(path,protocol,*res);
-    }
+        if(protocol.empty())
+        {
+            conduit::relay::io::load(path,*res);
+        }
+        else
+        {
+            conduit::relay::io::load(path,protocol,*res);
+        }
+    });
 
     set_output<Node>(res);
 
@@ -1086,18 +1635,22 @@ BlueprintFlatten::execute()
 
     if(rank == root)
     {
-        if(protocol.empty())
+        // keep io off the main thread while extracts write in the background
+        AsyncWriter::instance().run_io([&]()
         {
-            //path = path;
-            path = path + ".csv";
-            conduit::relay::io::save(output,path);
-            result_path = path;
-        }
-        else
-        {
-            conduit::relay::io::save(output,path,protocol);
-	    result_path = path;
-        }
+            if(protocol.empty())
+            {
+                //path = path;
+                path = path + ".csv";
+                conduit::relay::io::save(output,path);
+                result_path = path;
+            }
+            else
+            {
+                conduit::relay::io::save(output,path,protocol);
+                result_path = path;
+            }
+        });
     }
 
     // add this to the extract results in the registry
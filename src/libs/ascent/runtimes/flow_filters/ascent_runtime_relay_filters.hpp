@@ -50,6 +50,16 @@ void mesh_blueprint_save(const conduit::Node &data,
                          const conduit::Node &extra_opts,
                          std::string &root_file_out);
 
+// same as above, collectives use the given mpi comm (fortran handle)
+// instead of the workspace default. Ignored for non-mpi builds.
+void mesh_blueprint_save(const conduit::Node &data,
+                         const std::string &path,
+                         const std::string &file_protocol,
+                         int num_files,
+                         const conduit::Node &extra_opts,
+                         std::string &root_file_out,
+                         int mpi_comm_id);
+
 class ASCENT_API RelayIOSave : public ::flow::Filter
 {
 public:
@@ -35,6 +35,7 @@
 #include <ascent_resources.hpp>
 #include <flow_graph.hpp>
 #include <flow_workspace.hpp>
+#include <png_utils/ascent_image_encoder.hpp>
 
 // mpi
 #ifdef ASCENT_MPI_ENABLED
@@ -245,8 +246,10 @@ public:
       m_data(data_object)
   {
     // we have to keep around the dataset so we bring the
-    // whole collection with us
-    vtkh::DataSet &data = m_collection->dataset_by_topology(m_topo_name);
+    // whole collection with us. The plot already converted
+    // the fields it needs, so don't ask for any more
+    std::vector<std::string> no_fields;
+    vtkh::DataSet &data = m_collection->dataset_by_topology(m_topo_name, no_fields);
     renderer->SetInput(&data);
     m_registry->add<vtkh::Renderer>(m_key,renderer,1);
   }
@@ -800,7 +803,8 @@ public:
     meta["type"] = "simple";
     meta["version"] = "1.1";
     meta["metadata/type"] = "parametric-image-stack";
-    meta["name_pattern"] = "{time}/{phi}_{theta}_" + m_image_name + ".png";
+    meta["name_pattern"] = "{time}/{phi}_{theta}_" + m_image_name
+                           + ImageEncoder::DefaultExtension();
 
     conduit::Node times;
     times["default"] = get_string(m_times[0]);
@@ -868,7 +872,8 @@ public:
       csv<<phi<<",";
       csv<<theta<<",";
       csv<<current_time<<",";
-      csv<<current_time<<"/"<<phi<<"_"<<theta<<"_"<<m_image_name<<".png\n";
+      csv<<current_time<<"/"<<phi<<"_"<<theta<<"_"<<m_image_name
+         <<ImageEncoder::DefaultExtension()<<"\n";
     }
 
     m_csv = csv.str();
@@ -1296,7 +1301,9 @@ DefaultRender::execute()
             }
 
             std::string topo_name = collection->field_topology(field_name);
-            vtkh::DataSet &dataset = collection->dataset_by_topology(topo_name);
+            std::vector<std::string> camera_fields(1, field_name);
+            vtkh::DataSet &dataset = collection->dataset_by_topology(topo_name,
+                                                                     camera_fields);
 
             vtkh::AutoCamera auto_cam;
 
@@ -1675,7 +1682,13 @@ CreatePlot::execute()
       }
     }
 
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    // plots only need the field they color by
+    std::vector<std::string> plot_fields;
+    if(field_name != "")
+    {
+      plot_fields.push_back(field_name);
+    }
+    vtkh::DataSet &data = collection->dataset_by_topology(topo_name, plot_fields);
 
     std::string type = params()["type"].as_string();
 
@@ -1882,6 +1895,19 @@ ExecScene::execute()
 
     detail::AscentScene *scene = input<detail::AscentScene>(0);
     std::vector<vtkh::Render> * renders = input<std::vector<vtkh::Render>>(1);
+
+    // when streaming to the web client, keep the encoded pngs so
+    // they don't have to be read back from disk
+    const bool keep_pngs = Metadata::n_metadata.has_path("web/stream") &&
+                           Metadata::n_metadata["web/stream"].as_string() == "true";
+    if(keep_pngs)
+    {
+      for(int i = 0; i < renders->size(); ++i)
+      {
+        renders->at(i).SetKeepPNGBuffer(true);
+      }
+    }
+
     scene->Execute(*renders);
 
     // the images should exist now so add them to the image list
@@ -1893,10 +1919,13 @@ ExecScene::execute()
       graph().workspace().registry().add<Node>("image_list", image_list,1);
     }
 
+    // the files were written with the default format, and the kept
+    // buffers are listed under the same names
+    const std::string extension = ImageEncoder::DefaultExtension();
     conduit::Node *image_list = graph().workspace().registry().fetch<Node>("image_list");
     for(int i = 0; i < renders->size(); ++i)
     {
-      const std::string image_name = renders->at(i).GetImageName() + ".png";
+      const std::string image_name = renders->at(i).GetImageName() + extension;
       conduit::Node image_data;
       image_data["image_name"] = image_name;
       image_data["image_width"] = renders->at(i).GetWidth();
@@ -1922,6 +1951,30 @@ ExecScene::execute()
       image_list->append() = image_data;
     }
 
+    if(keep_pngs)
+    {
+      if(!graph().workspace().registry().has_entry("image_buffers"))
+      {
+        conduit::Node *image_buffers = new conduit::Node();
+        graph().workspace().registry().add<Node>("image_buffers", image_buffers,1);
+      }
+
+      conduit::Node *image_buffers = graph().workspace().registry().fetch<Node>("image_buffers");
+      for(int i = 0; i < renders->size(); ++i)
+      {
+        const std::vector<unsigned char> &png = renders->at(i).GetPNGBuffer();
+        // only rank 0 encodes
+        if(png.empty())
+        {
+          continue;
+        }
+        conduit::Node &image_buffer = image_buffers->append();
+        // the buffer is always a png, whatever format the file has
+        image_buffer["image_name"] = renders->at(i).GetImageName() + extension;
+        image_buffer["png"].set(&png[0], png.size());
+      }
+    }
+
 }
 //-----------------------------------------------------------------------------
 
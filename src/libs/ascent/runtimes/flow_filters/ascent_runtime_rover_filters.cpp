@@ -194,7 +194,13 @@ RoverXRay::execute()
 
     std::string topo_name = collection->field_topology(field_name);
 
-    vtkh::DataSet &dataset = collection->dataset_by_topology(topo_name);
+    std::vector<std::string> used_fields(1, field_name);
+    if(params().has_path("emission"))
+    {
+      used_fields.push_back(params()["emission"].as_string());
+    }
+    vtkh::DataSet &dataset = collection->dataset_by_topology(topo_name,
+                                                             used_fields);
 
     vtkmCamera camera;
     camera.ResetToBounds(dataset.GetGlobalBounds());
@@ -428,7 +434,9 @@ RoverVolume::execute()
 
     std::string topo_name = collection->field_topology(field_name);
 
-    vtkh::DataSet &dataset = collection->dataset_by_topology(topo_name);
+    std::vector<std::string> used_fields(1, field_name);
+    vtkh::DataSet &dataset = collection->dataset_by_topology(topo_name,
+                                                             used_fields);
 
     vtkmCamera camera;
     camera.ResetToBounds(dataset.GetGlobalBounds());
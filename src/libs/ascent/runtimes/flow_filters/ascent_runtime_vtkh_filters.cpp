@@ -82,11 +82,15 @@
 #include <ascent_runtime_conduit_to_vtkm_parsing.hpp>
 #include <ascent_runtime_vtkh_utils.hpp>
 #include <ascent_expression_eval.hpp>
+#include <png_utils/ascent_value_image.hpp>
 
 #endif
 
 #include <stdio.h>
+#include <algorithm>
+#include <limits>
 #include <random>
+#include <set>
 
 using namespace conduit;
 using namespace std;
@@ -320,7 +324,8 @@ VTKHVectorMagnitude::execute()
 
     std::string topo_name = collection->field_topology(field_name);
 
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    std::vector<std::string> used_fields(1, field_name);
+    vtkh::DataSet &data = collection->dataset_by_topology(topo_name, used_fields);
 
     vtkh::VectorMagnitude mag;
 
@@ -340,6 +345,8 @@ VTKHVectorMagnitude::execute()
     // and add the result of this operation
     VTKHCollection *new_coll = collection->copy_without_topology(topo_name);
     new_coll->add(*mag_output, topo_name);
+    // the other fields of the topology are still valid on the output
+    new_coll->carry_lazy_fields(*collection, topo_name);
     // re wrap in data object
     DataObject *res =  new DataObject(new_coll);
     delete mag_output;
@@ -1111,11 +1118,15 @@ VTKHGhostStripper::verify_params(const conduit::Node &params,
 
     res = check_numeric("min_value",params, info, true, true) && res;
     res = check_numeric("max_value",params, info, true, true) && res;
+    res = check_string("static_ghosts",params, info, false) && res;
+    res = check_string("static_topology",params, info, false) && res;
 
     std::vector<std::string> valid_paths;
     valid_paths.push_back("field");
     valid_paths.push_back("min_value");
     valid_paths.push_back("max_value");
+    valid_paths.push_back("static_ghosts");
+    valid_paths.push_back("static_topology");
     std::string surprises = surprise_check(valid_paths, params);
 
     if(surprises != "")
@@ -1172,6 +1183,15 @@ VTKHGhostStripper::execute()
       stripper.SetMaxValue(max_val);
       stripper.SetMinValue(min_val);
 
+      if(params().has_path("static_ghosts"))
+      {
+        stripper.SetStaticGhosts(params()["static_ghosts"].as_string() == "true");
+      }
+      if(params().has_path("static_topology"))
+      {
+        stripper.SetStaticTopology(params()["static_topology"].as_string() == "true");
+      }
+
       stripper.Update();
 
       vtkh::DataSet *stripper_output = stripper.GetOutput();
@@ -2164,7 +2184,8 @@ VTKHLagrangian::execute()
 
     std::string topo_name = collection->field_topology(field_name);
 
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    std::vector<std::string> used_fields(1, field_name);
+    vtkh::DataSet &data = collection->dataset_by_topology(topo_name, used_fields);
 
 
     double step_size = params()["step_size"].to_float64();
@@ -2278,7 +2299,8 @@ VTKHLog::execute()
 
     std::string topo_name = collection->field_topology(field_name);
 
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    std::vector<std::string> used_fields(1, field_name);
+    vtkh::DataSet &data = collection->dataset_by_topology(topo_name, used_fields);
 
     vtkh::Log logger;
     logger.SetInput(&data);
@@ -2303,6 +2325,8 @@ VTKHLog::execute()
     // and add the result of this operation
     VTKHCollection *new_coll = collection->copy_without_topology(topo_name);
     new_coll->add(*log_output, topo_name);
+    // the other fields of the topology are still valid on the output
+    new_coll->carry_lazy_fields(*collection, topo_name);
     // re wrap in data object
     DataObject *res =  new DataObject(new_coll);
     delete log_output;
@@ -2388,7 +2412,8 @@ VTKHLog10::execute()
 
     std::string topo_name = collection->field_topology(field_name);
 
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    std::vector<std::string> used_fields(1, field_name);
+    vtkh::DataSet &data = collection->dataset_by_topology(topo_name, used_fields);
 
     vtkh::Log10 logger;
     logger.SetInput(&data);
@@ -2413,6 +2438,8 @@ VTKHLog10::execute()
     // and add the result of this operation
     VTKHCollection *new_coll = collection->copy_without_topology(topo_name);
     new_coll->add(*log_output, topo_name);
+    // the other fields of the topology are still valid on the output
+    new_coll->carry_lazy_fields(*collection, topo_name);
     // re wrap in data object
     DataObject *res =  new DataObject(new_coll);
     delete log_output;
@@ -2498,7 +2525,8 @@ VTKHLog2::execute()
 
     std::string topo_name = collection->field_topology(field_name);
 
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    std::vector<std::string> used_fields(1, field_name);
+    vtkh::DataSet &data = collection->dataset_by_topology(topo_name, used_fields);
 
     vtkh::Log2 logger;
     logger.SetInput(&data);
@@ -2523,6 +2551,8 @@ VTKHLog2::execute()
     // and add the result of this operation
     VTKHCollection *new_coll = collection->copy_without_topology(topo_name);
     new_coll->add(*log_output, topo_name);
+    // the other fields of the topology are still valid on the output
+    new_coll->carry_lazy_fields(*collection, topo_name);
     // re wrap in data object
     DataObject *res =  new DataObject(new_coll);
     delete log_output;
@@ -2605,7 +2635,8 @@ VTKHRecenter::execute()
 
     std::string topo_name = collection->field_topology(field_name);
 
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    std::vector<std::string> used_fields(1, field_name);
+    vtkh::DataSet &data = collection->dataset_by_topology(topo_name, used_fields);
 
 
     std::string association = params()["association"].as_string();
@@ -2637,6 +2668,8 @@ VTKHRecenter::execute()
     // and add the result of this operation
     VTKHCollection *new_coll = collection->copy_without_topology(topo_name);
     new_coll->add(*recenter_output, topo_name);
+    // the other fields of the topology are still valid on the output
+    new_coll->carry_lazy_fields(*collection, topo_name);
     // re wrap in data object
     DataObject *res =  new DataObject(new_coll);
     delete recenter_output;
@@ -2722,7 +2755,8 @@ VTKHHistSampling::execute()
 
     std::string topo_name = collection->field_topology(field_name);
 
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    std::vector<std::string> used_fields(1, field_name);
+    vtkh::DataSet &data = collection->dataset_by_topology(topo_name, used_fields);
 
     float sample_rate = .1f;
     if(params().has_path("sample_rate"))
@@ -2789,6 +2823,8 @@ VTKHHistSampling::execute()
     // and add the result of this operation
     VTKHCollection *new_coll = collection->copy_without_topology(topo_name);
     new_coll->add(*hist_output, topo_name);
+    // the other fields of the topology are still valid on the output
+    new_coll->carry_lazy_fields(*collection, topo_name);
     // re wrap in data object
     DataObject *res =  new DataObject(new_coll);
     delete hist_output;
@@ -2874,7 +2910,8 @@ VTKHQCriterion::execute()
 
     std::string topo_name = collection->field_topology(field_name);
 
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    std::vector<std::string> used_fields(1, field_name);
+    vtkh::DataSet &data = collection->dataset_by_topology(topo_name, used_fields);
 
     vtkh::Gradient grad;
     grad.SetInput(&data);
@@ -2912,6 +2949,8 @@ VTKHQCriterion::execute()
     // and add the result of this operation
     VTKHCollection *new_coll = collection->copy_without_topology(topo_name);
     new_coll->add(*grad_output, topo_name);
+    // the other fields of the topology are still valid on the output
+    new_coll->carry_lazy_fields(*collection, topo_name);
     // re wrap in data object
     DataObject *res =  new DataObject(new_coll);
     delete grad_output;
@@ -2996,7 +3035,8 @@ VTKHDivergence::execute()
 
     std::string topo_name = collection->field_topology(field_name);
 
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    std::vector<std::string> used_fields(1, field_name);
+    vtkh::DataSet &data = collection->dataset_by_topology(topo_name, used_fields);
 
     vtkh::Gradient grad;
     grad.SetInput(&data);
@@ -3033,6 +3073,8 @@ VTKHDivergence::execute()
     // and add the result of this operation
     VTKHCollection *new_coll = collection->copy_without_topology(topo_name);
     new_coll->add(*grad_output, topo_name);
+    // the other fields of the topology are still valid on the output
+    new_coll->carry_lazy_fields(*collection, topo_name);
     // re wrap in data object
     DataObject *res =  new DataObject(new_coll);
     delete grad_output;
@@ -3117,7 +3159,8 @@ VTKHVorticity::execute()
 
     std::string topo_name = collection->field_topology(field_name);
 
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    std::vector<std::string> used_fields(1, field_name);
+    vtkh::DataSet &data = collection->dataset_by_topology(topo_name, used_fields);
 
     vtkh::Gradient grad;
     grad.SetInput(&data);
@@ -3154,6 +3197,8 @@ VTKHVorticity::execute()
     // and add the result of this operation
     VTKHCollection *new_coll = collection->copy_without_topology(topo_name);
     new_coll->add(*grad_output, topo_name);
+    // the other fields of the topology are still valid on the output
+    new_coll->carry_lazy_fields(*collection, topo_name);
     // re wrap in data object
     DataObject *res =  new DataObject(new_coll);
     delete grad_output;
@@ -3239,7 +3284,8 @@ VTKHGradient::execute()
 
     std::string topo_name = collection->field_topology(field_name);
 
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    std::vector<std::string> used_fields(1, field_name);
+    vtkh::DataSet &data = collection->dataset_by_topology(topo_name, used_fields);
 
     vtkh::Gradient grad;
     grad.SetInput(&data);
@@ -3268,6 +3314,8 @@ VTKHGradient::execute()
     // and add the result of this operation
     VTKHCollection *new_coll = collection->copy_without_topology(topo_name);
     new_coll->add(*grad_output, topo_name);
+    // the other fields of the topology are still valid on the output
+    new_coll->carry_lazy_fields(*collection, topo_name);
     // re wrap in data object
     DataObject *res =  new DataObject(new_coll);
     delete grad_output;
@@ -3521,7 +3569,8 @@ VTKHStats::execute()
 
     std::string topo_name = collection->field_topology(field_name);
 
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    std::vector<std::string> used_fields(1, field_name);
+    vtkh::DataSet &data = collection->dataset_by_topology(topo_name, used_fields);
 
     vtkh::Statistics stats;
     stats.SetField(field_name);
@@ -3617,7 +3666,8 @@ VTKHHistogram::execute()
 
     std::string topo_name = collection->field_topology(field_name);
 
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    std::vector<std::string> used_fields(1, field_name);
+    vtkh::DataSet &data = collection->dataset_by_topology(topo_name, used_fields);
 
     int bins = 128;
     if(params().has_path("bins"))
@@ -3764,6 +3814,321 @@ VTKHProject2d::execute()
 
 //-----------------------------------------------------------------------------
 
+VTKHValueImage::VTKHValueImage()
+:Filter()
+{
+// empty
+}
+
+//-----------------------------------------------------------------------------
+VTKHValueImage::~VTKHValueImage()
+{
+// empty
+}
+
+//-----------------------------------------------------------------------------
+void
+VTKHValueImage::declare_interface(Node &i)
+{
+    i["type_name"]   = "vtkh_value_image";
+    i["port_names"].append() = "in";
+    i["output_port"] = "false";
+}
+
+//-----------------------------------------------------------------------------
+bool
+VTKHValueImage::verify_params(const conduit::Node &params,
+                              conduit::Node &info)
+{
+    info.reset();
+    bool res = check_string("path",params, info, true);
+    res &= check_string("topology",params, info, false);
+    res &= check_numeric("image_width",params, info, false);
+    res &= check_numeric("image_height",params, info, false);
+    res &= check_string("mode",params, info, false);
+
+    if(params.has_path("mode"))
+    {
+      const std::string mode = params["mode"].as_string();
+      if(mode != "composited" && mode != "per_rank")
+      {
+        info["errors"].append() = "'mode' must be 'composited' or 'per_rank'";
+        res = false;
+      }
+    }
+
+    if(params.has_path("fields") && !params["fields"].dtype().is_list())
+    {
+      info["errors"].append() = "'fields' must be a list of field names";
+      res = false;
+    }
+
+    std::vector<std::string> valid_paths;
+    std::vector<std::string> ignore_paths;
+    valid_paths.push_back("path");
+    valid_paths.push_back("topology");
+    valid_paths.push_back("image_width");
+    valid_paths.push_back("image_height");
+    valid_paths.push_back("mode");
+    valid_paths.push_back("fields");
+    valid_paths.push_back("camera");
+    ignore_paths.push_back("camera");
+    ignore_paths.push_back("fields");
+
+    std::string surprises = surprise_check(valid_paths, ignore_paths, params);
+
+    if(surprises != "")
+    {
+      res = false;
+      info["errors"].append() = surprises;
+    }
+
+    return res;
+}
+
+//-----------------------------------------------------------------------------
+void
+VTKHValueImage::execute()
+{
+
+    if(!input(0).check_type<DataObject>())
+    {
+        ASCENT_ERROR("vtkh_value_image input must be a data object");
+    }
+
+    DataObject *data_object = input<DataObject>(0);
+    if(!data_object->is_valid())
+    {
+      return;
+    }
+    std::shared_ptr<VTKHCollection> collection = data_object->as_vtkh_collection();
+
+    bool throw_error = false;
+    std::string topo_name = detail::resolve_topology(params(),
+                                                     this->name(),
+                                                     collection,
+                                                     throw_error);
+    if(topo_name == "")
+    {
+      return;
+    }
+
+    std::set<std::string> field_filter;
+    if(params().has_path("fields"))
+    {
+      const Node &n_fields = params()["fields"];
+      for(index_t i = 0; i < n_fields.number_of_children(); ++i)
+      {
+        field_filter.insert(n_fields.child(i).as_string());
+      }
+    }
+
+    // only the listed fields need to be converted for rendering
+    vtkh::DataSet *data_ptr = nullptr;
+    if(field_filter.empty())
+    {
+      data_ptr = &collection->dataset_by_topology(topo_name);
+    }
+    else
+    {
+      std::vector<std::string> used_fields(field_filter.begin(),
+                                           field_filter.end());
+      data_ptr = &collection->dataset_by_topology(topo_name, used_fields);
+    }
+    vtkh::DataSet &data = *data_ptr;
+    vtkm::Bounds bounds = data.GetGlobalBounds();
+    vtkm::rendering::Camera camera;
+    camera.ResetToBounds(bounds);
+
+    if(params().has_path("camera"))
+    {
+      parse_camera(params()["camera"], camera);
+    }
+
+    int width = 512;
+    int height = 512;
+    if(params().has_path("image_width"))
+    {
+      width = params()["image_width"].to_int32();
+    }
+    if(params().has_path("image_height"))
+    {
+      height = params()["image_height"].to_int32();
+    }
+
+    bool composite = true;
+    if(params().has_path("mode"))
+    {
+      composite = params()["mode"].as_string() == "composited";
+    }
+
+    // the renderer calls its depth channel "depth", so a field with that
+    // name is rendered under another name and saved as a field again
+    const std::string depth_alias = "__ascent_value_image_depth";
+    vtkh::DataSet render_data;
+    const int num_input_domains = static_cast<int>(data.GetNumberOfDomains());
+    for(int dom = 0; dom < num_input_domains; ++dom)
+    {
+      vtkm::cont::DataSet dset;
+      vtkm::Id domain_id;
+      data.GetDomain(dom, dset, domain_id);
+      if(!dset.HasField("depth"))
+      {
+        render_data.AddDomain(dset, domain_id);
+        continue;
+      }
+
+      vtkm::cont::DataSet renamed;
+      const vtkm::Id num_coords = dset.GetNumberOfCoordinateSystems();
+      for(vtkm::Id i = 0; i < num_coords; ++i)
+      {
+        renamed.AddCoordinateSystem(dset.GetCoordinateSystem(i));
+      }
+      renamed.SetCellSet(dset.GetCellSet());
+      const vtkm::IdComponent num_dset_fields = dset.GetNumberOfFields();
+      for(vtkm::IdComponent f = 0; f < num_dset_fields; ++f)
+      {
+        const vtkm::cont::Field &field = dset.GetField(f);
+        if(field.GetName() == "depth")
+        {
+          renamed.AddField(vtkm::cont::Field(depth_alias,
+                                             field.GetAssociation(),
+                                             field.GetData()));
+        }
+        else
+        {
+          renamed.AddField(field);
+        }
+      }
+      render_data.AddDomain(renamed, domain_id);
+    }
+
+    vtkh::ScalarRenderer tracer;
+    tracer.SetWidth(width);
+    tracer.SetHeight(height);
+    tracer.SetInput(&render_data);
+    tracer.SetCamera(camera);
+    tracer.SetCompositeImages(composite);
+    tracer.Update();
+
+    vtkh::DataSet *output = tracer.GetOutput();
+
+    // no hit can be farther than the farthest corner of the data,
+    // anything beyond that is background
+    const vtkm::Vec<vtkm::Float32,3> pos = camera.GetPosition();
+    vtkm::Float64 max_depth = 0.;
+    for(int c = 0; c < 8; ++c)
+    {
+      vtkm::Vec<vtkm::Float64,3> corner((c & 1) ? bounds.X.Max : bounds.X.Min,
+                                       (c & 2) ? bounds.Y.Max : bounds.Y.Min,
+                                       (c & 4) ? bounds.Z.Max : bounds.Z.Min);
+      corner[0] -= pos[0];
+      corner[1] -= pos[1];
+      corner[2] -= pos[2];
+      max_depth = std::max(max_depth, static_cast<vtkm::Float64>(vtkm::Magnitude(corner)));
+    }
+    max_depth *= 1.01;
+
+    std::string path = output_dir(params()["path"].as_string());
+    std::vector<std::string> file_names;
+
+    const int num_domains = static_cast<int>(output->GetNumberOfDomains());
+    for(int dom = 0; dom < num_domains; ++dom)
+    {
+      vtkm::cont::DataSet dset;
+      vtkm::Id domain_id;
+      output->GetDomain(dom, dset, domain_id);
+
+      Node image;
+      image["width"] = width;
+      image["height"] = height;
+      image["camera/position"].set(&camera.GetPosition()[0],3);
+      image["camera/look_at"].set(&camera.GetLookAt()[0],3);
+      image["camera/up"].set(&camera.GetViewUp()[0],3);
+      image["camera/fov"] = camera.GetFieldOfView();
+      image["camera/zoom"] = camera.GetZoom();
+
+      const vtkm::IdComponent num_fields = dset.GetNumberOfFields();
+      for(vtkm::IdComponent f = 0; f < num_fields; ++f)
+      {
+        const vtkm::cont::Field &field = dset.GetField(f);
+        const bool is_depth = field.GetName() == "depth";
+        const std::string name = field.GetName() == depth_alias ?
+                                 "depth" : field.GetName();
+        if(!is_depth && !field_filter.empty() &&
+           field_filter.find(name) == field_filter.end())
+        {
+          continue;
+        }
+
+        vtkm::cont::ArrayHandle<vtkm::Float32> values;
+        field.GetData().AsArrayHandle(values);
+        auto portal = values.ReadPortal();
+        const vtkm::Id size = values.GetNumberOfValues();
+
+        Node &n_values = is_depth ? image["depth"] : image["fields"].add_child(name);
+        n_values.set(DataType::float32(size));
+        float32 *ptr = n_values.value();
+        for(vtkm::Id i = 0; i < size; ++i)
+        {
+          ptr[i] = portal.Get(i);
+        }
+
+        if(is_depth)
+        {
+          for(vtkm::Id i = 0; i < size; ++i)
+          {
+            if(!(ptr[i] <= max_depth))
+            {
+              ptr[i] = std::numeric_limits<float32>::infinity();
+            }
+          }
+        }
+      }
+
+      for(auto it = field_filter.begin(); it != field_filter.end(); ++it)
+      {
+        if(!image.has_path("fields") || !image["fields"].has_child(*it))
+        {
+          ASCENT_ERROR("value_image: field '"<<*it<<"' is not a scalar "
+                       <<"float field of topology '"<<topo_name<<"'");
+        }
+      }
+
+      std::string file_name = path + ".vimg";
+      if(!composite)
+      {
+        file_name = conduit_fmt::format("{}_{:06d}.vimg", path, domain_id);
+      }
+
+      ValueImageEncoder encoder;
+      encoder.Encode(image);
+      encoder.Save(file_name);
+      file_names.push_back(file_name);
+    }
+    delete output;
+
+    // add this to the extract results in the registry
+    if(!graph().workspace().registry().has_entry("extract_list"))
+    {
+      conduit::Node *extract_list = new conduit::Node();
+      graph().workspace().registry().add<Node>("extract_list",
+                                               extract_list,
+                                               -1); // TODO keep forever?
+    }
+
+    conduit::Node *extract_list = graph().workspace().registry().fetch<Node>("extract_list");
+
+    for(size_t i = 0; i < file_names.size(); ++i)
+    {
+      Node &einfo = extract_list->append();
+      einfo["type"] = "value_image";
+      einfo["path"] = file_names[i];
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 VTKHNoOp::VTKHNoOp()
 :Filter()
 {
@@ -3840,7 +4205,8 @@ VTKHNoOp::execute()
 
     std::string topo_name = collection->field_topology(field_name);
 
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    std::vector<std::string> used_fields(1, field_name);
+    vtkh::DataSet &data = collection->dataset_by_topology(topo_name, used_fields);
 
     vtkh::NoOp noop;
 
@@ -3854,6 +4220,8 @@ VTKHNoOp::execute()
     // and add the result of this operation
     VTKHCollection *new_coll = collection->copy_without_topology(topo_name);
     new_coll->add(*noop_output, topo_name);
+    // the other fields of the topology are still valid on the output
+    new_coll->carry_lazy_fields(*collection, topo_name);
     // re wrap in data object
     DataObject *res =  new DataObject(new_coll);
     delete noop_output;
@@ -3944,7 +4312,8 @@ VTKHVectorComponent::execute()
 
     std::string topo_name = collection->field_topology(field_name);
 
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    std::vector<std::string> used_fields(1, field_name);
+    vtkh::DataSet &data = collection->dataset_by_topology(topo_name, used_fields);
 
     vtkh::VectorComponent comp;
 
@@ -3960,6 +4329,8 @@ VTKHVectorComponent::execute()
     // and add the result of this operation
     VTKHCollection *new_coll = collection->copy_without_topology(topo_name);
     new_coll->add(*comp_output, topo_name);
+    // the other fields of the topology are still valid on the output
+    new_coll->carry_lazy_fields(*collection, topo_name);
     // re wrap in data object
     DataObject *res =  new DataObject(new_coll);
     delete comp_output;
@@ -4075,7 +4446,14 @@ VTKHCompositeVector::execute()
 
     std::string topo_name = collection->field_topology(field_name1);
 
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    std::vector<std::string> used_fields;
+    used_fields.push_back(field_name1);
+    used_fields.push_back(field_name2);
+    if(field_name3 != "")
+    {
+      used_fields.push_back(field_name3);
+    }
+    vtkh::DataSet &data = collection->dataset_by_topology(topo_name, used_fields);
 
 
     vtkh::CompositeVector comp;
@@ -4098,6 +4476,8 @@ VTKHCompositeVector::execute()
     // and add the result of this operation
     VTKHCollection *new_coll = collection->copy_without_topology(topo_name);
     new_coll->add(*comp_output, topo_name);
+    // the other fields of the topology are still valid on the output
+    new_coll->carry_lazy_fields(*collection, topo_name);
     // re wrap in data object
     DataObject *res =  new DataObject(new_coll);
     delete comp_output;
@@ -4186,15 +4566,19 @@ VTKHScale::execute()
 #endif
 
     VTKHCollection *new_coll = new VTKHCollection();
+    // only the coordinates change, so no fields are needed and the
+    // pending ones are still valid on the output
+    std::vector<std::string> no_fields;
     for(auto &topo : topo_names)
     {
-      vtkh::DataSet &data = collection->dataset_by_topology(topo);
+      vtkh::DataSet &data = collection->dataset_by_topology(topo, no_fields);
       vtkh::PointTransform transform;
       transform.SetScale(x_scale, y_scale, z_scale);
       transform.SetInput(&data);
       transform.Update();
       vtkh::DataSet *trans_output = transform.GetOutput();
       new_coll->add(*trans_output, topo);
+      new_coll->carry_lazy_fields(*collection, topo);
       delete trans_output;
     }
 
@@ -4379,7 +4763,8 @@ VTKHParticleAdvection::execute()
     }
 
     std::string topo_name = collection->field_topology(field_name);
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    std::vector<std::string> used_fields(1, field_name);
+    vtkh::DataSet &data = collection->dataset_by_topology(topo_name, used_fields);
 
     int numSteps = get_int32(params()["num_steps"], data_object);
     float stepSize = get_float32(params()["step_size"], data_object);
@@ -4955,7 +5340,14 @@ VTKHWarpXStreamline::execute()
     }
     
     std::string topo_name = collection->field_topology(b_field);
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    std::vector<std::string> used_fields;
+    used_fields.push_back(b_field);
+    used_fields.push_back(e_field);
+    used_fields.push_back(charge_field);
+    used_fields.push_back(mass_field);
+    used_fields.push_back(momentum_field);
+    used_fields.push_back(weighting_field);
+    vtkh::DataSet &data = collection->dataset_by_topology(topo_name, used_fields);
 
 
     int numSteps = get_int32(params()["num_steps"], data_object);
@@ -395,6 +395,19 @@ public:
 };
 
 
+//-----------------------------------------------------------------------------
+class ASCENT_API VTKHValueImage : public ::flow::Filter
+{
+public:
+    VTKHValueImage();
+    virtual ~VTKHValueImage();
+
+    virtual void   declare_interface(conduit::Node &i);
+    virtual bool   verify_params(const conduit::Node &params,
+                                 conduit::Node &info);
+    virtual void   execute();
+};
+
 //-----------------------------------------------------------------------------
 class ASCENT_API VTKHCleanGrid : public ::flow::Filter
 {
@@ -0,0 +1,400 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_async_writer.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "ascent_async_writer.hpp"
+#include "ascent_logging.hpp"
+#include <flow.hpp>
+
+#include <future>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+#ifdef ASCENT_MPI_ENABLED
+#include <mpi.h>
+#endif
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::detail --
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+//-----------------------------------------------------------------------------
+// runs the task, returns the error message if it failed
+//-----------------------------------------------------------------------------
+std::string
+run_task(const AsyncWriter::Task &task)
+{
+    std::string error;
+    try
+    {
+        task();
+    }
+    catch(conduit::Error &e)
+    {
+        error = e.message();
+    }
+    catch(std::exception &e)
+    {
+        error = e.what();
+    }
+    catch(...)
+    {
+        error = "unknown exception";
+    }
+    return error;
+}
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::detail --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+AsyncWriter &
+AsyncWriter::instance()
+{
+    static AsyncWriter writer;
+    return writer;
+}
+
+//-----------------------------------------------------------------------------
+AsyncWriter::AsyncWriter()
+: m_running(0),
+  m_users(0),
+  m_active(false),
+  m_stop(false),
+  m_comm_id(-1),
+  m_source_comm_id(-1)
+{
+}
+
+//-----------------------------------------------------------------------------
+AsyncWriter::~AsyncWriter()
+{
+    // the thread must not outlive the object. We can't free the
+    // communicator here since MPI may already be finalized.
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_stop = true;
+    m_cond.notify_all();
+    lock.unlock();
+    if(m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool
+AsyncWriter::supported()
+{
+#ifdef ASCENT_MPI_ENABLED
+    int provided = MPI_THREAD_SINGLE;
+    MPI_Query_thread(&provided);
+    return provided == MPI_THREAD_MULTIPLE;
+#else
+    return true;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+void
+AsyncWriter::start()
+{
+    // must hold the lock
+    if(!m_active)
+    {
+        m_stop = false;
+        m_thread = std::thread(&AsyncWriter::worker, this);
+        m_active = true;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+AsyncWriter::worker()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while(true)
+    {
+        m_cond.wait(lock, [this]{ return m_stop || !m_tasks.empty(); });
+        if(m_tasks.empty())
+        {
+            // stop requested and nothing left to do
+            return;
+        }
+
+        Task task = m_tasks.front();
+        lock.unlock();
+
+        const std::string error = detail::run_task(task);
+
+        lock.lock();
+        m_tasks.pop_front();
+        m_running--;
+        if(!error.empty())
+        {
+            m_errors.push_back(error);
+        }
+        m_cond.notify_all();
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+AsyncWriter::check_errors()
+{
+    std::vector<std::string> errors;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        errors.swap(m_errors);
+    }
+
+    if(!errors.empty())
+    {
+        std::stringstream msg;
+        msg<<"Asynchronous extract failed:";
+        for(size_t i = 0; i < errors.size(); ++i)
+        {
+            msg<<"\n "<<errors[i];
+        }
+        ASCENT_ERROR(msg.str());
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+AsyncWriter::submit(Task task, int max_in_flight)
+{
+    check_errors();
+    if(max_in_flight < 1)
+    {
+        max_in_flight = 1;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    start();
+    m_cond.wait(lock, [this, max_in_flight]{ return m_running < max_in_flight; });
+    m_tasks.push_back(task);
+    m_running++;
+    m_cond.notify_all();
+}
+
+//-----------------------------------------------------------------------------
+void
+AsyncWriter::run(Task task)
+{
+    // the worker reports errors of queued tasks through m_errors,
+    // but here the caller wants them directly
+    std::shared_ptr<std::promise<std::string>> result
+      = std::make_shared<std::promise<std::string>>();
+    std::future<std::string> error = result->get_future();
+
+    Task wrapped = [task, result]()
+    {
+        result->set_value(detail::run_task(task));
+    };
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        start();
+        // don't count against max_in_flight, the caller waits anyway
+        m_tasks.push_back(wrapped);
+        m_running++;
+        m_cond.notify_all();
+    }
+
+    const std::string msg = error.get();
+    if(!msg.empty())
+    {
+        ASCENT_ERROR(msg);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+AsyncWriter::run_io(Task task)
+{
+    if(is_active())
+    {
+        run(task);
+    }
+    else
+    {
+        task();
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+AsyncWriter::drain()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait(lock, [this]{ return m_running == 0; });
+    }
+    check_errors();
+}
+
+//-----------------------------------------------------------------------------
+void
+AsyncWriter::shutdown()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if(m_active)
+    {
+        m_stop = true;
+        m_cond.notify_all();
+        lock.unlock();
+        m_thread.join();
+        lock.lock();
+        m_active = false;
+        m_stop = false;
+    }
+    lock.unlock();
+
+#ifdef ASCENT_MPI_ENABLED
+    if(m_comm_id != -1)
+    {
+        MPI_Comm comm = MPI_Comm_f2c(m_comm_id);
+        MPI_Comm_free(&comm);
+        m_comm_id = -1;
+        m_source_comm_id = -1;
+    }
+#endif
+    check_errors();
+}
+
+//-----------------------------------------------------------------------------
+bool
+AsyncWriter::is_active()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_active;
+}
+
+//-----------------------------------------------------------------------------
+int
+AsyncWriter::in_flight()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_running;
+}
+
+//-----------------------------------------------------------------------------
+void
+AsyncWriter::attach()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_users++;
+}
+
+//-----------------------------------------------------------------------------
+void
+AsyncWriter::detach()
+{
+    bool last = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_users > 0)
+        {
+            m_users--;
+        }
+        last = m_users == 0;
+    }
+
+    if(last)
+    {
+        shutdown();
+    }
+    else
+    {
+        // tasks don't know who submitted them, so wait for all of them
+        drain();
+    }
+}
+
+//-----------------------------------------------------------------------------
+int
+AsyncWriter::mpi_comm_id()
+{
+#ifdef ASCENT_MPI_ENABLED
+    int source_comm_id = flow::Workspace::default_mpi_comm();
+    if(m_comm_id != -1 && m_source_comm_id != source_comm_id)
+    {
+        // the ascent communicator changed, tasks using the old
+        // duplicate must finish before we let go of it
+        drain();
+        MPI_Comm comm = MPI_Comm_f2c(m_comm_id);
+        MPI_Comm_free(&comm);
+        m_comm_id = -1;
+    }
+
+    if(m_comm_id == -1)
+    {
+        MPI_Comm dup_comm;
+        MPI_Comm_dup(MPI_Comm_f2c(source_comm_id), &dup_comm);
+        m_comm_id = MPI_Comm_c2f(dup_comm);
+        m_source_comm_id = source_comm_id;
+    }
+    return m_comm_id;
+#else
+    return -1;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+AsyncWriter::Task
+AsyncWriter::collective(Task task, int mpi_comm_id)
+{
+#ifdef ASCENT_MPI_ENABLED
+    return [task, mpi_comm_id]()
+    {
+        const std::string error = detail::run_task(task);
+        if(error.empty())
+        {
+            return;
+        }
+
+        MPI_Comm comm = MPI_Comm_f2c(mpi_comm_id);
+        int size = 1;
+        int rank = 0;
+        MPI_Comm_size(comm, &size);
+        MPI_Comm_rank(comm, &rank);
+        if(size == 1)
+        {
+            ASCENT_ERROR(error);
+        }
+        // the other ranks may be waiting on us in a collective
+        std::cerr<<"Asynchronous extract failed on rank "<<rank<<": "
+                 <<error<<"\nAborting, since other ranks can't "
+                 <<"complete the write."<<std::endl;
+        MPI_Abort(comm, 1);
+    };
+#else
+    (void) mpi_comm_id;
+    return task;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
@@ -0,0 +1,129 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_async_writer.hpp
+///
+//-----------------------------------------------------------------------------
+#ifndef ASCENT_ASYNC_WRITER_HPP
+#define ASCENT_ASYNC_WRITER_HPP
+
+#include <ascent_exports.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// Runs extract writes on a single background thread (singleton).
+//
+// Extracts stage the data they want to save and submit a task; the
+// simulation continues while the task runs. Each submit passes its own
+// max_in_flight and blocks until fewer tasks are pending. Every Ascent
+// runtime attaches to the writer while it is open; detaching drains all
+// pending tasks and the last runtime to detach stops the thread.
+//
+// Tasks that use MPI must use mpi_comm_id(), a duplicate of the ascent
+// communicator, so background collectives never interleave with
+// collectives issued by the main thread. That also requires the MPI
+// library to provide MPI_THREAD_MULTIPLE (see supported()). Tasks that
+// issue collectives should be wrapped with collective(), a rank whose
+// task fails can't tell the others to stop waiting.
+//
+// I/O libraries like HDF5 keep global state (e.g. relay's hdf5 options)
+// and are not always thread safe, so all file I/O issued by Ascent goes
+// through run_io(), which keeps it on the writer thread while the writer
+// is active. Every rank runs the tasks in submission order, so the
+// collectives inside them match up.
+//-----------------------------------------------------------------------------
+class ASCENT_API AsyncWriter
+{
+public:
+    typedef std::function<void()> Task;
+
+    static AsyncWriter &instance();
+
+    // returns true if tasks can run in the background. Always true without
+    // MPI, requires MPI_THREAD_MULTIPLE otherwise
+    static bool supported();
+
+    // queue a task, blocks while max_in_flight tasks are pending
+    void submit(Task task, int max_in_flight);
+    // run a task on the writer thread and wait for it
+    void run(Task task);
+    // run a synchronous I/O task and wait for it: on the writer thread
+    // while it is active, otherwise on the calling thread
+    void run_io(Task task);
+    // wait for all pending tasks
+    void drain();
+    // drain, stop the thread and release the duplicated communicator
+    void shutdown();
+
+    // register a user (runtime) of the writer
+    void attach();
+    // drain, and shutdown if no other user is attached
+    void detach();
+
+    // true if the writer thread is running
+    bool is_active();
+    // number of tasks that are queued or running
+    int  in_flight();
+
+    // mpi communicator (fortran handle) for tasks.
+    // must be called from the main thread, on all ranks
+    int  mpi_comm_id();
+
+    // wraps a task that issues collectives on mpi_comm_id. If the task
+    // fails with more than one rank, the error is reported and the job
+    // is aborted, since the other ranks would wait in the collective
+    // forever. Otherwise the error is reported like any other task error.
+    static Task collective(Task task, int mpi_comm_id);
+
+private:
+    AsyncWriter();
+    ~AsyncWriter();
+    AsyncWriter(const AsyncWriter &) = delete;
+    AsyncWriter &operator=(const AsyncWriter &) = delete;
+
+    void start();
+    void worker();
+    // throws errors recorded by tasks, must hold no locks
+    void check_errors();
+
+    std::thread              m_thread;
+    std::mutex               m_mutex;
+    std::condition_variable  m_cond;
+    std::deque<Task>         m_tasks;
+    std::vector<std::string> m_errors;
+    int                      m_running;
+    int                      m_users;
+    bool                     m_active;
+    bool                     m_stop;
+    int                      m_comm_id;
+    int                      m_source_comm_id;
+};
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
@@ -11,6 +11,7 @@
 //-----------------------------------------------------------------------------
 
 #include "ascent_block_timer.hpp"
+#include <flow_trace.hpp>
 #include <climits>
 #include <math.h>
 #include <stdio.h>
@@ -103,6 +104,8 @@ BlockTimer::Start(const std::string &name)
 
     ++s_global_depth;
 
+    flow::Trace::begin(name, "ascent");
+
     if (s_global_depth <= MAX_DEPTH)
     {
         s_current_path += "children/" + name + "/";
@@ -124,6 +127,8 @@ BlockTimer::Stop(const std::string &name)
 #ifdef ASCENT_MPI_ENABLED
     //MPI_Barrier(MPI_COMM_WORLD);
 #endif
+    flow::Trace::end(name, "ascent");
+
     if (s_global_depth <= MAX_DEPTH)
     {
         // Record timer.
@@ -98,9 +98,41 @@ DataLogger::write_log()
 #endif
 }
 
+void
+DataLogger::trace_value(const std::string &key, double value)
+{
+  if(!flow::Trace::enabled())
+  {
+    return;
+  }
+
+  if(!m_trace_entries.empty() && key == "bytes")
+  {
+    m_trace_entries.back().m_bytes = static_cast<conduit::int64>(value);
+  }
+  else if(!m_trace_entries.empty() && key == "cells")
+  {
+    m_trace_entries.back().m_cells = static_cast<conduit::int64>(value);
+  }
+  else
+  {
+    flow::Trace::counter(key, value, "ascent");
+  }
+}
+
 void
 DataLogger::open_entry(const std::string &entryName)
 {
+  if(flow::Trace::enabled())
+  {
+    TraceEntry entry;
+    entry.m_name  = entryName;
+    entry.m_bytes = -1;
+    entry.m_cells = -1;
+    m_trace_entries.push_back(entry);
+    flow::Trace::begin(entryName, "ascent");
+  }
+
 #ifdef ASCENT_LOGGING_ENABLED
     write_indent();
     // ensure that we have unique keys for valid yaml
@@ -129,6 +161,17 @@ DataLogger::open_entry(const std::string &entryName)
 void
 DataLogger::close_entry()
 {
+  if(!m_trace_entries.empty())
+  {
+    const TraceEntry &entry = m_trace_entries.back();
+    flow::Trace::end(entry.m_name,
+                     "ascent",
+                     -1,
+                     entry.m_bytes,
+                     entry.m_cells);
+    m_trace_entries.pop_back();
+  }
+
 #ifdef ASCENT_LOGGING_ENABLED
   write_indent();
   this->m_stream<<"time : "<<Timers.top().elapsed()<<"\n";
@@ -3,11 +3,14 @@
 
 #include <ascent_exports.h>
 #include <flow_timer.hpp>
+#include <flow_trace.hpp>
 
 #include <string>
 #include <stack>
 #include <map>
 #include <sstream>
+#include <type_traits>
+#include <vector>
 
 //from rover logging
 namespace ascent
@@ -39,6 +42,7 @@ public:
     write_indent();
     this->m_stream << key << ": " << value <<"\n";
     m_at_block_start = false;
+    trace_data(key, value, typename std::is_arithmetic<T>::type());
   }
 
   std::stringstream& stream() { return m_stream; }
@@ -56,6 +60,31 @@ protected:
   std::stack<std::map<std::string,int>> m_key_counters;
   bool m_at_block_start;
   int m_rank;
+
+  // entries are also recorded as flow::Trace events. "bytes" and "cells"
+  // are attached to the entry's end event, other numbers become counters
+  struct TraceEntry
+  {
+    std::string    m_name;
+    conduit::int64 m_bytes;
+    conduit::int64 m_cells;
+  };
+
+  void trace_value(const std::string &key, double value);
+
+  template<typename T>
+  void trace_data(const std::string &key, const T &value, std::true_type)
+  {
+    trace_value(key, static_cast<double>(value));
+  }
+
+  template<typename T>
+  void trace_data(const std::string &, const T &, std::false_type)
+  {
+    // only numbers are traced
+  }
+
+  std::vector<TraceEntry> m_trace_entries;
 };
 
 #define ASCENT_DATA_OPEN(key) ascent::DataLogger::instance()->open_entry(key);
@@ -16,10 +16,15 @@
 #include <ascent_config.h>
 #include <ascent_logging.hpp>
 #include <ascent_resources.hpp>
+#include <png_utils/ascent_png_encoder.hpp>
+#include <png_utils/ascent_qoi_decoder.hpp>
 
 // thirdparty includes
 #include <lodepng.h>
 
+#include <algorithm>
+#include <vector>
+
 // conduit includes
 #include <conduit_relay.hpp>
 
@@ -65,10 +70,107 @@ web_client_root_directory()
     return web_root;
 }
 
+//-----------------------------------------------------------------------------
+// -- begin ascent::detail --
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+//-----------------------------------------------------------------------------
+// conduit does not tell us when a connection closes and another one opens
+// (the new socket may even live at the old address), so every n-th message
+// is sent in full to bring clients that could not apply deltas up to date
+//-----------------------------------------------------------------------------
+const int full_message_interval = 10;
+
+//-----------------------------------------------------------------------------
+void
+message_delta(const Node &curr,
+              const Node &prev,
+              const std::string &path,
+              Node &update,
+              Node &remove)
+{
+    if(curr.dtype().is_object() && prev.dtype().is_object())
+    {
+        NodeConstIterator itr = curr.children();
+        while(itr.has_next())
+        {
+            const Node &child = itr.next();
+            const std::string name = itr.name();
+            if(!prev.has_child(name))
+            {
+                update[name].set(child);
+                continue;
+            }
+
+            Node child_update;
+            message_delta(child,
+                          prev[name],
+                          path + name + "/",
+                          child_update,
+                          remove);
+            if(!child_update.dtype().is_empty())
+            {
+                update[name].move(child_update);
+            }
+        }
+
+        itr = prev.children();
+        while(itr.has_next())
+        {
+            itr.next();
+            if(!curr.has_child(itr.name()))
+            {
+                remove.append() = path + itr.name();
+            }
+        }
+    }
+    else
+    {
+        Node info;
+        if(curr.diff(prev, info, 0.0))
+        {
+            update.set(curr);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::detail --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+WebInterface::MessageDelta(const Node &curr,
+                           const Node &prev,
+                           Node &delta)
+{
+    delta.reset();
+    Node update;
+    Node remove(DataType::list());
+    detail::message_delta(curr, prev, "", update, remove);
+
+    if(!update.dtype().is_empty())
+    {
+        delta["update"].move(update);
+    }
+
+    if(remove.number_of_children() > 0)
+    {
+        delta["remove"].move(remove);
+    }
+}
+
 #ifdef ASCENT_WEBSERVER_ENABLED
 //-----------------------------------------------------------------------------
 WebInterface::WebInterface()
 :m_enabled(false),
+ m_last_wsock(NULL),
+ m_last_msg_id(0),
+ m_msgs_since_full(0),
  m_ms_poll(100),
  m_ms_timeout(100),
  m_doc_root("")
@@ -107,6 +209,13 @@ WebInterface::Enable()
     m_enabled = true;
 }
 
+//-----------------------------------------------------------------------------
+bool
+WebInterface::Enabled() const
+{
+    return m_enabled;
+}
+
 //-----------------------------------------------------------------------------
 WebSocket *
 WebInterface::Connection()
@@ -174,13 +283,50 @@ WebInterface::PushMessage(const Node &msg)
         return;
     }
 
-    // sent the message
-    wsock->send(msg);
+    // a new socket gets everything, otherwise only what changed since
+    // the last message. Deltas name the message they apply to, so a
+    // client that does not have it skips them until the next full message
+    const conduit::int64 msg_id = m_last_msg_id + 1;
+    if(wsock != m_last_wsock ||
+       m_msgs_since_full + 1 >= detail::full_message_interval)
+    {
+        Node full_msg;
+        full_msg.set(msg);
+        full_msg["message_id"] = msg_id;
+        wsock->send(full_msg);
+        m_msgs_since_full = 0;
+    }
+    else
+    {
+        Node delta;
+        MessageDelta(msg, m_last_msg, delta);
+        if(delta.dtype().is_empty())
+        {
+            // the client's copy is still current
+            return;
+        }
+        delta["base_id"] = m_last_msg_id;
+        delta["message_id"] = msg_id;
+        wsock->send(delta);
+        m_msgs_since_full++;
+    }
+
+    m_last_wsock = wsock;
+    m_last_msg_id = msg_id;
+    m_last_msg.set(msg);
 }
 
 //-----------------------------------------------------------------------------
 void
 WebInterface::PushRenders(const Node &renders)
+{
+    PushRenders(renders, Node());
+}
+
+//-----------------------------------------------------------------------------
+void
+WebInterface::PushRenders(const Node &renders,
+                          const Node &png_buffers)
 {
     //  Don't do any more work unless we have a valid client connection
     // (also handles case where stream is not enabled)
@@ -197,8 +343,30 @@ WebInterface::PushRenders(const Node &renders)
     while(itr.has_next())
     {
         const Node &curr = itr.next();
-        EncodeImage(curr.as_string(),
-                    msg["renders"].append());
+        const std::string image_name = curr.as_string();
+
+        const Node *png = NULL;
+        NodeConstIterator buffers_itr = png_buffers.children();
+        while(buffers_itr.has_next() && png == NULL)
+        {
+            const Node &buffer = buffers_itr.next();
+            if(buffer["image_name"].as_string() == image_name)
+            {
+                png = &buffer["png"];
+            }
+        }
+
+        if(png != NULL)
+        {
+            EncodePNG(png->data_ptr(),
+                      png->dtype().number_of_elements(),
+                      msg["renders"].append());
+        }
+        else
+        {
+            EncodeImage(image_name,
+                        msg["renders"].append());
+        }
 
     }
 
@@ -214,6 +382,35 @@ WebInterface::EncodeImage(const std::string &png_image_path,
 {
     out.reset();
 
+    // browsers can't show qoi images, so they are sent as png
+    const std::string qoi_ext = ".qoi";
+    if(png_image_path.size() > qoi_ext.size() &&
+       png_image_path.compare(png_image_path.size() - qoi_ext.size(),
+                              qoi_ext.size(),
+                              qoi_ext) == 0)
+    {
+        std::vector<unsigned char> rgba;
+        int width = 0;
+        int height = 0;
+        QOIDecoder decoder;
+        decoder.Decode(rgba, width, height, png_image_path);
+
+        // the encoder wants the bottom row first
+        const size_t row_size = (size_t)width * 4;
+        std::vector<unsigned char> flipped(rgba.size());
+        for(int y = 0; y < height; ++y)
+        {
+            std::copy(rgba.begin() + y * row_size,
+                      rgba.begin() + (y + 1) * row_size,
+                      flipped.begin() + (height - 1 - y) * row_size);
+        }
+
+        PNGEncoder encoder;
+        encoder.Encode(&flipped[0], width, height);
+        EncodePNG(encoder.PngBuffer(), encoder.PngBufferSize(), out);
+        return;
+    }
+
     std::ifstream file(png_image_path.c_str(),
                        std::ios::binary);
 
@@ -234,14 +431,26 @@ WebInterface::EncodeImage(const std::string &png_image_path,
         ASCENT_WARN("ERROR Reading png file " << png_image_path);
     }
 
+    EncodePNG(png_raw_ptr, png_raw_bytes, out);
+}
+
+//-----------------------------------------------------------------------------
+void
+WebInterface::EncodePNG(const void *png_data,
+                        size_t png_bytes,
+                        conduit::Node &out)
+{
+    out.reset();
+
     // base64 encode the raw png data
-    png_data["encoded"].set(DataType::char8_str(png_raw_bytes*2));
+    Node encoded;
+    encoded.set(DataType::char8_str(png_bytes*2));
 
-    utils::base64_encode(png_raw_ptr,
-                         png_raw_bytes,
-                         png_data["encoded"].data_ptr());
+    utils::base64_encode(png_data,
+                         png_bytes,
+                         encoded.data_ptr());
 
-    out["data"] = "data:image/png;base64," + png_data["encoded"].as_string();
+    out["data"] = "data:image/png;base64," + encoded.as_string();
 }
 
 //-----------------------------------------------------------------------------
@@ -280,6 +489,13 @@ void
 WebInterface::Enable()
 {}
 
+//-----------------------------------------------------------------------------
+bool
+WebInterface::Enabled() const
+{
+    return false;
+}
+
 //-----------------------------------------------------------------------------
 void
 WebInterface::PushMessage(const Node &msg)
@@ -290,6 +506,12 @@ void
 WebInterface::PushRenders(const Node &renders)
 {}
 
+//-----------------------------------------------------------------------------
+void
+WebInterface::PushRenders(const Node &renders,
+                          const Node &png_buffers)
+{}
+
 //-----------------------------------------------------------------------------
 #endif // end #ifdef ASCENT_WEBSERVER_ENABLED
 //-----------------------------------------------------------------------------
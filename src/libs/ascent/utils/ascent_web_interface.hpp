@@ -50,9 +50,25 @@ public:
     void                            SetTimeout(int ms_timeout);
 
     void                            Enable();
+    bool                            Enabled() const;
 
+    // After the first message on a connection, only the entries that
+    // changed since the last message are sent (see MessageDelta), along
+    // with the ids of the message they apply to ("base_id") and of the
+    // new message ("message_id"). Full messages carry "message_id" and
+    // are resent periodically.
     void                            PushMessage(const conduit::Node &msg);
     void                            PushRenders(const conduit::Node &renders);
+    // png_buffers is a list of {"image_name", "png"} entries holding
+    // already encoded images, renders found there are not read from disk
+    void                            PushRenders(const conduit::Node &renders,
+                                                const conduit::Node &png_buffers);
+
+    // delta["update"] holds the entries of curr that are new or differ
+    // from prev, delta["remove"] lists the paths of prev missing in curr
+    static void                     MessageDelta(const conduit::Node &curr,
+                                                 const conduit::Node &prev,
+                                                 conduit::Node &delta);
 
 private:
 #ifdef ASCENT_WEBSERVER_ENABLED
@@ -60,7 +76,14 @@ private:
 
     void                            EncodeImage(const std::string &png_file_path,
                                                 conduit::Node &out);
+    void                            EncodePNG(const void *png_data,
+                                              size_t png_bytes,
+                                              conduit::Node &out);
     bool                            m_enabled;
+    conduit::relay::web::WebSocket *m_last_wsock;
+    conduit::int64                  m_last_msg_id;
+    int                             m_msgs_since_full;
+    conduit::Node                   m_last_msg;
     conduit::relay::web::WebServer  m_server;
     int                             m_ms_poll;
     int                             m_ms_timeout;
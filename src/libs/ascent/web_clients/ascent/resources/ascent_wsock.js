@@ -33,9 +33,51 @@ function highlight_json(json)
     });
 }
 
+/*
+apply an info delta ({update: {...}, remove: ["a/b", ...]}) to the
+current state
+*/
+function merge_json(state, update)
+{
+    for (var key in update)
+    {
+        if (update[key] !== null && typeof update[key] == 'object' &&
+            !Array.isArray(update[key]) &&
+            state[key] !== null && typeof state[key] == 'object' &&
+            !Array.isArray(state[key]))
+        {
+            merge_json(state[key], update[key]);
+        }
+        else
+        {
+            state[key] = update[key];
+        }
+    }
+}
+
+function remove_json_path(state, path)
+{
+    var parts = path.split("/");
+    var curr = state;
+    for (var i = 0; i < parts.length - 1; i++)
+    {
+        curr = curr[parts[i]];
+        if (curr === undefined || curr === null)
+        {
+            return;
+        }
+    }
+    delete curr[parts[parts.length - 1]];
+}
+
 function ascent_websocket_client()
 {
     var num_msgs = 0;
+    // last full info message, deltas are applied to this
+    var state = {};
+    // id of the message state matches, deltas for other messages
+    // are skipped until the next full message
+    var state_id = -1;
     var wsproto = (location.protocol === 'https:') ? 'wss:' : 'ws:';
     connection = new WebSocket(wsproto + '//' + window.location.host + '/websocket');
 
@@ -56,9 +98,32 @@ function ascent_websocket_client()
         num_msgs+=1;
         $("#status").html("# msgs: " +  num_msgs.toString());
 
-        if(msg.info)
+        if(msg.update || msg.remove)
+        {
+            if(msg.base_id !== state_id)
+            {
+                return;
+            }
+            state_id = msg.message_id;
+            if(msg.update)
+            {
+                merge_json(state, msg.update);
+            }
+            if(msg.remove)
+            {
+                for (var i = 0; i < msg.remove.length; i++)
+                {
+                    remove_json_path(state, msg.remove[i]);
+                }
+            }
+            $("#info").html(highlight_json(state));
+        }
+        else if(msg.info)
         {
-            $("#info").html(highlight_json(msg));
+            state_id = msg.message_id;
+            delete msg.message_id;
+            state = msg;
+            $("#info").html(highlight_json(state));
         }
 
         if(msg.renders)
@@ -70,6 +70,11 @@ template <typename T> T Array<T>::get_value (const int32 i) const
   return m_internals->get_value (i);
 }
 
+template <typename T> uint64 Array<T>::version () const
+{
+  return m_internals->version ();
+}
+
 // Type Explicit instatiations
 template class Array<int8>;
 template class Array<uint8>;
@@ -36,6 +36,9 @@ template <typename T> class Array
   // host and device
   T get_value (const int32 i) const;
   Array<T> copy ();
+  // changes whenever the data may have been written, and differs
+  // between arrays, so an unchanged version means unchanged data
+  uint64 version () const;
 
   protected:
   std::shared_ptr<ArrayInternals<T>> m_internals;
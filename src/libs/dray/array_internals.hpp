@@ -153,6 +153,7 @@ template <typename T> class ArrayInternals : public ArrayInternalsBase
     memcpy (m_host, data, sizeof (T) * m_size);
     m_device_dirty = true;
     m_host_dirty = true;
+    touch ();
   }
 
   size_t size () const
@@ -171,6 +172,7 @@ template <typename T> class ArrayInternals : public ArrayInternalsBase
     deallocate_host ();
     deallocate_device ();
     m_size = size;
+    touch ();
   }
 
   T *get_device_ptr ()
@@ -194,6 +196,7 @@ template <typename T> class ArrayInternals : public ArrayInternalsBase
     // indicate that the device has the most recent data
     m_host_dirty = true;
     m_device_dirty = false;
+    touch ();
     return m_device;
   }
 
@@ -243,6 +246,7 @@ template <typename T> class ArrayInternals : public ArrayInternalsBase
     // indicate that the host has the most recent data
     m_device_dirty = true;
     m_host_dirty = false;
+    touch ();
 
     return m_host;
   }
@@ -6,11 +6,20 @@
 #include <dray/array_internals_base.hpp>
 #include <dray/array_registry.hpp>
 
+#include <atomic>
+
 namespace dray
 {
 
+namespace detail
+{
+// stamps are never reused, so equal stamps mean the same unmodified array
+std::atomic<uint64> array_version_counter (0);
+} // namespace detail
+
 ArrayInternalsBase::ArrayInternalsBase ()
 {
+  touch ();
   ArrayRegistry::add_array (this);
 }
 
@@ -19,4 +28,14 @@ ArrayInternalsBase::~ArrayInternalsBase ()
   ArrayRegistry::remove_array (this);
 }
 
+uint64 ArrayInternalsBase::version () const
+{
+  return m_version;
+}
+
+void ArrayInternalsBase::touch ()
+{
+  m_version = ++detail::array_version_counter;
+}
+
 } // namespace dray
@@ -6,6 +6,8 @@
 #ifndef DRAY_ARRAY_INTERNALS_BASE_HPP
 #define DRAY_ARRAY_INTERNALS_BASE_HPP
 
+#include <dray/types.hpp>
+
 #include <stddef.h>
 
 namespace dray
@@ -19,6 +21,13 @@ class ArrayInternalsBase
   virtual void release_device_ptr () = 0;
   virtual size_t device_alloc_size () = 0;
   virtual size_t host_alloc_size () = 0;
+  // process unique stamp that changes every time the data may have been
+  // written (allocation, resize, set or a non-const pointer request)
+  uint64 version () const;
+
+  protected:
+  void touch ();
+  uint64 m_version;
 };
 
 } // namespace dray
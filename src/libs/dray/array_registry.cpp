@@ -216,6 +216,57 @@ ArrayRegistry::summary()
 
 }
 
+// the pool accessors below report 0 for a pool that was never created,
+// rather than creating it just to ask for its size
+
+size_t ArrayRegistry::host_pool_size()
+{
+  if(m_host_allocator_id == -1)
+  {
+    return 0;
+  }
+  auto &rm = umpire::ResourceManager::getInstance ();
+  return rm.getAllocator(m_host_allocator_id).getCurrentSize();
+}
+
+size_t ArrayRegistry::host_pool_high_water()
+{
+  if(m_host_allocator_id == -1)
+  {
+    return 0;
+  }
+  auto &rm = umpire::ResourceManager::getInstance ();
+  return rm.getAllocator(m_host_allocator_id).getHighWatermark();
+}
+
+size_t ArrayRegistry::device_pool_size()
+{
+#if defined(DRAY_DEVICE_ENABLED)
+  if(m_device_allocator_id == -1)
+  {
+    return 0;
+  }
+  auto &rm = umpire::ResourceManager::getInstance ();
+  return rm.getAllocator(m_device_allocator_id).getCurrentSize();
+#else
+  return 0;
+#endif
+}
+
+size_t ArrayRegistry::device_pool_high_water()
+{
+#if defined(DRAY_DEVICE_ENABLED)
+  if(m_device_allocator_id == -1)
+  {
+    return 0;
+  }
+  auto &rm = umpire::ResourceManager::getInstance ();
+  return rm.getAllocator(m_device_allocator_id).getHighWatermark();
+#else
+  return 0;
+#endif
+}
+
 int ArrayRegistry::number_of_arrays()
 {
   return static_cast<int>(m_arrays.size());
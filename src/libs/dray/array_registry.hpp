@@ -25,6 +25,12 @@ class ArrayRegistry
     static int    number_of_arrays();
     // print summary of arrays and umpire usage to std out
     static void   summary();
+    // current size and high water mark of the umpire pools,
+    // 0 for a pool that has not been created yet
+    static size_t host_pool_size();
+    static size_t host_pool_high_water();
+    static size_t device_pool_size();
+    static size_t device_pool_high_water();
 
     // memory allocators
     // host alloc
@@ -692,6 +692,34 @@ array_unique_values(const Array<T> &input)
   return array_unique_values_inplace(temp_array);
 }
 
+// Hash of the 32-bit words of the array, continuing from hash. Every word
+// is mixed with its index and the results are summed, so it is computed
+// where the data lives in a single pass without copying it back.
+template<typename T>
+static inline uint64
+array_hash(const Array<T> &input, uint64 hash = 14695981039346656037ULL)
+{
+  static_assert(sizeof(T) % sizeof(uint32) == 0,
+                "array_hash needs a whole number of 32-bit words");
+  const int32 words = int32(input.size() * (sizeof(T) / sizeof(uint32)));
+  const uint32 *ptr = reinterpret_cast<const uint32*>(input.get_device_ptr_const());
+  const uint64 seed = hash ^ (uint64(words) * 0x9e3779b97f4a7c15ULL);
+  RAJA::ReduceSum<reduce_policy, uint64> sum(0);
+
+  RAJA::forall<for_policy>(RAJA::RangeSegment(0, words), [=] DRAY_LAMBDA (int32 i)
+  {
+    // splitmix64 finalizer
+    uint64 x = seed + (uint64(i) << 32) + uint64(ptr[i]);
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    x = x ^ (x >> 31);
+    sum += x;
+  });
+  DRAY_ERROR_CHECK();
+
+  return seed ^ sum.get();
+}
+
 #ifdef DRAY_CUDA_ENABLED
 inline __device__ Vec<float32, 4> const_get_vec4f (const Vec<float32, 4> *const data)
 {
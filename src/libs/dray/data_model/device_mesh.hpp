@@ -38,7 +38,9 @@ template <class ElemT> struct DeviceMesh
   static constexpr auto dim = ElemT::get_dim ();
   static constexpr auto etype = ElemT::get_etype ();
 
-  DeviceMesh (UnstructuredMesh<ElemT> &mesh, bool use_bvh = true);
+  DeviceMesh (UnstructuredMesh<ElemT> &mesh,
+              bool use_bvh = true,
+              bool use_face_neighbors = false);
   DeviceMesh () = delete;
 
   //TODO use a DeviceGridFunction
@@ -52,6 +54,9 @@ template <class ElemT> struct DeviceMesh
   // if the element was subdivided m_ref_boxs
   // contains the sub-ref box of the original element
   // TODO: this should be married with BVH
+  // faces_per_elem neighbors for each element, null unless
+  // requested at construction
+  const int32 *m_face_neighbors;
 
   DRAY_EXEC_ONLY typename AdaptGetOrderPolicy<ElemT>::type get_order_policy() const
   {
@@ -60,6 +65,23 @@ template <class ElemT> struct DeviceMesh
 
   DRAY_EXEC_ONLY ElemT get_elem (int32 el_idx) const;
   DRAY_EXEC_ONLY Location locate (const Vec<Float, 3> &point) const;
+  // For points close to the previous one (e.g. samples along a ray).
+  // Tries the hint cell first, starting newton at the hint's reference
+  // point, then walks a few face neighbors before falling back to the bvh.
+  DRAY_EXEC_ONLY Location locate (const Vec<Float, 3> &point,
+                                  const Location &hint) const;
+  // The hint cell and face neighbor walk of locate(point, hint), without
+  // the bvh fallback. Returns cell id -1 if the walk did not find the point.
+  DRAY_EXEC_ONLY Location walk (const Vec<Float, 3> &point,
+                                const Location &hint) const;
+  // Newton inversion of element el_idx, starting at ref_coords.
+  DRAY_EXEC_ONLY bool invert (const int32 el_idx,
+                              const Vec<Float, 3> &point,
+                              Vec<Float, dim> &ref_coords) const;
+  // Calls leaf(el_idx, ref_box_id) for every bvh leaf whose box contains
+  // the point, in traversal order, until leaf returns true.
+  template <typename LeafFunctor>
+  DRAY_EXEC_ONLY void traverse (const Vec<Float, 3> &point, LeafFunctor &leaf) const;
 };
 
 
@@ -68,14 +90,22 @@ template <class ElemT> struct DeviceMesh
 // ------------------ //
 
 template <class ElemT>
-DeviceMesh<ElemT>::DeviceMesh (UnstructuredMesh<ElemT> &mesh, bool use_bvh)
+DeviceMesh<ElemT>::DeviceMesh (UnstructuredMesh<ElemT> &mesh,
+                               bool use_bvh,
+                               bool use_face_neighbors)
 : m_idx_ptr (mesh.m_dof_data.m_ctrl_idx.get_device_ptr_const ()),
   m_val_ptr (mesh.m_dof_data.m_values.get_device_ptr_const ()),
   m_poly_order (mesh.m_poly_order),
   // hack to get around that constructing the bvh needs the device mesh
   m_bvh (use_bvh ? mesh.get_bvh(): BVH()),
-  m_ref_boxs (mesh.m_ref_aabbs.get_device_ptr_const ())
+  m_ref_boxs (mesh.m_ref_aabbs.get_device_ptr_const ()),
+  m_face_neighbors (nullptr)
 {
+  // building the face neighbors also needs a device mesh
+  if (use_face_neighbors && mesh.get_face_neighbors ().size () > 0)
+  {
+    m_face_neighbors = mesh.m_face_neighbors.get_device_ptr_const ();
+  }
 }
 
 template <class ElemT>
@@ -244,15 +274,156 @@ template <> struct LocateHack<2>
     return eval_inverse(elem, stats, world_coords, guess_domain, ref_coords, use_init_guess);
   }
 };
+//
+// exit_face(): the face (numbered as in extract_faces()) a newton
+// iterate that ended outside of the element is furthest beyond, or -1.
+// ref_coords is moved to a starting guess for the neighbor across it.
+//
+template <int32 dim>
+DRAY_EXEC int32 exit_face (const RefSpaceTag<dim, ElemType::Tensor>,
+                           Vec<Float, dim> &ref_coords)
+{
+  int32 face = -1;
+  Float max_dist = 0.f;
+  for (int32 d = 0; d < dim; ++d)
+  {
+    if (-ref_coords[d] > max_dist)
+    {
+      max_dist = -ref_coords[d];
+      face = d;
+    }
+    if (ref_coords[d] - 1.f > max_dist)
+    {
+      max_dist = ref_coords[d] - 1.f;
+      face = d + 3;
+    }
+  }
+
+  if (face != -1)
+  {
+    // assume the neighbor has the same orientation, the clamp
+    // keeps the guess inside the element if it does not
+    const int32 axis = face % 3;
+    ref_coords[axis] += face < 3 ? 1.f : -1.f;
+    for (int32 d = 0; d < dim; ++d)
+    {
+      ref_coords[d] = fminf(Float(1.f), fmaxf(ref_coords[d], Float(0.f)));
+    }
+  }
+  return face;
+}
+
+template <int32 dim>
+DRAY_EXEC int32 exit_face (const RefSpaceTag<dim, ElemType::Simplex>,
+                           Vec<Float, dim> &ref_coords)
+{
+  // faces 0..dim-1 are opposite the vertex on that axis (ref_coords[d] = 0),
+  // face dim is opposite the origin
+  int32 face = -1;
+  Float max_dist = 0.f;
+  Float sum = 0.f;
+  for (int32 d = 0; d < dim; ++d)
+  {
+    sum += ref_coords[d];
+    if (-ref_coords[d] > max_dist)
+    {
+      max_dist = -ref_coords[d];
+      face = d;
+    }
+  }
+  if (sum - 1.f > max_dist)
+  {
+    face = dim;
+  }
+
+  if (face != -1)
+  {
+    // no shared orientation to exploit, start at the centroid
+    for (int32 d = 0; d < dim; ++d)
+    {
+      ref_coords[d] = 1.f / Float(dim + 1);
+    }
+  }
+  return face;
+}
+
 } // namespace detail
 
 template <class ElemT>
-DRAY_EXEC_ONLY Location DeviceMesh<ElemT>::locate (const Vec<Float, 3> &point) const
+DRAY_EXEC_ONLY bool DeviceMesh<ElemT>::invert (const int32 el_idx,
+                                               const Vec<Float, 3> &point,
+                                               Vec<Float, dim> &ref_coords) const
+{
+  // only used when newton has no initial guess
+  const SubRef<dim, etype> ref_box = ref_universe (RefSpaceTag<dim, etype>{});
+  return detail::LocateHack<ElemT::get_dim ()>::template eval_inverse<ElemT> (
+  get_elem (el_idx), point, ref_box, ref_coords, true);
+}
+
+template <class ElemT>
+DRAY_EXEC_ONLY Location DeviceMesh<ElemT>::locate (const Vec<Float, 3> &point,
+                                                   const Location &hint) const
 {
-  constexpr auto etype = ElemT::get_etype ();  //TODO use type trait instead
+  Location loc = walk (point, hint);
+  if (loc.m_cell_id == -1)
+  {
+    loc = locate (point);
+  }
+  return loc;
+}
+
+template <class ElemT>
+DRAY_EXEC_ONLY Location DeviceMesh<ElemT>::walk (const Vec<Float, 3> &point,
+                                                 const Location &hint) const
+{
+  constexpr auto etype = ElemT::get_etype ();
+  constexpr int32 faces_per_elem = etype == ElemType::Tensor ? 2 * dim : dim + 1;
+  // neighbors visited before giving up on the walk
+  constexpr int32 max_walk = 4;
+
+  int32 el_idx = hint.m_cell_id;
+  Vec<Float, dim> el_coords;
+  for (int32 d = 0; d < dim; ++d)
+  {
+    el_coords[d] = hint.m_ref_pt[d];
+  }
+
+  for (int32 step = 0; step <= max_walk && el_idx != -1; ++step)
+  {
+    if (invert (el_idx, point, el_coords))
+    {
+      Location loc{ el_idx, { -1.f, -1.f, -1.f } };
+      loc.m_ref_pt[0] = el_coords[0];
+      loc.m_ref_pt[1] = el_coords[1];
+      if (dim == 3)
+      {
+        loc.m_ref_pt[2] = el_coords[2];
+      }
+      return loc;
+    }
 
-  Location loc{ -1, { -1.f, -1.f, -1.f } };
+    if (m_face_neighbors == nullptr)
+    {
+      break;
+    }
 
+    const int32 face = detail::exit_face (RefSpaceTag<dim, etype>{}, el_coords);
+    if (face == -1)
+    {
+      // newton failed inside the element
+      break;
+    }
+    el_idx = m_face_neighbors[el_idx * faces_per_elem + face];
+  }
+
+  return Location{ -1, { -1.f, -1.f, -1.f } };
+}
+
+template <class ElemT>
+template <typename LeafFunctor>
+DRAY_EXEC_ONLY void DeviceMesh<ElemT>::traverse (const Vec<Float, 3> &point,
+                                                 LeafFunctor &leaf) const
+{
   int32 todo[64];
   int32 current_node = 0;
   int32 stackptr = 0;
@@ -325,25 +496,8 @@ DRAY_EXEC_ONLY Location DeviceMesh<ElemT>::locate (const Vec<Float, 3> &point) c
       current_node = -current_node - 1; // swap the neg address
       const int32 el_idx = m_bvh.m_leaf_nodes[current_node];
       const int32 ref_box_id = m_bvh.m_aabb_ids[current_node];
-      SubRef<dim, etype> ref_start_box = m_ref_boxs[ref_box_id];
-      bool use_init_guess = true;
-      // locate the point
-
-      Vec<Float, dim> el_coords;
-
-      bool found;
-      found = detail::LocateHack<ElemT::get_dim ()>::template eval_inverse<ElemT> (
-      get_elem (el_idx), point, ref_start_box, el_coords, use_init_guess);
-
-      if (found)
+      if (leaf (el_idx, ref_box_id))
       {
-        loc.m_cell_id = el_idx;
-        loc.m_ref_pt[0] = el_coords[0];
-        loc.m_ref_pt[1] = el_coords[1];
-        if (dim == 3)
-        {
-          loc.m_ref_pt[2] = el_coords[2];
-        }
         break;
       }
 
@@ -351,8 +505,48 @@ DRAY_EXEC_ONLY Location DeviceMesh<ElemT>::locate (const Vec<Float, 3> &point) c
       stackptr--;
     }
   } // while
+}
 
-  return loc;
+namespace detail
+{
+
+// newton on each candidate element until one holds the point
+template <class ElemT> struct LocateLeaf
+{
+  static constexpr auto dim = ElemT::get_dim ();
+  static constexpr auto etype = ElemT::get_etype ();
+
+  const DeviceMesh<ElemT> &m_mesh;
+  const Vec<Float, 3> m_point;
+  Location m_loc;
+
+  DRAY_EXEC_ONLY bool operator() (const int32 el_idx, const int32 ref_box_id)
+  {
+    // start newton at the center of the leaf's reference box
+    Vec<Float, dim> el_coords = subref_center (m_mesh.m_ref_boxs[ref_box_id]);
+    if (!m_mesh.invert (el_idx, m_point, el_coords))
+    {
+      return false;
+    }
+    m_loc.m_cell_id = el_idx;
+    m_loc.m_ref_pt[0] = el_coords[0];
+    m_loc.m_ref_pt[1] = el_coords[1];
+    if (dim == 3)
+    {
+      m_loc.m_ref_pt[2] = el_coords[2];
+    }
+    return true;
+  }
+};
+
+} // namespace detail
+
+template <class ElemT>
+DRAY_EXEC_ONLY Location DeviceMesh<ElemT>::locate (const Vec<Float, 3> &point) const
+{
+  detail::LocateLeaf<ElemT> leaf{ *this, point, { -1, { -1.f, -1.f, -1.f } } };
+  traverse (point, leaf);
+  return leaf.m_loc;
 }
 
 } // namespace dray
@@ -32,6 +32,16 @@ public:
   virtual int32 dims() const = 0;
   virtual AABB<3> bounds() = 0;
   virtual Array<Location> locate (Array<Vec<Float, 3>> &wpoints) = 0;
+  // locate starting from a guess for each point (e.g. where the point was
+  // found on the previous cycle), guesses with cell id -1 are searched
+  virtual Array<Location> locate (Array<Vec<Float, 3>> &wpoints,
+                                  const Array<Location> &guesses) = 0;
+  // hash of the connectivity and control points, for telling when
+  // results that only depend on the geometry can be reused
+  virtual uint64 hash() = 0;
+  // cheap check to try before hash(): unchanged while neither the
+  // connectivity nor the control points are written or replaced
+  virtual uint64 version() const = 0;
   virtual void to_node(conduit::Node &n_topo) = 0;
 };
 
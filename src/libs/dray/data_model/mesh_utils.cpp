@@ -398,6 +398,61 @@ Array<Vec<int32, 2>> reconstruct (Array<int32> &orig_ids)
   return face_ids;
 }
 
+Array<int32> face_neighbors (Array<Vec<int32, 4>> &faces, const int32 faces_per_elem)
+{
+  const int32 size = faces.size ();
+
+  Array<int32> neighbors;
+  neighbors.resize (size);
+  array_memset (neighbors, -1);
+
+  if (size == 0)
+  {
+    return neighbors;
+  }
+
+  Array<int32> orig_ids = sort_faces (faces);
+
+  const Vec<int32, 4> *faces_ptr = faces.get_device_ptr_const ();
+  const int32 *orig_ids_ptr = orig_ids.get_device_ptr_const ();
+  int32 *neighbors_ptr = neighbors.get_device_ptr ();
+
+  RAJA::forall<for_policy> (RAJA::RangeSegment (0, size - 1), [=] DRAY_LAMBDA (int32 i) {
+    // we assume everthing is sorted and there can be at most
+    // two faces that can be shared
+    if (is_same (faces_ptr[i], faces_ptr[i + 1]))
+    {
+      const int32 a = orig_ids_ptr[i];
+      const int32 b = orig_ids_ptr[i + 1];
+      neighbors_ptr[a] = b / faces_per_elem;
+      neighbors_ptr[b] = a / faces_per_elem;
+    }
+  });
+  DRAY_ERROR_CHECK();
+
+  return neighbors;
+}
+
+template <int32 ncomp, int32 P>
+Array<int32> face_neighbors (UnstructuredMesh<Element<3, ncomp, ElemType::Tensor, P>> &mesh)
+{
+  Array<Vec<int32, 4>> faces = extract_faces (mesh);
+  return face_neighbors (faces, 6);
+}
+
+template <int32 ncomp, int32 P>
+Array<int32> face_neighbors (UnstructuredMesh<Element<3, ncomp, ElemType::Simplex, P>> &mesh)
+{
+  Array<Vec<int32, 4>> faces = extract_faces (mesh);
+  return face_neighbors (faces, 4);
+}
+
+template <int32 ncomp, ElemType etype, int32 P>
+Array<int32> face_neighbors (UnstructuredMesh<Element<2, ncomp, etype, P>> &mesh)
+{
+  return Array<int32> ();
+}
+
 // TODO
 /// template<typename T, class ElemT>
 /// BVH construct_face_bvh(Mesh<T, ElemT> &mesh, Array<Vec<int32,2>> &faces)
@@ -721,6 +776,38 @@ template Array<Vec<int32, 4>>
 extract_faces(UnstructuredMesh<Element<3, 3, ElemType::Simplex, Order::Quadratic>> &mesh);
 
 
+//
+// face_neighbors();
+//
+template Array<int32>
+face_neighbors(UnstructuredMesh<Element<3, 3, ElemType::Tensor, Order::General>> &mesh);
+template Array<int32>
+face_neighbors(UnstructuredMesh<Element<3, 3, ElemType::Tensor, Order::Linear>> &mesh);
+template Array<int32>
+face_neighbors(UnstructuredMesh<Element<3, 3, ElemType::Tensor, Order::Quadratic>> &mesh);
+
+template Array<int32>
+face_neighbors(UnstructuredMesh<Element<3, 3, ElemType::Simplex, Order::General>> &mesh);
+template Array<int32>
+face_neighbors(UnstructuredMesh<Element<3, 3, ElemType::Simplex, Order::Linear>> &mesh);
+template Array<int32>
+face_neighbors(UnstructuredMesh<Element<3, 3, ElemType::Simplex, Order::Quadratic>> &mesh);
+
+template Array<int32>
+face_neighbors(UnstructuredMesh<Element<2, 3, ElemType::Tensor, Order::General>> &mesh);
+template Array<int32>
+face_neighbors(UnstructuredMesh<Element<2, 3, ElemType::Tensor, Order::Linear>> &mesh);
+template Array<int32>
+face_neighbors(UnstructuredMesh<Element<2, 3, ElemType::Tensor, Order::Quadratic>> &mesh);
+
+template Array<int32>
+face_neighbors(UnstructuredMesh<Element<2, 3, ElemType::Simplex, Order::General>> &mesh);
+template Array<int32>
+face_neighbors(UnstructuredMesh<Element<2, 3, ElemType::Simplex, Order::Linear>> &mesh);
+template Array<int32>
+face_neighbors(UnstructuredMesh<Element<2, 3, ElemType::Simplex, Order::Quadratic>> &mesh);
+
+
 //
 // construct_bvh();   // Tensor
 //
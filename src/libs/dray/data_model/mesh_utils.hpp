@@ -40,6 +40,22 @@ Array<Vec<int32, 4>> extract_faces(UnstructuredMesh<Element<3, ncomp, ElemType::
 
 
 
+// Sorts faces (as returned by extract_faces) and returns, for each
+// face of each element, the id of the element on the other side of
+// the face or -1 on the boundary.
+Array<int32> face_neighbors (Array<Vec<int32, 4>> &faces, const int32 faces_per_elem);
+
+// Face adjacency of a volume mesh, indexed by el_id * faces_per_elem + face_id
+// with the face ids of extract_faces. Surface meshes return an empty array.
+template <int32 ncomp, int32 P>
+Array<int32> face_neighbors (UnstructuredMesh<Element<3, ncomp, ElemType::Tensor, P>> &mesh);
+
+template <int32 ncomp, int32 P>
+Array<int32> face_neighbors (UnstructuredMesh<Element<3, ncomp, ElemType::Simplex, P>> &mesh);
+
+template <int32 ncomp, ElemType etype, int32 P>
+Array<int32> face_neighbors (UnstructuredMesh<Element<2, ncomp, etype, P>> &mesh);
+
 // Returns faces, where faces[i][0] = el_id and 0 <= faces[i][1] = face_id < 6.
 // This allows us to identify the needed dofs for a face mesh.
 template <ElemType etype>
@@ -30,11 +30,22 @@ template <class Element> const BVH UnstructuredMesh<Element>::get_bvh ()
   return m_bvh;
 }
 
+template <class Element> const Array<int32> UnstructuredMesh<Element>::get_face_neighbors ()
+{
+  if(!m_has_face_neighbors)
+  {
+    m_face_neighbors = detail::face_neighbors (*this);
+    m_has_face_neighbors = true;
+  }
+  return m_face_neighbors;
+}
+
 template <class Element>
 UnstructuredMesh<Element>::UnstructuredMesh (const GridFunction<3u> &dof_data, int32 poly_order)
 : m_dof_data (dof_data),
   m_poly_order (poly_order),
-  m_is_constructed(false)
+  m_is_constructed(false),
+  m_has_face_neighbors(false)
 {
   // check to see if this is a valid construction
   if(Element::get_P() != Order::General)
@@ -68,7 +79,9 @@ UnstructuredMesh<Element>::UnstructuredMesh(const UnstructuredMesh &other)
     m_poly_order(other.m_poly_order),
     m_is_constructed(other.m_is_constructed),
     m_bvh(other.m_bvh),
-    m_ref_aabbs(other.m_ref_aabbs)
+    m_ref_aabbs(other.m_ref_aabbs),
+    m_has_face_neighbors(other.m_has_face_neighbors),
+    m_face_neighbors(other.m_face_neighbors)
 {
   // check to see if this is a valid construction
   if(Element::get_P() != Order::General)
@@ -97,7 +110,9 @@ UnstructuredMesh<Element>::UnstructuredMesh(UnstructuredMesh &&other)
     m_poly_order(other.m_poly_order),
     m_is_constructed(other.m_is_constructed),
     m_bvh(other.m_bvh),
-    m_ref_aabbs(other.m_ref_aabbs)
+    m_ref_aabbs(other.m_ref_aabbs),
+    m_has_face_neighbors(other.m_has_face_neighbors),
+    m_face_neighbors(other.m_face_neighbors)
 {
   // check to see if this is a valid construction
   if(Element::get_P() != Order::General)
@@ -120,6 +135,177 @@ UnstructuredMesh<Element>::UnstructuredMesh(UnstructuredMesh &&other)
   }
 }
 
+namespace detail
+{
+
+// solves the first bvh leaf of a point right away, as DeviceMesh::locate
+// would, and only counts the other leaves in case the first one misses
+template <class Element> struct FirstLeaf
+{
+  LocateLeaf<Element> m_locate;
+  bool m_tried;
+  int32 m_count;
+  DRAY_EXEC_ONLY bool operator() (const int32 el_idx, const int32 ref_box_id)
+  {
+    if (!m_tried)
+    {
+      m_tried = true;
+      return m_locate (el_idx, ref_box_id);
+    }
+    ++m_count;
+    return false;
+  }
+};
+
+// records the candidate elements of a point in traversal order,
+// except for the first one FirstLeaf already tried
+struct StoreLeaves
+{
+  int32 *m_elems;
+  int32 *m_boxes;
+  int32 *m_points;
+  int32 m_point;
+  int32 m_skip;
+  int32 m_count;
+  DRAY_EXEC bool operator() (const int32 el_idx, const int32 ref_box_id)
+  {
+    if (m_skip > 0)
+    {
+      --m_skip;
+      return false;
+    }
+    m_elems[m_count] = el_idx;
+    m_boxes[m_count] = ref_box_id;
+    m_points[m_count] = m_point;
+    ++m_count;
+    return false;
+  }
+};
+
+//
+// Locates the points whose location has cell id -1. Each point first
+// tries the first element the bvh gives it, which is where most points
+// are, and stops there if it holds the point. The remaining candidates of
+// the points that missed are located as a batch: they are sorted by
+// element, and the newton solves run in that order so consecutive solves
+// share an element's control points. Of the candidates that hold a point,
+// the first in bvh traversal order wins, as in DeviceMesh::locate.
+//
+template <class Element>
+void locate_batch (UnstructuredMesh<Element> &mesh,
+                   Array<Vec<Float, 3>> &wpoints,
+                   Array<Location> &locations)
+{
+  constexpr int32 dim = Element::get_dim ();
+  constexpr ElemType etype = Element::get_etype ();
+
+  const int32 size = wpoints.size ();
+  DeviceMesh<Element> device_mesh (mesh);
+  const Vec<Float, 3> *points_ptr = wpoints.get_device_ptr_const ();
+  Location *loc_ptr = locations.get_device_ptr ();
+
+  Array<int32> counts;
+  counts.resize (size);
+  int32 *counts_ptr = counts.get_device_ptr ();
+  RAJA::forall<for_policy> (RAJA::RangeSegment (0, size), [=] DRAY_LAMBDA (int32 i) {
+    if (loc_ptr[i].m_cell_id != -1)
+    {
+      counts_ptr[i] = 0;
+      return;
+    }
+    FirstLeaf<Element> leaves{ { device_mesh, points_ptr[i], loc_ptr[i] }, false, 0 };
+    device_mesh.traverse (points_ptr[i], leaves);
+    loc_ptr[i] = leaves.m_locate.m_loc;
+    // a hit stops the traversal, so only misses have more candidates
+    counts_ptr[i] = leaves.m_count;
+  });
+  DRAY_ERROR_CHECK();
+
+  int32 total = 0;
+  Array<int32> offsets = array_exc_scan_plus (counts, total);
+  if (total == 0)
+  {
+    return;
+  }
+  DRAY_LOG_ENTRY ("candidates", total);
+
+  Array<int32> cand_elems;
+  Array<int32> cand_boxes;
+  Array<int32> cand_points;
+  cand_elems.resize (total);
+  cand_boxes.resize (total);
+  cand_points.resize (total);
+  int32 *elems_ptr = cand_elems.get_device_ptr ();
+  int32 *boxes_ptr = cand_boxes.get_device_ptr ();
+  int32 *cand_points_ptr = cand_points.get_device_ptr ();
+  const int32 *offsets_ptr = offsets.get_device_ptr_const ();
+  RAJA::forall<for_policy> (RAJA::RangeSegment (0, size), [=] DRAY_LAMBDA (int32 i) {
+    if (counts_ptr[i] == 0)
+    {
+      return;
+    }
+    const int32 offset = offsets_ptr[i];
+    StoreLeaves leaves{ elems_ptr + offset, boxes_ptr + offset, cand_points_ptr + offset, i, 1, 0 };
+    device_mesh.traverse (points_ptr[i], leaves);
+  });
+  DRAY_ERROR_CHECK();
+
+  // group the candidates by element
+  Array<int32> keys;
+  array_copy (keys, cand_elems);
+  Array<int32> order = array_counting (total, 0, 1);
+  int32 *keys_ptr = keys.get_device_ptr ();
+  int32 *order_ptr = order.get_device_ptr ();
+  RAJA::sort_pairs<for_policy> (RAJA::make_span (keys_ptr, total),
+                                RAJA::make_span (order_ptr, total));
+  DRAY_ERROR_CHECK();
+
+  // the reference coordinates of every candidate, one array per axis,
+  // and the first candidate that held each point
+  Array<Float> ref_x;
+  Array<Float> ref_y;
+  Array<Float> ref_z;
+  ref_x.resize (total);
+  ref_y.resize (total);
+  ref_z.resize (total);
+  Float *ref_x_ptr = ref_x.get_device_ptr ();
+  Float *ref_y_ptr = ref_y.get_device_ptr ();
+  Float *ref_z_ptr = ref_z.get_device_ptr ();
+
+  Array<int32> first;
+  first.resize (size);
+  array_memset (first, total);
+  int32 *first_ptr = first.get_device_ptr ();
+
+  const SubRef<dim, etype> *ref_boxs_ptr = device_mesh.m_ref_boxs;
+  RAJA::forall<for_policy> (RAJA::RangeSegment (0, total), [=] DRAY_LAMBDA (int32 k) {
+    const int32 cand = order_ptr[k];
+    const int32 point = cand_points_ptr[cand];
+    Vec<Float, dim> el_coords = subref_center (ref_boxs_ptr[boxes_ptr[cand]]);
+    if (device_mesh.invert (keys_ptr[k], points_ptr[point], el_coords))
+    {
+      ref_x_ptr[cand] = el_coords[0];
+      ref_y_ptr[cand] = el_coords[1];
+      ref_z_ptr[cand] = dim == 3 ? el_coords[dim - 1] : Float (-1.f);
+      RAJA::atomicMin<atomic_policy> (&first_ptr[point], cand);
+    }
+  });
+  DRAY_ERROR_CHECK();
+
+  RAJA::forall<for_policy> (RAJA::RangeSegment (0, size), [=] DRAY_LAMBDA (int32 i) {
+    const int32 cand = first_ptr[i];
+    if (counts_ptr[i] == 0 || cand == total)
+    {
+      return;
+    }
+    Location loc{ elems_ptr[cand], { ref_x_ptr[cand], ref_y_ptr[cand], ref_z_ptr[cand] } };
+    loc_ptr[i] = loc;
+  });
+  DRAY_ERROR_CHECK();
+}
+
+} // namespace detail
+
 template <class Element>
 Array<Location> UnstructuredMesh<Element>::locate (Array<Vec<Float, 3u>> &wpoints)
 {
@@ -128,20 +314,62 @@ Array<Location> UnstructuredMesh<Element>::locate (Array<Vec<Float, 3u>> &wpoint
   const int32 size = wpoints.size ();
   Array<Location> locations;
   locations.resize (size);
+  array_memset (locations, Location{ -1, { -1.f, -1.f, -1.f } });
+
+  detail::locate_batch (*this, wpoints, locations);
+
+  DRAY_LOG_CLOSE();
+
+  return locations;
+}
+
+template <class Element>
+Array<Location> UnstructuredMesh<Element>::locate (Array<Vec<Float, 3u>> &wpoints,
+                                                   const Array<Location> &guesses)
+{
+  DRAY_LOG_OPEN ("locate_guess");
+
+  const int32 size = wpoints.size ();
+  if (guesses.size () != size)
+  {
+    DRAY_ERROR ("Locate: "<<guesses.size ()<<" guesses for "<<size<<" points");
+  }
 
+  Array<Location> locations;
+  locations.resize (size);
   Location *loc_ptr = locations.get_device_ptr ();
+  const Location *guess_ptr = guesses.get_device_ptr_const ();
   const Vec<Float,3> *points_ptr = wpoints.get_device_ptr_const();
 
-  DeviceMesh<Element> device_mesh (*this);
+  // the walk only uses face neighbors if they were already built,
+  // otherwise just the guess cell is tried
+  DeviceMesh<Element> device_mesh (*this, false, m_has_face_neighbors);
 
+  const int32 num_cells = cells ();
+  RAJA::ReduceSum<reduce_policy, int32> misses (0);
   RAJA::forall<for_policy> (RAJA::RangeSegment (0, size), [=] DRAY_LAMBDA (int32 i) {
-
-    Location loc = { -1, { -1.f, -1.f, -1.f } };
-    const Vec<Float, 3> target_pt = points_ptr[i];
-    loc_ptr[i] = device_mesh.locate(target_pt);
+    Location guess = guess_ptr[i];
+    if (guess.m_cell_id < 0 || guess.m_cell_id >= num_cells)
+    {
+      // the guesses may come from a different mesh, and any negative
+      // id means no guess
+      guess.m_cell_id = -1;
+    }
+    const Location loc = device_mesh.walk (points_ptr[i], guess);
+    loc_ptr[i] = loc;
+    if (loc.m_cell_id == -1)
+    {
+      misses += 1;
+    }
   });
-
   DRAY_ERROR_CHECK();
+
+  DRAY_LOG_ENTRY ("misses", misses.get ());
+  if (misses.get () > 0)
+  {
+    detail::locate_batch (*this, wpoints, locations);
+  }
+
   DRAY_LOG_CLOSE();
 
   return locations;
@@ -159,6 +387,26 @@ int32 UnstructuredMesh<Element>::order() const
   return m_poly_order;
 }
 
+template<typename Element>
+uint64 UnstructuredMesh<Element>::hash()
+{
+  uint64 res = 14695981039346656037ULL;
+  res = (res ^ (uint64) m_poly_order) * 1099511628211ULL;
+  res = (res ^ (uint64) m_dof_data.m_el_dofs) * 1099511628211ULL;
+  res = (res ^ (uint64) m_dof_data.m_size_el) * 1099511628211ULL;
+  res = array_hash(m_dof_data.m_ctrl_idx, res);
+  res = array_hash(m_dof_data.m_values, res);
+  return res;
+}
+
+template<typename Element>
+uint64 UnstructuredMesh<Element>::version() const
+{
+  // array versions are unique, so the pair identifies the geometry
+  return (m_dof_data.m_ctrl_idx.version() * 1099511628211ULL) ^
+         m_dof_data.m_values.version();
+}
+
 template<typename Element>
 AABB<3> UnstructuredMesh<Element>::bounds()
 {
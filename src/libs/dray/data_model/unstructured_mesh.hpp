@@ -52,6 +52,8 @@ protected:
   // we are lazy constructing these
   BVH m_bvh;
   Array<SubRef<dim, etype>> m_ref_aabbs;
+  bool m_has_face_neighbors;
+  Array<int32> m_face_neighbors;
 
   //// Accept input data (as shared).
   //// Useful for keeping same data but changing class template arguments.
@@ -84,6 +86,10 @@ public:
 
   virtual AABB<3> bounds() override;
   virtual Array<Location> locate (Array<Vec<Float, 3>> &wpoints) override;
+  virtual Array<Location> locate (Array<Vec<Float, 3>> &wpoints,
+                                  const Array<Location> &guesses) override;
+  virtual uint64 hash() override;
+  virtual uint64 version() const override;
   virtual void to_node(conduit::Node &n_topo) override;
 
 
@@ -97,6 +103,9 @@ public:
   UnstructuredMesh(const UnstructuredMesh &other);
 
   const BVH get_bvh ();
+  // for each face of each element, the neighboring element or -1
+  // (see detail::face_neighbors). Empty for surface meshes.
+  const Array<int32> get_face_neighbors ();
 
   GridFunction<3u> get_dof_data ()
   {
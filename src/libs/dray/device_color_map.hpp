@@ -58,7 +58,8 @@ class DeviceColorMap
 
   }
 
-  DRAY_EXEC Vec<float32, 4> color (const Float &scalar) const
+  // index of the color sample used for scalar, non-decreasing in scalar
+  DRAY_EXEC int32 index (const Float &scalar) const
   {
     Float s = scalar;
 
@@ -73,7 +74,12 @@ class DeviceColorMap
     int32 sample_idx = static_cast<int32> (normalized * float32 (m_size - 1));
     sample_idx = clamp (sample_idx, 0, m_size - 1);
     //std::cout<<"s "<<sample_idx<<" "<<scalar<<" mn "<<m_min<<" mx "<<m_max<<"n";
-    return m_colors[sample_idx];
+    return sample_idx;
+  }
+
+  DRAY_EXEC Vec<float32, 4> color (const Float &scalar) const
+  {
+    return m_colors[index (scalar)];
   }
 }; // class device color map
 
@@ -0,0 +1,1156 @@
+// Copyright 2019 Lawrence Livermore National Security, LLC and other
+// Devil Ray Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <dray/filters/adaptive_linearize.hpp>
+
+#include <dray/dray.hpp>
+#include <dray/data_model/data_set.hpp>
+#include <dray/data_model/device_field.hpp>
+#include <dray/data_model/device_mesh.hpp>
+#include <dray/data_model/element.hpp>
+#include <dray/data_model/subref.hpp>
+#include <dray/data_model/unstructured_field.hpp>
+#include <dray/data_model/unstructured_mesh.hpp>
+#include <dray/array.hpp>
+#include <dray/array_utils.hpp>
+#include <dray/dispatcher.hpp>
+#include <dray/error.hpp>
+#include <dray/error_check.hpp>
+#include <dray/math.hpp>
+#include <dray/policies.hpp>
+#include <dray/utils/data_logger.hpp>
+#include <dray/utils/mpi_utils.hpp>
+
+#include <RAJA/RAJA.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+
+#ifdef DRAY_MPI_ENABLED
+#include <mpi.h>
+#endif
+
+// Start internal implementation
+namespace
+{
+
+using namespace dray;
+
+// Adds the deviation of each element from the multilinear interpolant of
+// its corner control points into error (keeping the max). A multilinear
+// function written in the Bernstein basis has its values at the Greville
+// points (i/p, j/p, k/p) as coefficients, so by the convex hull property
+// the largest difference between the control points and the interpolant
+// at those points bounds the error of the straight sided element.
+template <int32 ncomp>
+void accumulate_error(const GridFunction<ncomp> &gf,
+                      const int32 order,
+                      const int32 dim,
+                      const Float scale,
+                      Array<Float> &error)
+{
+  // linear and constant elements are exact
+  if(order < 2)
+  {
+    return;
+  }
+
+  const int32 nx = order + 1;
+  const int32 ny = dim > 1 ? order + 1 : 1;
+  const int32 nz = dim > 2 ? order + 1 : 1;
+  const int32 cy = dim > 1 ? 2 : 1;
+  const int32 cz = dim > 2 ? 2 : 1;
+  const int32 el_dofs = gf.m_el_dofs;
+
+  const int32 *idx_ptr = gf.m_ctrl_idx.get_device_ptr_const();
+  const Vec<Float, ncomp> *val_ptr = gf.m_values.get_device_ptr_const();
+  Float *error_ptr = error.get_device_ptr();
+
+  RAJA::forall<for_policy>(RAJA::RangeSegment(0, gf.get_num_elem()),
+    [=] DRAY_LAMBDA (int32 el)
+  {
+    const int32 *el_idx = idx_ptr + el * el_dofs;
+
+    Vec<Float, ncomp> corners[8];
+    for(int32 k = 0; k < cz; ++k)
+      for(int32 j = 0; j < cy; ++j)
+        for(int32 i = 0; i < 2; ++i)
+        {
+          const int32 dof = i * order + nx * (j * order + ny * k * order);
+          corners[i + 2 * j + 4 * k] = val_ptr[el_idx[dof]];
+        }
+
+    Float max_dev = 0;
+    int32 dof = 0;
+    for(int32 kk = 0; kk < nz; ++kk)
+      for(int32 jj = 0; jj < ny; ++jj)
+        for(int32 ii = 0; ii < nx; ++ii, ++dof)
+        {
+          const Float u = Float(ii) / Float(order);
+          const Float v = Float(jj) / Float(order);
+          const Float w = Float(kk) / Float(order);
+
+          Vec<Float, ncomp> linear;
+          linear = 0;
+          for(int32 k = 0; k < cz; ++k)
+            for(int32 j = 0; j < cy; ++j)
+              for(int32 i = 0; i < 2; ++i)
+              {
+                const Float weight = (i ? u : 1.f - u) *
+                                     (j ? v : 1.f - v) *
+                                     (k ? w : 1.f - w);
+                linear += corners[i + 2 * j + 4 * k] * weight;
+              }
+
+          const Float dev = (val_ptr[el_idx[dof]] - linear).Normlinf();
+          max_dev = dev > max_dev ? dev : max_dev;
+        }
+
+    max_dev *= scale;
+    if(max_dev > error_ptr[el])
+    {
+      error_ptr[el] = max_dev;
+    }
+  });
+  DRAY_ERROR_CHECK();
+}
+
+// the error of the piecewise linear approximation falls with the
+// square of the number of subdivisions
+int32 level_for(const Float error, const Float tolerance, const int32 max_level)
+{
+  if(error <= tolerance)
+  {
+    return 1;
+  }
+  const int32 level = int32(std::ceil(std::sqrt(error / tolerance)));
+  return std::max(1, std::min(level, max_level));
+}
+
+// ids of the corner control points of a tensor element, x fastest
+template <int32 ncomp>
+void corner_ids(const GridFunction<ncomp> &gf,
+                const int32 order,
+                const int32 dim,
+                const int32 el,
+                int32 corners[8])
+{
+  const int32 nx = order + 1;
+  const int32 ny = dim > 1 ? order + 1 : 1;
+  const int32 *el_idx = gf.m_ctrl_idx.get_host_ptr_const() + el * gf.m_el_dofs;
+  for(int32 c = 0; c < (1 << dim); ++c)
+  {
+    const int32 i = c & 1;
+    const int32 j = (c >> 1) & 1;
+    const int32 k = (c >> 2) & 1;
+    corners[c] = el_idx[i * order + nx * (j * order + ny * k * order)];
+  }
+}
+
+// an edge on the boundary of a domain, named by the positions of its end
+// points (the lower one first), and its class inside the domain
+struct BoundaryEdge
+{
+  std::array<Float, 6> m_key;
+  int32 m_class;
+};
+
+// Splitting an edge of one element splits it for every element that shares
+// it, so the (element, axis) pairs connected through shared edges (the
+// sheets of a hex mesh) have to be split the same number of times. Then
+// neighbours see the same points on their shared faces. Groups the pairs,
+// indexed by el * dim + axis, using the corner control points as vertices.
+// The edges of faces that only one element uses are returned in boundary,
+// so sheets can be followed into neighbouring domains.
+template <int32 ncomp>
+Array<int32> edge_classes(const GridFunction<ncomp> &gf,
+                          const int32 order,
+                          const int32 dim,
+                          int32 &num_classes,
+                          std::vector<BoundaryEdge> &boundary)
+{
+  const int32 size = gf.get_num_elem();
+  std::vector<int32> parent(size * dim);
+  for(int32 i = 0; i < size * dim; ++i)
+  {
+    parent[i] = i;
+  }
+
+  auto find = [&parent](int32 i)
+  {
+    while(parent[i] != i)
+    {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  };
+
+  std::map<std::pair<int32, int32>, int32> edges;
+  // faces by sorted corner ids and the number of elements using them
+  std::map<std::array<int32, 4>, int32> faces;
+  int32 corners[8];
+  for(int32 el = 0; el < size; ++el)
+  {
+    corner_ids(gf, order, dim, el, corners);
+    for(int32 axis = 0; axis < dim; ++axis)
+    {
+      for(int32 side = 0; side < 2; ++side)
+      {
+        std::array<int32, 4> face = {{-1, -1, -1, -1}};
+        int32 q = 0;
+        for(int32 c = 0; c < (1 << dim); ++c)
+        {
+          if(((c >> axis) & 1) == side)
+          {
+            face[q++] = corners[c];
+          }
+        }
+        std::sort(face.begin(), face.begin() + q);
+        faces[face]++;
+      }
+
+      const int32 pair = el * dim + axis;
+      for(int32 c = 0; c < (1 << dim); ++c)
+      {
+        if(c & (1 << axis))
+        {
+          continue;
+        }
+        const int32 a = corners[c];
+        const int32 b = corners[c | (1 << axis)];
+        auto res = edges.insert({{std::min(a, b), std::max(a, b)}, pair});
+        if(!res.second)
+        {
+          parent[find(pair)] = find(res.first->second);
+        }
+      }
+    }
+  }
+
+  Array<int32> classes;
+  classes.resize(size * dim);
+  int32 *class_ptr = classes.get_host_ptr();
+  std::map<int32, int32> class_ids;
+  for(int32 i = 0; i < size * dim; ++i)
+  {
+    auto res = class_ids.insert({find(i), int32(class_ids.size())});
+    class_ptr[i] = res.first->second;
+  }
+  num_classes = int32(class_ids.size());
+
+  const Vec<Float, ncomp> *val_ptr = gf.m_values.get_host_ptr_const();
+  std::set<std::pair<int32, int32>> boundary_edges;
+  for(const auto &face : faces)
+  {
+    if(face.second != 1)
+    {
+      continue;
+    }
+    // in 2d the face is an edge, in 3d its edges join sorted corner
+    // ids that are not diagonal, which are the ones in the edge map
+    const std::array<int32, 4> &ids = face.first;
+    const int32 num_ids = dim == 3 ? 4 : 2;
+    for(int32 a = 0; a < num_ids; ++a)
+      for(int32 b = a + 1; b < num_ids; ++b)
+      {
+        const std::pair<int32, int32> edge(ids[a], ids[b]);
+        if(edges.count(edge) > 0)
+        {
+          boundary_edges.insert(edge);
+        }
+      }
+  }
+
+  for(const auto &edge : boundary_edges)
+  {
+    std::array<Float, 3> pos[2];
+    const int32 ends[2] = {edge.first, edge.second};
+    for(int32 e = 0; e < 2; ++e)
+    {
+      pos[e] = {{0.f, 0.f, 0.f}};
+      for(int32 c = 0; c < std::min(ncomp, 3); ++c)
+      {
+        pos[e][c] = val_ptr[ends[e]][c];
+      }
+    }
+    if(pos[1] < pos[0])
+    {
+      std::swap(pos[0], pos[1]);
+    }
+
+    BoundaryEdge bedge;
+    std::copy(pos[0].begin(), pos[0].end(), bedge.m_key.begin());
+    std::copy(pos[1].begin(), pos[1].end(), bedge.m_key.begin() + 3);
+    bedge.m_class = class_ptr[edges[edge]];
+    boundary.push_back(bedge);
+  }
+  return classes;
+}
+
+// error estimates and edge classes of one domain
+struct DomainError
+{
+  Array<Float> m_error;
+  Array<int32> m_classes;
+  int32 m_num_classes;
+  std::vector<BoundaryEdge> m_boundary;
+  // for each class, the index of the sheet it belongs to if that sheet
+  // continues into other domains, otherwise -1
+  std::vector<int32> m_shared;
+};
+
+// Sheets continue into the neighbouring domains through the edges they
+// share, which are matched by the positions of their end points. Links the
+// classes of all domains on all ranks that meet on an edge, and numbers
+// the resulting shared sheets the same way on every rank. Returns the
+// number of shared sheets.
+int32 link_domains(std::vector<DomainError> &errors)
+{
+  // 6 coordinates and the global class id per boundary edge
+  constexpr int32 entry_size = 7;
+
+  int64 rank_classes = 0;
+  for(size_t d = 0; d < errors.size(); ++d)
+  {
+    rank_classes += errors[d].m_num_classes;
+  }
+
+  int64 rank_offset = 0;
+#ifdef DRAY_MPI_ENABLED
+  MPI_Comm mpi_comm = MPI_Comm_f2c(::dray::dray::mpi_comm());
+  MPI_Exscan(&rank_classes, &rank_offset, 1, MPI_LONG_LONG, MPI_SUM, mpi_comm);
+  if(::dray::dray::mpi_rank() == 0)
+  {
+    rank_offset = 0;
+  }
+#endif
+
+  std::vector<float64> local_entries;
+  int64 offset = rank_offset;
+  for(size_t d = 0; d < errors.size(); ++d)
+  {
+    for(const BoundaryEdge &edge : errors[d].m_boundary)
+    {
+      local_entries.insert(local_entries.end(), edge.m_key.begin(), edge.m_key.end());
+      local_entries.push_back(float64(offset + edge.m_class));
+    }
+    offset += errors[d].m_num_classes;
+  }
+
+  std::vector<float64> entries;
+#ifdef DRAY_MPI_ENABLED
+  const int32 size = ::dray::dray::mpi_size();
+  int32 local_count = int32(local_entries.size());
+  std::vector<int32> counts(size);
+  MPI_Allgather(&local_count, 1, MPI_INT, counts.data(), 1, MPI_INT, mpi_comm);
+  std::vector<int32> displs(size, 0);
+  for(int32 r = 1; r < size; ++r)
+  {
+    displs[r] = displs[r - 1] + counts[r - 1];
+  }
+  entries.resize(displs[size - 1] + counts[size - 1]);
+  MPI_Allgatherv(local_entries.data(),
+                 local_count,
+                 MPI_DOUBLE,
+                 entries.data(),
+                 counts.data(),
+                 displs.data(),
+                 MPI_DOUBLE,
+                 mpi_comm);
+#else
+  entries = local_entries;
+#endif
+
+  // every rank links all edges the same way
+  std::map<int64, int64> parent;
+  auto find = [&parent](int64 i)
+  {
+    while(parent[i] != i)
+    {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  };
+
+  std::map<std::array<float64, 6>, int64> edges;
+  const size_t num_entries = entries.size() / entry_size;
+  for(size_t e = 0; e < num_entries; ++e)
+  {
+    const float64 *entry = &entries[e * entry_size];
+    std::array<float64, 6> key;
+    std::copy(entry, entry + 6, key.begin());
+    const int64 id = int64(entry[6]);
+    parent.insert({id, id});
+    auto res = edges.insert({key, id});
+    if(!res.second)
+    {
+      const int64 a = find(id);
+      const int64 b = find(res.first->second);
+      parent[std::max(a, b)] = std::min(a, b);
+    }
+  }
+
+  // only sheets that join more than one class are shared
+  std::map<int64, int32> sheet_sizes;
+  for(auto &p : parent)
+  {
+    sheet_sizes[find(p.first)]++;
+  }
+  std::map<int64, int32> sheet_ids;
+  for(auto &sheet : sheet_sizes)
+  {
+    if(sheet.second > 1)
+    {
+      sheet_ids.insert({sheet.first, int32(sheet_ids.size())});
+    }
+  }
+
+  offset = rank_offset;
+  for(size_t d = 0; d < errors.size(); ++d)
+  {
+    DomainError &domain = errors[d];
+    domain.m_shared.assign(domain.m_num_classes, -1);
+    for(const BoundaryEdge &edge : domain.m_boundary)
+    {
+      auto sheet = sheet_ids.find(find(offset + edge.m_class));
+      if(sheet != sheet_ids.end())
+      {
+        domain.m_shared[edge.m_class] = sheet->second;
+      }
+    }
+    offset += domain.m_num_classes;
+  }
+  return int32(sheet_ids.size());
+}
+
+// splits of each (element, axis) pair of every domain, the largest level
+// any element in its class needs, including the elements of other domains
+// on shared sheets. num_shared has to agree across ranks.
+std::vector<std::vector<int32>> axis_levels(const std::vector<DomainError> &errors,
+                                            const int32 num_shared,
+                                            const int32 dim,
+                                            const Float tolerance,
+                                            const int32 max_level)
+{
+  std::vector<std::vector<int32>> class_levels(errors.size());
+  std::vector<int32> shared_levels(num_shared, 1);
+  for(size_t d = 0; d < errors.size(); ++d)
+  {
+    const DomainError &domain = errors[d];
+    const Float *error_ptr = domain.m_error.get_host_ptr_const();
+    const int32 *class_ptr = domain.m_classes.get_host_ptr_const();
+    const int32 size = domain.m_error.size();
+
+    class_levels[d].assign(domain.m_num_classes, 1);
+    for(int32 el = 0; el < size; ++el)
+    {
+      const int32 level = level_for(error_ptr[el], tolerance, max_level);
+      for(int32 axis = 0; axis < dim; ++axis)
+      {
+        int32 &class_level = class_levels[d][class_ptr[el * dim + axis]];
+        class_level = std::max(class_level, level);
+      }
+    }
+
+    for(int32 c = 0; c < domain.m_num_classes; ++c)
+    {
+      if(domain.m_shared[c] != -1)
+      {
+        int32 &shared_level = shared_levels[domain.m_shared[c]];
+        shared_level = std::max(shared_level, class_levels[d][c]);
+      }
+    }
+  }
+
+#ifdef DRAY_MPI_ENABLED
+  if(num_shared > 0)
+  {
+    MPI_Comm mpi_comm = MPI_Comm_f2c(::dray::dray::mpi_comm());
+    MPI_Allreduce(MPI_IN_PLACE,
+                  shared_levels.data(),
+                  num_shared,
+                  MPI_INT,
+                  MPI_MAX,
+                  mpi_comm);
+  }
+#endif
+
+  std::vector<std::vector<int32>> levels(errors.size());
+  for(size_t d = 0; d < errors.size(); ++d)
+  {
+    const DomainError &domain = errors[d];
+    const int32 *class_ptr = domain.m_classes.get_host_ptr_const();
+    const int32 size = domain.m_error.size();
+
+    for(int32 c = 0; c < domain.m_num_classes; ++c)
+    {
+      if(domain.m_shared[c] != -1)
+      {
+        class_levels[d][c] = shared_levels[domain.m_shared[c]];
+      }
+    }
+
+    levels[d].resize(size * dim);
+    for(int32 i = 0; i < size * dim; ++i)
+    {
+      levels[d][i] = class_levels[d][class_ptr[i]];
+    }
+  }
+  return levels;
+}
+
+int64 count_cells(const std::vector<int32> &levels, const int32 dim)
+{
+  int64 count = 0;
+  for(size_t el = 0; el < levels.size() / dim; ++el)
+  {
+    int64 cells = 1;
+    for(int32 axis = 0; axis < dim; ++axis)
+    {
+      cells *= levels[el * dim + axis];
+    }
+    count += cells;
+  }
+  return count;
+}
+
+int64 count_elements(const std::vector<DomainError> &errors,
+                     const int32 num_shared,
+                     const int32 dim,
+                     const Float tolerance,
+                     const int32 max_level)
+{
+  const std::vector<std::vector<int32>> levels =
+    axis_levels(errors, num_shared, dim, tolerance, max_level);
+  int64 count = 0;
+  for(size_t d = 0; d < levels.size(); ++d)
+  {
+    count += count_cells(levels[d], dim);
+  }
+
+#ifdef DRAY_MPI_ENABLED
+  MPI_Comm mpi_comm = MPI_Comm_f2c(::dray::dray::mpi_comm());
+  int64 global_count = 0;
+  MPI_Allreduce(&count, &global_count, 1, MPI_LONG_LONG, MPI_SUM, mpi_comm);
+  count = global_count;
+#endif
+  return count;
+}
+
+Float max_error(const std::vector<DomainError> &errors)
+{
+  Float res = 0;
+  for(size_t d = 0; d < errors.size(); ++d)
+  {
+    const Float *error_ptr = errors[d].m_error.get_host_ptr_const();
+    const int32 size = errors[d].m_error.size();
+    for(int32 i = 0; i < size; ++i)
+    {
+      res = std::max(res, error_ptr[i]);
+    }
+  }
+
+#ifdef DRAY_MPI_ENABLED
+  MPI_Comm mpi_comm = MPI_Comm_f2c(::dray::dray::mpi_comm());
+  float64 local_max = res;
+  float64 global_max = 0;
+  MPI_Allreduce(&local_max, &global_max, 1, MPI_DOUBLE, MPI_MAX, mpi_comm);
+  res = Float(global_max);
+#endif
+  return res;
+}
+
+// how each element is split and where its linear elements start
+struct RefineLayout
+{
+  // splits along each axis, 1 for axes the elements don't have
+  Array<Vec<int32, 3>> m_levels;
+  Array<int32> m_cell_offsets;
+  int32 m_num_cells;
+};
+
+RefineLayout make_layout(const std::vector<int32> &levels, const int32 dim)
+{
+  const int32 size = int32(levels.size() / dim);
+
+  RefineLayout layout;
+  layout.m_levels.resize(size);
+  layout.m_cell_offsets.resize(size);
+  Vec<int32, 3> *level_ptr = layout.m_levels.get_host_ptr();
+  int32 *cell_ptr = layout.m_cell_offsets.get_host_ptr();
+
+  // the connectivity (cells * 8) is indexed with int32
+  const int64 limit = std::numeric_limits<int32>::max() / 8;
+  int64 cells = 0;
+  for(int32 el = 0; el < size; ++el)
+  {
+    Vec<int32, 3> level = {{1, 1, 1}};
+    for(int32 axis = 0; axis < dim; ++axis)
+    {
+      level[axis] = levels[el * dim + axis];
+    }
+    level_ptr[el] = level;
+    cell_ptr[el] = int32(cells);
+    cells += int64(level[0]) * level[1] * level[2];
+    if(cells > limit)
+    {
+      DRAY_ERROR("AdaptiveLinearize: more than "<<limit<<" linear elements in one"
+                 <<" domain. Raise the tolerance or set an element budget.");
+    }
+  }
+  layout.m_num_cells = int32(cells);
+  return layout;
+}
+
+// Identifies a lattice point on the boundary of an element by the vertex,
+// edge or face it lies on (named by corner ids) and its position there,
+// measured from the lowest corner id so every element touching it agrees.
+// Returns false for points inside the element.
+template <int32 dim>
+bool shared_key(const int32 corners[8],
+                const Vec<int32, 3> &idx,
+                const Vec<int32, 3> &level,
+                std::array<int32, 5> &key)
+{
+  int32 free_axes[3];
+  int32 num_free = 0;
+  int32 fixed = 0;
+  for(int32 d = 0; d < dim; ++d)
+  {
+    if(idx[d] > 0 && idx[d] < level[d])
+    {
+      free_axes[num_free++] = d;
+    }
+    else if(idx[d] == level[d])
+    {
+      fixed |= 1 << d;
+    }
+  }
+
+  if(num_free == dim)
+  {
+    return false;
+  }
+  else if(num_free == 0)
+  {
+    key = {{corners[fixed], -1, -1, 0, 0}};
+  }
+  else if(num_free == 1)
+  {
+    const int32 f = free_axes[0];
+    int32 a = corners[fixed];
+    int32 b = corners[fixed | (1 << f)];
+    int32 t = idx[f];
+    if(b < a)
+    {
+      std::swap(a, b);
+      t = level[f] - t;
+    }
+    key = {{a, b, -1, t, 0}};
+  }
+  else
+  {
+    const int32 f0 = free_axes[0];
+    const int32 f1 = free_axes[1];
+    int32 face[4];
+    int32 origin = 0;
+    for(int32 q = 0; q < 4; ++q)
+    {
+      face[q] = corners[fixed | (q & 1) << f0 | ((q >> 1) & 1) << f1];
+      origin = face[q] < face[origin] ? q : origin;
+    }
+    int32 s = (origin & 1) ? level[f0] - idx[f0] : idx[f0];
+    int32 t = (origin & 2) ? level[f1] - idx[f1] : idx[f1];
+    int32 n0 = face[origin ^ 1];
+    int32 n1 = face[origin ^ 2];
+    if(n1 < n0)
+    {
+      std::swap(s, t);
+      std::swap(n0, n1);
+    }
+    key = {{face[origin], n0, n1, s, t}};
+  }
+  return true;
+}
+
+// the output points of one grid function and the connectivity of the
+// linear elements. Points on the corners, edges and faces of the input
+// elements are created once and shared by every element touching them.
+struct RefinePoints
+{
+  Array<int32> m_conn;
+  // the element and reference coordinates each point is evaluated at
+  Array<int32> m_point_el;
+  Array<Vec<Float, 3>> m_point_ref;
+  int32 m_num_points;
+};
+
+template <int32 dim, int32 ncomp>
+RefinePoints make_points(const GridFunction<ncomp> &gf,
+                         const int32 order,
+                         const RefineLayout &layout)
+{
+  constexpr int32 verts = 1 << dim;
+  const Vec<int32, 3> *level_ptr = layout.m_levels.get_host_ptr_const();
+  const int32 *cell_ptr = layout.m_cell_offsets.get_host_ptr_const();
+
+  RefinePoints points;
+  points.m_conn.resize(layout.m_num_cells * verts);
+  int32 *conn_ptr = points.m_conn.get_host_ptr();
+
+  std::vector<int32> point_el;
+  std::vector<Vec<Float, 3>> point_ref;
+  std::map<std::array<int32, 5>, int32> shared;
+  std::vector<int32> lattice;
+  int32 corners[8];
+
+  const int32 size = gf.get_num_elem();
+  for(int32 el = 0; el < size; ++el)
+  {
+    corner_ids(gf, order, dim, el, corners);
+    const Vec<int32, 3> level = level_ptr[el];
+    const int32 stride_y = level[0] + 1;
+    const int32 stride_z = stride_y * (level[1] + 1);
+    lattice.assign(stride_z * (level[2] + 1), -1);
+
+    const int32 num_cells = level[0] * level[1] * level[2];
+    for(int32 c = 0; c < num_cells; ++c)
+    {
+      const Vec<int32, 3> cell = {{c % level[0],
+                                   (c / level[0]) % level[1],
+                                   c / (level[0] * level[1])}};
+      SubRef<dim, ElemType::Tensor> box;
+      for(int32 d = 0; d < dim; ++d)
+      {
+        box[0][d] = Float(cell[d]) / Float(level[d]);
+        box[1][d] = Float(cell[d] + 1) / Float(level[d]);
+      }
+
+      // linear tensor elements use the same lexicographic vertex
+      // ordering as the lattice
+      for(int32 v = 0; v < verts; ++v)
+      {
+        Vec<int32, 3> idx = cell;
+        Vec<Float, dim> corner;
+        for(int32 d = 0; d < dim; ++d)
+        {
+          idx[d] += (v >> d) & 1;
+          corner[d] = Float((v >> d) & 1);
+        }
+
+        int32 &id = lattice[idx[0] + idx[1] * stride_y + idx[2] * stride_z];
+        if(id == -1)
+        {
+          std::array<int32, 5> key;
+          if(shared_key<dim>(corners, idx, level, key))
+          {
+            auto res = shared.insert({key, int32(point_el.size())});
+            id = res.first->second;
+          }
+          else
+          {
+            id = int32(point_el.size());
+          }
+
+          if(id == int32(point_el.size()))
+          {
+            const Vec<Float, dim> ref = subref2ref(box, corner);
+            Vec<Float, 3> ref3 = {{0.f, 0.f, 0.f}};
+            for(int32 d = 0; d < dim; ++d)
+            {
+              ref3[d] = ref[d];
+            }
+            point_el.push_back(el);
+            point_ref.push_back(ref3);
+          }
+        }
+        conn_ptr[(cell_ptr[el] + c) * verts + v] = id;
+      }
+    }
+  }
+
+  points.m_num_points = int32(point_el.size());
+  points.m_point_el.resize(points.m_num_points);
+  points.m_point_ref.resize(points.m_num_points);
+  std::copy(point_el.begin(), point_el.end(), points.m_point_el.get_host_ptr());
+  std::copy(point_ref.begin(), point_ref.end(), points.m_point_ref.get_host_ptr());
+  return points;
+}
+
+// largest extent of any component of the field over all ranks
+Float field_length(Collection &collection, const std::string &name)
+{
+  Range range;
+  for(DataSet &domain : collection.domains())
+  {
+    if(domain.has_field(name))
+    {
+      std::vector<Range> ranges = domain.field(name)->range();
+      for(size_t c = 0; c < ranges.size(); ++c)
+      {
+        range.include(ranges[c]);
+      }
+    }
+  }
+
+  float64 local_min = range.is_empty() ? infinity<float64>() : range.min();
+  float64 local_max = range.is_empty() ? neg_infinity<float64>() : range.max();
+#ifdef DRAY_MPI_ENABLED
+  MPI_Comm mpi_comm = MPI_Comm_f2c(::dray::dray::mpi_comm());
+  float64 global_min = 0;
+  float64 global_max = 0;
+  MPI_Allreduce(&local_min, &global_min, 1, MPI_DOUBLE, MPI_MIN, mpi_comm);
+  MPI_Allreduce(&local_max, &global_max, 1, MPI_DOUBLE, MPI_MAX, mpi_comm);
+  local_min = global_min;
+  local_max = global_max;
+#endif
+  if(local_max < local_min)
+  {
+    return 0;
+  }
+  return Float(local_max - local_min);
+}
+
+struct ErrorFunctor
+{
+  DomainError m_domain;
+  Float m_scale;
+
+  template <class ElemT>
+  void operator()(UnstructuredMesh<ElemT> &mesh)
+  {
+    if(ElemT::get_etype() != ElemType::Tensor)
+    {
+      DRAY_ERROR("AdaptiveLinearize only supports quad and hex elements");
+    }
+    accumulate_error(mesh.get_dof_data(),
+                     mesh.order(),
+                     ElemT::get_dim(),
+                     m_scale,
+                     m_domain.m_error);
+    m_domain.m_classes = edge_classes(mesh.get_dof_data(),
+                                      mesh.order(),
+                                      ElemT::get_dim(),
+                                      m_domain.m_num_classes,
+                                      m_domain.m_boundary);
+  }
+
+  template <class ElemT>
+  void operator()(UnstructuredField<ElemT> &field)
+  {
+    accumulate_error(field.get_dof_data(),
+                     field.order(),
+                     ElemT::get_dim(),
+                     m_scale,
+                     m_domain.m_error);
+  }
+};
+
+// Linear children share the corner values of the Bernstein sub-patches of
+// their parent, which are the values at the corners of their sub-reference
+// boxes, so evaluating the parent there gives the exact vertex data.
+template <int32 dim, class DeviceT, int32 ncomp>
+void eval_points(const DeviceT &device_data,
+                 const RefinePoints &points,
+                 Array<Vec<Float, ncomp>> &values)
+{
+  values.resize(points.m_num_points);
+  const int32 *el_ptr = points.m_point_el.get_device_ptr_const();
+  const Vec<Float, 3> *ref_ptr = points.m_point_ref.get_device_ptr_const();
+  Vec<Float, ncomp> *val_ptr = values.get_device_ptr();
+
+  RAJA::forall<for_policy>(RAJA::RangeSegment(0, points.m_num_points),
+    [=] DRAY_LAMBDA (int32 p)
+  {
+    Vec<Float, dim> ref;
+    for(int32 d = 0; d < dim; ++d)
+    {
+      ref[d] = ref_ptr[p][d];
+    }
+    val_ptr[p] = device_data.get_elem(el_ptr[p]).eval(ref);
+  });
+  DRAY_ERROR_CHECK();
+}
+
+struct RefineMeshFunctor
+{
+  RefineLayout *m_layout;
+  std::shared_ptr<Mesh> m_output;
+
+  template <class ElemT>
+  void operator()(UnstructuredMesh<ElemT> &mesh)
+  {
+    constexpr int32 dim = ElemT::get_dim();
+    using OutElemT = Element<dim, 3u, ElemType::Tensor, Order::Linear>;
+
+    RefinePoints points = make_points<dim>(mesh.get_dof_data(), mesh.order(), *m_layout);
+
+    GridFunction<3> out_gf;
+    out_gf.m_el_dofs = 1 << dim;
+    out_gf.m_size_el = m_layout->m_num_cells;
+    out_gf.m_size_ctrl = points.m_num_points;
+    out_gf.m_ctrl_idx = points.m_conn;
+
+    DeviceMesh<ElemT> device_mesh(mesh, false);
+    eval_points<dim>(device_mesh, points, out_gf.m_values);
+
+    m_output = std::make_shared<UnstructuredMesh<OutElemT>>(out_gf, 1);
+    m_output->name(mesh.name());
+  }
+};
+
+struct RefineFieldFunctor
+{
+  RefineLayout *m_layout;
+  std::shared_ptr<Field> m_output;
+
+  template <class ElemT>
+  void operator()(UnstructuredField<ElemT> &field)
+  {
+    constexpr int32 dim = ElemT::get_dim();
+    constexpr int32 ncomp = ElemT::get_ncomp();
+
+    RefineLayout &layout = *m_layout;
+    DeviceField<ElemT> device_field(field);
+    GridFunction<ncomp> out_gf;
+
+    if(field.order() == 0)
+    {
+      // every linear element keeps the value of its parent
+      using OutElemT = Element<dim, ncomp, ElemType::Tensor, Order::Constant>;
+      out_gf.m_el_dofs = 1;
+      out_gf.m_size_el = layout.m_num_cells;
+      out_gf.m_size_ctrl = layout.m_num_cells;
+      out_gf.m_ctrl_idx = array_counting(layout.m_num_cells, 0, 1);
+      out_gf.m_values.resize(layout.m_num_cells);
+      Vec<Float, ncomp> *out_val_ptr = out_gf.m_values.get_device_ptr();
+      const Vec<int32, 3> *level_ptr = layout.m_levels.get_device_ptr_const();
+      const int32 *cell_ptr = layout.m_cell_offsets.get_device_ptr_const();
+
+      RAJA::forall<for_policy>(RAJA::RangeSegment(0, field.get_num_elem()),
+        [=] DRAY_LAMBDA (int32 el)
+      {
+        Vec<Float, dim> ref;
+        ref = 0.5f;
+        const Vec<Float, ncomp> value = device_field.get_elem(el).eval(ref);
+        const Vec<int32, 3> level = level_ptr[el];
+        const int32 num_cells = level[0] * level[1] * level[2];
+        for(int32 c = 0; c < num_cells; ++c)
+        {
+          out_val_ptr[cell_ptr[el] + c] = value;
+        }
+      });
+      DRAY_ERROR_CHECK();
+      m_output = std::make_shared<UnstructuredField<OutElemT>>(out_gf, 0, field.name());
+    }
+    else
+    {
+      // fields number their own points, so discontinuous fields stay
+      // discontinuous across element boundaries
+      using OutElemT = Element<dim, ncomp, ElemType::Tensor, Order::Linear>;
+      RefinePoints points = make_points<dim>(field.get_dof_data(), field.order(), layout);
+      out_gf.m_el_dofs = 1 << dim;
+      out_gf.m_size_el = layout.m_num_cells;
+      out_gf.m_size_ctrl = points.m_num_points;
+      out_gf.m_ctrl_idx = points.m_conn;
+      eval_points<dim>(device_field, points, out_gf.m_values);
+      m_output = std::make_shared<UnstructuredField<OutElemT>>(out_gf, 1, field.name());
+    }
+    m_output->mesh_name(field.mesh_name());
+  }
+};
+
+// End internal implementation
+}
+
+namespace dray
+{
+
+AdaptiveLinearize::AdaptiveLinearize()
+  : m_tolerance(0.001f),
+    m_max_level(8),
+    m_element_budget(0),
+    m_num_elements(0),
+    m_used_tolerance(0.001f)
+{
+}
+
+void
+AdaptiveLinearize::tolerance(const Float tolerance)
+{
+  if(tolerance <= 0)
+  {
+    DRAY_ERROR("AdaptiveLinearize: tolerance must be positive");
+  }
+  m_tolerance = tolerance;
+}
+
+void
+AdaptiveLinearize::max_level(const int32 level)
+{
+  if(level < 1)
+  {
+    DRAY_ERROR("AdaptiveLinearize: max level must be at least 1");
+  }
+  m_max_level = level;
+}
+
+void
+AdaptiveLinearize::element_budget(const int64 budget)
+{
+  m_element_budget = budget;
+}
+
+void
+AdaptiveLinearize::add_field(const std::string &field_name)
+{
+  m_fields.push_back(field_name);
+}
+
+int64
+AdaptiveLinearize::number_of_elements() const
+{
+  return m_num_elements;
+}
+
+Float
+AdaptiveLinearize::used_tolerance() const
+{
+  return m_used_tolerance;
+}
+
+Collection
+AdaptiveLinearize::execute(Collection &collection)
+{
+  DRAY_LOG_OPEN("adaptive_linearize");
+
+  const int32 dim = collection.topo_dims();
+
+  // normalize the geometric error by the diagonal of the whole data set
+  AABB<3> bounds = collection.bounds();
+  Float diag = 0;
+  for(int32 d = 0; d < 3; ++d)
+  {
+    diag += bounds.m_ranges[d].length() * bounds.m_ranges[d].length();
+  }
+  diag = std::sqrt(diag);
+
+  // the field list and ranges have to agree across ranks
+  std::set<std::string> field_names(m_fields.begin(), m_fields.end());
+  if(field_names.empty())
+  {
+    for(DataSet &domain : collection.domains())
+    {
+      std::vector<std::string> names = domain.fields();
+      field_names.insert(names.begin(), names.end());
+    }
+    gather_strings(field_names);
+  }
+
+  std::map<std::string, Float> field_scales;
+  for(const std::string &name : field_names)
+  {
+    const Float length = field_length(collection, name);
+    if(length > 0)
+    {
+      field_scales[name] = 1.f / length;
+    }
+  }
+
+  // per element error estimates
+  std::vector<DomainError> errors;
+  for(DataSet &domain : collection.domains())
+  {
+    ErrorFunctor func;
+    func.m_domain.m_error.resize(domain.mesh()->cells());
+    array_memset_zero(func.m_domain.m_error);
+
+    func.m_scale = diag > 0 ? 1.f / diag : 1.f;
+    dispatch(domain.mesh(), func);
+
+    for(auto &scale : field_scales)
+    {
+      if(domain.has_field(scale.first))
+      {
+        func.m_scale = scale.second;
+        dispatch(domain.field(scale.first), func);
+      }
+    }
+    errors.push_back(func.m_domain);
+  }
+  const int32 num_shared = link_domains(errors);
+
+  // pick the tolerance
+  Float tolerance = m_tolerance;
+  int64 count = count_elements(errors, num_shared, dim, tolerance, m_max_level);
+  if(m_element_budget > 0 && count > m_element_budget)
+  {
+    // with the largest error as the tolerance nothing is refined
+    Float lo = tolerance;
+    Float hi = std::max(max_error(errors), tolerance);
+    for(int32 i = 0; i < 32 && hi / lo > 1.01f; ++i)
+    {
+      const Float mid = std::sqrt(lo * hi);
+      if(count_elements(errors, num_shared, dim, mid, m_max_level) > m_element_budget)
+      {
+        lo = mid;
+      }
+      else
+      {
+        hi = mid;
+      }
+    }
+    tolerance = hi;
+    count = count_elements(errors, num_shared, dim, tolerance, m_max_level);
+    if(count > m_element_budget)
+    {
+      DRAY_WARN("AdaptiveLinearize: element budget "<<m_element_budget
+                <<" is smaller than the number of input elements");
+    }
+  }
+  m_used_tolerance = tolerance;
+  m_num_elements = count;
+  DRAY_INFO("Linearizing with tolerance "<<tolerance<<" into "<<count<<" elements");
+
+  // build the linear domains
+  const std::vector<std::vector<int32>> levels =
+    axis_levels(errors, num_shared, dim, tolerance, m_max_level);
+  Collection res;
+  int32 index = 0;
+  for(DataSet &domain : collection.domains())
+  {
+    RefineLayout layout = make_layout(levels[index], dim);
+    index++;
+
+    RefineMeshFunctor mesh_func;
+    mesh_func.m_layout = &layout;
+    dispatch(domain.mesh(), mesh_func);
+
+    DataSet out_domain(mesh_func.m_output);
+    out_domain.domain_id(domain.domain_id());
+
+    const int32 num_fields = domain.number_of_fields();
+    for(int32 f = 0; f < num_fields; ++f)
+    {
+      RefineFieldFunctor field_func;
+      field_func.m_layout = &layout;
+      dispatch(domain.field(f), field_func);
+      out_domain.add_field(field_func.m_output);
+    }
+    res.add_domain(out_domain);
+  }
+
+  DRAY_LOG_CLOSE();
+  return res;
+}
+
+};//namespace dray
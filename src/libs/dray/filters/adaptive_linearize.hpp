@@ -0,0 +1,86 @@
+// Copyright 2019 Lawrence Livermore National Security, LLC and other
+// Devil Ray Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#ifndef DRAY_ADAPTIVE_LINEARIZE_HPP
+#define DRAY_ADAPTIVE_LINEARIZE_HPP
+
+#include <dray/data_model/collection.hpp>
+
+#include <string>
+#include <vector>
+
+namespace dray
+{
+
+/**
+ @brief Converts high order (quad / hex) data into linear elements, choosing
+        the number of subdivisions for each element separately.
+
+        Each element and field is compared against the multilinear interpolant
+        of its corner control points. The deviation (relative to the data set
+        diagonal for the geometry and to the field range for fields) is a bound
+        on the error of the straight sided version of the element, and it
+        shrinks with the square of the subdivision level. Each element asks
+        for the smallest level that brings the estimate below the tolerance.
+        Elements connected through shared edges split those edges the same
+        number of times (the largest level asked for along that sheet of
+        elements), so elements are split into a lattice of linear elements
+        that matches its neighbours on every shared face, and the points on
+        shared corners, edges and faces are output once. A sheet runs through
+        the whole mesh, so one curved element refines the full slab of
+        elements along each direction it splits. Sheets continue into other
+        domains (on any rank) through boundary edges whose end points have
+        the same positions, so domains match on their shared faces too.
+        If the result would exceed the element budget (summed over all
+        ranks), the tolerance is relaxed until it fits.
+*/
+class AdaptiveLinearize
+{
+protected:
+  Float m_tolerance;
+  int32 m_max_level;
+  int64 m_element_budget;
+  std::vector<std::string> m_fields;
+  int64 m_num_elements;
+  Float m_used_tolerance;
+public:
+  AdaptiveLinearize();
+
+  /**
+   @brief Target relative error (default 0.001).
+  */
+  void tolerance(const Float tolerance);
+  /**
+   @brief Maximum subdivisions per axis of one element (default 8).
+  */
+  void max_level(const int32 level);
+  /**
+   @brief Maximum number of linear elements created over all ranks.
+          Zero (default) means no limit.
+  */
+  void element_budget(const int64 budget);
+  /**
+   @brief Only use these fields for the error estimate. By default
+          all fields are used. All fields are output either way.
+  */
+  void add_field(const std::string &field_name);
+
+  /**
+   @brief Total number of linear elements (over all ranks) created by
+          the last execute.
+  */
+  int64 number_of_elements() const;
+  /**
+   @brief The tolerance used by the last execute, larger than the
+          requested one if the budget was hit.
+  */
+  Float used_tolerance() const;
+
+  Collection execute(Collection &collection);
+};
+
+};//namespace dray
+
+#endif
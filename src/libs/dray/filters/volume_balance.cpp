@@ -293,13 +293,252 @@ void split(std::vector<float32> &pieces,
 }
 
 
+// the measured costs are kept as a histogram over the bounds of the last
+// balance: bins per axis, and the estimate and seconds of each bin. Its
+// size doesn't depend on the number of domains rendered, so ranks can
+// sum it instead of exchanging every domain
+constexpr int32 cost_bins = 16;
+constexpr int32 cost_size = cost_bins * cost_bins * cost_bins;
+
+// bins of one axis of the histogram bounds (hist) covered by the range,
+// starting at bin lo. With range_weights each bin gets the fraction of
+// the range inside it (to spread a domain's cost), otherwise the fraction
+// of the bin covered by the range (to collect the cost of a region)
+void bin_weights(const Range &range,
+                 const Range &hist,
+                 const bool range_weights,
+                 int32 &lo,
+                 std::vector<float32> &weights)
+{
+  weights.clear();
+  lo = 0;
+  const Range clipped = range.intersect(hist);
+  if(clipped.is_empty())
+  {
+    return;
+  }
+
+  const float32 width = hist.length() / float32(cost_bins);
+  if(!(width > 0.f))
+  {
+    // flat along this axis, everything lands in the first bin
+    weights.push_back(1.f);
+    return;
+  }
+
+  lo = std::min(std::max(int32((clipped.min() - hist.min()) / width), 0),
+                cost_bins - 1);
+  const int32 hi = std::min(std::max(int32((clipped.max() - hist.min()) / width), 0),
+                            cost_bins - 1);
+  const float32 length = range.length();
+  for(int32 b = lo; b <= hi; ++b)
+  {
+    const float32 bin_min = hist.min() + float32(b) * width;
+    const float32 covered = std::max(std::min(clipped.max(), bin_min + width) -
+                                     std::max(clipped.min(), bin_min), 0.f);
+    float32 weight = 1.f;
+    if(length > 0.f)
+    {
+      weight = covered / (range_weights ? length : width);
+    }
+    weights.push_back(weight);
+  }
+}
+
+float32 sample_volume(Collection &collection, const int32 samples)
+{
+  AABB<> sample_bounds = collection.bounds();
+  float32 mag = (sample_bounds.max() - sample_bounds.min()).magnitude();
+  const float32 sample_distance = mag / float32(samples);
+  return sample_distance * sample_distance * sample_distance;
+}
+
+// costs recorded by the volume renderer since the last gather, and the
+// view and histogram bounds they are recorded for
+struct CostRecord
+{
+  bool m_on = false;
+  bool m_has_camera = false;
+  Camera m_camera;
+  float32 m_sample_volume = 1.f;
+  AABB<3> m_bounds;
+  // estimate and seconds per histogram bin, empty if nothing is recorded
+  std::vector<float32> m_costs;
+};
+
+CostRecord &cost_record()
+{
+  static CostRecord record;
+  return record;
+}
+
 }//namespace detail
 
 VolumeBalance::VolumeBalance()
   : m_use_prefix(true),
     m_piece_factor(0.9f),
-    m_threshold(2.0)
+    m_threshold(2.0),
+    m_use_timings(false),
+    m_total_estimate(0.f),
+    m_total_seconds(0.f)
+{
+}
+
+void
+VolumeBalance::record_cost(const AABB<3> &bounds,
+                           const float32 seconds)
+{
+  detail::CostRecord &record = detail::cost_record();
+  if(!record.m_on || !record.m_has_camera)
+  {
+    return;
+  }
+  const float32 estimate = work_estimate(bounds,
+                                         record.m_camera,
+                                         record.m_sample_volume);
+  record_cost(bounds, estimate, seconds);
+}
+
+void
+VolumeBalance::record_cost(const AABB<3> &bounds,
+                           const float32 estimate,
+                           const float32 seconds)
+{
+  detail::CostRecord &record = detail::cost_record();
+  if(!record.m_on || record.m_bounds.is_empty())
+  {
+    return;
+  }
+
+  int32 lo[3];
+  std::vector<float32> weights[3];
+  for(int32 d = 0; d < 3; ++d)
+  {
+    detail::bin_weights(bounds.m_ranges[d],
+                        record.m_bounds.m_ranges[d],
+                        true,
+                        lo[d],
+                        weights[d]);
+  }
+
+  if(record.m_costs.empty())
+  {
+    record.m_costs.resize(detail::cost_size * 2, 0.f);
+  }
+
+  // spread the domain over the bins it covers
+  for(int32 z = 0; z < weights[2].size(); ++z)
+  {
+    for(int32 y = 0; y < weights[1].size(); ++y)
+    {
+      for(int32 x = 0; x < weights[0].size(); ++x)
+      {
+        const float32 weight = weights[0][x] * weights[1][y] * weights[2][z];
+        const int32 bin = ((lo[2] + z) * detail::cost_bins + lo[1] + y)
+                          * detail::cost_bins + lo[0] + x;
+        record.m_costs[bin * 2] += weight * estimate;
+        record.m_costs[bin * 2 + 1] += weight * seconds;
+      }
+    }
+  }
+}
+
+void
+VolumeBalance::recording_costs(bool on)
+{
+  detail::cost_record().m_on = on;
+}
+
+bool
+VolumeBalance::recording_costs()
 {
+  return detail::cost_record().m_on;
+}
+
+void
+VolumeBalance::cost_bounds(const AABB<3> &bounds)
+{
+  detail::CostRecord &record = detail::cost_record();
+  record.m_bounds = bounds;
+  record.m_costs.clear();
+}
+
+void
+VolumeBalance::clear_costs()
+{
+  detail::cost_record().m_costs.clear();
+}
+
+void
+VolumeBalance::gather_costs()
+{
+  detail::CostRecord &record = detail::cost_record();
+  m_cost_bounds = record.m_bounds;
+  m_costs = record.m_costs;
+  m_costs.resize(detail::cost_size * 2, 0.f);
+#ifdef DRAY_MPI_ENABLED
+  MPI_Comm mpi_comm = MPI_Comm_f2c(dray::mpi_comm());
+  MPI_Allreduce(MPI_IN_PLACE,
+                m_costs.data(),
+                m_costs.size(),
+                MPI_FLOAT,
+                MPI_SUM,
+                mpi_comm);
+#endif
+  clear_costs();
+
+  m_total_estimate = 0.f;
+  m_total_seconds = 0.f;
+  for(int32 i = 0; i < detail::cost_size; ++i)
+  {
+    m_total_estimate += m_costs[i * 2];
+    m_total_seconds += m_costs[i * 2 + 1];
+  }
+}
+
+float32
+VolumeBalance::cost_factor(const AABB<3> &bounds) const
+{
+  if(m_total_estimate <= 0.f || m_total_seconds <= 0.f)
+  {
+    return 1.f;
+  }
+
+  int32 lo[3];
+  std::vector<float32> weights[3];
+  for(int32 d = 0; d < 3; ++d)
+  {
+    detail::bin_weights(bounds.m_ranges[d],
+                        m_cost_bounds.m_ranges[d],
+                        false,
+                        lo[d],
+                        weights[d]);
+  }
+
+  // costs of the bins the region covers
+  float32 estimate = 0.f;
+  float32 seconds = 0.f;
+  for(int32 z = 0; z < weights[2].size(); ++z)
+  {
+    for(int32 y = 0; y < weights[1].size(); ++y)
+    {
+      for(int32 x = 0; x < weights[0].size(); ++x)
+      {
+        const float32 weight = weights[0][x] * weights[1][y] * weights[2][z];
+        const int32 bin = ((lo[2] + z) * detail::cost_bins + lo[1] + y)
+                          * detail::cost_bins + lo[0] + x;
+        estimate += weight * m_costs[bin * 2];
+        seconds += weight * m_costs[bin * 2 + 1];
+      }
+    }
+  }
+
+  if(estimate <= 0.f)
+  {
+    return 1.f;
+  }
+
+  return (seconds / estimate) / (m_total_seconds / m_total_estimate);
 }
 
 float32
@@ -611,6 +850,15 @@ void VolumeBalance::allgather(std::vector<float32> &local_volumes,
 #endif
 }
 
+float32
+VolumeBalance::work_estimate(const AABB<3> &bounds,
+                             Camera &camera,
+                             const float32 sample_volume)
+{
+  const float32 pixels = static_cast<float32>(camera.subset_size(bounds));
+  return (bounds.volume() / sample_volume) * pixels;
+}
+
 float32
 VolumeBalance::volumes(Collection &collection,
                        Camera &camera,
@@ -620,10 +868,7 @@ VolumeBalance::volumes(Collection &collection,
   const int32 local_doms = collection.local_size();
   volumes.resize(local_doms);
 
-  AABB<> sample_bounds = collection.bounds();
-  float32 mag = (sample_bounds.max() - sample_bounds.min()).magnitude();
-  const float32 sample_distance = mag / float32(samples);
-  const float32 sample_volume = sample_distance * sample_distance * sample_distance;
+  const float32 sample_volume = detail::sample_volume(collection, samples);
 
   float32 total_volume = 0;
   for(int32 i = 0; i < collection.local_size(); ++i)
@@ -633,17 +878,16 @@ VolumeBalance::volumes(Collection &collection,
 
     //float32 samples = bounds.m_ranges[bounds.max_dim()].length() / sample_distance;
 
-    float32 volume = bounds.volume();
     // alternative volume calculation
     //detail::VolumeSumFunctor vfunc;
     //dispatch(dataset.mesh(), vfunc);
     //float32 volume = vfunc.m_sum;
 
-    float32 pixels = static_cast<float32>(camera.subset_size(bounds));
-    float32 normalized_pixels = pixels / float32(camera.get_width() + camera.get_height());
-    volumes[i] = volume * normalized_pixels;
-    //volumes[i] = volume * pixels;
-    volumes[i] = (volume/sample_volume) * pixels;
+    volumes[i] = work_estimate(bounds, camera, sample_volume);
+    if(m_use_timings)
+    {
+      volumes[i] *= cost_factor(bounds);
+    }
     total_volume += volumes[i];
   }
   return total_volume;
@@ -659,6 +903,24 @@ VolumeBalance::execute(Collection &collection, Camera &camera, int32 samples)
   DRAY_LOG_OPEN("volume_balance");
   Collection res;
 
+  // costs measured while rendering the last frame, then start recording
+  // the costs of this one against this view
+  if(m_use_timings)
+  {
+    gather_costs();
+    DRAY_LOG_ENTRY("measured_seconds", m_total_seconds);
+    detail::CostRecord &record = detail::cost_record();
+    record.m_camera = camera;
+    record.m_sample_volume = detail::sample_volume(collection, samples);
+    record.m_has_camera = true;
+    cost_bounds(collection.bounds());
+  }
+  else
+  {
+    clear_costs();
+  }
+  recording_costs(m_use_timings);
+
   const int32 local_doms = collection.local_size();
 
   std::vector<float32> local_volumes;
@@ -777,4 +1039,9 @@ void VolumeBalance::threshold(float32 value)
   m_threshold = value;
 }
 
+void VolumeBalance::use_timings(bool on)
+{
+  m_use_timings = on;
+}
+
 }//namespace dray
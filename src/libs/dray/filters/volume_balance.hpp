@@ -13,6 +13,13 @@ protected:
   bool m_use_prefix;
   float32 m_piece_factor;
   float32 m_threshold;
+  bool m_use_timings;
+  // histogram of the costs recorded on all ranks: estimate and seconds
+  // per bin over m_cost_bounds
+  std::vector<float32> m_costs;
+  AABB<3> m_cost_bounds;
+  float32 m_total_estimate;
+  float32 m_total_seconds;
 public:
   VolumeBalance();
 
@@ -22,6 +29,30 @@ public:
   void piece_factor(float32 size);
   // only load balance if the ratio of the max load / average load > value
   void threshold(float32 value);
+  // weight the projected volume estimates by the render times measured
+  // for the same region of space during the previous frame
+  void use_timings(bool on);
+
+  // called by the volume renderer for each domain it integrates. The
+  // estimate is computed with the camera and samples of the last balance,
+  // in the same unit the balancer uses
+  static void record_cost(const AABB<3> &bounds,
+                          const float32 seconds);
+  static void record_cost(const AABB<3> &bounds,
+                          const float32 estimate,
+                          const float32 seconds);
+  // costs are summed into a fixed histogram over the bounds set with
+  // cost_bounds, nothing is recorded before they are set
+  static void recording_costs(bool on);
+  static bool recording_costs();
+  static void cost_bounds(const AABB<3> &bounds);
+  static void clear_costs();
+
+  // collect the costs recorded on all ranks and clear the local record
+  void gather_costs();
+  // measured seconds per unit of estimated work for the region relative
+  // to the average over the whole histogram (1 if nothing is known)
+  float32 cost_factor(const AABB<3> &bounds) const;
 
   Collection execute(Collection &collection, Camera &camera, int32 samples);
 
@@ -50,6 +81,12 @@ public:
                  std::vector<int32> &global_offsets,
                  std::vector<float32> &global_volumes);
 
+  // projected work for a domain: samples inside its bounds times
+  // the pixels it covers
+  static float32 work_estimate(const AABB<3> &bounds,
+                               Camera &camera,
+                               const float32 sample_volume);
+
   float32 volumes(Collection &collection,
                   Camera &camera,
                   int32 samples,
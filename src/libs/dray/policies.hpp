@@ -15,22 +15,31 @@
 namespace dray
 {
 
+#define DRAY_DYNAMIC_TILE_SIZE 64
+
 #ifdef DRAY_CUDA_ENABLED
 #define BLOCK_SIZE 128
 using for_policy = RAJA::cuda_exec<BLOCK_SIZE>;
+using for_dynamic_policy = RAJA::cuda_exec<BLOCK_SIZE>;
 using reduce_policy = RAJA::cuda_reduce;
 using atomic_policy = RAJA::cuda_atomic;
 #elif defined(DRAY_HIP_ENABLED)
 #define BLOCK_SIZE 256
 using for_policy = RAJA::hip_exec<BLOCK_SIZE>;
+using for_dynamic_policy = RAJA::hip_exec<BLOCK_SIZE>;
 using reduce_policy = RAJA::hip_reduce;
 using atomic_policy = RAJA::hip_atomic;
 #elif defined(DRAY_OPENMP_ENABLED)
 using for_policy = RAJA::omp_parallel_for_exec;
+// iterations with very uneven cost (e.g., rays marching through high
+// order cells) are handed out to threads in small tiles as they finish
+using for_dynamic_policy =
+  RAJA::omp_parallel_exec<RAJA::omp_for_dynamic_exec<DRAY_DYNAMIC_TILE_SIZE>>;
 using reduce_policy = RAJA::omp_reduce;
 using atomic_policy = RAJA::omp_atomic;
 #else
 using for_policy = RAJA::seq_exec;
+using for_dynamic_policy = RAJA::seq_exec;
 using reduce_policy = RAJA::seq_reduce;
 using atomic_policy = RAJA::seq_atomic;
 #endif
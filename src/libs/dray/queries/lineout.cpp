@@ -21,6 +21,7 @@ namespace dray
 
 Lineout::Lineout()
   : m_samples(100),
+    m_locator(nullptr),
     m_empty_val(0)
 {
 }
@@ -54,6 +55,12 @@ Lineout::add_var(const std::string var)
   m_vars.push_back(var);
 }
 
+void
+Lineout::locator(PointLocator *locator)
+{
+  m_locator = locator;
+}
+
 void
 Lineout::empty_val(const Float val)
 {
@@ -188,6 +195,7 @@ Lineout::execute(Collection &collection)
   }
 
   locator.empty_val(m_empty_val);
+  locator.locator(m_locator);
 
   Array<Vec<Float,3>> points = create_points();
   PointLocation::Result lres = locator.execute(collection, points);
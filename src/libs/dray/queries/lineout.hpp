@@ -6,10 +6,13 @@
 namespace dray
 {
 
+class PointLocator;
+
 class Lineout
 {
 protected:
   int32 m_samples;
+  PointLocator *m_locator;
   Float m_empty_val;
   std::vector<Vec<Float,3>> m_starts;
   std::vector<Vec<Float,3>> m_ends;
@@ -31,6 +34,8 @@ public:
   void empty_val(const Float val);
   void add_line(const Vec<Float,3> start, const Vec<Float,3> end);
   void add_var(const std::string var);
+  // reuse the sample locations kept by locator (not owned)
+  void locator(PointLocator *locator);
   Lineout::Result execute(Collection &collection);
   Array<Vec<Float,3>> create_points();
 };
@@ -1,4 +1,5 @@
 #include <dray/queries/point_location.hpp>
+#include <dray/queries/point_locator.hpp>
 
 #include <dray/error.hpp>
 #include <dray/warning.hpp>
@@ -159,10 +160,17 @@ struct PointLocationLocateFunctor
 }//namespace detail
 
 PointLocation::PointLocation()
-  : m_empty_val(0)
+  : m_empty_val(0),
+    m_locator(nullptr)
 {
 }
 
+void
+PointLocation::locator(PointLocator *locator)
+{
+  m_locator = locator;
+}
+
 void
 PointLocation::add_var(const std::string var)
 {
@@ -254,6 +262,11 @@ PointLocation::execute(Collection &collection, Array<Vec<Float,3>> &points)
     array_memset(values[i], m_empty_val);
   }
 
+  if(m_locator != nullptr)
+  {
+    m_locator->locate(collection, points);
+  }
+
   bool has_data = false;
   for(int32 i = 0; i < collection.local_size(); ++i)
   {
@@ -261,8 +274,19 @@ PointLocation::execute(Collection &collection, Array<Vec<Float,3>> &points)
     // if the points are not found, the values won't be updated,
     // so at the end, we will should have all the field values
     DataSet data_set = collection.domain(i);
-    Array<Location> locs = data_set.mesh()->locate(points);
-    bool domain_has_data = detail::has_data(locs);
+    Array<Location> locs;
+    bool domain_has_data;
+    if(m_locator != nullptr)
+    {
+      locs = m_locator->locations(i);
+      domain_has_data = m_locator->has_data(i);
+    }
+    else
+    {
+      // without a persistent locator, the points are located from scratch
+      locs = data_set.mesh()->locate(points);
+      domain_has_data = detail::has_data(locs);
+    }
     if(domain_has_data)
     {
       has_data = true;
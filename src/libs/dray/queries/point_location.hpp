@@ -6,11 +6,14 @@
 namespace dray
 {
 
+class PointLocator;
+
 class PointLocation
 {
 protected:
   Float m_empty_val;
   std::vector<std::string> m_vars;
+  PointLocator *m_locator;
 public:
   PointLocation();
 
@@ -24,6 +27,8 @@ public:
 
   void empty_val(const Float val);
   void add_var(const std::string var);
+  // reuse the point locations kept by locator (not owned)
+  void locator(PointLocator *locator);
   PointLocation::Result execute(Collection &collection, Array<Vec<Float,3>> &points);
 };
 
@@ -0,0 +1,184 @@
+#include <dray/queries/point_locator.hpp>
+
+#include <dray/error.hpp>
+#include <dray/array_utils.hpp>
+#include <dray/utils/data_logger.hpp>
+
+#include <dray/dray.hpp>
+#include <dray/policies.hpp>
+#include <dray/error_check.hpp>
+#include <RAJA/RAJA.hpp>
+
+#include <list>
+#include <map>
+
+namespace dray
+{
+
+namespace detail
+{
+
+// defined in point_location.cpp
+bool has_data(const Array<Location> &locs);
+
+// process wide locators, the most recently used first
+struct LocatorCache
+{
+  std::list<std::pair<std::string, PointLocator>> m_locators;
+  std::map<std::string,
+           std::list<std::pair<std::string, PointLocator>>::iterator> m_index;
+};
+
+LocatorCache &locator_cache()
+{
+  static LocatorCache cache;
+  return cache;
+}
+
+}//namespace detail
+
+PointLocator::PointLocator()
+  : m_points_version(0),
+    m_points_hash(0),
+    m_points_size(-1),
+    m_located_domains(0)
+{
+}
+
+void
+PointLocator::locate(Collection &collection, Array<Vec<Float,3>> &points)
+{
+  DRAY_LOG_OPEN("point_locator");
+  const int32 points_size = points.size();
+  if(points.version() != m_points_version || points_size != m_points_size)
+  {
+    const uint64 points_hash = array_hash(points);
+    if(points_hash != m_points_hash || points_size != m_points_size)
+    {
+      // everything has to be located again
+      clear();
+      m_points_hash = points_hash;
+      m_points_size = points_size;
+    }
+    m_points_version = points.version();
+  }
+
+  const int32 num_domains = collection.local_size();
+  m_mesh_versions.resize(num_domains, 0);
+  m_mesh_hashes.resize(num_domains, 0);
+  m_locations.resize(num_domains);
+  m_has_data.resize(num_domains, false);
+  m_located_domains = 0;
+
+  for(int32 i = 0; i < num_domains; ++i)
+  {
+    DataSet data_set = collection.domain(i);
+    Mesh *mesh = data_set.mesh();
+    const bool located = m_locations[i].size() == points_size;
+    if(located && mesh->version() == m_mesh_versions[i])
+    {
+      continue;
+    }
+    // a new mesh object (e.g. converted again for this cycle) may still
+    // hold the same geometry
+    const uint64 mesh_hash = mesh->hash();
+    if(located && mesh_hash == m_mesh_hashes[i])
+    {
+      m_mesh_versions[i] = mesh->version();
+      continue;
+    }
+    if(located)
+    {
+      // the mesh moved, start from where the points were
+      m_locations[i] = mesh->locate(points, m_locations[i]);
+    }
+    else
+    {
+      m_locations[i] = mesh->locate(points);
+    }
+    m_has_data[i] = detail::has_data(m_locations[i]);
+    m_mesh_hashes[i] = mesh_hash;
+    // locating builds device views of the mesh, so read this afterwards
+    m_mesh_versions[i] = mesh->version();
+    m_located_domains++;
+  }
+  DRAY_LOG_ENTRY("located_domains", m_located_domains);
+  DRAY_LOG_CLOSE();
+}
+
+Array<Location>
+PointLocator::locations(const int32 domain) const
+{
+  if(domain < 0 || domain >= (int32) m_locations.size())
+  {
+    DRAY_ERROR("PointLocator: invalid domain index "<<domain);
+  }
+  return m_locations[domain];
+}
+
+bool
+PointLocator::has_data(const int32 domain) const
+{
+  if(domain < 0 || domain >= (int32) m_has_data.size())
+  {
+    DRAY_ERROR("PointLocator: invalid domain index "<<domain);
+  }
+  return m_has_data[domain];
+}
+
+int32
+PointLocator::located_domains() const
+{
+  return m_located_domains;
+}
+
+void
+PointLocator::clear()
+{
+  m_points_version = 0;
+  m_points_hash = 0;
+  m_points_size = -1;
+  m_mesh_versions.clear();
+  m_mesh_hashes.clear();
+  m_locations.clear();
+  m_has_data.clear();
+  m_located_domains = 0;
+}
+
+PointLocator &
+PointLocator::find(const std::string &key)
+{
+  detail::LocatorCache &cache = detail::locator_cache();
+  auto it = cache.m_index.find(key);
+  if(it != cache.m_index.end())
+  {
+    cache.m_locators.splice(cache.m_locators.begin(),
+                            cache.m_locators,
+                            it->second);
+    return it->second->second;
+  }
+
+  cache.m_locators.emplace_front(key, PointLocator());
+  cache.m_index[key] = cache.m_locators.begin();
+  if(cache.m_locators.size() > max_cached_locators)
+  {
+    cache.m_index.erase(cache.m_locators.back().first);
+    cache.m_locators.pop_back();
+  }
+  return cache.m_locators.front().second;
+}
+
+void
+PointLocator::clear_cache()
+{
+  detail::locator_cache().m_locators.clear();
+  detail::locator_cache().m_index.clear();
+}
+
+int32
+PointLocator::cache_size()
+{
+  return int32(detail::locator_cache().m_locators.size());
+}
+
+}//namespace dray
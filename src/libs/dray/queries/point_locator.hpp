@@ -0,0 +1,60 @@
+#ifndef DRAY_POINT_LOCATOR_HPP
+#define DRAY_POINT_LOCATOR_HPP
+
+#include <dray/data_model/collection.hpp>
+
+#include <string>
+#include <vector>
+
+namespace dray
+{
+
+//
+// Keeps the locations (cell ids and reference coordinates) of a set of
+// points in each local domain of a collection. Domains whose mesh is
+// unchanged since the last call keep their locations, so probes that stay
+// in place only need their fields evaluated again. A mesh whose arrays
+// were not touched is taken as unchanged without reading it; otherwise its
+// hash is compared. When a domain's mesh changes, the previous locations
+// are used as starting guesses, and new points are located from scratch.
+//
+class PointLocator
+{
+protected:
+  uint64 m_points_version;
+  uint64 m_points_hash;
+  int32 m_points_size;
+  std::vector<uint64> m_mesh_versions;
+  std::vector<uint64> m_mesh_hashes;
+  std::vector<Array<Location>> m_locations;
+  std::vector<bool> m_has_data;
+  int32 m_located_domains;
+public:
+  PointLocator();
+
+  // locates the points in every local domain of the collection
+  void locate(Collection &collection, Array<Vec<Float,3>> &points);
+  // the locations for local domain i, from the last call to locate
+  Array<Location> locations(const int32 domain) const;
+  // true if any of the points are inside local domain i
+  bool has_data(const int32 domain) const;
+  // the number of domains the last call to locate had to search
+  int32 located_domains() const;
+  void clear();
+
+  // the most locators kept by find
+  static constexpr size_t max_cached_locators = 32;
+
+  // process wide locators so probes can persist between executions,
+  // keyed by the caller. Only the max_cached_locators most recently
+  // used ones are kept, a locator stays valid until as many other keys
+  // have been used or the cache is cleared.
+  static PointLocator &find(const std::string &key);
+  static void clear_cache();
+  // the number of locators currently kept
+  static int32 cache_size();
+};
+
+};//namespace dray
+
+#endif//DRAY_POINT_LOCATOR_HPP
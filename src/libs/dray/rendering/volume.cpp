@@ -9,8 +9,11 @@
 
 #include <dray/dispatcher.hpp>
 #include <dray/array_utils.hpp>
+#include <dray/math.hpp>
 #include <dray/error_check.hpp>
+#include <dray/warning.hpp>
 #include <dray/device_color_map.hpp>
+#include <dray/filters/volume_balance.hpp>
 
 #include <dray/utils/data_logger.hpp>
 #include <dray/utils/timer.hpp>
@@ -66,6 +69,212 @@ Array<VolumePartial> compact_partials(const Array<VolumePartial> &partials)
   return gather(partials, compact_idxs);
 }
 
+// ------------------------------------------------------------------------
+// Empty space skipping. The domain bounds are split into a coarse grid of
+// macro cells, and a macro cell is marked visible when it overlaps the
+// bounds of a cell whose scalar range maps to a non-zero opacity (in
+// positive bases the field is bounded by its dofs). Samples that fall in
+// other macro cells are fully transparent, so rays jump over them.
+// Macro cells that only overlap transparent cells are marked occupied, so
+// a jump can tell whether it may have left the domain.
+// ------------------------------------------------------------------------
+struct MacroCells
+{
+  static constexpr int32 empty = 0;
+  static constexpr int32 occupied = 1;
+  static constexpr int32 visible = 2;
+
+  AABB<3> m_bounds;
+  Vec<int32,3> m_dims;
+  Vec<Float,3> m_inv_size;
+  Array<int32> m_state;
+};
+
+struct DeviceMacroCells
+{
+  const int32 *m_state;
+  AABB<3> m_bounds;
+  Vec<int32,3> m_dims;
+  Vec<Float,3> m_inv_size;
+
+  DeviceMacroCells(MacroCells &macro_cells)
+    : m_state(macro_cells.m_state.get_device_ptr_const()),
+      m_bounds(macro_cells.m_bounds),
+      m_dims(macro_cells.m_dims),
+      m_inv_size(macro_cells.m_inv_size)
+  {
+  }
+
+  DRAY_EXEC int32 axis_index(const Float value, const int32 axis) const
+  {
+    const int32 idx = static_cast<int32>((value - m_bounds.m_ranges[axis].min())
+                                         * m_inv_size[axis]);
+    return clamp(idx, 0, m_dims[axis] - 1);
+  }
+
+  // returns the first distance on the sample lattice (distance plus a
+  // multiple of sample_dist) that is in a visible macro cell, or a
+  // distance past the end of the ray. left is set if the jump passed
+  // through space that none of the domain's cells overlap.
+  DRAY_EXEC Float skip(const Ray &ray,
+                       Float distance,
+                       const Float sample_dist,
+                       bool &left) const
+  {
+    while(distance < ray.m_far)
+    {
+      const Vec<Float,3> point = ray.m_orig + distance * ray.m_dir;
+      Float exit_dist;
+      bool inside = true;
+      for(int32 d = 0; d < 3; ++d)
+      {
+        inside &= m_bounds.m_ranges[d].contains(point[d]);
+      }
+      if(!inside)
+      {
+        // jump to where the ray enters the grid, if it does
+        Float t_min, t_max;
+        span(ray, m_bounds, t_min, t_max);
+        left = true;
+        if(t_max < distance || t_min > t_max)
+        {
+          return ray.m_far;
+        }
+        exit_dist = t_min;
+      }
+      else
+      {
+        Vec<int32,3> idx;
+        for(int32 d = 0; d < 3; ++d)
+        {
+          idx[d] = axis_index(point[d], d);
+        }
+        const int32 state = m_state[(idx[2] * m_dims[1] + idx[1]) * m_dims[0] + idx[0]];
+        if(state == MacroCells::visible)
+        {
+          return distance;
+        }
+        left |= state == MacroCells::empty;
+        AABB<3> macro_cell;
+        for(int32 d = 0; d < 3; ++d)
+        {
+          const Float size = m_bounds.m_ranges[d].length() / Float(m_dims[d]);
+          const Float lo = m_bounds.m_ranges[d].min() + Float(idx[d]) * size;
+          macro_cell.m_ranges[d].include(lo);
+          macro_cell.m_ranges[d].include(lo + size);
+        }
+        Float t_min;
+        span(ray, macro_cell, t_min, exit_dist);
+      }
+      // always make progress
+      const Float steps = floor((exit_dist - distance) / sample_dist) + 1.f;
+      distance += fmaxf(steps, 1.f) * sample_dist;
+    }
+    return distance;
+  }
+
+  DRAY_EXEC static void span(const Ray &ray,
+                             const AABB<3> &box,
+                             Float &t_min,
+                             Float &t_max)
+  {
+    t_min = neg_infinity<Float>();
+    t_max = infinity<Float>();
+    for(int32 d = 0; d < 3; ++d)
+    {
+      const Float inv_dir = rcp_safe(ray.m_dir[d]);
+      const Float t0 = (box.m_ranges[d].min() - ray.m_orig[d]) * inv_dir;
+      const Float t1 = (box.m_ranges[d].max() - ray.m_orig[d]) * inv_dir;
+      t_min = fmaxf(t_min, fminf(t0, t1));
+      t_max = fminf(t_max, fmaxf(t0, t1));
+    }
+  }
+};
+
+template<typename MeshElement, typename FieldElement>
+MacroCells
+macro_cells(UnstructuredMesh<MeshElement> &mesh,
+            UnstructuredField<FieldElement> &field,
+            ColorMap &color_map)
+{
+  const int32 num_elems = mesh.cells();
+
+  MacroCells res;
+  res.m_bounds = mesh.bounds();
+  // about two cells per macro cell along the longest axis
+  const int32 max_res = clamp(int32(cbrt(float32(num_elems)) * 0.5f), 1, 64);
+  Float max_length = 0.f;
+  for(int32 d = 0; d < 3; ++d)
+  {
+    max_length = fmaxf(max_length, res.m_bounds.m_ranges[d].length());
+  }
+  int32 num_macro_cells = 1;
+  for(int32 d = 0; d < 3; ++d)
+  {
+    const Float length = res.m_bounds.m_ranges[d].length();
+    res.m_dims[d] = max_length > 0.f
+                    ? clamp(int32(max_res * length / max_length + 0.5f), 1, max_res)
+                    : 1;
+    res.m_inv_size[d] = length > 0.f ? Float(res.m_dims[d]) / length : 0.f;
+    num_macro_cells *= res.m_dims[d];
+  }
+
+  // running count of the color samples with a non-zero alpha, so
+  // any scalar range is classified with two lookups
+  Array<Vec<float32,4>> colors = color_map.colors();
+  const int32 num_colors = colors.size();
+  Array<int32> opaque_counts;
+  opaque_counts.resize(num_colors + 1);
+  const Vec<float32,4> *colors_ptr = colors.get_host_ptr_const();
+  int32 *opaque_counts_host_ptr = opaque_counts.get_host_ptr();
+  opaque_counts_host_ptr[0] = 0;
+  for(int32 i = 0; i < num_colors; ++i)
+  {
+    opaque_counts_host_ptr[i + 1] = opaque_counts_host_ptr[i]
+                                    + (colors_ptr[i][3] > 0.f ? 1 : 0);
+  }
+
+  res.m_state.resize(num_macro_cells);
+  array_memset_zero(res.m_state);
+
+  DeviceMesh<MeshElement> device_mesh(mesh);
+  DeviceField<FieldElement> device_field(field);
+  DeviceColorMap d_color_map(color_map);
+  DeviceMacroCells d_macro_cells(res);
+  const int32 *opaque_counts_ptr = opaque_counts.get_device_ptr_const();
+  int32 *state_ptr = res.m_state.get_device_ptr();
+
+  RAJA::forall<for_policy>(RAJA::RangeSegment(0, num_elems), [=] DRAY_LAMBDA (int32 i)
+  {
+    AABB<1> range;
+    device_field.get_elem(i).get_bounds(range);
+    const int32 lo = d_color_map.index(range.m_ranges[0].min());
+    const int32 hi = d_color_map.index(range.m_ranges[0].max());
+    const int32 state = opaque_counts_ptr[hi + 1] - opaque_counts_ptr[lo] == 0
+                        ? MacroCells::occupied
+                        : MacroCells::visible;
+
+    AABB<3> bounds;
+    device_mesh.get_elem(i).get_bounds(bounds);
+    Vec<int32,3> idx_min, idx_max;
+    for(int32 d = 0; d < 3; ++d)
+    {
+      idx_min[d] = d_macro_cells.axis_index(bounds.m_ranges[d].min(), d);
+      idx_max[d] = d_macro_cells.axis_index(bounds.m_ranges[d].max(), d);
+    }
+    const Vec<int32,3> dims = d_macro_cells.m_dims;
+    for(int32 z = idx_min[2]; z <= idx_max[2]; ++z)
+      for(int32 y = idx_min[1]; y <= idx_max[1]; ++y)
+        for(int32 x = idx_min[0]; x <= idx_max[0]; ++x)
+        {
+          RAJA::atomicMax<atomic_policy>(&state_ptr[(z * dims[1] + y) * dims[0] + x], state);
+        }
+  });
+  DRAY_ERROR_CHECK();
+
+  return res;
+}
+
 template<typename MeshElement, typename FieldElement>
 Array<VolumePartial>
 integrate_partials(UnstructuredMesh<MeshElement> &mesh,
@@ -75,7 +284,8 @@ integrate_partials(UnstructuredMesh<MeshElement> &mesh,
                    const int32 samples,
                    const AABB<3> bounds,
                    ColorMap &color_map,
-                   bool use_lighting)
+                   bool use_lighting,
+                   bool skip_empty_space)
 {
   DRAY_LOG_OPEN("volume");
   constexpr float32 correction_scalar = 10.f;
@@ -115,10 +325,20 @@ integrate_partials(UnstructuredMesh<MeshElement> &mesh,
 
 
   // complicated device stuff
-  DeviceMesh<MeshElement> device_mesh(mesh);
+  // consecutive samples are usually in the same or a neighboring cell,
+  // so locate them starting from the previous sample's cell
+  DeviceMesh<MeshElement> device_mesh(mesh, true, true);
 
   DeviceColorMap d_color_map(corrected);
 
+  Timer skip_timer;
+  MacroCells macro_cells = detail::macro_cells(mesh, field, corrected);
+  DeviceMacroCells d_macro_cells(macro_cells);
+  DRAY_LOG_ENTRY("macro_cells", skip_timer.elapsed());
+
+  // rays with more segments than fit keep accumulating into the last one
+  RAJA::ReduceSum<reduce_policy, int32> merged_rays(0);
+
 
   VolumeShader<MeshElement, FieldElement> shader(mesh,
                                                  field,
@@ -129,9 +349,10 @@ integrate_partials(UnstructuredMesh<MeshElement> &mesh,
   mstats.resize(ray_size);
   stats::Stats *mstats_ptr = mstats.get_device_ptr();
 
-  // TODO: somehow load balance based on far - near
+  // the cost of a ray depends on how far it marches through the
+  // mesh, so rays are handed out in tiles to whichever thread is free
   Timer timer;
-  RAJA::forall<for_policy>(RAJA::RangeSegment(0, ray_size), [=] DRAY_LAMBDA (int32 i)
+  RAJA::forall<for_dynamic_policy>(RAJA::RangeSegment(0, ray_size), [=] DRAY_LAMBDA (int32 i)
   {
     const Ray ray = rays_ptr[i];
     // advance the ray one step
@@ -139,6 +360,11 @@ integrate_partials(UnstructuredMesh<MeshElement> &mesh,
     constexpr Vec4f clear = {0.f, 0.f, 0.f, 0.f};
     const int32 partial_offset = max_segments * i;
     int32 segment = 0;
+    // the partial has samples that have not been written
+    bool open = false;
+    // all segments are used up, so the rest of the ray goes into the last
+    bool merging = false;
+    bool merged = false;
 
     VolumePartial partial;
 
@@ -148,15 +374,24 @@ integrate_partials(UnstructuredMesh<MeshElement> &mesh,
     stats::Stats mstat;
     mstat.construct();
 
-    for(int s = 0; s < max_segments; ++s)
+    while(distance < ray.m_far)
     {
       bool found = false;
+      bool left = false;
       // find next segment
-      Location loc;
+      Location loc{ -1, { -1.f, -1.f, -1.f } };
       while(distance < ray.m_far && !found)
       {
+        if(skip_empty_space)
+        {
+          distance = d_macro_cells.skip(ray, distance, sample_dist, left);
+        }
+        if(distance >= ray.m_far)
+        {
+          break;
+        }
         Vec<Float,3> point = ray.m_orig + distance * ray.m_dir;
-        loc = device_mesh.locate(point);
+        loc = device_mesh.locate(point, loc);
         if(loc.m_cell_id != -1)
         {
           found = true;
@@ -173,8 +408,17 @@ integrate_partials(UnstructuredMesh<MeshElement> &mesh,
         break;
       }
 
-      partial.m_depth = distance;
-      partial.m_color = clear;
+      if(merging)
+      {
+        merged = true;
+        merging = false;
+      }
+      else if(!open)
+      {
+        partial.m_depth = distance;
+        partial.m_color = clear;
+        open = true;
+      }
 
       int count = 0;
       mstat.acc_candidates(1);
@@ -197,28 +441,70 @@ integrate_partials(UnstructuredMesh<MeshElement> &mesh,
         count++;
 
         distance += sample_dist;
+        if(skip_empty_space)
+        {
+          left = false;
+          const Float next_distance = d_macro_cells.skip(ray, distance, sample_dist, left);
+          if(next_distance != distance)
+          {
+            distance = next_distance;
+            if(partial.m_color[3] == 0.f)
+            {
+              partial.m_depth = distance;
+            }
+            else if(left)
+            {
+              // the gap may hold another domain, so the segment ends
+              break;
+            }
+          }
+        }
         Vec<Float,3> point = ray.m_orig + distance * ray.m_dir;
-        loc = device_mesh.locate(point);
+        loc = device_mesh.locate(point, loc);
         found = loc.m_cell_id != -1;
       }
       while(distance < ray.m_far && found && partial.m_color[3] < 0.95f);
 
-      partials_ptr[partial_offset + segment] = partial;
-      segment++;
-
-      if(distance >= ray.m_far || partial.m_color[3] > 0.95f)
+      if(partial.m_color[3] > 0.95f)
       {
         // we are done
         break;
       }
 
-    } // for segments
+      if(segment < max_segments - 1)
+      {
+        partials_ptr[partial_offset + segment] = partial;
+        segment++;
+        open = false;
+      }
+      else
+      {
+        merging = true;
+      }
+    } // segments
+
+    if(open)
+    {
+      partials_ptr[partial_offset + segment] = partial;
+    }
+    if(merged)
+    {
+      merged_rays += 1;
+    }
     mstats_ptr[i] = mstat;
   });
   DRAY_ERROR_CHECK();
   DRAY_LOG_ENTRY("integrate_partials",timer.elapsed());
+  DRAY_LOG_ENTRY("merged_rays", merged_rays.get());
   stats::StatStore::add_ray_stats(active_rays, mstats);
 
+  if(merged_rays.get() > 0)
+  {
+    DRAY_WARNING("Volume: "<<merged_rays.get()<<" rays crossed the domain more than "
+              <<max_segments<<" times. Their remaining samples were blended into "
+              <<"their last segment.");
+  }
+
   timer.reset();
   partials = detail::compact_partials(partials);
   DRAY_LOG_ENTRY("compact",timer.elapsed());
@@ -236,21 +522,23 @@ struct IntegratePartialsFunctor
   Float m_samples;
   AABB<3> m_bounds;
   bool m_use_lighting;
+  bool m_skip_empty_space;
   Array<VolumePartial> m_partials;
   IntegratePartialsFunctor(Array<Ray> *rays,
                            Array<PointLight> &lights,
                            ColorMap &color_map,
                            Float samples,
                            AABB<3> bounds,
-                           bool use_lighting)
+                           bool use_lighting,
+                           bool skip_empty_space)
     :
       m_rays(rays),
       m_lights(lights),
       m_color_map(color_map),
       m_samples(samples),
       m_bounds(bounds),
-      m_use_lighting(use_lighting)
-
+      m_use_lighting(use_lighting),
+      m_skip_empty_space(skip_empty_space)
   {
   }
 
@@ -264,7 +552,8 @@ struct IntegratePartialsFunctor
                                             m_samples,
                                             m_bounds,
                                             m_color_map,
-                                            m_use_lighting);
+                                            m_use_lighting,
+                                            m_skip_empty_space);
   }
 };
 
@@ -275,6 +564,7 @@ Volume::Volume(Collection &collection)
   : m_samples(100),
     m_collection(collection),
     m_use_lighting(true),
+    m_skip_empty_space(true),
     m_active_domain(0)
 {
   // add some default alpha
@@ -345,8 +635,16 @@ Volume::integrate(Array<Ray> &rays, Array<PointLight> &lights)
                                         m_color_map,
                                         m_samples,
                                         m_bounds,
-                                        m_use_lighting);
+                                        m_use_lighting,
+                                        m_skip_empty_space);
+  Timer timer;
   dispatch_3d(mesh, field, func);
+
+  if(VolumeBalance::recording_costs())
+  {
+    VolumeBalance::record_cost(mesh->bounds(), timer.elapsed());
+  }
+
   return func.m_partials;
 }
 // ------------------------------------------------------------------------
@@ -363,6 +661,13 @@ void Volume::use_lighting(bool do_it)
   m_use_lighting = do_it;
 }
 
+// ------------------------------------------------------------------------
+
+void Volume::skip_empty_space(bool do_it)
+{
+  m_skip_empty_space = do_it;
+}
+
 
 // ------------------------------------------------------------------------
 
@@ -3,6 +3,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 namespace dray
 {
@@ -52,6 +53,13 @@ Logger::write(const int level, const std::string &message, const char *file, int
 /* ----------------------------------------------------------------------------------*/
 
 DataLogger DataLogger::m_instance;
+DataLogger::TraceCallback DataLogger::m_trace_sink = nullptr;
+
+namespace detail
+{
+// names of the open entries, so end events can be named
+static thread_local std::vector<std::string> trace_entries;
+} // namespace detail
 
 DataLogger::DataLogger()
   : m_at_block_start(true),
@@ -156,6 +164,7 @@ DataLogger::open(const std::string &entryName)
     m_timers.push(Timer());
     m_at_block_start = true;
 
+    trace_open(entryName);
 }
 
 void
@@ -167,6 +176,36 @@ DataLogger::close()
   m_blocks.pop();
   m_key_counters.pop();
   m_at_block_start = false;
+
+  trace_close();
+}
+
+void
+DataLogger::set_trace_callback(TraceCallback callback)
+{
+  m_trace_sink = callback;
+}
+
+void
+DataLogger::trace_open(const std::string &entryName)
+{
+  if(m_trace_sink == nullptr)
+  {
+    return;
+  }
+  detail::trace_entries.push_back(entryName);
+  m_trace_sink(TRACE_BEGIN, entryName.c_str(), 0.0);
+}
+
+void
+DataLogger::trace_close()
+{
+  if(m_trace_sink == nullptr || detail::trace_entries.empty())
+  {
+    return;
+  }
+  m_trace_sink(TRACE_END, detail::trace_entries.back().c_str(), 0.0);
+  detail::trace_entries.pop_back();
 }
 
 } // namespace dray
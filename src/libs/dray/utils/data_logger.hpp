@@ -1,12 +1,14 @@
 #ifndef DRAY_DATA_LOGGER_HPP
 #define DRAY_DATA_LOGGER_HPP
 
+#include <dray/dray_exports.h>
 #include <dray/utils/yaml_writer.hpp>
 #include <dray/utils/timer.hpp>
 
 #include <fstream>
 #include <map>
 #include <stack>
+#include <type_traits>
 
 namespace dray
 {
@@ -25,9 +27,20 @@ protected:
   static class Logger* m_instance;
 };
 
-class DataLogger
+class DRAY_API DataLogger
 {
 public:
+  // entries can also be forwarded as begin/end/counter events to an
+  // external tracer (ascent installs one when tracing is enabled).
+  // This works even when DRAY_ENABLE_LOGGING is off.
+  enum TracePhase
+  {
+    TRACE_BEGIN   = 0,
+    TRACE_END     = 1,
+    TRACE_COUNTER = 2
+  };
+  typedef void (*TraceCallback)(int phase, const char *name, double value);
+
   struct Block
   {
     int Indent;
@@ -50,6 +63,18 @@ public:
     write_indent();
     this->m_stream << key << ": " << value <<"\n";
     m_at_block_start = false;
+    trace_entry(key, value);
+  }
+
+  static void set_trace_callback(TraceCallback callback);
+  static bool trace_enabled() { return m_trace_sink != nullptr; }
+  void trace_open(const std::string &entryName);
+  void trace_close();
+
+  template<typename T>
+  void trace_entry(const std::string &key, const T &value)
+  {
+    trace_entry(key, value, typename std::is_arithmetic<T>::type());
   }
 
   void write_log();
@@ -68,6 +93,23 @@ protected:
   std::stack<std::map<std::string,int>> m_key_counters;
   bool m_at_block_start;
   int m_rank;
+
+  template<typename T>
+  void trace_entry(const std::string &key, const T &value, std::true_type)
+  {
+    if(m_trace_sink != nullptr)
+    {
+      m_trace_sink(TRACE_COUNTER, key.c_str(), static_cast<double>(value));
+    }
+  }
+
+  template<typename T>
+  void trace_entry(const std::string &, const T &, std::false_type)
+  {
+    // only numbers are forwarded
+  }
+
+  static TraceCallback m_trace_sink;
 };
 
 } // namspace dray
@@ -88,9 +130,9 @@ protected:
 #define DRAY_INFO(msg)
 #define DRAY_WARN(msg)
 
-#define DRAY_LOG_OPEN(name)
-#define DRAY_LOG_CLOSE()
-#define DRAY_LOG_ENTRY(key,value)
+#define DRAY_LOG_OPEN(name) { if(::dray::DataLogger::trace_enabled()) ::dray::DataLogger::get_instance()->trace_open(name); }
+#define DRAY_LOG_CLOSE() { if(::dray::DataLogger::trace_enabled()) ::dray::DataLogger::get_instance()->trace_close(); }
+#define DRAY_LOG_ENTRY(key,value) { if(::dray::DataLogger::trace_enabled()) ::dray::DataLogger::get_instance()->trace_entry(key,value); }
 #define DRAY_LOG_VALUE(value)
 #define DRAY_LOG_WRITE()
 #endif
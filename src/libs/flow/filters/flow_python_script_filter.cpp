@@ -21,6 +21,11 @@
 #include <string.h>
 #include <limits.h>
 #include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <sys/stat.h>
 
 // conduit python module capi header
 #include "conduit_python.hpp"
@@ -101,38 +106,73 @@ namespace filters
 namespace detail
 {
 
-PyObject* execute_python(PyObject *py_input,
-                        flow::PythonInterpreter *py_interp,
-                        conduit::Node &params)
+//-----------------------------------------------------------------------------
+// names of the module and helper functions that bind a script to flow
+//-----------------------------------------------------------------------------
+struct ScriptInterface
 {
-    std::string module_name = "flow_script_filter";
-    std::string input_func_name = "flow_input";
-    std::string set_output_func_name = "flow_set_output";
-
-    bool echo = false;
-    if( params.has_path("echo") &&
-        params["echo"].as_string() == "true")
-    {
-        echo = true;
-    }
+    std::string module_name;
+    std::string input_func_name;
+    std::string set_output_func_name;
+};
 
-    py_interp->set_echo(echo);
+//-----------------------------------------------------------------------------
+void
+script_interface(const conduit::Node &params,
+                 ScriptInterface &iface)
+{
+    iface.module_name = "flow_script_filter";
+    iface.input_func_name = "flow_input";
+    iface.set_output_func_name = "flow_set_output";
 
     if( params.has_path("interface/module") )
     {
-        module_name = params["interface/module"].as_string();
+        iface.module_name = params["interface/module"].as_string();
     }
 
     if( params.has_path("interface/input") )
     {
-        input_func_name = params["interface/input"].as_string();
+        iface.input_func_name = params["interface/input"].as_string();
     }
 
     if( params.has_path("interface/set_output") )
     {
-        set_output_func_name = params["interface/set_output"].as_string();
+        iface.set_output_func_name = params["interface/set_output"].as_string();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// file name presented as __file__ to the script (empty if none)
+//-----------------------------------------------------------------------------
+std::string
+script_file_name(const conduit::Node &params)
+{
+    std::string filter_source_file_path = "";
+
+    if( params.has_child("file") )
+    {
+        filter_source_file_path = params["file"].as_string();
     }
+    // this is used in the mpi case, where we read the file on one rank
+    // and present the script as "source", but we still want to present
+    // the file name
+    else if (params.has_child("source_file"))
+    {
+        filter_source_file_path = params["source_file"].as_string();
+    }
+
+    return filter_source_file_path;
+}
 
+//-----------------------------------------------------------------------------
+// creates (or finds) the binding module, defines the input and output
+// helpers in it and imports them into the global ns.
+// returns the module's dict (borrowed)
+//-----------------------------------------------------------------------------
+PyObject *
+setup_module(flow::PythonInterpreter *py_interp,
+             const ScriptInterface &iface)
+{
     std::ostringstream filter_setup_src_oss;
     // lookup or create a new module
     filter_setup_src_oss.str("");
@@ -146,24 +186,24 @@ PyObject* execute_python(PyObject *py_input,
                          << "    return mymod\n"
                          << "\n"
                          // setup the module
-                         << "flow_setup_module(\"" << module_name << "\")\n";
+                         << "flow_setup_module(\"" << iface.module_name << "\")\n";
     FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->run_script(filter_setup_src_oss.str()));
 
     filter_setup_src_oss.str();
     filter_setup_src_oss << "\n"
                          // import into the global dict
-                         << "import " << module_name << "\n"
+                         << "import " << iface.module_name << "\n"
                          << "\n";
     FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->run_script(filter_setup_src_oss.str()));
 
 
     // fetch the module from the global dict (borrowed)
-    PyObject *py_mod = py_interp->get_global_object(module_name);
+    PyObject *py_mod = py_interp->get_global_object(iface.module_name);
 
     // sanity check
     if( !PyModule_Check(py_mod) )
     {
-        CONDUIT_ERROR("Unexpected error: " << module_name
+        CONDUIT_ERROR("Unexpected error: " << iface.module_name
                       << " is not a python module!");
     }
 
@@ -171,21 +211,16 @@ PyObject* execute_python(PyObject *py_input,
     //  where we will place our methods and bind our input data
     PyObject *py_mod_dict = PyModule_GetDict(py_mod);
 
-    // bind our input data
-    FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->set_dict_object(py_mod_dict,
-                                                                  py_input,
-                                                                  "_flow_input"));
-
     // run script to establish input and output helpers in the module
     // note: global here binds to module scope
     filter_setup_src_oss.str("");
     filter_setup_src_oss << "\n"
                          << "_flow_output = None\n"
                          << "\n"
-                         << "def "<< input_func_name << "():\n"
+                         << "def "<< iface.input_func_name << "():\n"
                          << "    return _flow_input\n"
                          << "\n"
-                         << "def " << set_output_func_name <<  "(out):\n"
+                         << "def " << iface.set_output_func_name <<  "(out):\n"
                          << "    global _flow_output\n"
                          << "    _flow_output = out\n"
                          << "\n";
@@ -197,39 +232,318 @@ PyObject* execute_python(PyObject *py_input,
     // so the names are bound to the global ns
     filter_setup_src_oss.str("");
     filter_setup_src_oss << "\n"
-                         << "from " << module_name
+                         << "from " << iface.module_name
                          << " import "
-                         << input_func_name << ", "
-                         << set_output_func_name
+                         << iface.input_func_name << ", "
+                         << iface.set_output_func_name
                          << "\n";
 
     FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->run_script(filter_setup_src_oss.str()));
-    
-    std::string filter_source_file_path = "";
-    
-    if( params.has_child("file") )
+
+    return py_mod_dict;
+}
+
+//-----------------------------------------------------------------------------
+// inject the file name as __file__ in the global ns
+//-----------------------------------------------------------------------------
+void
+push_source_file(flow::PythonInterpreter *py_interp,
+                 const std::string &filter_source_file_path)
+{
+    std::ostringstream oss;
+    oss << "\n"
+        << "if not '_flow_source_file_stack' in globals():\n"
+        << "    _flow_source_file_stack = []\n"
+        << "if '__file__' in globals():\n"
+        << "    _flow_source_file_stack.append(__file__)\n"
+        << "__file__ = \"" << filter_source_file_path << "\"\n";
+    FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->run_script(oss.str()));
+}
+
+//-----------------------------------------------------------------------------
+// restore __file__ changed by push_source_file
+//-----------------------------------------------------------------------------
+void
+pop_source_file(flow::PythonInterpreter *py_interp)
+{
+    const std::string file_stack_src = "if len(_flow_source_file_stack) > 0:\n"
+                                       "    __file__ = _flow_source_file_stack.pop()\n";
+    FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->run_script(file_stack_src));
+}
+
+//-----------------------------------------------------------------------------
+// a script compiled and executed once, whose entry function is
+// called on every execute
+//-----------------------------------------------------------------------------
+struct CompiledScript
+{
+    PyObject *py_mod_dict; // binding module dict (owned)
+    PyObject *py_ns_dict;  // namespace the script ran in (owned)
+    PyObject *py_entry;    // entry function (owned)
+    std::string stamp;     // modification time and size of a script file
+};
+
+//-----------------------------------------------------------------------------
+// keyed by interface names, entry name, and script source or file.
+// The references belong to the interpreter that compiled the scripts.
+//-----------------------------------------------------------------------------
+struct CompiledScripts
+{
+    flow::PythonInterpreter *interp;
+    std::map<std::string, CompiledScript> scripts;
+};
+
+//-----------------------------------------------------------------------------
+CompiledScripts &
+compiled_scripts()
+{
+    static CompiledScripts cache = {NULL, std::map<std::string, CompiledScript>()};
+    return cache;
+}
+
+//-----------------------------------------------------------------------------
+void
+release_compiled_script(CompiledScript &compiled)
+{
+    Py_DECREF(compiled.py_entry);
+    Py_DECREF(compiled.py_ns_dict);
+    Py_DECREF(compiled.py_mod_dict);
+}
+
+//-----------------------------------------------------------------------------
+// drops every compiled script, the references are only released
+// while the interpreter that created them is still running
+//-----------------------------------------------------------------------------
+void
+release_compiled_scripts()
+{
+    CompiledScripts &cache = compiled_scripts();
+    if(cache.interp != NULL &&
+       cache.interp->is_running() &&
+       Py_IsInitialized())
     {
-        filter_source_file_path = params["file"].as_string();
+        std::map<std::string, CompiledScript>::iterator itr;
+        for(itr = cache.scripts.begin(); itr != cache.scripts.end(); ++itr)
+        {
+            release_compiled_script(itr->second);
+        }
     }
-    // this is used in the mpi case, where we read the file on one rank
-    // and present the script as "source", but we still want to present
-    // the file name
-    else if (params.has_child("source_file")) 
+    cache.scripts.clear();
+    cache.interp = NULL;
+}
+
+//-----------------------------------------------------------------------------
+// modification time and size of a script file, so an unchanged file
+// does not have to be read again
+//-----------------------------------------------------------------------------
+std::string
+script_file_stamp(const std::string &file_name)
+{
+    struct stat file_stat;
+    if(stat(file_name.c_str(), &file_stat) != 0)
     {
-        filter_source_file_path = params["source_file"].as_string();
+        CONDUIT_ERROR("python_script failed to open " << file_name);
+    }
+    std::ostringstream oss;
+    oss << file_stat.st_mtime << ":" << file_stat.st_size;
+    return oss.str();
+}
+
+//-----------------------------------------------------------------------------
+PyObject* execute_python_entry(PyObject *py_input,
+                               flow::PythonInterpreter *py_interp,
+                               conduit::Node &params)
+{
+    ScriptInterface iface;
+    script_interface(params, iface);
+
+    const std::string entry_func_name = params["entry"].as_string();
+    const std::string filter_source_file_path = script_file_name(params);
+
+    std::ostringstream key_oss;
+    key_oss << iface.module_name << "\n"
+            << iface.input_func_name << "\n"
+            << iface.set_output_func_name << "\n"
+            << entry_func_name << "\n"
+            << filter_source_file_path << "\n";
+
+    std::string stamp;
+    if( params.has_child("source") )
+    {
+        key_oss << "source\n" << params["source"].as_string();
+    }
+    else // file is the other case
+    {
+        key_oss << "file\n";
+        stamp = script_file_stamp(params["file"].as_string());
+    }
+    const std::string key = key_oss.str();
+
+    CompiledScripts &cache = compiled_scripts();
+    if(cache.interp != py_interp)
+    {
+        release_compiled_scripts();
+        cache.interp = py_interp;
+    }
+
+    std::map<std::string, CompiledScript> &scripts = cache.scripts;
+    std::map<std::string, CompiledScript>::iterator itr = scripts.find(key);
+
+    if(itr != scripts.end() && itr->second.stamp != stamp)
+    {
+        // the script file changed since it was compiled
+        release_compiled_script(itr->second);
+        scripts.erase(itr);
+        itr = scripts.end();
+    }
+
+    if(itr == scripts.end())
+    {
+        std::string script;
+        if( params.has_child("source") )
+        {
+            script = params["source"].as_string();
+        }
+        else
+        {
+            std::ifstream ifs(params["file"].as_string().c_str());
+            if(!ifs.is_open())
+            {
+                CONDUIT_ERROR("python_script failed to open "
+                              << params["file"].as_string());
+            }
+            script.assign((std::istreambuf_iterator<char>(ifs)),
+                          std::istreambuf_iterator<char>());
+        }
+
+        PyObject *py_mod_dict = setup_module(py_interp, iface);
+
+        // the module level code of the script runs once, with no input bound
+        FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->set_dict_object(py_mod_dict,
+                                                                      Py_None,
+                                                                      "_flow_input"));
+
+        if( !filter_source_file_path.empty() )
+        {
+            push_source_file(py_interp, filter_source_file_path);
+        }
+
+        // each script runs in its own copy of the global dict, so module
+        // level names (and the entry itself) of two scripts can't clash
+        PyObject *py_ns_dict = PyDict_Copy(py_interp->global_dict());
+        FLOW_CHECK_PYTHON_ERROR(py_interp, py_ns_dict != NULL);
+
+        if( !filter_source_file_path.empty() )
+        {
+            pop_source_file(py_interp);
+        }
+
+        PyObject *py_code = py_interp->compile_script(script,
+                                                      filter_source_file_path.empty() ?
+                                                      "<python_script>" :
+                                                      filter_source_file_path);
+        if(py_code == NULL)
+        {
+            Py_DECREF(py_ns_dict);
+        }
+        FLOW_CHECK_PYTHON_ERROR(py_interp, py_code != NULL);
+
+        bool ok = py_interp->run_code(py_code, py_ns_dict);
+        Py_DECREF(py_code);
+        if(!ok)
+        {
+            Py_DECREF(py_ns_dict);
+        }
+        FLOW_CHECK_PYTHON_ERROR(py_interp, ok);
+
+        PyObject *py_entry = py_interp->get_dict_object(py_ns_dict,
+                                                        entry_func_name);
+
+        if(py_entry == NULL || !PyCallable_Check(py_entry))
+        {
+            Py_DECREF(py_ns_dict);
+            CONDUIT_ERROR("python_script entry '" << entry_func_name
+                          << "' is not a function defined by the script");
+        }
+
+        CompiledScript compiled;
+        compiled.py_mod_dict = py_mod_dict;
+        compiled.py_ns_dict = py_ns_dict; // already a new reference
+        compiled.py_entry = py_entry;
+        compiled.stamp = stamp;
+        Py_INCREF(compiled.py_mod_dict);
+        Py_INCREF(compiled.py_entry);
+
+        itr = scripts.insert(std::make_pair(key, compiled)).first;
     }
-    
-    // inject the file name as __file__ in the module 
+
+    const CompiledScript &compiled = itr->second;
+
+    // bind our input data, so the input and output helpers still work
+    FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->set_dict_object(compiled.py_mod_dict,
+                                                                  py_input,
+                                                                  "_flow_input"));
+    FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->set_dict_object(compiled.py_mod_dict,
+                                                                  Py_None,
+                                                                  "_flow_output"));
+
+    PyObject *py_res = py_interp->call_function(compiled.py_entry, py_input);
+    FLOW_CHECK_PYTHON_ERROR(py_interp, py_res != NULL);
+
+    // the entry may return its result or pass it to set_output
+    if(py_res == Py_None)
+    {
+        Py_DECREF(py_res);
+        py_res = py_interp->get_dict_object(compiled.py_mod_dict,
+                                            "_flow_output");
+        if(py_res == NULL)
+        {
+            // bad!, it should at least be python's None
+            CONDUIT_ERROR("python_script failed to fetch output");
+        }
+        // we need to incref b/c py_res is borrowed, and flow will decref
+        // when it is done with the python object
+        Py_INCREF(py_res);
+    }
+
+    return py_res;
+}
+
+//-----------------------------------------------------------------------------
+PyObject* execute_python(PyObject *py_input,
+                        flow::PythonInterpreter *py_interp,
+                        conduit::Node &params)
+{
+    bool echo = false;
+    if( params.has_path("echo") &&
+        params["echo"].as_string() == "true")
+    {
+        echo = true;
+    }
+
+    py_interp->set_echo(echo);
+
+    if( params.has_child("entry") )
+    {
+        return execute_python_entry(py_input, py_interp, params);
+    }
+
+    ScriptInterface iface;
+    script_interface(params, iface);
+
+    PyObject *py_mod_dict = setup_module(py_interp, iface);
+
+    // bind our input data
+    FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->set_dict_object(py_mod_dict,
+                                                                  py_input,
+                                                                  "_flow_input"));
+
+    const std::string filter_source_file_path = script_file_name(params);
+
+    // inject the file name as __file__ in the module
     if( !filter_source_file_path.empty() )
     {
-        filter_setup_src_oss.str("");
-        filter_setup_src_oss << "\n"
-                             << "if not '_flow_source_file_stack' in globals():\n"
-                             << "    _flow_source_file_stack = []\n"
-                             << "if '__file__' in globals():\n"
-                             << "    _flow_source_file_stack.append(__file__)\n"
-                             << "__file__ = \"" << filter_source_file_path << "\"\n";
-        FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->run_script(filter_setup_src_oss.str()));
+        push_source_file(py_interp, filter_source_file_path);
     }
 
 
@@ -254,9 +568,7 @@ PyObject* execute_python(PyObject *py_input,
     // restore __file__ if changed
     if( !filter_source_file_path.empty() )
     {
-        const std::string file_stack_src = "if len(_flow_source_file_stack) > 0:\n"
-                                           "    __file__ = _flow_source_file_stack.pop()\n";
-        FLOW_CHECK_PYTHON_ERROR(py_interp, py_interp->run_script(file_stack_src));
+        pop_source_file(py_interp);
     }
 
     // we need to incref b/c py_res is borrowed, and flow will decref
@@ -277,6 +589,8 @@ flow::PythonInterpreter *PythonScript::interpreter()
 {
     if(m_interp == NULL)
     {
+        // anything compiled by a previous interpreter is gone
+        detail::release_compiled_scripts();
         m_interp = new PythonInterpreter();
 
         if(!m_interp->initialize())
@@ -307,6 +621,13 @@ flow::PythonInterpreter *PythonScript::interpreter()
     return m_interp;
 }
 
+//-----------------------------------------------------------------------------
+void
+PythonScript::clear_compiled_scripts()
+{
+    detail::release_compiled_scripts();
+}
+
 //-----------------------------------------------------------------------------
 PythonScript::PythonScript()
 :Filter()
@@ -371,6 +692,19 @@ PythonScript::verify_params(const conduit::Node &params,
         }
     }
 
+    if( params.has_child("entry") )
+    {
+        if( !params["entry"].dtype().is_string() )
+        {
+            info["errors"].append() = "parameter 'entry' is not a string";
+            res = false;
+        }
+        else
+        {
+            info["info"].append().set("provides 'entry' function, script is compiled once");
+        }
+    }
+
     if( params.has_child("interface") )
     {
         const Node &n_iface = params["interface"];
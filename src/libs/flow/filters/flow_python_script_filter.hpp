@@ -60,6 +60,10 @@ public:
                                  conduit::Node &info);
     virtual void   execute();
 
+    // releases the scripts kept compiled for 'entry' functions,
+    // call before the python interpreter goes away
+    static void    clear_compiled_scripts();
+
 protected:
     void execute_python(conduit::Node *n);
 private:
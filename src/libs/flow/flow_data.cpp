@@ -61,6 +61,22 @@ Data::data_ptr() const
 {
     return m_data_ptr;
 }
+//-----------------------------------------------------------------------------
+index_t
+Data::bytes() const
+{
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+template <>
+index_t
+DataWrapper<Node>::bytes() const
+{
+    const Node *n = value<Node>();
+    return n != NULL ? n->total_bytes_allocated() : 0;
+}
+
 //-----------------------------------------------------------------------------
 void
 Data::info(Node &out) const
@@ -69,6 +85,7 @@ Data::info(Node &out) const
     ostringstream oss;
     oss << m_data_ptr;
     out["data_ptr"] = oss.str();
+    out["bytes"] = bytes();
 }
 
 
@@ -59,6 +59,8 @@ public:
     virtual Data  *wrap(void *data)   = 0;
     // actually delete the data
     virtual void            release() = 0;
+    // estimated memory held by the data, 0 when unknown
+    virtual conduit::index_t bytes() const;
 
     void          *data_ptr();
     const  void   *data_ptr() const;
@@ -129,8 +131,17 @@ class DataWrapper: public Data
             set_data_ptr(NULL);
         }
     }
+
+    virtual conduit::index_t bytes() const
+    {
+        return 0;
+    }
 };
 
+// conduit nodes report the memory they own
+template <>
+FLOW_API conduit::index_t DataWrapper<conduit::Node>::bytes() const;
+
 
 // this needs to be declared here to cement proper symbol visibly
 // to use runtime type checking in further libs
@@ -521,6 +521,83 @@ PythonInterpreter::run_script_file(const std::string &fname,
     return run_script(py_script, py_dict);
 }
 
+//-----------------------------------------------------------------------------
+///
+/// Compiles passed python script into a code object that can be
+/// executed many times with run_code.
+//-----------------------------------------------------------------------------
+PyObject *
+PythonInterpreter::compile_script(const std::string &script,
+                                  const std::string &file_name)
+{
+    PyObject *res = NULL;
+    if(m_running)
+    {
+        if(m_echo)
+        {
+            CONDUIT_INFO("PythonInterpreter::compile_script " << script);
+        }
+
+        res = Py_CompileString((char*)script.c_str(),
+                               (char*)file_name.c_str(),
+                               Py_file_input);
+        if(check_error())
+        {
+            Py_XDECREF(res);
+            res = NULL;
+        }
+    }
+    return res;
+}
+
+//-----------------------------------------------------------------------------
+///
+/// Executes a code object from compile_script in the given dict.
+//-----------------------------------------------------------------------------
+bool
+PythonInterpreter::run_code(PyObject *py_code,
+                            PyObject *py_dict)
+{
+    bool res = false;
+    if(m_running && py_code != NULL)
+    {
+#ifdef IS_PY3K
+        PyObject *py_res = PyEval_EvalCode(py_code,
+                                           py_dict,
+                                           py_dict);
+#else
+        PyObject *py_res = PyEval_EvalCode((PyCodeObject*)py_code,
+                                           py_dict,
+                                           py_dict);
+#endif
+        Py_XDECREF(py_res);
+        if(!check_error())
+            res = true;
+    }
+    return res;
+}
+
+//-----------------------------------------------------------------------------
+///
+/// Calls a python callable with a single argument.
+//-----------------------------------------------------------------------------
+PyObject *
+PythonInterpreter::call_function(PyObject *py_func,
+                                 PyObject *py_arg)
+{
+    PyObject *res = NULL;
+    if(m_running)
+    {
+        res = PyObject_CallFunctionObjArgs(py_func, py_arg, NULL);
+        if(check_error())
+        {
+            Py_XDECREF(res);
+            res = NULL;
+        }
+    }
+    return res;
+}
+
 
 
 //-----------------------------------------------------------------------------
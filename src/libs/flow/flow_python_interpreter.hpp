@@ -73,6 +73,18 @@ public:
     bool         run_script_file(const std::string &fname,
                                  PyObject *py_dict);
 
+    /// compile once, exec many
+    /// compile_script returns a new reference to a code object
+    /// (or NULL on error), file_name is used in tracebacks
+    PyObject    *compile_script(const std::string &script,
+                                const std::string &file_name);
+    bool         run_code(PyObject *py_code,
+                          PyObject *py_dict);
+
+    /// calls py_func(py_arg), returns a new reference (or NULL on error)
+    PyObject    *call_function(PyObject *py_func,
+                               PyObject *py_arg);
+
     /// set into global dict
     bool         set_global_object(PyObject *py_obj,
                                    const std::string &name);
@@ -0,0 +1,443 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: flow_trace.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "flow_trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+
+using namespace conduit;
+
+//-----------------------------------------------------------------------------
+// -- begin flow:: --
+//-----------------------------------------------------------------------------
+namespace flow
+{
+
+//-----------------------------------------------------------------------------
+// -- begin flow::detail --
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+// events per thread before the ring buffer wraps
+const size_t TRACE_BUFFER_SIZE = 16384;
+
+//-----------------------------------------------------------------------------
+// single writer (the owning thread), read by flush()
+//-----------------------------------------------------------------------------
+struct TraceBuffer
+{
+    TraceBuffer(int id)
+    : thread_id(id),
+      events(TRACE_BUFFER_SIZE),
+      count(0),
+      flushed(0)
+    {}
+
+    int                         thread_id;
+    std::vector<Trace::Event>   events;
+    std::atomic<uint64>         count;
+    uint64                      flushed;
+};
+
+//-----------------------------------------------------------------------------
+struct TraceState
+{
+    TraceState()
+    : enabled(false),
+      dropped(0),
+      start(std::chrono::steady_clock::now())
+    {}
+
+    std::atomic<bool>                          enabled;
+    index_t                                    dropped;
+    std::chrono::steady_clock::time_point      start;
+    // guards registration of new thread buffers and flush
+    std::mutex                                 mutex;
+    std::vector<std::unique_ptr<TraceBuffer>>  buffers;
+};
+
+//-----------------------------------------------------------------------------
+TraceState &
+trace_state()
+{
+    static TraceState state;
+    return state;
+}
+
+//-----------------------------------------------------------------------------
+TraceBuffer *
+thread_buffer()
+{
+    // buffers are owned by the trace state, so events recorded by
+    // threads that have exited can still be flushed
+    static thread_local TraceBuffer *buffer = NULL;
+    if(buffer == NULL)
+    {
+        TraceState &state = trace_state();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        int id = static_cast<int>(state.buffers.size());
+        state.buffers.emplace_back(new TraceBuffer(id));
+        buffer = state.buffers.back().get();
+    }
+    return buffer;
+}
+
+//-----------------------------------------------------------------------------
+void
+record(const std::string &name,
+       const char *category,
+       int phase,
+       int64 domain_id,
+       int64 bytes,
+       int64 cells,
+       double value)
+{
+    TraceState &state = trace_state();
+    const double time = std::chrono::duration<double, std::micro>(
+                          std::chrono::steady_clock::now() - state.start).count();
+
+    TraceBuffer *buffer = thread_buffer();
+    const uint64 idx = buffer->count.load(std::memory_order_relaxed);
+    Trace::Event &event = buffer->events[idx % buffer->events.size()];
+
+    const size_t name_len = std::min(name.size(), sizeof(event.name) - 1);
+    memcpy(event.name, name.c_str(), name_len);
+    event.name[name_len] = '\0';
+    event.category  = category;
+    event.phase     = phase;
+    event.thread_id = buffer->thread_id;
+    event.domain_id = domain_id;
+    event.bytes     = bytes;
+    event.cells     = cells;
+    event.value     = value;
+    event.time      = time;
+
+    // publish the event
+    buffer->count.store(idx + 1, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+bool
+event_time_less(const Trace::Event &a, const Trace::Event &b)
+{
+    return a.time < b.time;
+}
+
+//-----------------------------------------------------------------------------
+std::string
+json_escape(const char *str)
+{
+    std::string res;
+    for(const char *c = str; *c != '\0'; ++c)
+    {
+        if(*c == '"' || *c == '\\')
+        {
+            res += '\\';
+            res += *c;
+        }
+        else if(static_cast<unsigned char>(*c) < 0x20)
+        {
+            res += ' ';
+        }
+        else
+        {
+            res += *c;
+        }
+    }
+    return res;
+}
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end flow::detail --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+Trace::enable(bool on)
+{
+    detail::trace_state().enabled.store(on, std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+bool
+Trace::enabled()
+{
+    return detail::trace_state().enabled.load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::begin(const std::string &name,
+             const char *category,
+             int64 domain_id,
+             int64 bytes,
+             int64 cells)
+{
+    if(!enabled())
+    {
+        return;
+    }
+    detail::record(name, category, BEGIN, domain_id, bytes, cells, 0.0);
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::end(const std::string &name,
+           const char *category,
+           int64 domain_id,
+           int64 bytes,
+           int64 cells)
+{
+    if(!enabled())
+    {
+        return;
+    }
+    detail::record(name, category, END, domain_id, bytes, cells, 0.0);
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::counter(const std::string &name,
+               double value,
+               const char *category)
+{
+    if(!enabled())
+    {
+        return;
+    }
+    detail::record(name, category, COUNTER, -1, -1, -1, value);
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::flush(std::vector<Event> &events)
+{
+    events.clear();
+    detail::TraceState &state = detail::trace_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    for(size_t i = 0; i < state.buffers.size(); ++i)
+    {
+        detail::TraceBuffer &buffer = *state.buffers[i];
+        const uint64 count = buffer.count.load(std::memory_order_acquire);
+        const uint64 size  = buffer.events.size();
+
+        uint64 first = buffer.flushed;
+        if(count - first > size)
+        {
+            // the ring wrapped, the oldest events are gone
+            state.dropped += static_cast<index_t>(count - size - first);
+            first = count - size;
+        }
+
+        for(uint64 idx = first; idx < count; ++idx)
+        {
+            events.push_back(buffer.events[idx % size]);
+        }
+        buffer.flushed = count;
+    }
+
+    std::stable_sort(events.begin(), events.end(), detail::event_time_less);
+}
+
+//-----------------------------------------------------------------------------
+index_t
+Trace::number_of_dropped_events()
+{
+    detail::TraceState &state = detail::trace_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.dropped;
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::write_chrome_trace(const std::vector<Event> &events,
+                          int pid,
+                          std::ostream &os)
+{
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for(size_t i = 0; i < events.size(); ++i)
+    {
+        const Event &event = events[i];
+        const std::string name = detail::json_escape(event.name);
+
+        if(i > 0)
+        {
+            os << ",";
+        }
+
+        os << "\n{\"name\":\"" << name << "\""
+           << ",\"cat\":\"" << detail::json_escape(event.category) << "\""
+           << ",\"pid\":" << pid
+           << ",\"tid\":" << event.thread_id
+           << ",\"ts\":" << std::fixed << event.time;
+
+        if(event.phase == COUNTER)
+        {
+            os << ",\"ph\":\"C\",\"args\":{\"" << name << "\":"
+               << event.value << "}";
+        }
+        else
+        {
+            os << ",\"ph\":\"" << (event.phase == BEGIN ? "B" : "E") << "\""
+               << ",\"args\":{";
+            bool first = true;
+            if(event.domain_id >= 0)
+            {
+                os << "\"domain_id\":" << event.domain_id;
+                first = false;
+            }
+            if(event.bytes >= 0)
+            {
+                os << (first ? "" : ",") << "\"bytes\":" << event.bytes;
+                first = false;
+            }
+            if(event.cells >= 0)
+            {
+                os << (first ? "" : ",") << "\"cells\":" << event.cells;
+            }
+            os << "}";
+        }
+        os << "}";
+    }
+    os << "\n]}\n";
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::write_chrome_trace(const std::vector<Event> &events,
+                          int pid,
+                          const std::string &file_name)
+{
+    std::ofstream ofs(file_name.c_str());
+    if(!ofs.is_open())
+    {
+        CONDUIT_ERROR("Trace: failed to open " << file_name);
+    }
+    write_chrome_trace(events, pid, ofs);
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::summary(const std::vector<Event> &events,
+               Node &out)
+{
+    out.reset();
+
+    // open begin events per thread, matched by name
+    std::map<int, std::vector<const Event*>> open_events;
+
+    for(size_t i = 0; i < events.size(); ++i)
+    {
+        const Event &event = events[i];
+
+        if(event.phase == BEGIN)
+        {
+            open_events[event.thread_id].push_back(&event);
+            continue;
+        }
+
+        Node &entry = out[event.category].add_child(event.name);
+
+        if(event.phase == COUNTER)
+        {
+            entry["count"] = entry.has_child("count") ?
+                             entry["count"].to_int64() + 1 : 1;
+            entry["value"] = event.value;
+            continue;
+        }
+
+        // end event, find the matching begin (innermost first)
+        std::vector<const Event*> &stack = open_events[event.thread_id];
+        const Event *begin = NULL;
+        for(size_t j = stack.size(); j > 0; --j)
+        {
+            if(strcmp(stack[j-1]->name, event.name) == 0)
+            {
+                begin = stack[j-1];
+                stack.erase(stack.begin() + (j-1));
+                break;
+            }
+        }
+
+        if(begin == NULL)
+        {
+            // the begin was flushed in a previous cycle or dropped
+            continue;
+        }
+
+        const double seconds = (event.time - begin->time) * 1e-6;
+        if(!entry.has_child("count"))
+        {
+            entry["count"] = (int64) 0;
+            entry["total_time"] = 0.0;
+            entry["max_time"] = 0.0;
+        }
+        entry["count"] = entry["count"].to_int64() + 1;
+        entry["total_time"] = entry["total_time"].to_float64() + seconds;
+        entry["max_time"] = std::max(entry["max_time"].to_float64(), seconds);
+
+        const int64 bytes = std::max(begin->bytes, event.bytes);
+        if(bytes >= 0)
+        {
+            entry["bytes"] = (entry.has_child("bytes") ?
+                              entry["bytes"].to_int64() : 0) + bytes;
+        }
+        const int64 cells = std::max(begin->cells, event.cells);
+        if(cells >= 0)
+        {
+            entry["cells"] = (entry.has_child("cells") ?
+                              entry["cells"].to_int64() : 0) + cells;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+TraceScope::TraceScope(const std::string &name,
+                       const char *category,
+                       int64 domain_id)
+: m_name(name),
+  m_category(category),
+  m_domain_id(domain_id),
+  m_active(Trace::enabled())
+{
+    if(m_active)
+    {
+        Trace::begin(m_name, m_category, m_domain_id);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TraceScope::~TraceScope()
+{
+    if(m_active)
+    {
+        Trace::end(m_name, m_category, m_domain_id);
+    }
+}
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end flow:: --
+//-----------------------------------------------------------------------------
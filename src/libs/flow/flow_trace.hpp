@@ -0,0 +1,134 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: flow_trace.hpp
+///
+//-----------------------------------------------------------------------------
+
+#ifndef FLOW_TRACE_HPP
+#define FLOW_TRACE_HPP
+
+#include <flow_exports.h>
+#include <conduit.hpp>
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- begin flow:: --
+//-----------------------------------------------------------------------------
+namespace flow
+{
+
+//-----------------------------------------------------------------------------
+///
+/// Trace is a process wide event recorder. Each thread records begin, end
+/// and counter events into its own ring buffer without locking, all events
+/// share one clock. Recording is off until enable(true) is called.
+///
+/// flush() must not be called while other threads are recording (in
+/// practice, call it between executions).
+///
+//-----------------------------------------------------------------------------
+class FLOW_API Trace
+{
+public:
+    enum Phase
+    {
+        BEGIN   = 0,
+        END     = 1,
+        COUNTER = 2
+    };
+
+    struct Event
+    {
+        char            name[48];
+        // category must point to a string literal
+        const char     *category;
+        int             phase;
+        int             thread_id;
+        conduit::int64  domain_id;
+        conduit::int64  bytes;
+        conduit::int64  cells;
+        double          value;
+        // micro seconds since the trace clock started
+        double          time;
+    };
+
+    static void   enable(bool on);
+    static bool   enabled();
+
+    static void   begin(const std::string &name,
+                        const char *category = "flow",
+                        conduit::int64 domain_id = -1,
+                        conduit::int64 bytes = -1,
+                        conduit::int64 cells = -1);
+
+    static void   end(const std::string &name,
+                      const char *category = "flow",
+                      conduit::int64 domain_id = -1,
+                      conduit::int64 bytes = -1,
+                      conduit::int64 cells = -1);
+
+    static void   counter(const std::string &name,
+                          double value,
+                          const char *category = "flow");
+
+    /// moves all recorded events (sorted by time) into events
+    static void   flush(std::vector<Event> &events);
+    /// events lost because a thread's ring buffer wrapped
+    static conduit::index_t number_of_dropped_events();
+
+    /// Chrome trace / Perfetto json, pid is usually the mpi rank
+    static void   write_chrome_trace(const std::vector<Event> &events,
+                                     int pid,
+                                     std::ostream &os);
+    static void   write_chrome_trace(const std::vector<Event> &events,
+                                     int pid,
+                                     const std::string &file_name);
+
+    /// per category/name counts, total and max times (seconds),
+    /// and summed bytes and cells
+    static void   summary(const std::vector<Event> &events,
+                          conduit::Node &out);
+};
+
+//-----------------------------------------------------------------------------
+/// records a begin event now, and the matching end event when it
+/// goes out of scope
+//-----------------------------------------------------------------------------
+class FLOW_API TraceScope
+{
+public:
+    TraceScope(const std::string &name,
+               const char *category = "flow",
+               conduit::int64 domain_id = -1);
+   ~TraceScope();
+
+private:
+    std::string     m_name;
+    const char     *m_category;
+    conduit::int64  m_domain_id;
+    bool            m_active;
+};
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end flow:: --
+//-----------------------------------------------------------------------------
+
+#define FLOW_TRACE_SCOPE(name) flow::TraceScope FLOW_TRACE_SCOPE_##name(#name);
+
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
@@ -13,12 +13,15 @@
 
 #include "flow_workspace.hpp"
 #include "flow_timer.hpp"
+#include "flow_trace.hpp"
 
 // standard lib includes
 #include <iostream>
 #include <string.h>
 #include <limits.h>
 #include <cstdlib>
+#include <algorithm>
+#include <vector>
 
 using namespace conduit;
 using namespace std;
@@ -34,6 +37,7 @@ namespace flow
 // pick a safe non-inited value w/o the mpi headers, but
 // we will try this strategy.
 int Workspace::m_default_mpi_comm = -1;
+Workspace::OutputBytesReducer Workspace::m_output_bytes_reducer = NULL;
 static int g_timing_exec_count = 0;
 
 //-----------------------------------------------------------------------------
@@ -44,6 +48,11 @@ class Workspace::ExecutionPlan
         static void generate(Graph &g,
                              conduit::Node &traversals);
 
+        static void generate_memory_aware(Graph &g,
+                                          const std::map<std::string,index_t> &output_bytes,
+                                          conduit::Node &traversals,
+                                          index_t &peak_bytes);
+
     private:
         ExecutionPlan();
         ~ExecutionPlan();
@@ -52,6 +61,11 @@ class Workspace::ExecutionPlan
                                        const std::string &filter_name,
                                        conduit::Node &tags,
                                        conduit::Node &tarv);
+
+        static index_t freed_bytes(Graph &graph,
+                                   const std::string &filter_name,
+                                   std::map<std::string,int> &refs,
+                                   std::map<std::string,index_t> &est);
 };
 
 //-----------------------------------------------------------------------------
@@ -207,6 +221,188 @@ Workspace::ExecutionPlan::bf_topo_sort_visit(Graph &graph,
 
 }
 
+//-----------------------------------------------------------------------------
+// Greedy list schedule. A filter can run once all of its inputs exist, of
+// those, pick the one that grows the live bytes the least: its output
+// estimate minus the inputs it is the last consumer of. Ties go to the
+// filter that became ready last, so without estimates (first execution)
+// the order is depth first.
+//
+// The result is a single traversal that holds every filter.
+//-----------------------------------------------------------------------------
+void
+Workspace::ExecutionPlan::generate_memory_aware(Graph &graph,
+                                                const std::map<std::string,index_t> &output_bytes,
+                                                conduit::Node &traversals,
+                                                index_t &peak_bytes)
+{
+    traversals.reset();
+    peak_bytes = 0;
+
+    // number of input ports whose filter has not run yet
+    std::map<std::string,int>     inputs_needed;
+    // number of consumers that have not run yet
+    std::map<std::string,int>     refs;
+    std::map<std::string,index_t> est;
+    std::vector<std::string>      ready;
+
+    std::map<std::string,Filter*>::iterator itr;
+
+    for(itr  = graph.m_filters.begin();
+        itr != graph.m_filters.end();
+        itr++)
+    {
+        Filter *f = itr->second;
+        std::string f_name = f->name();
+
+        int uref = 1;
+        est[f_name] = 0;
+        if(f->output_port())
+        {
+            int num_refs = graph.edges_out(f_name).number_of_children();
+            uref = num_refs > 0 ? num_refs : 1;
+
+            std::map<std::string,index_t>::const_iterator b_itr;
+            b_itr = output_bytes.find(f_name);
+            if(b_itr != output_bytes.end())
+            {
+                est[f_name] = b_itr->second;
+            }
+        }
+        refs[f_name] = uref;
+
+        int num_inputs = 0;
+        if ( f->port_names().number_of_children() > 0 )
+        {
+            NodeConstIterator f_inputs(&graph.edges_in(f_name));
+
+            while(f_inputs.has_next())
+            {
+                const Node &n_f_input = f_inputs.next();
+
+                if(!n_f_input.dtype().is_string())
+                {
+                    index_t port_idx = f_inputs.index();
+                    CONDUIT_ERROR("Filter " << f->detailed_name()
+                                  << " is missing connection to input port "
+                                  << port_idx
+                                  << " ("
+                                  << f->port_index_to_name(port_idx)
+                                  << ")");
+                }
+                num_inputs++;
+            }
+        }
+
+        inputs_needed[f_name] = num_inputs;
+        if(num_inputs == 0)
+        {
+            ready.push_back(f_name);
+        }
+    }
+
+    if(graph.m_filters.empty())
+    {
+        return;
+    }
+
+    // ties go to the back, run sources in name order
+    std::reverse(ready.begin(), ready.end());
+
+    Node &trav = traversals.append();
+    index_t live = 0;
+
+    while(!ready.empty())
+    {
+        size_t  best       = 0;
+        index_t best_delta = 0;
+        index_t best_freed = 0;
+
+        for(size_t i = 0; i < ready.size(); i++)
+        {
+            index_t freed = freed_bytes(graph, ready[i], refs, est);
+            index_t delta = est[ready[i]] - freed;
+            if(i == 0 || delta <= best_delta)
+            {
+                best       = i;
+                best_delta = delta;
+                best_freed = freed;
+            }
+        }
+
+        std::string f_name = ready[best];
+        ready.erase(ready.begin() + best);
+        Filter *f = graph.m_filters[f_name];
+
+        // inputs are still alive while the filter runs
+        live += est[f_name];
+        peak_bytes = std::max(peak_bytes, live);
+        live -= best_freed;
+
+        trav[f_name] = refs[f_name];
+
+        if ( f->port_names().number_of_children() > 0 )
+        {
+            NodeConstIterator f_inputs(&graph.edges_in(f_name));
+            while(f_inputs.has_next())
+            {
+                refs[f_inputs.next().as_string()]--;
+            }
+        }
+
+        if(f->output_port())
+        {
+            NodeConstIterator f_outputs(&graph.edges_out(f_name));
+            while(f_outputs.has_next())
+            {
+                std::string f_out_name = f_outputs.next().as_string();
+                if(--inputs_needed[f_out_name] == 0)
+                {
+                    ready.push_back(f_out_name);
+                }
+            }
+        }
+    }
+
+    if(trav.number_of_children() != (index_t)graph.m_filters.size())
+    {
+        CONDUIT_ERROR("Cannot schedule filter graph, it contains a cycle");
+    }
+}
+
+//-----------------------------------------------------------------------------
+index_t
+Workspace::ExecutionPlan::freed_bytes(Graph &graph,
+                                      const std::string &f_name,
+                                      std::map<std::string,int> &refs,
+                                      std::map<std::string,index_t> &est)
+{
+    Filter *f = graph.m_filters[f_name];
+    if ( f->port_names().number_of_children() == 0 )
+    {
+        return 0;
+    }
+
+    // a filter may be connected to more than one port
+    std::map<std::string,int> uses;
+    NodeConstIterator f_inputs(&graph.edges_in(f_name));
+    while(f_inputs.has_next())
+    {
+        uses[f_inputs.next().as_string()]++;
+    }
+
+    index_t res = 0;
+    std::map<std::string,int>::iterator u_itr;
+    for(u_itr = uses.begin(); u_itr != uses.end(); u_itr++)
+    {
+        if(refs[u_itr->first] == u_itr->second)
+        {
+            res += est[u_itr->first];
+        }
+    }
+    return res;
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 
@@ -215,7 +411,8 @@ Workspace::Workspace()
 :m_graph(this),
  m_registry(),
  m_timing_info(),
- m_enable_timings(false)
+ m_enable_timings(false),
+ m_memory_aware_schedule(false)
 {
 
 }
@@ -260,7 +457,18 @@ void
 Workspace::traversals(Node &traversals)
 {
     traversals.reset();
-    ExecutionPlan::generate(graph(),traversals);
+    if(m_memory_aware_schedule)
+    {
+        index_t peak_bytes = 0;
+        ExecutionPlan::generate_memory_aware(graph(),
+                                             m_output_bytes,
+                                             traversals,
+                                             peak_bytes);
+    }
+    else
+    {
+        ExecutionPlan::generate(graph(),traversals);
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -269,7 +477,25 @@ Workspace::execute()
 {
     Timer t_total_exec;
     Node traversals;
-    ExecutionPlan::generate(graph(),traversals);
+    index_t est_peak_bytes = 0;
+    if(m_memory_aware_schedule)
+    {
+        ExecutionPlan::generate_memory_aware(graph(),
+                                             m_output_bytes,
+                                             traversals,
+                                             est_peak_bytes);
+    }
+    else
+    {
+        ExecutionPlan::generate(graph(),traversals);
+    }
+
+    // bytes held by filter outputs that still have consumers to run
+    std::map<std::string,int>     live_refs;
+    std::map<std::string,index_t> live_bytes;
+    index_t live = 0;
+    index_t peak_bytes = 0;
+
     // execute traversals
     NodeIterator travs_itr = traversals.children();
 
@@ -300,7 +526,9 @@ Workspace::execute()
 
             Timer t_flt_exec;
             // execute
+            Trace::begin(f->name());
             f->execute();
+            Trace::end(f->name());
 
             if(m_enable_timings)
             {
@@ -321,6 +549,14 @@ Workspace::execute()
                 registry().add(f_name,
                                f->output(),
                                uref);
+
+                index_t out_bytes = f->output().bytes();
+                m_output_bytes[f_name] = out_bytes;
+                live_refs[f_name]  = uref;
+                live_bytes[f_name] = out_bytes;
+                live += out_bytes;
+                peak_bytes = std::max(peak_bytes, live);
+                Trace::counter("live_bytes", (double) live);
             }
 
             f->reset_inputs_and_output();
@@ -332,10 +568,54 @@ Workspace::execute()
                 std::string port_name = ports_itr.next().as_string();
                 std::string f_input_name = graph().edges_in(f_name)[port_name].as_string();
                 registry().consume(f_input_name);
+
+                std::map<std::string,int>::iterator r_itr;
+                r_itr = live_refs.find(f_input_name);
+                if(r_itr != live_refs.end() && --r_itr->second == 0)
+                {
+                    live -= live_bytes[f_input_name];
+                }
             }
         }
     }
 
+    if(m_memory_aware_schedule && m_output_bytes_reducer != NULL)
+    {
+        // every process must pick the same order, so they all
+        // schedule with the largest size seen for each output
+        std::vector<std::string> f_names;
+        std::vector<index_t> f_bytes;
+        std::map<std::string,Filter*>::iterator f_itr;
+        for(f_itr = graph().filters().begin();
+            f_itr != graph().filters().end();
+            f_itr++)
+        {
+            f_names.push_back(f_itr->first);
+            std::map<std::string,index_t>::const_iterator b_itr;
+            b_itr = m_output_bytes.find(f_itr->first);
+            f_bytes.push_back(b_itr != m_output_bytes.end() ? b_itr->second : 0);
+        }
+
+        m_output_bytes_reducer(f_bytes);
+
+        for(size_t i = 0; i < f_names.size(); ++i)
+        {
+            if(f_bytes[i] > 0 || m_output_bytes.count(f_names[i]) > 0)
+            {
+                m_output_bytes[f_names[i]] = f_bytes[i];
+            }
+        }
+    }
+
+    m_schedule_info.reset();
+    m_schedule_info["mode"] = m_memory_aware_schedule ? "memory_aware"
+                                                      : "depth_first";
+    if(m_memory_aware_schedule)
+    {
+        m_schedule_info["estimated_peak_bytes"] = est_peak_bytes;
+    }
+    m_schedule_info["peak_bytes"] = peak_bytes;
+
     if(m_enable_timings)
     {
         m_timing_info << g_timing_exec_count
@@ -355,12 +635,36 @@ void Workspace::enable_timings(bool enabled)
   m_enable_timings = enabled;
 }
 
+//-----------------------------------------------------------------------------
+void
+Workspace::enable_memory_aware_schedule(bool enabled)
+{
+    m_memory_aware_schedule = enabled;
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::schedule_info(Node &out) const
+{
+    out.reset();
+    out.update(m_schedule_info);
+    out["output_bytes"].set(DataType::object());
+    std::map<std::string,index_t>::const_iterator itr;
+    for(itr = m_output_bytes.begin(); itr != m_output_bytes.end(); itr++)
+    {
+        out["output_bytes"].add_child(itr->first) = itr->second;
+    }
+}
+
 //-----------------------------------------------------------------------------
 void
 Workspace::reset()
 {
     graph().reset();
     registry().reset();
+    // estimates are keyed by filter name, they don't carry over
+    m_output_bytes.clear();
+    m_schedule_info.reset();
 }
 
 
@@ -373,6 +677,7 @@ Workspace::info(Node &out) const
     graph().info(out["graph"]);
     registry().info(out["registry"]);
     out["timings"] = timing_info();
+    schedule_info(out["schedule"]);
 }
 
 
@@ -434,6 +739,13 @@ Workspace::create_filter(const std::string &filter_type_name)
     return FilterFactory::registered_types()[filter_type_name](filter_type_name.c_str());
 }
 
+//-----------------------------------------------------------------------------
+void
+Workspace::set_output_bytes_reducer(OutputBytesReducer reducer)
+{
+    m_output_bytes_reducer = reducer;
+}
+
 //-----------------------------------------------------------------------------
 void
 Workspace::set_default_mpi_comm(int mpi_comm_id)
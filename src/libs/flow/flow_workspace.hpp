@@ -21,7 +21,9 @@
 #include <flow_data.hpp>
 #include <flow_registry.hpp>
 #include <flow_graph.hpp>
+#include <map>
 #include <sstream>
+#include <vector>
 
 
 //-----------------------------------------------------------------------------
@@ -145,11 +147,27 @@ public:
 
     void enable_timings(bool enabled);
 
+    /// order filter execution to reduce the peak number of bytes held
+    /// by filter outputs, using the output sizes seen in previous
+    /// executions (default: off, one depth first traversal per sink)
+    void enable_memory_aware_schedule(bool enabled);
+
+    /// per filter output size estimates, and the estimated and observed
+    /// peak live bytes of the last execution
+    void schedule_info(conduit::Node &out) const;
+
+    /// combines the output sizes of one execution across processes, so
+    /// all of them schedule the same order (filters may be collective).
+    /// Called with one entry per filter, in filter name order.
+    typedef void (*OutputBytesReducer)(std::vector<conduit::index_t> &bytes);
+    static void set_output_bytes_reducer(OutputBytesReducer reducer);
+
 private:
 
     static Filter *create_filter(const std::string &filter_type);
 
     static int  m_default_mpi_comm;
+    static OutputBytesReducer m_output_bytes_reducer;
 
     class ExecutionPlan;
     class FilterFactory;
@@ -158,6 +176,10 @@ private:
     Registry          m_registry;
     std::stringstream m_timing_info;
     bool              m_enable_timings;
+    bool              m_memory_aware_schedule;
+    // output bytes of each filter, recorded after it executes
+    std::map<std::string,conduit::index_t> m_output_bytes;
+    conduit::Node     m_schedule_info;
 
 };
 
@@ -0,0 +1,155 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_image_encoder.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "ascent_image_encoder.hpp"
+
+using namespace conduit;
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::detail --
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+//-----------------------------------------------------------------------------
+std::string &
+image_default_format()
+{
+    static std::string format = "png";
+    return format;
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::detail --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+ImageEncoder::ImageEncoder()
+: m_format(detail::image_default_format())
+{}
+
+//-----------------------------------------------------------------------------
+ImageEncoder::~ImageEncoder()
+{}
+
+//-----------------------------------------------------------------------------
+void
+ImageEncoder::Encode(const float *rgba_in,
+                     const int width,
+                     const int height,
+                     const std::vector<std::string> &comments)
+{
+    if(m_format == "qoi")
+    {
+        m_qoi.Encode(rgba_in, width, height);
+    }
+    else
+    {
+        m_png.Encode(rgba_in, width, height, comments);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+ImageEncoder::Encode(const unsigned char *rgba_in,
+                     const int width,
+                     const int height,
+                     const std::vector<std::string> &comments)
+{
+    if(m_format == "qoi")
+    {
+        m_qoi.Encode(rgba_in, width, height);
+    }
+    else
+    {
+        m_png.Encode(rgba_in, width, height, comments);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+ImageEncoder::Save(const std::string &file_base)
+{
+    if(m_format == "qoi")
+    {
+        m_qoi.Save(file_base + ".qoi");
+    }
+    else
+    {
+        m_png.Save(file_base + ".png");
+    }
+}
+
+//-----------------------------------------------------------------------------
+void *
+ImageEncoder::Buffer()
+{
+    return m_format == "qoi" ? m_qoi.Buffer() : m_png.PngBuffer();
+}
+
+//-----------------------------------------------------------------------------
+size_t
+ImageEncoder::BufferSize()
+{
+    return m_format == "qoi" ? m_qoi.BufferSize() : m_png.PngBufferSize();
+}
+
+//-----------------------------------------------------------------------------
+const std::string &
+ImageEncoder::Format() const
+{
+    return m_format;
+}
+
+//-----------------------------------------------------------------------------
+void
+ImageEncoder::SetDefaultOptions(const conduit::Node &options)
+{
+    if(options.has_child("format"))
+    {
+        const std::string format = options["format"].as_string();
+        if(format != "png" && format != "qoi")
+        {
+            CONDUIT_ERROR("Unknown image encoding format '" << format << "'"
+                          << " (supported: png, qoi)");
+        }
+        detail::image_default_format() = format;
+    }
+    PNGEncoder::SetDefaultOptions(options);
+}
+
+//-----------------------------------------------------------------------------
+std::string
+ImageEncoder::DefaultFormat()
+{
+    return detail::image_default_format();
+}
+
+//-----------------------------------------------------------------------------
+std::string
+ImageEncoder::DefaultExtension()
+{
+    return "." + detail::image_default_format();
+}
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
@@ -0,0 +1,78 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_image_encoder.hpp
+///
+//-----------------------------------------------------------------------------
+#ifndef ASCENT_IMAGE_ENCODER_HPP
+#define ASCENT_IMAGE_ENCODER_HPP
+
+#include <png_utils/ascent_png_utils_exports.h>
+#include <png_utils/ascent_png_encoder.hpp>
+#include <png_utils/ascent_qoi_encoder.hpp>
+
+#include <conduit.hpp>
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+/// Encodes rendered images with the process wide default format
+/// ("png" or "qoi"). QOI does not store comments.
+//-----------------------------------------------------------------------------
+class ASCENT_API ImageEncoder
+{
+public:
+    ImageEncoder();
+    ~ImageEncoder();
+
+    void               Encode(const float *rgba_in,
+                              const int width,
+                              const int height,
+                              const std::vector<std::string> &comments);
+
+    void               Encode(const unsigned char *rgba_in,
+                              const int width,
+                              const int height,
+                              const std::vector<std::string> &comments);
+
+    // appends the extension of the format
+    void               Save(const std::string &file_base);
+
+    void              *Buffer();
+    size_t             BufferSize();
+    const std::string &Format() const;
+
+    // format ("png" or "qoi"), plus the png options
+    // (compression_level, filter, threads)
+    static void        SetDefaultOptions(const conduit::Node &options);
+    static std::string DefaultFormat();
+    // ".png" or ".qoi"
+    static std::string DefaultExtension();
+
+private:
+    std::string m_format;
+    PNGEncoder  m_png;
+    QOIEncoder  m_qoi;
+};
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
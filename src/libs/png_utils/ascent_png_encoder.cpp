@@ -14,6 +14,12 @@
 
 // standard includes
 #include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+#ifdef ASCENT_OPENMP_ENABLED
+#include <omp.h>
+#endif
 
 // thirdparty includes
 #include <conduit.hpp>
@@ -28,264 +34,499 @@ namespace ascent
 {
 
 //-----------------------------------------------------------------------------
-PNGEncoder::PNGEncoder()
-:m_buffer(NULL),
- m_buffer_size(0)
-{}
+// -- begin ascent::detail --
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+// bytes of filtered image data deflated by one task, fixed so the
+// output does not depend on the number of threads
+const size_t PNG_DEFLATE_CHUNK_SIZE = 1 << 20;
 
 //-----------------------------------------------------------------------------
-PNGEncoder::~PNGEncoder()
+struct PNGEncoderDefaults
 {
-    Cleanup();
+    PNGEncoderDefaults()
+    : compression_level(1),
+      filter("minsum"),
+      num_threads(0)
+    {}
+
+    int         compression_level;
+    std::string filter;
+    int         num_threads;
+};
+
+//-----------------------------------------------------------------------------
+PNGEncoderDefaults &
+png_encoder_defaults()
+{
+    static PNGEncoderDefaults defaults;
+    return defaults;
 }
 
 //-----------------------------------------------------------------------------
-void
-PNGEncoder::Encode(const unsigned char *rgba_in,
-                   const int width,
-                   const int height)
+int
+png_num_threads(int num_threads)
 {
-    Cleanup();
+#ifdef ASCENT_OPENMP_ENABLED
+    return num_threads > 0 ? num_threads : omp_get_max_threads();
+#else
+    (void) num_threads;
+    return 1;
+#endif
+}
 
-    // upside down relative to what lodepng wants
-    unsigned char *rgba_flip = new unsigned char[width * height *4];
+//-----------------------------------------------------------------------------
+void
+png_compress_settings(int level,
+                      lpng::LodePNGCompressSettings &settings)
+{
+    // level 6 matches the lodepng defaults
+    const unsigned windowsize[10] = {0, 0, 256, 512, 1024, 2048, 2048, 8192, 16384, 32768};
+    const unsigned nicematch[10]  = {0, 0, 16,  32,  64,   128,  128,  258,  258,   258};
 
-    for (int y=0; y<height; ++y)
+    level = std::max(0, std::min(level, 9));
+    if(level == 0)
     {
-        memcpy(&(rgba_flip[y*width*4]),
-               &(rgba_in[(height-y-1)*width*4]),
-               width*4);
+        settings.btype = 0;
+        settings.use_lz77 = 0;
     }
+    else if(level == 1)
+    {
+        settings.btype = 2;
+        settings.use_lz77 = 0;
+    }
+    else
+    {
+        settings.btype = 2;
+        settings.use_lz77 = 1;
+        settings.windowsize = windowsize[level];
+        settings.nicematch = nicematch[level];
+        settings.lazymatching = level >= 6 ? 1 : 0;
+    }
+}
 
-     unsigned error = lpng::lodepng_encode_memory(&m_buffer,
-                                            &m_buffer_size,
-                                            &rgba_flip[0],
-                                            width,
-                                            height,
-                                            lpng::LCT_RGBA, // these settings match those for
-                                            8);       // lodepng_encode32_file
+//-----------------------------------------------------------------------------
+unsigned char
+paeth(int a, int b, int c)
+{
+    int p  = a + b - c;
+    int pa = abs(p - a);
+    int pb = abs(p - b);
+    int pc = abs(p - c);
+    if(pa <= pb && pa <= pc) return (unsigned char)a;
+    if(pb <= pc) return (unsigned char)b;
+    return (unsigned char)c;
+}
 
-    delete [] rgba_flip;
+//-----------------------------------------------------------------------------
+// the png minimum sum of absolute differences heuristic (what lodepng
+// does with LFS_MINSUM), choosing the filter of each row in parallel
+//-----------------------------------------------------------------------------
+void
+minsum_filters(const unsigned char *rgba,
+               const int width,
+               const int height,
+               const int num_threads,
+               std::vector<unsigned char> &filters)
+{
+    const int line_bytes = width * 4;
+    filters.resize(height);
 
-    if(error)
+#ifdef ASCENT_OPENMP_ENABLED
+    #pragma omp parallel for num_threads(num_threads)
+#else
+    (void) num_threads;
+#endif
+    for(int y = 0; y < height; ++y)
     {
-        CONDUIT_WARN("lodepng_encode_memory failed")
+        const unsigned char *line = rgba + (size_t)y * line_bytes;
+        const unsigned char *prev = y > 0 ? line - line_bytes : NULL;
+
+        size_t best_sum = 0;
+        unsigned char best_type = 0;
+        for(int type = 0; type < 5; ++type)
+        {
+            size_t sum = 0;
+            for(int i = 0; i < line_bytes; ++i)
+            {
+                const int a = i >= 4 ? line[i - 4] : 0;
+                const int b = prev != NULL ? prev[i] : 0;
+                const int c = (prev != NULL && i >= 4) ? prev[i - 4] : 0;
+                int pred = 0;
+                if(type == 1) pred = a;
+                else if(type == 2) pred = b;
+                else if(type == 3) pred = (a + b) / 2;
+                else if(type == 4) pred = paeth(a, b, c);
+
+                const unsigned char val = (unsigned char)(line[i] - pred);
+                // unfiltered bytes count as unsigned, others as signed
+                sum += type == 0 ? val : abs((signed char)val);
+            }
+
+            if(type == 0 || sum < best_sum)
+            {
+                best_sum = sum;
+                best_type = (unsigned char)type;
+            }
+        }
+        filters[y] = best_type;
     }
 }
 
 //-----------------------------------------------------------------------------
-void
-PNGEncoder::Encode(const float *rgba_in,
-                   const int width,
-                   const int height)
+unsigned
+adler32(const unsigned char *data, size_t size)
 {
-    Cleanup();
+    unsigned s1 = 1;
+    unsigned s2 = 0;
+    while(size > 0)
+    {
+        // at most 5552 bytes before the sums can overflow
+        size_t amount = std::min(size, (size_t)5552);
+        size -= amount;
+        while(amount > 0)
+        {
+            s1 += *data++;
+            s2 += s1;
+            --amount;
+        }
+        s1 %= 65521;
+        s2 %= 65521;
+    }
+    return (s2 << 16) | s1;
+}
 
-    // upside down relative to what lodepng wants
-    unsigned char *rgba_flip = new unsigned char[width * height *4];
+//-----------------------------------------------------------------------------
+// lodepng custom_zlib: deflates fixed size chunks of the filtered image
+// in parallel and joins them (each non final chunk ends byte aligned)
+//-----------------------------------------------------------------------------
+unsigned
+parallel_zlib_compress(unsigned char **out,
+                       size_t *out_size,
+                       const unsigned char *in,
+                       size_t in_size,
+                       const lpng::LodePNGCompressSettings *settings)
+{
+    const int num_threads = *static_cast<const int*>(settings->custom_context);
 
+    lpng::LodePNGCompressSettings chunk_settings = *settings;
+    chunk_settings.custom_zlib = NULL;
+    chunk_settings.custom_deflate = NULL;
 
-    for(int x = 0; x < width; ++x)
+    const size_t chunk_size = PNG_DEFLATE_CHUNK_SIZE;
+    const int num_chunks = std::max((size_t)1, (in_size + chunk_size - 1) / chunk_size);
+
+    std::vector<unsigned char*> chunks(num_chunks, NULL);
+    std::vector<size_t> chunk_sizes(num_chunks, 0);
+    std::vector<unsigned> errors(num_chunks, 0);
 
 #ifdef ASCENT_OPENMP_ENABLED
-        #pragma omp parrallel for
+    #pragma omp parallel for schedule(dynamic) num_threads(num_threads)
+#else
+    (void) num_threads;
 #endif
-        for (int y = 0; y < height; ++y)
+    for(int i = 0; i < num_chunks; ++i)
+    {
+        const size_t begin = (size_t)i * chunk_size;
+        const size_t size = std::min(chunk_size, in_size - begin);
+        errors[i] = lpng::lodepng_deflate_part(&chunks[i],
+                                               &chunk_sizes[i],
+                                               in + begin,
+                                               size,
+                                               &chunk_settings,
+                                               i == num_chunks - 1);
+    }
+
+    unsigned error = 0;
+    size_t deflate_size = 0;
+    for(int i = 0; i < num_chunks; ++i)
+    {
+        if(errors[i] != 0)
         {
-            int inOffset = (y * width + x) * 4;
-            int outOffset = ((height - y - 1) * width + x) * 4;
-            rgba_flip[outOffset + 0] = (unsigned char)(rgba_in[inOffset + 0] * 255.f);
-            rgba_flip[outOffset + 1] = (unsigned char)(rgba_in[inOffset + 1] * 255.f);
-            rgba_flip[outOffset + 2] = (unsigned char)(rgba_in[inOffset + 2] * 255.f);
-            rgba_flip[outOffset + 3] = (unsigned char)(rgba_in[inOffset + 3] * 255.f);
+            error = errors[i];
         }
+        deflate_size += chunk_sizes[i];
+    }
 
-     unsigned error = lpng::lodepng_encode_memory(&m_buffer,
-                                            &m_buffer_size,
-                                            &rgba_flip[0],
-                                            width,
-                                            height,
-                                            lpng::LCT_RGBA, // these settings match those for
-                                            8);       // lodepng_encode32_file
+    if(error == 0)
+    {
+        // 2 byte zlib header, data, 4 byte adler32 checksum
+        unsigned char *res = (unsigned char*) malloc(deflate_size + 6);
+        // CMF 120: deflate with a 32k window, FLG: no dict, check bits
+        unsigned cmf_flg = 256 * 120;
+        cmf_flg += 31 - cmf_flg % 31;
+        res[0] = (unsigned char)(cmf_flg >> 8);
+        res[1] = (unsigned char)(cmf_flg & 255);
+
+        size_t offset = 2;
+        for(int i = 0; i < num_chunks; ++i)
+        {
+            memcpy(res + offset, chunks[i], chunk_sizes[i]);
+            offset += chunk_sizes[i];
+        }
 
-    delete [] rgba_flip;
+        const unsigned checksum = adler32(in, in_size);
+        res[offset + 0] = (unsigned char)(checksum >> 24);
+        res[offset + 1] = (unsigned char)(checksum >> 16);
+        res[offset + 2] = (unsigned char)(checksum >> 8);
+        res[offset + 3] = (unsigned char)(checksum);
 
-    if(error)
+        *out = res;
+        *out_size = offset + 4;
+    }
+
+    for(int i = 0; i < num_chunks; ++i)
     {
-        CONDUIT_WARN("lodepng_encode_memory failed");
+        free(chunks[i]);
     }
+
+    return error;
 }
 
 //-----------------------------------------------------------------------------
+// flips rows (lodepng wants the first row at the top) and converts to 8 bits
+//-----------------------------------------------------------------------------
+template<typename T>
 void
-PNGEncoder::Encode(const double *rgba_in,
-                   const int width,
-                   const int height)
+flip_to_rgba8(const T *rgba_in,
+              const int width,
+              const int height,
+              const T scale,
+              unsigned char *rgba_out)
 {
-  unsigned char *rgba = new unsigned char[width * height *4];
-
-
-  for(int x = 0; x < width; ++x)
-
 #ifdef ASCENT_OPENMP_ENABLED
     #pragma omp parallel for
 #endif
-    for (int y = 0; y < height; ++y)
+    for(int y = 0; y < height; ++y)
     {
-      int offset = (y * width + x) * 4;
-      rgba[offset + 0] = (unsigned char)(rgba_in[offset + 0] * 255.);
-      rgba[offset + 1] = (unsigned char)(rgba_in[offset + 1] * 255.);
-      rgba[offset + 2] = (unsigned char)(rgba_in[offset + 2] * 255.);
-      rgba[offset + 3] = (unsigned char)(rgba_in[offset + 3] * 255.);
+        const T *in = rgba_in + (size_t)y * width * 4;
+        unsigned char *out = rgba_out + (size_t)(height - y - 1) * width * 4;
+        for(int i = 0; i < width * 4; ++i)
+        {
+            out[i] = (unsigned char)(in[i] * scale);
+        }
     }
-
-  Encode(rgba, width, height);
-  delete[] rgba;
 }
 
-
 //-----------------------------------------------------------------------------
+template<typename T>
 void
-PNGEncoder::EncodeChannel(const double *buffer_in,
-                          const int width,
-                          const int height)
+channel_to_rgba8(const T *buffer_in,
+                 const int size,
+                 unsigned char *rgba_out)
 {
-
-  unsigned char *rgba = new unsigned char[width * height *4];
-
-  for(int x = 0; x < width; ++x)
-
 #ifdef ASCENT_OPENMP_ENABLED
     #pragma omp parallel for
 #endif
-    for (int y = 0; y < height; ++y)
+    for(int i = 0; i < size; ++i)
     {
-      int offset = (y * width + x);
-      rgba[offset + 0] = (unsigned char)(buffer_in[offset] * 255.);
-      rgba[offset + 1] = (unsigned char)(buffer_in[offset] * 255.);
-      rgba[offset + 2] = (unsigned char)(buffer_in[offset] * 255.);
-      rgba[offset + 3] = 255;
+        const unsigned char val = (unsigned char)(buffer_in[i] * 255.);
+        rgba_out[i * 4 + 0] = val;
+        rgba_out[i * 4 + 1] = val;
+        rgba_out[i * 4 + 2] = val;
+        rgba_out[i * 4 + 3] = 255;
     }
+}
 
-  Encode(rgba, width, height);
-  delete[] rgba;
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::detail --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+PNGEncoder::PNGEncoder()
+:m_buffer(NULL),
+ m_buffer_size(0),
+ m_compression_level(detail::png_encoder_defaults().compression_level),
+ m_filter(detail::png_encoder_defaults().filter),
+ m_num_threads(detail::png_encoder_defaults().num_threads)
+{}
+
+//-----------------------------------------------------------------------------
+PNGEncoder::~PNGEncoder()
+{
+    Cleanup();
 }
 
 //-----------------------------------------------------------------------------
 void
-PNGEncoder::EncodeChannel(const float *buffer_in,
-                          const int width,
-                          const int height)
+PNGEncoder::SetCompressionLevel(int level)
 {
+    m_compression_level = level;
+}
 
-  unsigned char *rgba = new unsigned char[width * height *4];
-
-  for(int x = 0; x < width; ++x)
-
-#ifdef ASCENT_OPENMP_ENABLED
-    #pragma omp parallel for
-#endif
-    for (int y = 0; y < height; ++y)
+//-----------------------------------------------------------------------------
+void
+PNGEncoder::SetFilterStrategy(const std::string &filter)
+{
+    if(filter != "none" && filter != "minsum" && filter != "entropy")
     {
-      int offset = (y * width + x);
-      rgba[offset + 0] = (unsigned char)(buffer_in[offset] * 255.);
-      rgba[offset + 1] = (unsigned char)(buffer_in[offset] * 255.);
-      rgba[offset + 2] = (unsigned char)(buffer_in[offset] * 255.);
-      rgba[offset + 3] = 255;
+        CONDUIT_ERROR("PNGEncoder: unknown filter strategy '" << filter
+                      << "', expected 'none', 'minsum' or 'entropy'");
     }
-
-  Encode(rgba, width, height);
-  delete[] rgba;
+    m_filter = filter;
 }
 
 //-----------------------------------------------------------------------------
 void
-PNGEncoder::Encode(const unsigned char *rgba_in,
-                   const int width,
-                   const int height,
-                   const std::vector<std::string> &comments)
+PNGEncoder::SetNumThreads(int num_threads)
 {
-    Cleanup();
-
-    // upside down relative to what lodepng wants
-    unsigned char *rgba_flip = new unsigned char[width * height *4];
+    m_num_threads = num_threads;
+}
 
-    for (int y=0; y<height; ++y)
+//-----------------------------------------------------------------------------
+void
+PNGEncoder::SetDefaultOptions(const conduit::Node &options)
+{
+    detail::PNGEncoderDefaults &defaults = detail::png_encoder_defaults();
+    if(options.has_child("compression_level"))
     {
-        memcpy(&(rgba_flip[y*width*4]),
-               &(rgba_in[(height-y-1)*width*4]),
-               width*4);
+        defaults.compression_level = options["compression_level"].to_int32();
     }
- 
-    lpng::LodePNGState state;
-    lpng::lodepng_state_init(&state);
-    // use less aggressive compression
-    state.encoder.zlibsettings.btype = 2;
-    state.encoder.zlibsettings.use_lz77 = 0;
-    if(comments.size() % 2 != 0)
+    if(options.has_child("filter"))
     {
-        CONDUIT_INFO("PNGEncoder::Encode comments missing value for the last key.\n"
-                     << "Ignoring the last key.\n");
+        // validates the name
+        PNGEncoder encoder;
+        encoder.SetFilterStrategy(options["filter"].as_string());
+        defaults.filter = options["filter"].as_string();
     }
-    if(comments.size() > 1)
+    if(options.has_child("threads"))
     {
-        lpng::lodepng_info_init(&state.info_png);
-        // Comments are in pairs with a key and a value, using
-        // comments.size()-1 ensures that we don't use the last
-        // comment if the length of the vector isn't a multiple of 2.
-        for (int i = 0; i < comments.size()-1; i += 2)
-            lpng::lodepng_add_text(&state.info_png, comments[i].c_str(),
-                                                    comments[i+1].c_str());
+        defaults.num_threads = options["threads"].to_int32();
     }
+}
 
-    unsigned error = lodepng_encode(&m_buffer,
-                                    &m_buffer_size,
-                                    &rgba_flip[0],
-                                    width,
-                                    height,
-                                    &state);
-
-    delete [] rgba_flip;
+//-----------------------------------------------------------------------------
+void
+PNGEncoder::DefaultOptions(conduit::Node &options)
+{
+    const detail::PNGEncoderDefaults &defaults = detail::png_encoder_defaults();
+    options["compression_level"] = defaults.compression_level;
+    options["filter"] = defaults.filter;
+    options["threads"] = defaults.num_threads;
+}
 
-    if(error)
-    {
-       CONDUIT_WARN("lodepng_encode_memory failed");
-    }
+//-----------------------------------------------------------------------------
+void
+PNGEncoder::Encode(const unsigned char *rgba_in,
+                   const int width,
+                   const int height)
+{
+    Encode(rgba_in, width, height, std::vector<std::string>());
 }
 
 //-----------------------------------------------------------------------------
 void
 PNGEncoder::Encode(const float *rgba_in,
+                   const int width,
+                   const int height)
+{
+    Encode(rgba_in, width, height, std::vector<std::string>());
+}
+
+//-----------------------------------------------------------------------------
+void
+PNGEncoder::Encode(const double *rgba_in,
+                   const int width,
+                   const int height)
+{
+    std::vector<unsigned char> rgba_flip((size_t)width * height * 4);
+    detail::flip_to_rgba8(rgba_in, width, height, 255., &rgba_flip[0]);
+    EncodeRGBA8(&rgba_flip[0], width, height, std::vector<std::string>());
+}
+
+
+//-----------------------------------------------------------------------------
+void
+PNGEncoder::EncodeChannel(const double *buffer_in,
+                          const int width,
+                          const int height)
+{
+    std::vector<unsigned char> rgba((size_t)width * height * 4);
+    detail::channel_to_rgba8(buffer_in, width * height, &rgba[0]);
+    Encode(&rgba[0], width, height);
+}
+
+//-----------------------------------------------------------------------------
+void
+PNGEncoder::EncodeChannel(const float *buffer_in,
+                          const int width,
+                          const int height)
+{
+    std::vector<unsigned char> rgba((size_t)width * height * 4);
+    detail::channel_to_rgba8(buffer_in, width * height, &rgba[0]);
+    Encode(&rgba[0], width, height);
+}
+
+//-----------------------------------------------------------------------------
+void
+PNGEncoder::Encode(const unsigned char *rgba_in,
                    const int width,
                    const int height,
                    const std::vector<std::string> &comments)
 {
-    Cleanup();
-
     // upside down relative to what lodepng wants
-    unsigned char *rgba_flip = new unsigned char[width * height *4];
+    std::vector<unsigned char> rgba_flip((size_t)width * height * 4);
+    detail::flip_to_rgba8(rgba_in, width, height, (unsigned char) 1, &rgba_flip[0]);
+    EncodeRGBA8(&rgba_flip[0], width, height, comments);
+}
 
+//-----------------------------------------------------------------------------
+void
+PNGEncoder::Encode(const float *rgba_in,
+                   const int width,
+                   const int height,
+                   const std::vector<std::string> &comments)
+{
+    // upside down relative to what lodepng wants
+    std::vector<unsigned char> rgba_flip((size_t)width * height * 4);
+    detail::flip_to_rgba8(rgba_in, width, height, 255.f, &rgba_flip[0]);
+    EncodeRGBA8(&rgba_flip[0], width, height, comments);
+}
 
-    for(int x = 0; x < width; ++x)
+//-----------------------------------------------------------------------------
+void
+PNGEncoder::EncodeRGBA8(const unsigned char *rgba,
+                        const int width,
+                        const int height,
+                        const std::vector<std::string> &comments)
+{
+    Cleanup();
 
-#ifdef ASCENT_OPENMP_ENABLED
-        #pragma omp parallel for
-#endif
-        for (int y = 0; y < height; ++y)
-        {
-            int inOffset = (y * width + x) * 4;
-            int outOffset = ((height - y - 1) * width + x) * 4;
-            rgba_flip[outOffset + 0] = (unsigned char)(rgba_in[inOffset + 0] * 255.f);
-            rgba_flip[outOffset + 1] = (unsigned char)(rgba_in[inOffset + 1] * 255.f);
-            rgba_flip[outOffset + 2] = (unsigned char)(rgba_in[inOffset + 2] * 255.f);
-            rgba_flip[outOffset + 3] = (unsigned char)(rgba_in[inOffset + 3] * 255.f);
-        }
+    int num_threads = detail::png_num_threads(m_num_threads);
 
     lpng::LodePNGState state;
     lpng::lodepng_state_init(&state);
-    // use less aggressive compression
-    state.encoder.zlibsettings.btype = 2;
-    state.encoder.zlibsettings.use_lz77 = 0;
+
+    detail::png_compress_settings(m_compression_level,
+                                  state.encoder.zlibsettings);
+    state.encoder.zlibsettings.custom_zlib = detail::parallel_zlib_compress;
+    state.encoder.zlibsettings.custom_context = &num_threads;
+
+    if(m_compression_level <= 0)
+    {
+        // always write rgba, skips a pass over all pixels
+        state.encoder.auto_convert = 0;
+    }
+
+    std::vector<unsigned char> filters;
+    if(m_filter == "none")
+    {
+        state.encoder.filter_strategy = lpng::LFS_ZERO;
+    }
+    else if(m_filter == "entropy")
+    {
+        state.encoder.filter_strategy = lpng::LFS_ENTROPY;
+    }
+    else
+    {
+        detail::minsum_filters(rgba, width, height, num_threads, filters);
+        state.encoder.filter_strategy = lpng::LFS_PREDEFINED;
+        state.encoder.predefined_filters = &filters[0];
+    }
+
     if(comments.size() % 2 != 0)
     {
         CONDUIT_INFO("PNGEncoder::Encode comments missing value for the last key.\n"
@@ -293,27 +534,26 @@ PNGEncoder::Encode(const float *rgba_in,
     }
     if(comments.size() > 1)
     {
-        vtkh:lodepng_info_init(&state.info_png);
         // Comments are in pairs with a key and a value, using
         // comments.size()-1 ensures that we don't use the last
         // comment if the length of the vector isn't a multiple of 2.
-        for (int i = 0; i < comments.size()-1; i += 2)
+        for (size_t i = 0; i < comments.size()-1; i += 2)
             lpng::lodepng_add_text(&state.info_png, comments[i].c_str(),
                                                     comments[i+1].c_str());
     }
 
-    unsigned error = lodepng_encode(&m_buffer,
-                                    &m_buffer_size,
-                                    &rgba_flip[0],
-                                    width,
-                                    height,
-                                    &state);
+    unsigned error = lpng::lodepng_encode(&m_buffer,
+                                          &m_buffer_size,
+                                          rgba,
+                                          width,
+                                          height,
+                                          &state);
 
-    delete [] rgba_flip;
+    lpng::lodepng_state_cleanup(&state);
 
     if(error)
     {
-        CONDUIT_WARN("lodepng_encode_memory failed");
+        CONDUIT_WARN("lodepng_encode failed: " << lpng::lodepng_error_text(error));
     }
 }
 
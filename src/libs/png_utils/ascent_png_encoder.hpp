@@ -16,6 +16,7 @@
 
 #include <conduit.hpp>
 #include <string>
+#include <vector>
 
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
@@ -70,10 +71,32 @@ public:
 
     void           Cleanup();
 
+    // zlib effort from 0 (stored, no color type analysis) to 9,
+    // 1 (huffman coding only) is the default
+    void           SetCompressionLevel(int level);
+    // png row filters: "none", "minsum" (default) or "entropy"
+    void           SetFilterStrategy(const std::string &filter);
+    // threads used to filter and deflate, 0 (default) uses all
+    // OpenMP threads
+    void           SetNumThreads(int num_threads);
+
+    // settings of encoders created after this call
+    // (compression_level, filter, threads)
+    static void    SetDefaultOptions(const conduit::Node &options);
+    static void    DefaultOptions(conduit::Node &options);
+
 private:
+    void           EncodeRGBA8(const unsigned char *rgba,
+                               const int width,
+                               const int height,
+                               const std::vector<std::string> &comments);
+
     unsigned char *m_buffer;
     size_t         m_buffer_size;
     conduit::Node  m_base64_data;
+    int            m_compression_level;
+    std::string    m_filter;
+    int            m_num_threads;
 };
 
 //-----------------------------------------------------------------------------
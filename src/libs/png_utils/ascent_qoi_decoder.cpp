@@ -0,0 +1,173 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_qoi_decoder.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "ascent_qoi_decoder.hpp"
+
+// standard includes
+#include <string.h>
+#include <fstream>
+#include <iterator>
+
+// thirdparty includes
+#include <conduit.hpp>
+
+using namespace conduit;
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+QOIDecoder::QOIDecoder()
+{}
+
+//-----------------------------------------------------------------------------
+QOIDecoder::~QOIDecoder()
+{
+}
+
+//-----------------------------------------------------------------------------
+void
+QOIDecoder::Decode(std::vector<unsigned char> &rgba,
+                   int &width,
+                   int &height,
+                   const std::string &file_name)
+{
+    std::ifstream ifs(file_name.c_str(), std::ios::in | std::ios::binary);
+    if(!ifs.is_open())
+    {
+        CONDUIT_ERROR("Error opening qoi file " << file_name);
+    }
+    std::vector<unsigned char> buffer((std::istreambuf_iterator<char>(ifs)),
+                                      std::istreambuf_iterator<char>());
+    if(buffer.empty())
+    {
+        CONDUIT_ERROR("Error decoding qoi " << file_name << ": empty file");
+    }
+    Decode(rgba, width, height, &buffer[0], buffer.size());
+}
+
+//-----------------------------------------------------------------------------
+void
+QOIDecoder::Decode(std::vector<unsigned char> &rgba,
+                   int &width,
+                   int &height,
+                   const unsigned char *buffer,
+                   const size_t buffer_size)
+{
+    const size_t header_size = 14;
+    const size_t end_size = 8;
+
+    if(buffer_size < header_size + end_size ||
+       memcmp(buffer, "qoif", 4) != 0)
+    {
+        CONDUIT_ERROR("Error decoding qoi: invalid header");
+    }
+
+    const unsigned char *p = buffer + 4;
+    width  = (int)((unsigned)p[0] << 24 | p[1] << 16 | p[2] << 8 | p[3]);
+    height = (int)((unsigned)p[4] << 24 | p[5] << 16 | p[6] << 8 | p[7]);
+    const int channels = p[8];
+
+    if(width <= 0 || height <= 0 || (channels != 3 && channels != 4))
+    {
+        CONDUIT_ERROR("Error decoding qoi: invalid header");
+    }
+
+    const size_t num_pixels = (size_t)width * height;
+    rgba.resize(num_pixels * 4);
+
+    unsigned char index[64][4];
+    memset(index, 0, sizeof(index));
+    unsigned char px[4] = {0, 0, 0, 255};
+
+    size_t pos = header_size;
+    const size_t data_end = buffer_size - end_size;
+    int run = 0;
+
+    for(size_t i = 0; i < num_pixels; ++i)
+    {
+        if(run > 0)
+        {
+            --run;
+        }
+        else
+        {
+            if(pos >= data_end)
+            {
+                CONDUIT_ERROR("Error decoding qoi: truncated data");
+            }
+
+            const unsigned char b1 = buffer[pos++];
+            if(b1 == 0xfe)
+            {
+                if(pos + 3 > data_end)
+                {
+                    CONDUIT_ERROR("Error decoding qoi: truncated data");
+                }
+                px[0] = buffer[pos++];
+                px[1] = buffer[pos++];
+                px[2] = buffer[pos++];
+            }
+            else if(b1 == 0xff)
+            {
+                if(pos + 4 > data_end)
+                {
+                    CONDUIT_ERROR("Error decoding qoi: truncated data");
+                }
+                px[0] = buffer[pos++];
+                px[1] = buffer[pos++];
+                px[2] = buffer[pos++];
+                px[3] = buffer[pos++];
+            }
+            else if((b1 & 0xc0) == 0x00)
+            {
+                memcpy(px, index[b1], 4);
+            }
+            else if((b1 & 0xc0) == 0x40)
+            {
+                px[0] += ((b1 >> 4) & 0x03) - 2;
+                px[1] += ((b1 >> 2) & 0x03) - 2;
+                px[2] += ( b1       & 0x03) - 2;
+            }
+            else if((b1 & 0xc0) == 0x80)
+            {
+                if(pos >= data_end)
+                {
+                    CONDUIT_ERROR("Error decoding qoi: truncated data");
+                }
+                const unsigned char b2 = buffer[pos++];
+                const int vg = (b1 & 0x3f) - 32;
+                px[0] += vg - 8 + ((b2 >> 4) & 0x0f);
+                px[1] += vg;
+                px[2] += vg - 8 +  (b2       & 0x0f);
+            }
+            else
+            {
+                run = b1 & 0x3f;
+            }
+
+            const int hash = (px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64;
+            memcpy(index[hash], px, 4);
+        }
+
+        memcpy(&rgba[i * 4], px, 4);
+    }
+}
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
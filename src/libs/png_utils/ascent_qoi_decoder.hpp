@@ -0,0 +1,53 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_qoi_decoder.hpp
+///
+//-----------------------------------------------------------------------------
+#ifndef ASCENT_QOI_DECODER_HPP
+#define ASCENT_QOI_DECODER_HPP
+
+#include <png_utils/ascent_png_utils_exports.h>
+
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+class ASCENT_API QOIDecoder
+{
+public:
+    QOIDecoder();
+    ~QOIDecoder();
+    // rgba, the first row is the top of the image (like PNGDecoder)
+    void Decode(std::vector<unsigned char> &rgba,
+                int &width,
+                int &height,
+                const std::string &file_name);
+
+    void Decode(std::vector<unsigned char> &rgba,
+                int &width,
+                int &height,
+                const unsigned char *buffer,
+                const size_t buffer_size);
+};
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
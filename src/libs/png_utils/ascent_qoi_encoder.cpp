@@ -0,0 +1,258 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_qoi_encoder.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "ascent_qoi_encoder.hpp"
+
+// standard includes
+#include <string.h>
+#include <fstream>
+
+// thirdparty includes
+#include <conduit.hpp>
+
+using namespace conduit;
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::detail --
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+// op codes, see https://qoiformat.org/qoi-specification.pdf
+const unsigned char QOI_OP_INDEX = 0x00;
+const unsigned char QOI_OP_DIFF  = 0x40;
+const unsigned char QOI_OP_LUMA  = 0x80;
+const unsigned char QOI_OP_RUN   = 0xc0;
+const unsigned char QOI_OP_RGB   = 0xfe;
+const unsigned char QOI_OP_RGBA  = 0xff;
+
+//-----------------------------------------------------------------------------
+void
+qoi_write32(std::vector<unsigned char> &out, unsigned int val)
+{
+    out.push_back((unsigned char)(val >> 24));
+    out.push_back((unsigned char)(val >> 16));
+    out.push_back((unsigned char)(val >> 8));
+    out.push_back((unsigned char)(val));
+}
+
+//-----------------------------------------------------------------------------
+// rgba_in is 8 bit rgba, bottom row first
+//-----------------------------------------------------------------------------
+void
+qoi_encode(const unsigned char *rgba_in,
+           const int width,
+           const int height,
+           std::vector<unsigned char> &out)
+{
+    out.clear();
+    // worst case is one QOI_OP_RGBA per pixel, plus header and end marker
+    out.reserve((size_t)width * height * 5 + 14 + 8);
+
+    out.push_back('q');
+    out.push_back('o');
+    out.push_back('i');
+    out.push_back('f');
+    qoi_write32(out, (unsigned int)width);
+    qoi_write32(out, (unsigned int)height);
+    out.push_back(4); // channels
+    out.push_back(0); // srgb with linear alpha
+
+    unsigned char index[64][4];
+    memset(index, 0, sizeof(index));
+    unsigned char prev[4] = {0, 0, 0, 255};
+    int run = 0;
+
+    const size_t num_pixels = (size_t)width * height;
+    size_t count = 0;
+
+    for(int y = 0; y < height; ++y)
+    {
+        const unsigned char *row = rgba_in + (size_t)(height - y - 1) * width * 4;
+        for(int x = 0; x < width; ++x, ++count)
+        {
+            const unsigned char *px = row + x * 4;
+
+            if(memcmp(px, prev, 4) == 0)
+            {
+                ++run;
+                if(run == 62 || count == num_pixels - 1)
+                {
+                    out.push_back(QOI_OP_RUN | (unsigned char)(run - 1));
+                    run = 0;
+                }
+                continue;
+            }
+
+            if(run > 0)
+            {
+                out.push_back(QOI_OP_RUN | (unsigned char)(run - 1));
+                run = 0;
+            }
+
+            const int hash = (px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64;
+            if(memcmp(index[hash], px, 4) == 0)
+            {
+                out.push_back(QOI_OP_INDEX | (unsigned char)hash);
+            }
+            else
+            {
+                memcpy(index[hash], px, 4);
+
+                if(px[3] == prev[3])
+                {
+                    const signed char vr = (signed char)(px[0] - prev[0]);
+                    const signed char vg = (signed char)(px[1] - prev[1]);
+                    const signed char vb = (signed char)(px[2] - prev[2]);
+                    const signed char vg_r = (signed char)(vr - vg);
+                    const signed char vg_b = (signed char)(vb - vg);
+
+                    if(vr > -3 && vr < 2 &&
+                       vg > -3 && vg < 2 &&
+                       vb > -3 && vb < 2)
+                    {
+                        out.push_back(QOI_OP_DIFF |
+                                      (unsigned char)((vr + 2) << 4 |
+                                                      (vg + 2) << 2 |
+                                                      (vb + 2)));
+                    }
+                    else if(vg_r > -9 && vg_r < 8 &&
+                            vg   > -33 && vg < 32 &&
+                            vg_b > -9 && vg_b < 8)
+                    {
+                        out.push_back(QOI_OP_LUMA | (unsigned char)(vg + 32));
+                        out.push_back((unsigned char)((vg_r + 8) << 4 | (vg_b + 8)));
+                    }
+                    else
+                    {
+                        out.push_back(QOI_OP_RGB);
+                        out.push_back(px[0]);
+                        out.push_back(px[1]);
+                        out.push_back(px[2]);
+                    }
+                }
+                else
+                {
+                    out.push_back(QOI_OP_RGBA);
+                    out.push_back(px[0]);
+                    out.push_back(px[1]);
+                    out.push_back(px[2]);
+                    out.push_back(px[3]);
+                }
+            }
+            memcpy(prev, px, 4);
+        }
+    }
+
+    // end marker
+    for(int i = 0; i < 7; ++i)
+    {
+        out.push_back(0);
+    }
+    out.push_back(1);
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::detail --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+QOIEncoder::QOIEncoder()
+{}
+
+//-----------------------------------------------------------------------------
+QOIEncoder::~QOIEncoder()
+{
+    Cleanup();
+}
+
+//-----------------------------------------------------------------------------
+void
+QOIEncoder::Encode(const unsigned char *rgba_in,
+                   const int width,
+                   const int height)
+{
+    detail::qoi_encode(rgba_in, width, height, m_buffer);
+}
+
+//-----------------------------------------------------------------------------
+void
+QOIEncoder::Encode(const float *rgba_in,
+                   const int width,
+                   const int height)
+{
+    const size_t size = (size_t)width * height * 4;
+    std::vector<unsigned char> rgba(size);
+
+#ifdef ASCENT_OPENMP_ENABLED
+    #pragma omp parallel for
+#endif
+    for(long long i = 0; i < (long long)size; ++i)
+    {
+        rgba[i] = (unsigned char)(rgba_in[i] * 255.f);
+    }
+
+    detail::qoi_encode(&rgba[0], width, height, m_buffer);
+}
+
+//-----------------------------------------------------------------------------
+void
+QOIEncoder::Save(const std::string &filename)
+{
+    if(m_buffer.empty())
+    {
+        CONDUIT_WARN("Save must be called after encode()")
+        return;
+    }
+
+    std::ofstream ofs(filename.c_str(), std::ios::out | std::ios::binary);
+    if(!ofs.is_open())
+    {
+        CONDUIT_WARN("Error saving QOI buffer to file: " << filename);
+        return;
+    }
+    ofs.write((const char*)&m_buffer[0], m_buffer.size());
+}
+
+//-----------------------------------------------------------------------------
+void *
+QOIEncoder::Buffer()
+{
+    return m_buffer.empty() ? NULL : (void*)&m_buffer[0];
+}
+
+//-----------------------------------------------------------------------------
+size_t
+QOIEncoder::BufferSize()
+{
+    return m_buffer.size();
+}
+
+//-----------------------------------------------------------------------------
+void
+QOIEncoder::Cleanup()
+{
+    std::vector<unsigned char>().swap(m_buffer);
+}
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
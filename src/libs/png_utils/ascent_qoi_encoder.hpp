@@ -0,0 +1,67 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_qoi_encoder.hpp
+///
+//-----------------------------------------------------------------------------
+#ifndef ASCENT_QOI_ENCODER_HPP
+#define ASCENT_QOI_ENCODER_HPP
+
+#include <png_utils/ascent_png_utils_exports.h>
+
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+/// Writes images in the QOI format (https://qoiformat.org), a lossless
+/// single pass run length / delta encoding that is much faster to
+/// write than PNG, at the cost of larger files. Meant for intermediate
+/// images that are read by post processing tools.
+//-----------------------------------------------------------------------------
+class ASCENT_API QOIEncoder
+{
+public:
+    QOIEncoder();
+    ~QOIEncoder();
+
+    // the first row of the input is the bottom of the image
+    void           Encode(const unsigned char *rgba_in,
+                          const int width,
+                          const int height);
+
+    void           Encode(const float *rgba_in,
+                          const int width,
+                          const int height);
+
+    void           Save(const std::string &filename);
+
+    void          *Buffer();
+    size_t         BufferSize();
+
+    void           Cleanup();
+
+private:
+    std::vector<unsigned char> m_buffer;
+};
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
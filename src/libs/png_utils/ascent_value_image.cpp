@@ -0,0 +1,407 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_value_image.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "ascent_value_image.hpp"
+
+// standard includes
+#include <string.h>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+using namespace conduit;
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::detail --
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+const char VALUE_IMAGE_MAGIC[8] = {'A','S','C','V','I','M','G','1'};
+const int  VALUE_IMAGE_CAMERA_SIZE = 11;
+
+//-----------------------------------------------------------------------------
+template<typename T>
+void
+append(std::vector<unsigned char> &buffer, const T *values, const size_t count)
+{
+    if(count == 0)
+    {
+        return;
+    }
+    const size_t offset = buffer.size();
+    buffer.resize(offset + sizeof(T) * count);
+    memcpy(&buffer[offset], values, sizeof(T) * count);
+}
+
+//-----------------------------------------------------------------------------
+// reads from a buffer, throwing on truncated input
+class BufferReader
+{
+public:
+    BufferReader(const unsigned char *buffer, const size_t size)
+    : m_buffer(buffer),
+      m_size(size),
+      m_offset(0)
+    {}
+
+    template<typename T>
+    void read(T *values, const size_t count)
+    {
+        const size_t bytes = sizeof(T) * count;
+        if(m_size - m_offset < bytes)
+        {
+            CONDUIT_ERROR("Error decoding value image: truncated data");
+        }
+        memcpy(values, m_buffer + m_offset, bytes);
+        m_offset += bytes;
+    }
+
+    const unsigned char *skip(const size_t bytes)
+    {
+        if(m_size - m_offset < bytes)
+        {
+            CONDUIT_ERROR("Error decoding value image: truncated data");
+        }
+        const unsigned char *res = m_buffer + m_offset;
+        m_offset += bytes;
+        return res;
+    }
+
+private:
+    const unsigned char *m_buffer;
+    const size_t         m_size;
+    size_t               m_offset;
+};
+
+//-----------------------------------------------------------------------------
+// float32 view of an image array, converting if needed
+const float32 *
+float32_values(const Node &values,
+               const index_t size,
+               Node &tmp,
+               const std::string &name)
+{
+    if(values.dtype().number_of_elements() != size)
+    {
+        CONDUIT_ERROR("Error encoding value image: '" << name << "' has "
+                      << values.dtype().number_of_elements()
+                      << " values but the image has " << size << " pixels");
+    }
+    if(values.dtype().is_float32() && values.is_compact())
+    {
+        return values.as_float32_ptr();
+    }
+    values.to_float32_array(tmp);
+    return tmp.as_float32_ptr();
+}
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::detail --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+ValueImageEncoder::ValueImageEncoder()
+{}
+
+//-----------------------------------------------------------------------------
+ValueImageEncoder::~ValueImageEncoder()
+{
+    Cleanup();
+}
+
+//-----------------------------------------------------------------------------
+void
+ValueImageEncoder::Encode(const Node &image)
+{
+    Cleanup();
+
+    const int32 width  = image["width"].to_int32();
+    const int32 height = image["height"].to_int32();
+    const index_t size = (index_t) width * height;
+
+    Node n_depth;
+    const float32 *depth = detail::float32_values(image["depth"],
+                                                  size,
+                                                  n_depth,
+                                                  "depth");
+
+    std::vector<std::string> names;
+    if(image.has_child("fields"))
+    {
+        names = image["fields"].child_names();
+    }
+    const int32 num_fields = static_cast<int32>(names.size());
+
+    float64 camera[detail::VALUE_IMAGE_CAMERA_SIZE];
+    for(int i = 0; i < detail::VALUE_IMAGE_CAMERA_SIZE; ++i)
+    {
+        camera[i] = 0.0;
+    }
+    if(image.has_child("camera"))
+    {
+        const Node &n_camera = image["camera"];
+        const char *vecs[3] = {"position", "look_at", "up"};
+        for(int v = 0; v < 3; ++v)
+        {
+            if(n_camera.has_child(vecs[v]))
+            {
+                Node tmp;
+                n_camera[vecs[v]].to_float64_array(tmp);
+                const float64 *vals = tmp.as_float64_ptr();
+                for(int c = 0; c < 3; ++c)
+                {
+                    camera[v * 3 + c] = vals[c];
+                }
+            }
+        }
+        if(n_camera.has_child("fov"))
+        {
+            camera[9] = n_camera["fov"].to_float64();
+        }
+        if(n_camera.has_child("zoom"))
+        {
+            camera[10] = n_camera["zoom"].to_float64();
+        }
+    }
+
+    // coverage
+    std::vector<unsigned char> mask((size + 7) / 8, 0);
+    std::vector<index_t> covered;
+    for(index_t i = 0; i < size; ++i)
+    {
+        if(std::isfinite(depth[i]))
+        {
+            mask[i / 8] |= (unsigned char)(1 << (i % 8));
+            covered.push_back(i);
+        }
+    }
+    const index_t num_covered = static_cast<index_t>(covered.size());
+
+    m_buffer.reserve(64 + mask.size() +
+                     sizeof(float32) * num_covered * (num_fields + 1));
+    detail::append(m_buffer, detail::VALUE_IMAGE_MAGIC, 8);
+    detail::append(m_buffer, &width, 1);
+    detail::append(m_buffer, &height, 1);
+    detail::append(m_buffer, &num_fields, 1);
+    detail::append(m_buffer, camera, detail::VALUE_IMAGE_CAMERA_SIZE);
+    for(int32 f = 0; f < num_fields; ++f)
+    {
+        const int32 len = static_cast<int32>(names[f].size());
+        detail::append(m_buffer, &len, 1);
+        detail::append(m_buffer, names[f].c_str(), len);
+    }
+    detail::append(m_buffer, mask.data(), mask.size());
+
+    std::vector<float32> packed(num_covered);
+    for(index_t i = 0; i < num_covered; ++i)
+    {
+        packed[i] = depth[covered[i]];
+    }
+    detail::append(m_buffer, packed.data(), packed.size());
+
+    for(int32 f = 0; f < num_fields; ++f)
+    {
+        Node tmp;
+        const float32 *values = detail::float32_values(image["fields"].child(f),
+                                                       size,
+                                                       tmp,
+                                                       names[f]);
+        for(index_t i = 0; i < num_covered; ++i)
+        {
+            packed[i] = values[covered[i]];
+        }
+        detail::append(m_buffer, packed.data(), packed.size());
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+ValueImageEncoder::Save(const std::string &filename)
+{
+    if(m_buffer.empty())
+    {
+        CONDUIT_WARN("Save must be called after encode()")
+        return;
+    }
+
+    std::ofstream ofs(filename.c_str(), std::ios::out | std::ios::binary);
+    if(!ofs.is_open())
+    {
+        CONDUIT_WARN("Error saving value image to file: " << filename);
+        return;
+    }
+    ofs.write((const char*)&m_buffer[0], m_buffer.size());
+}
+
+//-----------------------------------------------------------------------------
+void *
+ValueImageEncoder::Buffer()
+{
+    return m_buffer.empty() ? NULL : (void*)&m_buffer[0];
+}
+
+//-----------------------------------------------------------------------------
+size_t
+ValueImageEncoder::BufferSize()
+{
+    return m_buffer.size();
+}
+
+//-----------------------------------------------------------------------------
+void
+ValueImageEncoder::Cleanup()
+{
+    m_buffer.clear();
+}
+
+//-----------------------------------------------------------------------------
+ValueImageDecoder::ValueImageDecoder()
+{}
+
+//-----------------------------------------------------------------------------
+ValueImageDecoder::~ValueImageDecoder()
+{
+}
+
+//-----------------------------------------------------------------------------
+void
+ValueImageDecoder::Decode(const std::string &file_name,
+                          Node &image)
+{
+    std::ifstream ifs(file_name.c_str(), std::ios::in | std::ios::binary);
+    if(!ifs.is_open())
+    {
+        CONDUIT_ERROR("Error opening value image file " << file_name);
+    }
+    std::vector<unsigned char> buffer((std::istreambuf_iterator<char>(ifs)),
+                                      std::istreambuf_iterator<char>());
+    if(buffer.empty())
+    {
+        CONDUIT_ERROR("Error decoding value image " << file_name << ": empty file");
+    }
+    Decode(&buffer[0], buffer.size(), image);
+}
+
+//-----------------------------------------------------------------------------
+void
+ValueImageDecoder::Decode(const unsigned char *buffer,
+                          const size_t buffer_size,
+                          Node &image)
+{
+    image.reset();
+    detail::BufferReader reader(buffer, buffer_size);
+
+    char magic[8];
+    reader.read(magic, 8);
+    if(memcmp(magic, detail::VALUE_IMAGE_MAGIC, 8) != 0)
+    {
+        CONDUIT_ERROR("Error decoding value image: invalid header");
+    }
+
+    int32 width, height, num_fields;
+    reader.read(&width, 1);
+    reader.read(&height, 1);
+    reader.read(&num_fields, 1);
+    if(width <= 0 || height <= 0 || num_fields < 0)
+    {
+        CONDUIT_ERROR("Error decoding value image: invalid header");
+    }
+    const index_t size = (index_t) width * height;
+
+    float64 camera[detail::VALUE_IMAGE_CAMERA_SIZE];
+    reader.read(camera, detail::VALUE_IMAGE_CAMERA_SIZE);
+
+    std::vector<std::string> names(num_fields);
+    for(int32 f = 0; f < num_fields; ++f)
+    {
+        int32 len;
+        reader.read(&len, 1);
+        if(len < 0)
+        {
+            CONDUIT_ERROR("Error decoding value image: invalid field name");
+        }
+        const unsigned char *chars = reader.skip(len);
+        names[f].assign((const char*)chars, len);
+    }
+
+    const unsigned char *mask = reader.skip((size + 7) / 8);
+
+    image["width"] = width;
+    image["height"] = height;
+    image["camera/position"].set(camera, 3);
+    image["camera/look_at"].set(camera + 3, 3);
+    image["camera/up"].set(camera + 6, 3);
+    image["camera/fov"] = camera[9];
+    image["camera/zoom"] = camera[10];
+
+    std::vector<index_t> covered;
+    for(index_t i = 0; i < size; ++i)
+    {
+        if(mask[i / 8] & (1 << (i % 8)))
+        {
+            covered.push_back(i);
+        }
+    }
+    const index_t num_covered = static_cast<index_t>(covered.size());
+    std::vector<float32> packed(num_covered);
+
+    image["depth"].set(DataType::float32(size));
+    float32 *depth = image["depth"].value();
+    for(index_t i = 0; i < size; ++i)
+    {
+        depth[i] = std::numeric_limits<float32>::infinity();
+    }
+    if(num_covered > 0)
+    {
+        reader.read(packed.data(), num_covered);
+    }
+    for(index_t i = 0; i < num_covered; ++i)
+    {
+        depth[covered[i]] = packed[i];
+    }
+
+    for(int32 f = 0; f < num_fields; ++f)
+    {
+        // names may contain '/'
+        Node &n_values = image["fields"].add_child(names[f]);
+        n_values.set(DataType::float32(size));
+        float32 *values = n_values.value();
+        for(index_t i = 0; i < size; ++i)
+        {
+            values[i] = std::numeric_limits<float32>::quiet_NaN();
+        }
+        if(num_covered > 0)
+        {
+            reader.read(packed.data(), num_covered);
+        }
+        for(index_t i = 0; i < num_covered; ++i)
+        {
+            values[covered[i]] = packed[i];
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
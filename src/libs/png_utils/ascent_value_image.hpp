@@ -0,0 +1,92 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_value_image.hpp
+///
+//-----------------------------------------------------------------------------
+#ifndef ASCENT_VALUE_IMAGE_HPP
+#define ASCENT_VALUE_IMAGE_HPP
+
+#include <png_utils/ascent_png_utils_exports.h>
+
+#include <conduit.hpp>
+
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+/// Value images hold the depth and the raw scalar values seen through each
+/// pixel instead of colors, so they can be recolored and relit after the
+/// run. In memory a value image is a conduit node:
+///
+///   width:  int32
+///   height: int32
+///   camera: (optional) position, look_at, up (3 x float64), fov, zoom
+///   depth:  float32 [width * height], +inf where nothing was hit
+///   fields/<name>: float32 [width * height]
+///
+/// The first row is the bottom of the image. Files only store covered
+/// pixels (little endian):
+///
+///   "ASCVIMG1", int32 width, height, number of fields,
+///   float64 camera[11], then for each field: int32 name length, name,
+///   a coverage bit mask (bit p % 8 of byte p / 8 is pixel p),
+///   float32 depths of the covered pixels, then the float32 values of the
+///   covered pixels for each field.
+//-----------------------------------------------------------------------------
+class ASCENT_API ValueImageEncoder
+{
+public:
+    ValueImageEncoder();
+    ~ValueImageEncoder();
+
+    void           Encode(const conduit::Node &image);
+
+    void           Save(const std::string &filename);
+
+    void          *Buffer();
+    size_t         BufferSize();
+
+    void           Cleanup();
+
+private:
+    std::vector<unsigned char> m_buffer;
+};
+
+//-----------------------------------------------------------------------------
+class ASCENT_API ValueImageDecoder
+{
+public:
+    ValueImageDecoder();
+    ~ValueImageDecoder();
+
+    // uncovered pixels get +inf depths and nan values
+    void Decode(const std::string &file_name,
+                conduit::Node &image);
+
+    void Decode(const unsigned char *buffer,
+                const size_t buffer_size,
+                conduit::Node &image);
+};
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
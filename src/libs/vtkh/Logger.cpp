@@ -3,6 +3,7 @@
 
 #include <iomanip>
 #include <cstdlib>
+#include <vector>
 
 namespace vtkh
 {
@@ -51,6 +52,13 @@ Logger::Write(const int level, const std::string &message, const char *file, int
 // ---------------------------------------------------------------------------------------
 
 DataLogger DataLogger::Instance;
+DataLogger::TraceCallback DataLogger::TraceSink = nullptr;
+
+namespace detail
+{
+// names of the open entries, so end events can be named
+static thread_local std::vector<std::string> trace_entries;
+} // namespace detail
 
 DataLogger::DataLogger()
   : AtBlockStart(true),
@@ -160,6 +168,7 @@ DataLogger::OpenLogEntry(const std::string &entryName)
     Timers.push(timer);
     AtBlockStart = true;
 
+    TraceOpen(entryName);
 }
 void
 DataLogger::CloseLogEntry()
@@ -170,5 +179,35 @@ DataLogger::CloseLogEntry()
   Blocks.pop();
   KeyCounters.pop();
   AtBlockStart = false;
+
+  TraceClose();
+}
+
+void
+DataLogger::SetTraceCallback(TraceCallback callback)
+{
+  TraceSink = callback;
+}
+
+void
+DataLogger::TraceOpen(const std::string &entryName)
+{
+  if(TraceSink == nullptr)
+  {
+    return;
+  }
+  detail::trace_entries.push_back(entryName);
+  TraceSink(TRACE_BEGIN, entryName.c_str(), 0.0);
+}
+
+void
+DataLogger::TraceClose()
+{
+  if(TraceSink == nullptr || detail::trace_entries.empty())
+  {
+    return;
+  }
+  TraceSink(TRACE_END, detail::trace_entries.back().c_str(), 0.0);
+  detail::trace_entries.pop_back();
 }
 };
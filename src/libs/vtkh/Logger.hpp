@@ -7,6 +7,7 @@
 
 #include <stack>
 #include <sstream>
+#include <type_traits>
 //from rover logging
 namespace vtkh
 {
@@ -42,6 +43,17 @@ public:
     {  }
   };
 
+  // log entries can also be forwarded as begin/end/counter events to
+  // an external tracer (ascent installs one when tracing is enabled).
+  // This works even when VTKH_ENABLE_LOGGING is off.
+  enum TracePhase
+  {
+    TRACE_BEGIN   = 0,
+    TRACE_END     = 1,
+    TRACE_COUNTER = 2
+  };
+  typedef void (*TraceCallback)(int phase, const char *name, double value);
+
   ~DataLogger();
   static DataLogger *GetInstance();
   void OpenLogEntry(const std::string &entryName);
@@ -54,6 +66,18 @@ public:
     WriteIndent();
     this->Stream << key << ": " << value <<"\n";
     AtBlockStart = false;
+    TraceAdd(key, value);
+  }
+
+  static void SetTraceCallback(TraceCallback callback);
+  static bool TraceEnabled() { return TraceSink != nullptr; }
+  void TraceOpen(const std::string &entryName);
+  void TraceClose();
+
+  template<typename T>
+  void TraceAdd(const std::string &key, const T &value)
+  {
+    TraceAdd(key, value, typename std::is_arithmetic<T>::type());
   }
 
   std::stringstream& GetStream() { return Stream; }
@@ -71,6 +95,23 @@ protected:
   std::stack<std::map<std::string,int>> KeyCounters;
   bool AtBlockStart;
   int Rank;
+
+  template<typename T>
+  void TraceAdd(const std::string &key, const T &value, std::true_type)
+  {
+    if(TraceSink != nullptr)
+    {
+      TraceSink(TRACE_COUNTER, key.c_str(), static_cast<double>(value));
+    }
+  }
+
+  template<typename T>
+  void TraceAdd(const std::string &, const T &, std::false_type)
+  {
+    // only numbers are forwarded
+  }
+
+  static TraceCallback TraceSink;
 };
 
 #ifdef VTKH_ENABLE_LOGGING
@@ -85,9 +126,9 @@ protected:
 #define VTKH_INFO(msg)
 #define VTKH_WARN(msg)
 #define VTKH_ERROR(msg)
-#define VTKH_DATA_ADD(key,value)
-#define VTKH_DATA_OPEN(key)
-#define VTKH_DATA_CLOSE()
+#define VTKH_DATA_ADD(key,value) { if(vtkh::DataLogger::TraceEnabled()) vtkh::DataLogger::GetInstance()->TraceAdd(key, value); }
+#define VTKH_DATA_OPEN(key) { if(vtkh::DataLogger::TraceEnabled()) vtkh::DataLogger::GetInstance()->TraceOpen(key); }
+#define VTKH_DATA_CLOSE() { if(vtkh::DataLogger::TraceEnabled()) vtkh::DataLogger::GetInstance()->TraceClose(); }
 #endif
 
 
@@ -9,6 +9,7 @@
 #include <vtkh/vtkh.hpp>
 #include <vtkh/compositing/DirectSendCompositor.hpp>
 #include <vtkh/compositing/RadixKCompositor.hpp>
+#include <vtkh/compositing/SharedMemoryCompositor.hpp>
 #include <diy/mpi.hpp>
 #endif
 
@@ -16,7 +17,8 @@ namespace vtkh
 {
 
 Compositor::Compositor()
-  : m_composite_mode(Z_BUFFER_SURFACE)
+  : m_composite_mode(Z_BUFFER_SURFACE),
+    m_shared_memory(true)
 {
 
 }
@@ -34,6 +36,20 @@ Compositor::SetCompositeMode(CompositeMode composite_mode)
   m_composite_mode = composite_mode;
 }
 
+void
+Compositor::SetSharedMemoryCompositing(bool on)
+{
+  m_shared_memory = on;
+}
+
+void
+Compositor::ReleaseSharedMemory()
+{
+#ifdef VTKH_PARALLEL
+  SharedMemoryCompositor::ReleaseSharedMemory();
+#endif
+}
+
 void
 Compositor::ClearImages()
 {
@@ -182,6 +198,28 @@ Compositor::Composite()
   return m_images[0];
 }
 
+void
+Compositor::CompositeBatch(std::vector<Image> &images)
+{
+  // nothing to do here in serial
+#ifdef VTKH_PARALLEL
+  vtkhdiy::mpi::communicator diy_comm(MPI_Comm_f2c(GetMPICommHandle()));
+
+  if(m_shared_memory)
+  {
+    SharedMemoryCompositor compositor;
+    compositor.CompositeSurfaces(diy_comm, images);
+    m_log_stream<<compositor.GetTimingString();
+  }
+  else
+  {
+    RadixKCompositor compositor;
+    compositor.CompositeSurfaces(diy_comm, images);
+    m_log_stream<<compositor.GetTimingString();
+  }
+#endif
+}
+
 void
 Compositor::Cleanup()
 {
@@ -205,9 +243,18 @@ Compositor::CompositeZBufferSurface()
   vtkhdiy::mpi::communicator diy_comm(MPI_Comm_f2c(GetMPICommHandle()));
 
   assert(m_images.size() == 1);
-  RadixKCompositor compositor;
-  compositor.CompositeSurface(diy_comm, this->m_images[0]);
-  m_log_stream<<compositor.GetTimingString();
+  if(m_shared_memory)
+  {
+    SharedMemoryCompositor compositor;
+    compositor.CompositeSurface(diy_comm, this->m_images[0]);
+    m_log_stream<<compositor.GetTimingString();
+  }
+  else
+  {
+    RadixKCompositor compositor;
+    compositor.CompositeSurface(diy_comm, this->m_images[0]);
+    m_log_stream<<compositor.GetTimingString();
+  }
 #endif
 }
 
@@ -22,6 +22,14 @@ public:
 
     void SetCompositeMode(CompositeMode composite_mode);
 
+    // Composite surfaces on each node in shared memory before compositing
+    // across nodes (on by default). Only used in parallel.
+    void SetSharedMemoryCompositing(bool on);
+
+    // Frees the shared memory kept between composites. Must be called
+    // before MPI_Finalize.
+    static void ReleaseSharedMemory();
+
     void ClearImages();
 
     void AddImage(const unsigned char *color_buffer,
@@ -48,6 +56,13 @@ public:
 
     Image Composite();
 
+    // Depth composites independent images, e.g. all the renders of a
+    // batch, in one pass. In parallel the images of a batch share the
+    // message rounds instead of paying their latency once per image.
+    // The results replace the images (on rank 0 in parallel). This does
+    // not use the images added with AddImage.
+    void CompositeBatch(std::vector<Image> &images);
+
     virtual void         Cleanup();
 
     std::string          GetLogString();
@@ -74,6 +89,7 @@ protected:
 
     std::stringstream   m_log_stream;
     CompositeMode       m_composite_mode;
+    bool                m_shared_memory;
     std::vector<Image>  m_images;
 };
 
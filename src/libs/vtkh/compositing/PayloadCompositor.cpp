@@ -8,6 +8,7 @@
 #include <mpi.h>
 #include <vtkh/vtkh.hpp>
 #include <vtkh/compositing/RadixKCompositor.hpp>
+#include <vtkh/compositing/SharedMemoryCompositor.hpp>
 #include <diy/mpi.hpp>
 #endif
 
@@ -15,10 +16,17 @@ namespace vtkh
 {
 
 PayloadCompositor::PayloadCompositor()
+  : m_shared_memory(true)
 {
 
 }
 
+void
+PayloadCompositor::SetSharedMemoryCompositing(bool on)
+{
+  m_shared_memory = on;
+}
+
 void
 PayloadCompositor::ClearImages()
 {
@@ -54,13 +62,28 @@ PayloadCompositor::Composite()
   vtkhdiy::mpi::communicator diy_comm(MPI_Comm_f2c(GetMPICommHandle()));
 
   assert(m_images.size() == 1);
-  RadixKCompositor compositor;
-  compositor.CompositeSurface(diy_comm, this->m_images[0]);
+  if(m_shared_memory)
+  {
+    SharedMemoryCompositor compositor;
+    compositor.CompositeSurface(diy_comm, this->m_images[0]);
+  }
+  else
+  {
+    RadixKCompositor compositor;
+    compositor.CompositeSurface(diy_comm, this->m_images[0]);
+  }
 #endif
   // Make this a param to avoid the copy?
   return m_images[0];
 }
 
+PayloadImage
+PayloadCompositor::LocalComposite()
+{
+  assert(m_images.size() != 0);
+  return m_images[0];
+}
+
 
 } // namespace vtkh
 
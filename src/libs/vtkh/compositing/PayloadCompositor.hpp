@@ -15,11 +15,17 @@ public:
 
     void ClearImages();
 
+    // see Compositor::SetSharedMemoryCompositing
+    void SetSharedMemoryCompositing(bool on);
+
     void AddImage(PayloadImage &image);
 
     PayloadImage Composite();
+    // composite of the images added on this rank, no communication
+    PayloadImage LocalComposite();
 protected:
     std::vector<PayloadImage>  m_images;
+    bool                       m_shared_memory;
 };
 
 };
@@ -31,39 +31,13 @@ void DepthComposite<Image>(Image &front, Image &back)
   compositor.ZBufferComposite(front, back);
 }
 
+// splits the image into group_size pieces along current_dim
 template<typename ImageType>
-void reduce_images(void *b,
-                   const vtkhdiy::ReduceProxy &proxy,
-                   const vtkhdiy::RegularSwapPartners &partners)
+void split_image(const ImageType &image,
+                 const int current_dim,
+                 const int group_size,
+                 std::vector<ImageType> &out_images)
 {
-  ImageBlock<ImageType> *block = reinterpret_cast<ImageBlock<ImageType>*>(b);
-  unsigned int round = proxy.round();
-  ImageType &image = block->m_image;
-  // count the number of incoming pixels
-  if(proxy.in_link().size() > 0)
-  {
-      for(int i = 0; i < proxy.in_link().size(); ++i)
-      {
-        int gid = proxy.in_link().target(i).gid;
-        if(gid == proxy.gid())
-        {
-          //skip revieving from self since we sent nothing
-          continue;
-        }
-        ImageType incoming;
-        proxy.dequeue(gid, incoming);
-        DepthComposite(image, incoming);
-      } // for in links
-  }
-
-  if(proxy.out_link().size() == 0)
-  {
-    return;
-  }
-  // do compositing?? intermediate stage?
-  const int group_size = proxy.out_link().size();
-  const int current_dim = partners.dim(round);
-
   //create balanced set of ranges for current dim
   vtkhdiy::DiscreteBounds image_bounds = VTKMBoundsToDIY(image.m_bounds);
   int range_length = image_bounds.max[current_dim] - image_bounds.min[current_dim];
@@ -103,11 +77,48 @@ void reduce_images(void *b,
     assert(subset_bounds[group_size-1].max[current_dim] == image_bounds.max[current_dim]);
   }
 
-  std::vector<ImageType> out_images(group_size);
+  out_images.resize(group_size);
   for(int i = 0; i < group_size; ++i)
   {
     out_images[i].SubsetFrom(image, DIYBoundsToVTKM(subset_bounds[i]));
   } //for
+}
+
+template<typename ImageType>
+void reduce_images(void *b,
+                   const vtkhdiy::ReduceProxy &proxy,
+                   const vtkhdiy::RegularSwapPartners &partners)
+{
+  ImageBlock<ImageType> *block = reinterpret_cast<ImageBlock<ImageType>*>(b);
+  unsigned int round = proxy.round();
+  ImageType &image = block->m_image;
+  // count the number of incoming pixels
+  if(proxy.in_link().size() > 0)
+  {
+      for(int i = 0; i < proxy.in_link().size(); ++i)
+      {
+        int gid = proxy.in_link().target(i).gid;
+        if(gid == proxy.gid())
+        {
+          //skip revieving from self since we sent nothing
+          continue;
+        }
+        ImageType incoming;
+        proxy.dequeue(gid, incoming);
+        DepthComposite(image, incoming);
+      } // for in links
+  }
+
+  if(proxy.out_link().size() == 0)
+  {
+    return;
+  }
+  // do compositing?? intermediate stage?
+  const int group_size = proxy.out_link().size();
+  const int current_dim = partners.dim(round);
+
+  std::vector<ImageType> out_images;
+  split_image(image, current_dim, group_size, out_images);
 
   for(int i = 0; i < group_size; ++i)
   {
@@ -123,6 +134,73 @@ void reduce_images(void *b,
 
 } // reduce images
 
+// reduce_images for a batch of independent images. Every message carries
+// the pieces of all the images, so a batch pays the latency of each
+// round once instead of once per image.
+template<typename ImageType>
+void reduce_image_batch(void *b,
+                        const vtkhdiy::ReduceProxy &proxy,
+                        const vtkhdiy::RegularSwapPartners &partners)
+{
+  ImageBatchBlock<ImageType> *block = reinterpret_cast<ImageBatchBlock<ImageType>*>(b);
+  unsigned int round = proxy.round();
+  std::vector<ImageType> &images = block->m_images;
+  const int num_images = static_cast<int>(images.size());
+
+  for(int i = 0; i < proxy.in_link().size(); ++i)
+  {
+    int gid = proxy.in_link().target(i).gid;
+    if(gid == proxy.gid())
+    {
+      //skip revieving from self since we sent nothing
+      continue;
+    }
+    std::vector<ImageType> incoming;
+    proxy.dequeue(gid, incoming);
+    assert(static_cast<int>(incoming.size()) == num_images);
+    for(int n = 0; n < num_images; ++n)
+    {
+      DepthComposite(images[n], incoming[n]);
+    }
+  } // for in links
+
+  if(proxy.out_link().size() == 0)
+  {
+    return;
+  }
+  const int group_size = proxy.out_link().size();
+  const int current_dim = partners.dim(round);
+
+  // out_batches[i][n] is the piece of image n that goes to target i
+  std::vector<std::vector<ImageType>> out_batches(group_size,
+                                                  std::vector<ImageType>(num_images));
+  for(int n = 0; n < num_images; ++n)
+  {
+    std::vector<ImageType> out_images;
+    split_image(images[n], current_dim, group_size, out_images);
+    for(int i = 0; i < group_size; ++i)
+    {
+      out_batches[i][n] = std::move(out_images[i]);
+    }
+  }
+
+  for(int i = 0; i < group_size; ++i)
+  {
+    if(proxy.out_link().target(i).gid == proxy.gid())
+    {
+      for(int n = 0; n < num_images; ++n)
+      {
+        images[n].Swap(out_batches[i][n]);
+      }
+    }
+    else
+    {
+      proxy.enqueue(proxy.out_link().target(i), out_batches[i]);
+    }
+  } //for
+
+} // reduce image batch
+
 RadixKCompositor::RadixKCompositor()
 {
 
@@ -179,6 +257,57 @@ RadixKCompositor::CompositeImpl(vtkhdiy::mpi::communicator &diy_comm, ImageType
     }
 }
 
+template<typename ImageType>
+void
+RadixKCompositor::CompositeBatchImpl(vtkhdiy::mpi::communicator &diy_comm,
+                                     std::vector<ImageType> &images)
+{
+    if(images.empty())
+    {
+      return;
+    }
+    // the decomposition only decides the partners, each image is split
+    // on its own bounds
+    vtkhdiy::DiscreteBounds global_bounds = VTKMBoundsToDIY(images[0].m_orig_bounds);
+
+    // tells diy to use one thread
+    const int num_threads = 1;
+    const int num_blocks = diy_comm.size();
+    const int magic_k = 8;
+
+    vtkhdiy::Master master(diy_comm, num_threads,
+                           -1, 0,
+                           [](void * b){
+                              ImageBatchBlock<ImageType> *block
+                              = reinterpret_cast<ImageBatchBlock<ImageType>*>(b);
+                              delete block;
+                           });
+
+    // create an assigner with one block per rank
+    vtkhdiy::ContiguousAssigner assigner(num_blocks, num_blocks);
+    AddImageBatchBlock<ImageType> create(master, images);
+    const int num_dims = 2;
+    vtkhdiy::RegularDecomposer<vtkhdiy::DiscreteBounds> decomposer(num_dims, global_bounds, num_blocks);
+    decomposer.decompose(diy_comm.rank(), assigner, create);
+    vtkhdiy::RegularSwapPartners partners(decomposer,
+                                      magic_k,
+                                      false); // false == distance halving
+    vtkhdiy::reduce(master,
+                assigner,
+                partners,
+                reduce_image_batch<ImageType>);
+
+    vtkhdiy::all_to_all(master,
+                    assigner,
+                    CollectImageBatch<ImageType>(),
+                    magic_k);
+
+    if(diy_comm.rank() == 0)
+    {
+      master.prof.output(m_timing_log);
+    }
+}
+
 void
 RadixKCompositor::CompositeSurface(vtkhdiy::mpi::communicator &diy_comm, Image &image)
 {
@@ -191,6 +320,20 @@ RadixKCompositor::CompositeSurface(vtkhdiy::mpi::communicator &diy_comm, Payload
   CompositeImpl(diy_comm, image);
 }
 
+void
+RadixKCompositor::CompositeSurfaces(vtkhdiy::mpi::communicator &diy_comm,
+                                    std::vector<Image> &images)
+{
+  CompositeBatchImpl(diy_comm, images);
+}
+
+void
+RadixKCompositor::CompositeSurfaces(vtkhdiy::mpi::communicator &diy_comm,
+                                    std::vector<PayloadImage> &images)
+{
+  CompositeBatchImpl(diy_comm, images);
+}
+
 std::string
 RadixKCompositor::GetTimingString()
 {
@@ -5,6 +5,7 @@
 #include <vtkh/compositing/PayloadImage.hpp>
 #include <diy/mpi.hpp>
 #include <sstream>
+#include <vector>
 
 namespace vtkh
 {
@@ -16,10 +17,16 @@ public:
   ~RadixKCompositor();
   void CompositeSurface(vtkhdiy::mpi::communicator &diy_comm, Image &image);
   void CompositeSurface(vtkhdiy::mpi::communicator &diy_comm, PayloadImage &image);
+  // composites independent images together, sharing the exchange rounds
+  void CompositeSurfaces(vtkhdiy::mpi::communicator &diy_comm, std::vector<Image> &images);
+  void CompositeSurfaces(vtkhdiy::mpi::communicator &diy_comm, std::vector<PayloadImage> &images);
 
   template<typename ImageType>
   void CompositeImpl(vtkhdiy::mpi::communicator &diy_comm, ImageType &image);
 
+  template<typename ImageType>
+  void CompositeBatchImpl(vtkhdiy::mpi::communicator &diy_comm, std::vector<ImageType> &images);
+
   std::string GetTimingString();
 private:
   std::stringstream m_timing_log;
@@ -0,0 +1,377 @@
+#include <vtkh/compositing/SharedMemoryCompositor.hpp>
+#include <vtkh/compositing/RadixKCompositor.hpp>
+
+#include <mpi.h>
+#include <algorithm>
+#include <assert.h>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <vector>
+
+namespace vtkh
+{
+
+namespace detail
+{
+
+struct NodeComms
+{
+  MPI_Comm m_node_comm;
+  // MPI_COMM_NULL on ranks that are not node leaders
+  MPI_Comm m_leader_comm;
+  int m_node_rank;
+  int m_node_size;
+  int m_max_node_size;
+  int m_num_leaders;
+
+  bool m_has_window;
+  MPI_Win m_window;
+  MPI_Aint m_window_bytes;
+};
+
+// keyed on the fortran handle of the parent comm
+std::map<int, NodeComms> &node_comms_cache()
+{
+  static std::map<int, NodeComms> cache;
+  return cache;
+}
+
+NodeComms &
+find_node_comms(MPI_Comm comm)
+{
+  auto &cache = node_comms_cache();
+  const int key = MPI_Comm_c2f(comm);
+  auto it = cache.find(key);
+  if(it != cache.end())
+  {
+    return it->second;
+  }
+
+  NodeComms comms;
+  comms.m_leader_comm = MPI_COMM_NULL;
+  comms.m_has_window = false;
+  comms.m_window_bytes = 0;
+
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+#if MPI_VERSION >= 3
+  // keying on the rank makes the lowest rank of each node its leader,
+  // so the leader of the node with rank 0 is rank 0 of the leaders
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &comms.m_node_comm);
+#else
+  MPI_Comm_split(comm, rank, 0, &comms.m_node_comm);
+#endif
+  MPI_Comm_rank(comms.m_node_comm, &comms.m_node_rank);
+  MPI_Comm_size(comms.m_node_comm, &comms.m_node_size);
+  MPI_Allreduce(&comms.m_node_size, &comms.m_max_node_size, 1, MPI_INT, MPI_MAX, comm);
+
+  const int color = comms.m_node_rank == 0 ? 0 : MPI_UNDEFINED;
+  MPI_Comm_split(comm, color, rank, &comms.m_leader_comm);
+  int is_leader = comms.m_node_rank == 0 ? 1 : 0;
+  MPI_Allreduce(&is_leader, &comms.m_num_leaders, 1, MPI_INT, MPI_SUM, comm);
+
+  return cache.insert(std::make_pair(key, comms)).first->second;
+}
+
+void
+free_window(NodeComms &comms)
+{
+#if MPI_VERSION >= 3
+  if(comms.m_has_window)
+  {
+    MPI_Win_free(&comms.m_window);
+  }
+#endif
+  comms.m_has_window = false;
+  comms.m_window_bytes = 0;
+}
+
+// makes sure every rank of the node has a slot of at least slot_bytes.
+// All ranks of a node composite images of the same size, so they agree
+// on when to reallocate.
+void
+reserve_window(NodeComms &comms, MPI_Aint slot_bytes)
+{
+#if MPI_VERSION >= 3
+  if(comms.m_has_window && comms.m_window_bytes >= slot_bytes)
+  {
+    return;
+  }
+  free_window(comms);
+
+  MPI_Info info;
+  MPI_Info_create(&info);
+  // let each slot live in memory local to its rank
+  MPI_Info_set(info, "alloc_shared_noncontig", "true");
+  void *base = nullptr;
+  MPI_Win_allocate_shared(slot_bytes, 1, info, comms.m_node_comm, &base, &comms.m_window);
+  MPI_Info_free(&info);
+  comms.m_has_window = true;
+  comms.m_window_bytes = slot_bytes;
+#else
+  (void) comms;
+  (void) slot_bytes;
+#endif
+}
+
+inline int pixel_bytes(const Image &)
+{
+  return 4;
+}
+
+inline int pixel_bytes(const PayloadImage &image)
+{
+  return image.m_payload_bytes;
+}
+
+inline unsigned char *pixel_data(Image &image)
+{
+  return &image.m_pixels[0];
+}
+
+inline unsigned char *pixel_data(PayloadImage &image)
+{
+  return &image.m_payloads[0];
+}
+
+// same depth tests as ImageCompositor and PayloadImageCompositor
+inline bool take_depth(const Image &, const float depth, const float front_depth)
+{
+  return depth <= 1.f && depth <= front_depth;
+}
+
+inline bool take_depth(const PayloadImage &, const float depth, const float front_depth)
+{
+  // this should handle NaNs correctly
+  return fmin(depth, front_depth) == depth;
+}
+
+#if MPI_VERSION >= 3
+// depth composites the images of the ranks of the node into the
+// image of the node leader
+template<typename ImageType>
+void
+node_composite(NodeComms &comms, ImageType &image)
+{
+  assert(image.m_bounds.X.Min == image.m_orig_bounds.X.Min);
+  assert(image.m_bounds.X.Max == image.m_orig_bounds.X.Max);
+  assert(image.m_bounds.Y.Min == image.m_orig_bounds.Y.Min);
+  assert(image.m_bounds.Y.Max == image.m_orig_bounds.Y.Max);
+
+  const int num_pixels = image.GetNumberOfPixels();
+  const int bytes = pixel_bytes(image);
+  // depths first, then pixels, padded to keep the next slot aligned
+  const MPI_Aint depth_bytes = static_cast<MPI_Aint>(num_pixels) * sizeof(float);
+  MPI_Aint slot_bytes = depth_bytes + static_cast<MPI_Aint>(num_pixels) * bytes;
+  slot_bytes = (slot_bytes + 63) / 64 * 64;
+
+  if(slot_bytes > 0)
+  {
+    reserve_window(comms, slot_bytes);
+
+    const int node_size = comms.m_node_size;
+    std::vector<float*> slot_depths(node_size);
+    std::vector<unsigned char*> slot_pixels(node_size);
+    for(int i = 0; i < node_size; ++i)
+    {
+      MPI_Aint size;
+      int disp_unit;
+      unsigned char *ptr = nullptr;
+      MPI_Win_shared_query(comms.m_window, i, &size, &disp_unit, &ptr);
+      slot_depths[i] = reinterpret_cast<float*>(ptr);
+      slot_pixels[i] = ptr + depth_bytes;
+    }
+
+    const int node_rank = comms.m_node_rank;
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, comms.m_window);
+
+    std::memcpy(slot_depths[node_rank], &image.m_depths[0], depth_bytes);
+    std::memcpy(slot_pixels[node_rank],
+                pixel_data(image),
+                static_cast<size_t>(num_pixels) * bytes);
+
+    MPI_Win_sync(comms.m_window);
+    MPI_Barrier(comms.m_node_comm);
+    MPI_Win_sync(comms.m_window);
+
+    // every rank composites its slice of the pixels of all the slots
+    // into the leader's slot
+    const int begin = static_cast<int>(static_cast<long long>(num_pixels) * node_rank / node_size);
+    const int end = static_cast<int>(static_cast<long long>(num_pixels) * (node_rank + 1) / node_size);
+    float *front_depths = slot_depths[0];
+    unsigned char *front_pixels = slot_pixels[0];
+    for(int s = 1; s < node_size; ++s)
+    {
+      const float *depths = slot_depths[s];
+      const unsigned char *pixels = slot_pixels[s];
+#ifdef VTKH_OPENMP_ENABLED
+      #pragma omp parallel for
+#endif
+      for(int i = begin; i < end; ++i)
+      {
+        const float depth = depths[i];
+        if(!take_depth(image, depth, front_depths[i]))
+        {
+          continue;
+        }
+        front_depths[i] = depth;
+        const size_t offset = static_cast<size_t>(i) * bytes;
+        std::copy(pixels + offset, pixels + offset + bytes, front_pixels + offset);
+      }
+    }
+
+    MPI_Win_sync(comms.m_window);
+    MPI_Barrier(comms.m_node_comm);
+    MPI_Win_sync(comms.m_window);
+
+    if(node_rank == 0)
+    {
+      std::memcpy(&image.m_depths[0], front_depths, depth_bytes);
+      std::memcpy(pixel_data(image),
+                  front_pixels,
+                  static_cast<size_t>(num_pixels) * bytes);
+    }
+
+    MPI_Win_unlock_all(comms.m_window);
+  }
+}
+#endif
+
+} // namespace detail
+
+SharedMemoryCompositor::SharedMemoryCompositor()
+{
+
+}
+
+SharedMemoryCompositor::~SharedMemoryCompositor()
+{
+
+}
+
+template<typename ImageType>
+void
+SharedMemoryCompositor::CompositeImpl(vtkhdiy::mpi::communicator &diy_comm, ImageType &image)
+{
+  detail::NodeComms &comms = detail::find_node_comms(diy_comm);
+
+  if(comms.m_max_node_size == 1)
+  {
+    // nothing shares a node
+    RadixKCompositor compositor;
+    compositor.CompositeSurface(diy_comm, image);
+    m_timing_log<<compositor.GetTimingString();
+    return;
+  }
+
+#if MPI_VERSION >= 3
+  const double start = MPI_Wtime();
+  detail::node_composite(comms, image);
+
+  m_timing_log<<"shared_memory_composite "<<MPI_Wtime() - start<<"\n";
+
+  if(comms.m_leader_comm != MPI_COMM_NULL && comms.m_num_leaders > 1)
+  {
+    vtkhdiy::mpi::communicator leader_comm(comms.m_leader_comm);
+    RadixKCompositor compositor;
+    compositor.CompositeSurface(leader_comm, image);
+    m_timing_log<<compositor.GetTimingString();
+  }
+#endif
+}
+
+template<typename ImageType>
+void
+SharedMemoryCompositor::CompositeBatchImpl(vtkhdiy::mpi::communicator &diy_comm,
+                                           std::vector<ImageType> &images)
+{
+  detail::NodeComms &comms = detail::find_node_comms(diy_comm);
+
+  if(comms.m_max_node_size == 1)
+  {
+    // nothing shares a node
+    RadixKCompositor compositor;
+    compositor.CompositeSurfaces(diy_comm, images);
+    m_timing_log<<compositor.GetTimingString();
+    return;
+  }
+
+#if MPI_VERSION >= 3
+  const double start = MPI_Wtime();
+  const int num_images = static_cast<int>(images.size());
+  for(int i = 0; i < num_images; ++i)
+  {
+    detail::node_composite(comms, images[i]);
+  }
+  m_timing_log<<"shared_memory_composite "<<MPI_Wtime() - start<<"\n";
+
+  if(comms.m_leader_comm != MPI_COMM_NULL && comms.m_num_leaders > 1)
+  {
+    vtkhdiy::mpi::communicator leader_comm(comms.m_leader_comm);
+    RadixKCompositor compositor;
+    compositor.CompositeSurfaces(leader_comm, images);
+    m_timing_log<<compositor.GetTimingString();
+  }
+#endif
+}
+
+void
+SharedMemoryCompositor::CompositeSurface(vtkhdiy::mpi::communicator &diy_comm, Image &image)
+{
+  CompositeImpl(diy_comm, image);
+}
+
+void
+SharedMemoryCompositor::CompositeSurface(vtkhdiy::mpi::communicator &diy_comm, PayloadImage &image)
+{
+  CompositeImpl(diy_comm, image);
+}
+
+void
+SharedMemoryCompositor::CompositeSurfaces(vtkhdiy::mpi::communicator &diy_comm,
+                                          std::vector<Image> &images)
+{
+  CompositeBatchImpl(diy_comm, images);
+}
+
+void
+SharedMemoryCompositor::CompositeSurfaces(vtkhdiy::mpi::communicator &diy_comm,
+                                          std::vector<PayloadImage> &images)
+{
+  CompositeBatchImpl(diy_comm, images);
+}
+
+std::string
+SharedMemoryCompositor::GetTimingString()
+{
+  std::string res(m_timing_log.str());
+  m_timing_log.str("");
+  return res;
+}
+
+void
+SharedMemoryCompositor::ReleaseSharedMemory()
+{
+  auto &cache = detail::node_comms_cache();
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if(finalized)
+  {
+    cache.clear();
+    return;
+  }
+  for(auto &entry : cache)
+  {
+    detail::NodeComms &comms = entry.second;
+    detail::free_window(comms);
+    if(comms.m_leader_comm != MPI_COMM_NULL)
+    {
+      MPI_Comm_free(&comms.m_leader_comm);
+    }
+    MPI_Comm_free(&comms.m_node_comm);
+  }
+  cache.clear();
+}
+
+} // namespace vtkh
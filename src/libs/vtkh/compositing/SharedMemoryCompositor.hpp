@@ -0,0 +1,51 @@
+#ifndef VTKH_SHARED_MEMORY_COMPOSITOR_HPP
+#define VTKH_SHARED_MEMORY_COMPOSITOR_HPP
+
+#include <vtkh/compositing/Image.hpp>
+#include <vtkh/compositing/PayloadImage.hpp>
+#include <diy/mpi.hpp>
+#include <sstream>
+#include <vector>
+
+namespace vtkh
+{
+
+//
+// Two level surface compositing. The ranks on each node depth composite
+// their images in an MPI-3 shared memory window, each rank handling a
+// slice of the pixels, and only the node leaders (the lowest rank of
+// each node) take part in the radix-k composite across nodes. The
+// result ends up on rank 0, as with RadixKCompositor.
+//
+// Falls back to plain radix-k when every node runs a single rank or
+// MPI-3 is not available.
+//
+class SharedMemoryCompositor
+{
+public:
+  SharedMemoryCompositor();
+  ~SharedMemoryCompositor();
+  void CompositeSurface(vtkhdiy::mpi::communicator &diy_comm, Image &image);
+  void CompositeSurface(vtkhdiy::mpi::communicator &diy_comm, PayloadImage &image);
+  // see RadixKCompositor::CompositeSurfaces
+  void CompositeSurfaces(vtkhdiy::mpi::communicator &diy_comm, std::vector<Image> &images);
+  void CompositeSurfaces(vtkhdiy::mpi::communicator &diy_comm, std::vector<PayloadImage> &images);
+
+  template<typename ImageType>
+  void CompositeImpl(vtkhdiy::mpi::communicator &diy_comm, ImageType &image);
+
+  template<typename ImageType>
+  void CompositeBatchImpl(vtkhdiy::mpi::communicator &diy_comm, std::vector<ImageType> &images);
+
+  std::string GetTimingString();
+
+  // The node communicators and shared windows are kept between
+  // composites. This frees them, and must happen before MPI_Finalize.
+  static void ReleaseSharedMemory();
+private:
+  std::stringstream m_timing_log;
+};
+
+} // namespace vtkh
+
+#endif
@@ -64,5 +64,64 @@ struct CollectImages
   } // operator
 };
 
+// CollectImages for a batch of images
+template<typename ImageType>
+struct CollectImageBatch
+{
+  void operator()(void *b, const vtkhdiy::ReduceProxy &proxy) const
+  {
+    ImageBatchBlock<ImageType> *block = reinterpret_cast<ImageBatchBlock<ImageType>*>(b);
+    std::vector<ImageType> &images = block->m_images;
+    const int num_images = static_cast<int>(images.size());
+
+    const int collection_rank = 0;
+    if(proxy.in_link().size() == 0)
+    {
+
+      if(proxy.gid() != collection_rank)
+      {
+        int dest_gid = collection_rank;
+        vtkhdiy::BlockID dest = proxy.out_link().target(dest_gid);
+
+        proxy.enqueue(dest, images);
+        for(int n = 0; n < num_images; ++n)
+        {
+          images[n].Clear();
+        }
+      }
+    } // if
+    else if(proxy.gid() == collection_rank)
+    {
+      std::vector<ImageType> final_images(num_images);
+      for(int n = 0; n < num_images; ++n)
+      {
+        final_images[n].InitOriginal(images[n]);
+        images[n].SubsetTo(final_images[n]);
+      }
+
+      for(int i = 0; i < proxy.in_link().size(); ++i)
+      {
+        int gid = proxy.in_link().target(i).gid;
+
+        if(gid == collection_rank)
+        {
+          continue;
+        }
+        std::vector<ImageType> incoming;
+        proxy.dequeue(gid, incoming);
+        for(int n = 0; n < num_images; ++n)
+        {
+          incoming[n].SubsetTo(final_images[n]);
+        }
+      } // for
+      for(int n = 0; n < num_images; ++n)
+      {
+        images[n].Swap(final_images[n]);
+      }
+    } // else
+
+  } // operator
+};
+
 } // namespace vtkh
 #endif
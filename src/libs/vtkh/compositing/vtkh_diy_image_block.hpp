@@ -18,6 +18,16 @@ struct ImageBlock
   }
 };
 
+template<typename ImageType>
+struct ImageBatchBlock
+{
+  std::vector<ImageType> &m_images;
+  ImageBatchBlock(std::vector<ImageType> &images)
+    : m_images(images)
+  {
+  }
+};
+
 struct MultiImageBlock
 {
   std::vector<Image> &m_images;
@@ -54,6 +64,31 @@ struct AddImageBlock
   }
 };
 
+template<typename ImageType>
+struct AddImageBatchBlock
+{
+  std::vector<ImageType> &m_images;
+  const vtkhdiy::Master  &m_master;
+
+  AddImageBatchBlock(vtkhdiy::Master &master, std::vector<ImageType> &images)
+    : m_images(images),
+      m_master(master)
+  {
+  }
+  template<typename BoundsType, typename LinkType>
+  void operator()(int gid,
+                  const BoundsType &,  // local_bounds
+                  const BoundsType &,  // local_with_ghost_bounds
+                  const BoundsType &,  // domain_bounds
+                  const LinkType &link) const
+  {
+    ImageBatchBlock<ImageType> *block = new ImageBatchBlock<ImageType>(m_images);
+    LinkType *linked = new LinkType(link);
+    vtkhdiy::Master& master = const_cast<vtkhdiy::Master&>(m_master);
+    master.add(gid, block, linked);
+  }
+};
+
 struct AddMultiImageBlock
 {
   std::vector<Image> &m_images;
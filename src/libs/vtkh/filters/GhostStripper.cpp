@@ -9,9 +9,14 @@
 #include <vtkm/worklet/DispatcherMapField.h>
 #include <vtkm/worklet/WorkletMapField.h>
 #include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/filter/MapFieldPermutation.h>
 #include <vtkm/BinaryOperators.h>
 
 #include <limits>
+#include <map>
+#include <tuple>
 
 namespace vtkh
 {
@@ -346,11 +351,200 @@ bool StructuredStrip(vtkm::cont::DataSet &dataset,
   return can_strip;
 }
 
+VTKM_EXEC_CONT
+inline vtkm::UInt64 Mix64(vtkm::UInt64 z)
+{
+  // splitmix64 finalizer
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+// position dependent hash of the ghost values, summed so it
+// can be computed with a single reduction
+class GhostHash : public vtkm::worklet::WorkletMapField
+{
+public:
+  typedef void ControlSignature(FieldIn, FieldOut);
+  typedef void ExecutionSignature(_1, WorkIndex, _2);
+
+  template<typename T>
+  VTKM_EXEC
+  void operator()(const T &value, const vtkm::Id &index, vtkm::UInt64 &hash) const
+  {
+    vtkm::UInt64 z = Mix64(static_cast<vtkm::UInt64>(index) + 0x9E3779B97F4A7C15ULL);
+    hash = z * (static_cast<vtkm::UInt64>(static_cast<vtkm::Int64>(value)) + 1);
+  }
+}; //class GhostHash
+
+vtkm::UInt64 HashGhosts(vtkm::cont::Field &ghost_field)
+{
+  VTKH_DATA_OPEN("hash_ghosts");
+  vtkm::cont::ArrayHandle<vtkm::UInt64> hashes;
+  vtkm::worklet::DispatcherMapField<GhostHash>(GhostHash())
+     .Invoke(ghost_field.GetData().ResetTypes(vtkm::TypeListScalarAll(),
+                                              VTKM_DEFAULT_STORAGE_LIST{}),
+             hashes);
+  vtkm::UInt64 hash = vtkm::cont::Algorithm::Reduce(hashes, vtkm::UInt64(0));
+  VTKH_DATA_CLOSE();
+  return hash;
+}
+
+// names of the index fields carried through the threshold so we
+// can recover which cells and points were kept
+const std::string cell_ids_name = "__vtkh_ghost_stripper_cell_ids";
+const std::string point_ids_name = "__vtkh_ghost_stripper_point_ids";
+
+struct StripPlan
+{
+  enum Kind
+  {
+    PassThrough,
+    Structured,
+    Threshold
+  };
+  Kind m_kind = PassThrough;
+  vtkm::Id m_num_cells = 0;
+  vtkm::Id m_num_points = 0;
+  vtkm::UInt64 m_ghost_hash = 0;
+  // the mesh the plan was built for, held so its arrays (and the cell
+  // set address) stay valid while the plan exists
+  vtkm::cont::UnknownCellSet m_source_cell_set;
+  vtkm::cont::UnknownArrayHandle m_source_coords;
+  // when the plan was last used, for evicting the oldest ones
+  vtkm::UInt64 m_last_use = 0;
+  // structured
+  vtkm::RangeId3 m_range;
+  // threshold
+  vtkm::cont::UnknownCellSet m_cell_set;
+  vtkm::cont::ArrayHandle<vtkm::Id> m_cell_ids;
+  vtkm::cont::ArrayHandle<vtkm::Id> m_point_ids;
+};
+
+// domain id, ghost field, min value, max value
+using PlanKey = std::tuple<vtkm::Id, std::string, vtkm::Int32, vtkm::Int32>;
+
+std::map<PlanKey, StripPlan> &plan_cache()
+{
+  static std::map<PlanKey, StripPlan> plans;
+  return plans;
+}
+
+int max_cached_plans = 256;
+
+vtkm::UInt64 &plan_clock()
+{
+  static vtkm::UInt64 clock = 0;
+  return clock;
+}
+
+// drops the least recently used plans until at most max_plans remain
+void TrimPlanCache(const int max_plans)
+{
+  std::map<PlanKey, StripPlan> &plans = plan_cache();
+  while(static_cast<int>(plans.size()) > max_plans)
+  {
+    auto oldest = plans.begin();
+    for(auto it = plans.begin(); it != plans.end(); ++it)
+    {
+      if(it->second.m_last_use < oldest->second.m_last_use)
+      {
+        oldest = it;
+      }
+    }
+    plans.erase(oldest);
+  }
+}
+
+// true if dom has the mesh the plan was built for. The arrays are
+// compared, not their contents, so this is cheap
+bool SameMesh(vtkm::cont::DataSet &dom, const StripPlan &plan)
+{
+  return dom.GetCellSet().GetCellSetBase() ==
+           plan.m_source_cell_set.GetCellSetBase() &&
+         dom.GetCoordinateSystem().GetData().GetBuffers() ==
+           plan.m_source_coords.GetBuffers();
+}
+
+void CachePlan(const PlanKey &key, StripPlan &plan)
+{
+  plan.m_last_use = ++plan_clock();
+  plan_cache()[key] = plan;
+  TrimPlanCache(max_cached_plans);
+}
+
+vtkm::cont::DataSet ApplyPlan(vtkm::cont::DataSet &dom,
+                              const StripPlan &plan,
+                              const vtkm::filter::FieldSelection &fields)
+{
+  if(plan.m_kind == StripPlan::PassThrough)
+  {
+    return dom;
+  }
+
+  if(plan.m_kind == StripPlan::Structured)
+  {
+    VTKH_DATA_OPEN("extract_structured");
+    vtkm::Id3 sample(1, 1, 1);
+    vtkh::vtkmExtractStructured extract;
+    auto output = extract.Run(dom, plan.m_range, sample, fields);
+    VTKH_DATA_CLOSE();
+    return output;
+  }
+
+  VTKH_DATA_OPEN("apply_strip_plan");
+  vtkm::cont::DataSet res;
+  res.SetCellSet(plan.m_cell_set);
+
+  const vtkm::IdComponent num_fields = dom.GetNumberOfFields();
+  for(vtkm::IdComponent i = 0; i < num_fields; ++i)
+  {
+    const vtkm::cont::Field &field = dom.GetField(i);
+    if(dom.HasCoordinateSystem(field.GetName()) ||
+       !fields.IsFieldSelected(field))
+    {
+      continue;
+    }
+
+    if(field.IsCellField())
+    {
+      vtkm::cont::Field mapped;
+      vtkm::filter::MapFieldPermutation(field, plan.m_cell_ids, mapped);
+      res.AddField(mapped);
+    }
+    else if(field.IsPointField())
+    {
+      vtkm::cont::Field mapped;
+      vtkm::filter::MapFieldPermutation(field, plan.m_point_ids, mapped);
+      res.AddField(mapped);
+    }
+    else
+    {
+      res.AddField(field);
+    }
+  }
+
+  const vtkm::IdComponent num_coords = dom.GetNumberOfCoordinateSystems();
+  for(vtkm::IdComponent i = 0; i < num_coords; ++i)
+  {
+    vtkm::cont::CoordinateSystem coords = dom.GetCoordinateSystem(i);
+    vtkm::cont::Field mapped;
+    vtkm::filter::MapFieldPermutation(coords, plan.m_point_ids, mapped);
+    res.AddCoordinateSystem(vtkm::cont::CoordinateSystem(coords.GetName(),
+                                                         mapped.GetData()));
+  }
+  VTKH_DATA_CLOSE();
+  return res;
+}
+
 } // namespace detail
 
 GhostStripper::GhostStripper()
   : m_min_value(0),  // default to real zones only
-    m_max_value(0)   // 0 = real, 1 = valid ghost, 2 = garbage ghost
+    m_max_value(0),  // 0 = real, 1 = valid ghost, 2 = garbage ghost
+    m_cache_plans(true),
+    m_static_ghosts(false),
+    m_static_topology(false)
 {
 
 }
@@ -378,6 +572,47 @@ GhostStripper::SetMaxValue(const vtkm::Int32 max_value)
   m_max_value = max_value;
 }
 
+void
+GhostStripper::SetCachePlans(bool on)
+{
+  m_cache_plans = on;
+}
+
+void
+GhostStripper::SetStaticGhosts(bool on)
+{
+  m_static_ghosts = on;
+}
+
+void
+GhostStripper::SetStaticTopology(bool on)
+{
+  m_static_topology = on;
+}
+
+void
+GhostStripper::ClearPlanCache()
+{
+  detail::plan_cache().clear();
+}
+
+int
+GhostStripper::GetNumberOfCachedPlans()
+{
+  return static_cast<int>(detail::plan_cache().size());
+}
+
+void
+GhostStripper::SetMaxCachedPlans(const int max_plans)
+{
+  if(max_plans < 0)
+  {
+    throw Error("GhostStripper: max cached plans must not be negative.");
+  }
+  detail::max_cached_plans = max_plans;
+  detail::TrimPlanCache(max_plans);
+}
+
 void GhostStripper::PreExecute()
 {
   Filter::PreExecute();
@@ -398,6 +633,7 @@ void GhostStripper::DoExecute()
   this->m_output = new DataSet();
 
   const int num_domains = this->m_input->GetNumberOfDomains();
+  vtkm::filter::FieldSelection fields = this->GetFieldSelection();
 
   for(int i = 0; i < num_domains; ++i)
   {
@@ -412,6 +648,46 @@ void GhostStripper::DoExecute()
     }
 
     vtkm::cont::Field field = dom.GetField(m_field_name);
+
+    detail::StripPlan plan;
+    plan.m_num_cells = dom.GetNumberOfCells();
+    plan.m_num_points = dom.GetNumberOfPoints();
+    detail::PlanKey key(domain_id, m_field_name, m_min_value, m_max_value);
+    // plans are replayed through the coordinates, so a domain without
+    // them is always stripped from scratch
+    bool cache_plan = m_cache_plans &&
+                      detail::max_cached_plans > 0 &&
+                      dom.GetNumberOfCoordinateSystems() > 0;
+
+    if(cache_plan)
+    {
+      plan.m_source_cell_set = dom.GetCellSet();
+      plan.m_source_coords = dom.GetCoordinateSystem().GetData();
+
+      auto cached = detail::plan_cache().find(key);
+      if(cached != detail::plan_cache().end() &&
+         cached->second.m_num_cells == plan.m_num_cells &&
+         cached->second.m_num_points == plan.m_num_points &&
+         (m_static_topology || detail::SameMesh(dom, cached->second)))
+      {
+        if(!m_static_ghosts)
+        {
+          plan.m_ghost_hash = detail::HashGhosts(field);
+        }
+        if(cached->second.m_ghost_hash == plan.m_ghost_hash)
+        {
+          cached->second.m_last_use = ++detail::plan_clock();
+          m_output->AddDomain(detail::ApplyPlan(dom, cached->second, fields),
+                              domain_id);
+          continue;
+        }
+      }
+      else if(!m_static_ghosts)
+      {
+        plan.m_ghost_hash = detail::HashGhosts(field);
+      }
+    }
+
     vtkm::Range ghost_range = field.GetRange().ReadPortal().Get(0);
 
     if(ghost_range.Min >= m_min_value &&
@@ -419,6 +695,10 @@ void GhostStripper::DoExecute()
     {
       // nothing to do here
       m_output->AddDomain(dom, domain_id);
+      if(cache_plan)
+      {
+        detail::CachePlan(key, plan);
+      }
       continue;
     }
 
@@ -441,25 +721,14 @@ void GhostStripper::DoExecute()
         do_threshold = false;
         if(should_strip)
         {
-          VTKH_DATA_OPEN("extract_structured");
           //vtkm::RangeId3 range(min[0],max[0]+1, min[1], max[1]+1, min[2], max[2]+1);
-          vtkm::RangeId3 range(min[0],max[0]+2, min[1], max[1]+2, min[2], max[2]+2);
-          vtkm::Id3 sample(1, 1, 1);
-
-          vtkh::vtkmExtractStructured extract;
-          auto output = extract.Run(dom,
-                                    range,
-                                    sample,
-                                    this->GetFieldSelection());
-
-          m_output->AddDomain(output, domain_id);
-          VTKH_DATA_CLOSE();
-        }
-        else
-        {
-          // All zones are valid so just pass through
-          m_output->AddDomain(dom, domain_id);
+          plan.m_kind = detail::StripPlan::Structured;
+          plan.m_range = vtkm::RangeId3(min[0],max[0]+2, min[1], max[1]+2, min[2], max[2]+2);
+          // extracting the range is as cheap as replaying it
+          cache_plan = false;
         }
+        // otherwise all zones are valid so just pass through
+        m_output->AddDomain(detail::ApplyPlan(dom, plan, fields), domain_id);
       }
 
     }
@@ -467,18 +736,55 @@ void GhostStripper::DoExecute()
     if(do_threshold)
     {
       vtkmThreshold thresholder;
+      vtkm::filter::FieldSelection threshold_fields = fields;
+      vtkm::cont::DataSet input = dom;
+
+      if(cache_plan)
+      {
+        // carry the original ids through so the result can be replayed
+        vtkm::cont::ArrayHandle<vtkm::Id> cell_ids;
+        vtkm::cont::ArrayHandle<vtkm::Id> point_ids;
+        vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(plan.m_num_cells), cell_ids);
+        vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(plan.m_num_points), point_ids);
+        input.AddCellField(detail::cell_ids_name, cell_ids);
+        input.AddPointField(detail::point_ids_name, point_ids);
+        threshold_fields.AddField(detail::cell_ids_name);
+        threshold_fields.AddField(detail::point_ids_name);
+      }
 
-      auto tout = thresholder.Run(dom,
+      auto tout = thresholder.Run(input,
                                   m_field_name,
                                   m_min_value,
                                   m_max_value,
-                                  this->GetFieldSelection());
+                                  threshold_fields);
 
       vtkh::vtkmCleanGrid cleaner;
-      auto clout = cleaner.Run(tout, this->GetFieldSelection());
+      if(cache_plan)
+      {
+        // merged points would average their original ids
+        cleaner.merge_points(false);
+      }
+      auto clout = cleaner.Run(tout, threshold_fields);
+
+      if(cache_plan)
+      {
+        plan.m_kind = detail::StripPlan::Threshold;
+        plan.m_cell_set = clout.GetCellSet();
+        vtkm::cont::ArrayCopyShallowIfPossible(
+          clout.GetField(detail::cell_ids_name).GetData(), plan.m_cell_ids);
+        vtkm::cont::ArrayCopyShallowIfPossible(
+          clout.GetField(detail::point_ids_name).GetData(), plan.m_point_ids);
+        // build the output the same way later executions will
+        clout = detail::ApplyPlan(dom, plan, fields);
+      }
       m_output->AddDomain(clout, domain_id);
     }
 
+    if(cache_plan)
+    {
+      detail::CachePlan(key, plan);
+    }
+
   }
 
 }
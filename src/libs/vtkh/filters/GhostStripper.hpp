@@ -20,6 +20,26 @@ public:
   void SetMinValue(const vtkm::Int32 min);
   void SetMaxValue(const vtkm::Int32 min);
 
+  // Reuse the kept cells and cell set computed for a domain on a previous
+  // execution when the domain has the same number of cells and points, the
+  // same cell set and coordinate arrays, and its ghost field hashes to the
+  // same value (on by default). Structured domains that only need a
+  // range extracted are not cached.
+  void SetCachePlans(bool on);
+  // Declare that ghost fields never change, so cached plans are reused
+  // without hashing the ghost field
+  void SetStaticGhosts(bool on);
+  // Declare that the connectivity and coordinates of a domain never
+  // change while its sizes stay the same, so cached plans are reused for
+  // new arrays holding the same mesh (e.g., data converted again each cycle)
+  void SetStaticTopology(bool on);
+
+  static void ClearPlanCache();
+  static int GetNumberOfCachedPlans();
+  // Bounds the process wide plan cache, the least recently used plans are
+  // dropped first (default 256, 0 disables caching)
+  static void SetMaxCachedPlans(const int max_plans);
+
 protected:
   void PreExecute() override;
   void PostExecute() override;
@@ -28,6 +48,9 @@ protected:
   std::string m_field_name;
   vtkm::Int32 m_min_value;
   vtkm::Int32 m_max_value;
+  bool m_cache_plans;
+  bool m_static_ghosts;
+  bool m_static_topology;
 };
 
 } //namespace vtkh
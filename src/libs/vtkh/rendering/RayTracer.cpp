@@ -1,12 +1,152 @@
 #include "RayTracer.hpp"
 
+#include <vtkh/Error.hpp>
+#include <vtkh/Logger.hpp>
+
 #include <vtkm/rendering/CanvasRayTracer.h>
 #include <vtkm/rendering/MapperRayTracer.h>
+#include <vtkm/rendering/raytracing/RayOperations.h>
+#include <vtkm/rendering/raytracing/TriangleExtractor.h>
+#include <vtkm/rendering/raytracing/TriangleIntersector.h>
+#include <map>
 #include <memory>
 
 namespace vtkh {
-  
+
+namespace detail
+{
+
+struct CachedGeometry
+{
+  // held so the arrays (and the cell set address used as the key)
+  // stay valid while the entry exists
+  vtkm::cont::UnknownCellSet m_cell_set;
+  vtkm::cont::CoordinateSystem m_coords;
+  // null if the cell set has no triangles
+  std::shared_ptr<vtkm::rendering::raytracing::TriangleIntersector> m_intersector;
+  vtkm::Bounds m_bounds;
+  vtkm::UInt64 m_last_use = 0;
+};
+
+using GeometryCache = std::multimap<const vtkm::cont::CellSet*, CachedGeometry>;
+
+GeometryCache &geometry_cache()
+{
+  static GeometryCache cache;
+  return cache;
+}
+
+int max_cached_geometries = 256;
+
+vtkm::UInt64 &geometry_clock()
+{
+  static vtkm::UInt64 clock = 0;
+  return clock;
+}
+
+// drops the least recently used geometry until at most max_geometries remain
+void TrimGeometryCache(const int max_geometries)
+{
+  GeometryCache &cache = geometry_cache();
+  while(static_cast<int>(cache.size()) > max_geometries)
+  {
+    auto oldest = cache.begin();
+    for(auto it = cache.begin(); it != cache.end(); ++it)
+    {
+      if(it->second.m_last_use < oldest->second.m_last_use)
+      {
+        oldest = it;
+      }
+    }
+    cache.erase(oldest);
+  }
+}
+
+CachedGeometry
+build_geometry(const vtkm::cont::UnknownCellSet &cellset,
+               const vtkm::cont::CoordinateSystem &coords)
+{
+  VTKH_DATA_OPEN("build_geometry");
+  CachedGeometry geom;
+  geom.m_cell_set = cellset;
+  geom.m_coords = coords;
+
+  vtkm::rendering::raytracing::TriangleExtractor extractor;
+  extractor.ExtractCells(cellset);
+  if(extractor.GetNumberOfTriangles() > 0)
+  {
+    geom.m_intersector =
+      std::make_shared<vtkm::rendering::raytracing::TriangleIntersector>();
+    // this builds the bvh
+    geom.m_intersector->SetData(coords, extractor.GetTriangles());
+    geom.m_bounds = geom.m_intersector->GetShapeBounds();
+  }
+  VTKH_DATA_ADD("triangles", extractor.GetNumberOfTriangles());
+  VTKH_DATA_CLOSE();
+  return geom;
+}
+
+CachedGeometry
+find_geometry(const vtkm::cont::UnknownCellSet &cellset,
+              const vtkm::cont::CoordinateSystem &coords,
+              bool use_cache)
+{
+  if(!use_cache || max_cached_geometries == 0)
+  {
+    return build_geometry(cellset, coords);
+  }
+
+  GeometryCache &cache = geometry_cache();
+  const vtkm::cont::CellSet *key = cellset.GetCellSetBase();
+  auto range = cache.equal_range(key);
+  for(auto it = range.first; it != range.second; ++it)
+  {
+    if(it->second.m_coords.GetData().GetBuffers() == coords.GetData().GetBuffers())
+    {
+      VTKH_DATA_ADD("geometry_cache", "hit");
+      it->second.m_last_use = ++geometry_clock();
+      return it->second;
+    }
+  }
+
+  VTKH_DATA_ADD("geometry_cache", "miss");
+  CachedGeometry geom = build_geometry(cellset, coords);
+  geom.m_last_use = ++geometry_clock();
+  cache.insert(std::make_pair(key, geom));
+  TrimGeometryCache(max_cached_geometries);
+  return geom;
+}
+
+vtkm::cont::ArrayHandle<vtkm::Vec4f_32>
+sample_color_table(const vtkm::cont::ColorTable &color_table)
+{
+  // same sampling as vtkm::rendering::Mapper::SetActiveColorTable
+  constexpr vtkm::Float32 conversion_to_float = (1.0f / 255.0f);
+  vtkm::cont::ArrayHandle<vtkm::Vec4ui_8> temp;
+  {
+    vtkm::cont::ScopedRuntimeDeviceTracker tracker(vtkm::cont::DeviceAdapterTagSerial{});
+    color_table.Sample(1024, temp);
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Vec4f_32> color_map;
+  color_map.Allocate(1024);
+  auto portal = color_map.WritePortal();
+  auto color_portal = temp.ReadPortal();
+  for(vtkm::Id i = 0; i < 1024; ++i)
+  {
+    auto color = color_portal.Get(i);
+    portal.Set(i, vtkm::Vec4f_32(color[0] * conversion_to_float,
+                                 color[1] * conversion_to_float,
+                                 color[2] * conversion_to_float,
+                                 color[3] * conversion_to_float));
+  }
+  return color_map;
+}
+
+} // namespace detail
+
 RayTracer::RayTracer()
+  : m_cache_geometry(true)
 {
   typedef vtkm::rendering::MapperRayTracer TracerType;
   auto mapper = std::make_shared<TracerType>();
@@ -18,7 +158,7 @@ RayTracer::~RayTracer()
 {
 }
 
-Renderer::vtkmCanvasPtr 
+Renderer::vtkmCanvasPtr
 RayTracer::GetNewCanvas(int width, int height)
 {
   return std::make_shared<vtkm::rendering::CanvasRayTracer>(width, height);
@@ -30,12 +170,109 @@ RayTracer::GetName() const
   return "vtkh::RayTracer";
 }
 
-void 
+void
 RayTracer::SetShadingOn(bool on)
 {
-  // do nothing by default;
   typedef vtkm::rendering::MapperRayTracer TracerType;
   std::static_pointer_cast<TracerType>(this->m_mapper)->SetShadingOn(on);
 }
 
+void
+RayTracer::SetCacheGeometry(bool on)
+{
+  m_cache_geometry = on;
+}
+
+void
+RayTracer::ClearGeometryCache()
+{
+  detail::geometry_cache().clear();
+}
+
+void
+RayTracer::SetMaxCachedGeometries(const int max_geometries)
+{
+  if(max_geometries < 0)
+  {
+    throw Error("RayTracer: max cached geometries must not be negative.");
+  }
+  detail::max_cached_geometries = max_geometries;
+  detail::TrimGeometryCache(max_geometries);
+}
+
+int
+RayTracer::GetNumberOfCachedGeometries()
+{
+  return static_cast<int>(detail::geometry_cache().size());
+}
+
+void
+RayTracer::DoExecute()
+{
+  //
+  // This is what vtkm::rendering::MapperRayTracer::RenderCells does,
+  // except that the triangles and bvh are built once per domain
+  // instead of once per domain and render.
+  //
+  const int total_renders = static_cast<int>(m_renders.size());
+  vtkm::cont::ArrayHandle<vtkm::Vec4f_32> color_map
+    = detail::sample_color_table(m_color_table);
+
+  const int num_domains = static_cast<int>(m_input->GetNumberOfDomains());
+  for(int dom = 0; dom < num_domains; ++dom)
+  {
+    vtkm::cont::DataSet data_set;
+    vtkm::Id domain_id;
+    m_input->GetDomain(dom, data_set, domain_id);
+    if(!data_set.HasField(m_field_name))
+    {
+      continue;
+    }
+
+    const vtkm::cont::UnknownCellSet &cellset = data_set.GetCellSet();
+    const vtkm::cont::Field &field = data_set.GetField(m_field_name);
+    const vtkm::cont::CoordinateSystem &coords = data_set.GetCoordinateSystem();
+
+    if(cellset.GetNumberOfCells() == 0)
+    {
+      continue;
+    }
+
+    detail::CachedGeometry geom = detail::find_geometry(cellset,
+                                                        coords,
+                                                        m_cache_geometry);
+    if(geom.m_intersector == nullptr)
+    {
+      continue;
+    }
+
+    m_tracer.Clear();
+    m_tracer.AddShapeIntersector(geom.m_intersector);
+    m_tracer.SetField(field, m_range);
+    m_tracer.SetColorMap(color_map);
+
+    for(int i = 0; i < total_renders; ++i)
+    {
+      m_tracer.SetShadingOn(m_renders[i].GetShadingOn());
+
+      Render::vtkmCanvas &canvas = m_renders[i].GetCanvas();
+      const vtkmCamera &camera = m_renders[i].GetCamera();
+      const vtkm::Int32 width = static_cast<vtkm::Int32>(canvas.GetWidth());
+      const vtkm::Int32 height = static_cast<vtkm::Int32>(canvas.GetHeight());
+
+      m_ray_camera.SetParameters(camera, width, height);
+      m_ray_camera.CreateRays(m_rays, geom.m_bounds);
+      m_rays.Buffers.at(0).InitConst(0.f);
+      vtkm::rendering::raytracing::RayOperations::MapCanvasToRays(m_rays,
+                                                                 camera,
+                                                                 canvas);
+
+      m_tracer.GetCamera() = m_ray_camera;
+      m_tracer.Render(m_rays);
+
+      canvas.WriteToCanvas(m_rays, m_rays.Buffers.at(0).Buffer, camera);
+    }
+  }
+}
+
 } // namespace vtkh
@@ -4,6 +4,10 @@
 #include <vtkh/rendering/Renderer.hpp>
 #include <vtkh/vtkh_exports.h>
 
+#include <vtkm/rendering/raytracing/Camera.h>
+#include <vtkm/rendering/raytracing/Ray.h>
+#include <vtkm/rendering/raytracing/RayTracer.h>
+
 namespace vtkh {
 
 class VTKH_API RayTracer : public Renderer
@@ -14,6 +18,25 @@ public:
   std::string GetName() const override;
   void SetShadingOn(bool on) override;
   static Renderer::vtkmCanvasPtr GetNewCanvas(int width = 1024, int height = 1024);
+
+  // Reuse the extracted triangles and BVH of a domain across render
+  // batches, scenes and plots, as long as the domain's cell set and
+  // coordinates are the same arrays (on by default). Cached geometry
+  // keeps those arrays alive until the cache is cleared.
+  void SetCacheGeometry(bool on);
+
+  static void ClearGeometryCache();
+  static int GetNumberOfCachedGeometries();
+  // least recently used geometry beyond this is dropped (default 256)
+  static void SetMaxCachedGeometries(const int max_geometries);
+
+protected:
+  void DoExecute() override;
+
+  bool m_cache_geometry;
+  vtkm::rendering::raytracing::RayTracer m_tracer;
+  vtkm::rendering::raytracing::Camera m_ray_camera;
+  vtkm::rendering::raytracing::Ray<vtkm::Float32> m_rays;
 };
 
 } // namespace vtkh
@@ -1,5 +1,6 @@
 #include "Render.hpp"
 #include <vtkh/rendering/Annotator.hpp>
+#include <png_utils/ascent_image_encoder.hpp>
 #include <png_utils/ascent_png_encoder.hpp>
 #include <vtkh/utils/vtkm_array_utils.hpp>
 #include <vtkm/rendering/MapperRayTracer.h>
@@ -17,7 +18,9 @@ Render::Render()
     m_render_screen_annotations(true),
     m_render_background(true),
     m_shading(true),
-    m_canvas(m_width, m_height)
+    m_canvas(m_width, m_height),
+    m_keep_png(false),
+    m_png_buffer(std::make_shared<std::vector<unsigned char>>())
 {
   m_world_annotation_scale[0] = 1.f;
   m_world_annotation_scale[1] = 1.f;
@@ -241,6 +244,7 @@ Render::Copy() const
   copy.m_canvas = CreateCanvas();
   copy.m_world_annotation_scale = m_world_annotation_scale;
   copy.m_color_bar_position = m_color_bar_position;
+  copy.m_keep_png = m_keep_png;
   return copy;
 }
 
@@ -304,9 +308,40 @@ Render::Save()
   float* color_buffer = &GetVTKMPointer(m_canvas.GetColorBuffer())[0][0];
   int height = m_canvas.GetHeight();
   int width = m_canvas.GetWidth();
-  ascent::PNGEncoder encoder;
+  ascent::ImageEncoder encoder;
   encoder.Encode(color_buffer, width, height, m_comments);
-  encoder.Save(m_image_name + ".png");
+  encoder.Save(m_image_name);
+
+  if(m_keep_png)
+  {
+    // the kept buffer is always a png
+    if(encoder.Format() == "png")
+    {
+      const unsigned char *png_ptr
+        = static_cast<const unsigned char*>(encoder.Buffer());
+      m_png_buffer->assign(png_ptr, png_ptr + encoder.BufferSize());
+    }
+    else
+    {
+      ascent::PNGEncoder png_encoder;
+      png_encoder.Encode(color_buffer, width, height, m_comments);
+      const unsigned char *png_ptr
+        = static_cast<const unsigned char*>(png_encoder.PngBuffer());
+      m_png_buffer->assign(png_ptr, png_ptr + png_encoder.PngBufferSize());
+    }
+  }
+}
+
+void
+Render::SetKeepPNGBuffer(bool on)
+{
+  m_keep_png = on;
+}
+
+const std::vector<unsigned char>&
+Render::GetPNGBuffer() const
+{
+  return *m_png_buffer;
 }
 
 vtkh::Render
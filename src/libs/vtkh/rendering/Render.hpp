@@ -1,6 +1,7 @@
 #ifndef VTK_H_RENDER_HPP
 #define VTK_H_RENDER_HPP
 
+#include <memory>
 #include <vector>
 #include <vtkh/vtkh_exports.h>
 #include <vtkh/DataSet.hpp>
@@ -37,6 +38,9 @@ public:
   vtkm::Int32                     GetWidth() const;
   vtkm::rendering::Color          GetBackgroundColor() const;
   bool                            GetShadingOn() const;
+  // encoded png from the last Save(), only kept when SetKeepPNGBuffer is on.
+  // implicit copies of a render share the same buffer
+  const std::vector<unsigned char>& GetPNGBuffer() const;
   void                            Print() const;
 
   void                            DoRenderAnnotations(bool on);
@@ -54,6 +58,7 @@ public:
   void                            SetBackgroundColor(float bg_color[4]);
   void                            SetForegroundColor(float fg_color[4]);
   void                            SetShadingOn(bool on);
+  void                            SetKeepPNGBuffer(bool on);
   void                            RenderWorldAnnotations();
   void                            RenderBackground();
   void                            RenderScreenAnnotations(const std::vector<std::string> &field_names,
@@ -78,6 +83,8 @@ protected:
   bool                         m_shading;
   vtkmCanvas                   m_canvas;
   vtkm::Vec<float,3>           m_world_annotation_scale;
+  bool                         m_keep_png;
+  std::shared_ptr<std::vector<unsigned char>> m_png_buffer;
 };
 
 static float vtkh_default_bg_color[4] = {0.f, 0.f, 0.f, 1.f};
@@ -98,7 +98,9 @@ void
 Renderer::Composite(const int &num_images)
 {
   VTKH_DATA_OPEN("Composite");
-  m_compositor->SetCompositeMode(Compositor::Z_BUFFER_SURFACE);
+  // composite the whole batch at once so the images share the
+  // compositing rounds
+  std::vector<Image> images(num_images);
   for(int i = 0; i < num_images; ++i)
   {
     float* color_buffer = &GetVTKMPointer(m_renders[i].GetCanvas().GetColorBuffer())[0][0];
@@ -107,22 +109,24 @@ Renderer::Composite(const int &num_images)
     int height = m_renders[i].GetCanvas().GetHeight();
     int width = m_renders[i].GetCanvas().GetWidth();
 
-    m_compositor->AddImage(color_buffer,
-                           depth_buffer,
-                           width,
-                           height);
+    images[i].Init(color_buffer,
+                   depth_buffer,
+                   width,
+                   height);
+  }
 
-    Image result = m_compositor->Composite();
+  m_compositor->CompositeBatch(images);
 
+  for(int i = 0; i < num_images; ++i)
+  {
 #ifdef VTKH_PARALLEL
     if(vtkh::GetMPIRank() == 0)
     {
-      ImageToCanvas(result, m_renders[i].GetCanvas(), true);
+      ImageToCanvas(images[i], m_renders[i].GetCanvas(), true);
     }
 #else
-    ImageToCanvas(result, m_renders[i].GetCanvas(), true);
+    ImageToCanvas(images[i], m_renders[i].GetCanvas(), true);
 #endif
-    m_compositor->ClearImages();
   } // for image
   VTKH_DATA_CLOSE();
 }
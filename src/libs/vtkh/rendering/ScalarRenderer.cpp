@@ -55,7 +55,8 @@ filter_scalar_fields(vtkm::cont::DataSet &dataset)
 
 ScalarRenderer::ScalarRenderer()
   : m_width(1024),
-    m_height(1024)
+    m_height(1024),
+    m_composite_images(true)
 {
 }
 
@@ -178,6 +179,22 @@ ScalarRenderer::DoExecute()
     }
   }
 
+  if(!m_composite_images)
+  {
+    // min_p is only set if this rank rendered something
+    if(min_p != std::numeric_limits<int>::max())
+    {
+      PayloadImage local_image = compositor.LocalComposite();
+      Result local_result = Convert(local_image, field_names);
+      if(local_result.Scalars.size() != 0)
+      {
+        vtkm::cont::DataSet dset = local_result.ToDataSet();
+        this->m_output->AddDomain(dset, vtkh::GetMPIRank());
+      }
+    }
+    return;
+  }
+
 #ifdef VTKH_PARALLEL
   MPI_Comm mpi_comm = MPI_Comm_f2c(vtkh::GetMPICommHandle());
 
@@ -371,6 +388,12 @@ ScalarRenderer::SetWidth(const int width)
   m_width = width;
 }
 
+void
+ScalarRenderer::SetCompositeImages(bool on)
+{
+  m_composite_images = on;
+}
+
 vtkh::DataSet *
 ScalarRenderer::GetInput()
 {
@@ -30,10 +30,14 @@ public:
   vtkh::DataSet *GetInput();
   void SetHeight(const int height);
   void SetWidth(const int width);
+  // When off, every rank with data outputs the image of its own domains
+  // (domain id = rank) instead of rank 0 outputting the composited image
+  void SetCompositeImages(bool on);
 protected:
 
   int m_width;
   int m_height;
+  bool m_composite_images;
   // image related data with cinema support
   vtkmCamera  m_camera;
   // methods
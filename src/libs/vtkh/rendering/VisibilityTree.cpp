@@ -0,0 +1,259 @@
+#include "VisibilityTree.hpp"
+
+#include <vtkh/Error.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace vtkh
+{
+
+namespace detail
+{
+
+struct CenterOrder
+{
+  const std::vector<vtkm::Bounds> &m_bounds;
+  int m_axis;
+
+  CenterOrder(const std::vector<vtkm::Bounds> &bounds, int axis)
+    : m_bounds(bounds),
+      m_axis(axis)
+  {}
+
+  inline bool operator()(const int &lhs, const int &rhs) const
+  {
+    const vtkm::Float64 lc = m_bounds[lhs].Center()[m_axis];
+    const vtkm::Float64 rc = m_bounds[rhs].Center()[m_axis];
+    if(lc != rc)
+    {
+      return lc < rc;
+    }
+    // keep the tree identical on every rank
+    return lhs < rhs;
+  }
+};
+
+inline const vtkm::Range &
+axis_range(const vtkm::Bounds &bounds, int axis)
+{
+  return axis == 0 ? bounds.X : (axis == 1 ? bounds.Y : bounds.Z);
+}
+
+} // namespace detail
+
+VisibilityTree::VisibilityTree()
+  : m_built(false)
+{
+}
+
+void
+VisibilityTree::Clear()
+{
+  m_bounds.clear();
+  m_nodes.clear();
+  m_empty_domains.clear();
+  m_built = false;
+}
+
+bool
+VisibilityTree::IsBuilt() const
+{
+  return m_built;
+}
+
+int
+VisibilityTree::GetNumberOfDomains() const
+{
+  return static_cast<int>(m_bounds.size());
+}
+
+void
+VisibilityTree::Build(const std::vector<vtkm::Bounds> &bounds)
+{
+  Clear();
+  m_bounds = bounds;
+
+  std::vector<int> domains;
+  const int num_domains = static_cast<int>(m_bounds.size());
+  for(int i = 0; i < num_domains; ++i)
+  {
+    if(m_bounds[i].IsNonEmpty())
+    {
+      domains.push_back(i);
+    }
+    else
+    {
+      m_empty_domains.push_back(i);
+    }
+  }
+
+  if(!domains.empty())
+  {
+    m_nodes.reserve(2 * domains.size());
+    BuildNode(domains, 0, static_cast<int>(domains.size()));
+  }
+  m_built = true;
+}
+
+int
+VisibilityTree::BuildNode(std::vector<int> &domains, int begin, int end)
+{
+  const int node_id = static_cast<int>(m_nodes.size());
+  m_nodes.push_back(Node());
+  m_nodes[node_id].m_axis = 0;
+  m_nodes[node_id].m_split = 0.;
+  m_nodes[node_id].m_left = -1;
+  m_nodes[node_id].m_right = -1;
+  m_nodes[node_id].m_domain = -1;
+
+  const int size = end - begin;
+  if(size == 1)
+  {
+    m_nodes[node_id].m_domain = domains[begin];
+    return node_id;
+  }
+
+  //
+  // Look for the most balanced plane that separates the domains. Blocks
+  // with ghost zones overlap their neighbors, so we allow an overlap of a
+  // fraction of the smallest block and put the plane in its middle.
+  //
+  int best_axis = -1;
+  int best_split = 0;
+  int best_balance = 0;
+  vtkm::Float64 best_gap = 0.;
+  vtkm::Float64 best_plane = 0.;
+
+  std::vector<int> sorted(size);
+  std::vector<vtkm::Float64> prefix_max(size);
+  std::vector<vtkm::Float64> suffix_min(size);
+
+  for(int axis = 0; axis < 3; ++axis)
+  {
+    std::copy(domains.begin() + begin, domains.begin() + end, sorted.begin());
+    std::sort(sorted.begin(), sorted.end(), detail::CenterOrder(m_bounds, axis));
+
+    vtkm::Float64 min_length = std::numeric_limits<vtkm::Float64>::max();
+    for(int i = 0; i < size; ++i)
+    {
+      const vtkm::Range &range = detail::axis_range(m_bounds[sorted[i]], axis);
+      min_length = std::min(min_length, range.Length());
+      prefix_max[i] = i == 0 ? range.Max : std::max(prefix_max[i - 1], range.Max);
+    }
+    for(int i = size - 1; i >= 0; --i)
+    {
+      const vtkm::Range &range = detail::axis_range(m_bounds[sorted[i]], axis);
+      suffix_min[i] = i == size - 1 ? range.Min : std::min(suffix_min[i + 1], range.Min);
+    }
+
+    const vtkm::Float64 tolerance = 0.25 * min_length;
+    for(int k = 1; k < size; ++k)
+    {
+      const vtkm::Float64 gap = suffix_min[k] - prefix_max[k - 1];
+      if(gap < -tolerance)
+      {
+        continue;
+      }
+      const int balance = std::min(k, size - k);
+      if(balance > best_balance || (balance == best_balance && gap > best_gap))
+      {
+        best_axis = axis;
+        best_split = k;
+        best_balance = balance;
+        best_gap = gap;
+        best_plane = 0.5 * (suffix_min[k] + prefix_max[k - 1]);
+      }
+    }
+  }
+
+  if(best_axis == -1)
+  {
+    // no separating plane (e.g. overlapping domains), fall back to a
+    // median split of the centers along the axis with the largest spread
+    vtkm::Bounds centers;
+    for(int i = begin; i < end; ++i)
+    {
+      centers.Include(m_bounds[domains[i]].Center());
+    }
+    best_axis = 0;
+    if(centers.Y.Length() > detail::axis_range(centers, best_axis).Length())
+    {
+      best_axis = 1;
+    }
+    if(centers.Z.Length() > detail::axis_range(centers, best_axis).Length())
+    {
+      best_axis = 2;
+    }
+    best_split = size / 2;
+  }
+
+  std::sort(domains.begin() + begin,
+            domains.begin() + end,
+            detail::CenterOrder(m_bounds, best_axis));
+
+  if(best_balance == 0)
+  {
+    best_plane = 0.5 * (m_bounds[domains[begin + best_split - 1]].Center()[best_axis] +
+                        m_bounds[domains[begin + best_split]].Center()[best_axis]);
+  }
+
+  const int left = BuildNode(domains, begin, begin + best_split);
+  const int right = BuildNode(domains, begin + best_split, end);
+
+  m_nodes[node_id].m_axis = best_axis;
+  m_nodes[node_id].m_split = best_plane;
+  m_nodes[node_id].m_left = left;
+  m_nodes[node_id].m_right = right;
+  return node_id;
+}
+
+void
+VisibilityTree::Order(const vtkm::Vec<vtkm::Float64,3> &eye,
+                      std::vector<int> &order) const
+{
+  if(!m_built)
+  {
+    throw Error("VisibilityTree: Order called before Build");
+  }
+
+  order.resize(m_bounds.size());
+  int position = 0;
+
+  if(!m_nodes.empty())
+  {
+    std::vector<int> stack;
+    stack.push_back(0);
+    while(!stack.empty())
+    {
+      const Node &node = m_nodes[stack.back()];
+      stack.pop_back();
+
+      if(node.m_domain != -1)
+      {
+        order[node.m_domain] = position++;
+        continue;
+      }
+
+      // visit the side of the plane the eye is on first
+      if(eye[node.m_axis] < node.m_split)
+      {
+        stack.push_back(node.m_right);
+        stack.push_back(node.m_left);
+      }
+      else
+      {
+        stack.push_back(node.m_left);
+        stack.push_back(node.m_right);
+      }
+    }
+  }
+
+  const int num_empty = static_cast<int>(m_empty_domains.size());
+  for(int i = 0; i < num_empty; ++i)
+  {
+    order[m_empty_domains[i]] = position++;
+  }
+}
+
+} // namespace vtkh
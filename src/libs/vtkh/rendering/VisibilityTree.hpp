@@ -0,0 +1,58 @@
+#ifndef VTK_H_VISIBILITY_TREE_HPP
+#define VTK_H_VISIBILITY_TREE_HPP
+
+#include <vtkh/vtkh_exports.h>
+#include <vtkm/Bounds.h>
+#include <vtkm/Types.h>
+
+#include <vector>
+
+namespace vtkh
+{
+
+//
+// K-d tree over the bounds of every domain (on all ranks). Each inner node
+// splits the domains with an axis aligned plane that separates them (up to
+// ghost overlap), so a front to back ordering for any eye position is a
+// single traversal that visits the near side of each plane first. The
+// tree is built once from the global bounds and every rank can derive the
+// ordering for each camera locally.
+//
+class VTKH_API VisibilityTree
+{
+public:
+  VisibilityTree();
+
+  // bounds of all domains, in global domain order
+  void Build(const std::vector<vtkm::Bounds> &bounds);
+
+  // order[i] is the front to back position of domain i. Domains with
+  // empty bounds are placed last.
+  void Order(const vtkm::Vec<vtkm::Float64,3> &eye,
+             std::vector<int> &order) const;
+
+  int GetNumberOfDomains() const;
+  bool IsBuilt() const;
+  void Clear();
+
+protected:
+  struct Node
+  {
+    int m_axis;
+    vtkm::Float64 m_split;
+    int m_left;
+    int m_right;
+    // -1 for inner nodes
+    int m_domain;
+  };
+
+  int BuildNode(std::vector<int> &domains, int begin, int end);
+
+  std::vector<vtkm::Bounds> m_bounds;
+  std::vector<Node> m_nodes;
+  std::vector<int> m_empty_domains;
+  bool m_built;
+};
+
+} // namespace vtkh
+#endif
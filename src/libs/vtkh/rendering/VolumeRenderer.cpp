@@ -29,38 +29,6 @@ namespace vtkh {
 namespace detail
 {
 
-struct VisOrdering
-{
-  int m_rank;
-  int m_domain_index;
-  int m_order;
-  float m_minz;
-};
-
-struct DepthOrder
-{
-  inline bool operator()(const VisOrdering &lhs, const VisOrdering &rhs)
-  {
-    return lhs.m_minz < rhs.m_minz;
-  }
-};
-
-struct RankOrder
-{
-  inline bool operator()(const VisOrdering &lhs, const VisOrdering &rhs)
-  {
-    if(lhs.m_rank < rhs.m_rank)
-    {
-      return true;
-    }
-    else if(lhs.m_rank == rhs.m_rank)
-    {
-      return lhs.m_domain_index < rhs.m_domain_index;
-    }
-    return false;
-  }
-};
-
 vtkm::cont::ArrayHandle<vtkm::Vec4f_32>
 convert_table(const vtkm::cont::ColorTable& colorTable)
 {
@@ -405,6 +373,7 @@ VolumeRenderer::VolumeRenderer()
   m_color_table.AddPointAlpha(.0f, .5);
   m_num_samples = 100.f;
   m_has_unstructured = false;
+  m_domain_offset = 0;
 }
 
 VolumeRenderer::~VolumeRenderer()
@@ -634,21 +603,6 @@ VolumeRenderer::GetNewCanvas(int width, int height)
   return std::make_shared<vtkm::rendering::CanvasRayTracer>(width, height);
 }
 
-float
-VolumeRenderer::FindMinDepth(const vtkm::rendering::Camera &camera,
-                                 const vtkm::Bounds &bounds) const
-{
-
-  vtkm::Vec<vtkm::Float64,3> center = bounds.Center();
-  vtkm::Vec<vtkm::Float64,3> fcenter;
-  fcenter[0] = static_cast<vtkm::Float32>(center[0]);
-  fcenter[1] = static_cast<vtkm::Float32>(center[1]);
-  fcenter[2] = static_cast<vtkm::Float32>(center[2]);
-  vtkm::Vec<vtkm::Float32,3> pos = camera.GetPosition();
-  vtkm::Float32 dist = vtkm::Magnitude(fcenter - pos);
-  return dist;
-}
-
 void
 VolumeRenderer::Composite(const int &num_images)
 {
@@ -688,146 +642,68 @@ VolumeRenderer::Composite(const int &num_images)
 }
 
 void
-VolumeRenderer::DepthSort(int num_domains,
-                          std::vector<float> &min_depths,
-                          std::vector<int> &local_vis_order)
+VolumeRenderer::BuildVisibilityTree()
 {
-  if(min_depths.size() != num_domains)
-  {
-    throw Error("min depths size does not equal the number of domains");
-  }
-  if(local_vis_order.size() != num_domains)
+  const int num_domains = static_cast<int>(m_input->GetNumberOfDomains());
+
+  // the bounds of every domain in the same order on all ranks. This is
+  // the only communication needed to order the domains for any camera.
+  std::vector<double> local_bounds(num_domains * 6);
+  for(int dom = 0; dom < num_domains; ++dom)
   {
-    throw Error("local vis order not equal to number of domains");
+    vtkm::Bounds bounds = m_input->GetDomainBounds(dom);
+    local_bounds[dom * 6 + 0] = bounds.X.Min;
+    local_bounds[dom * 6 + 1] = bounds.X.Max;
+    local_bounds[dom * 6 + 2] = bounds.Y.Min;
+    local_bounds[dom * 6 + 3] = bounds.Y.Max;
+    local_bounds[dom * 6 + 4] = bounds.Z.Min;
+    local_bounds[dom * 6 + 5] = bounds.Z.Max;
   }
+
+  std::vector<double> global_bounds;
+  m_domain_offset = 0;
 #ifdef VTKH_PARALLEL
-  int root = 0;
   MPI_Comm comm = MPI_Comm_f2c(vtkh::GetMPICommHandle());
-  int num_ranks = vtkh::GetMPISize();
-  int rank = vtkh::GetMPIRank();
-  int *domain_counts = NULL;
-  int *domain_offsets = NULL;
-  int *vis_order = NULL;
-  float *depths = NULL;
-
-  if(rank == root)
-  {
-    domain_counts = new int[num_ranks];
-    domain_offsets = new int[num_ranks];
-  }
-
-  MPI_Gather(&num_domains,
-             1,
-             MPI_INT,
-             domain_counts,
-             1,
-             MPI_INT,
-            root,
-             comm);
-
-  int depths_size = 0;
-  if(rank == root)
-  {
-    //scan for dispacements
-    domain_offsets[0] = 0;
-    for(int i = 1; i < num_ranks; ++i)
-    {
-      domain_offsets[i] = domain_offsets[i - 1] + domain_counts[i - 1];
-    }
+  const int num_ranks = vtkh::GetMPISize();
+  const int rank = vtkh::GetMPIRank();
 
-    for(int i = 0; i < num_ranks; ++i)
-    {
-      depths_size += domain_counts[i];
-    }
+  std::vector<int> counts(num_ranks);
+  int local_count = num_domains * 6;
+  MPI_Allgather(&local_count, 1, MPI_INT, &counts[0], 1, MPI_INT, comm);
 
-    depths = new float[depths_size];
-
-  }
-
-  MPI_Gatherv(&min_depths[0],
-              num_domains,
-              MPI_FLOAT,
-              depths,
-              domain_counts,
-              domain_offsets,
-              MPI_FLOAT,
-              root,
-              comm);
-
-  if(rank == root)
+  std::vector<int> offsets(num_ranks, 0);
+  for(int i = 1; i < num_ranks; ++i)
   {
-    std::vector<detail::VisOrdering> order;
-    order.resize(depths_size);
-
-    for(int i = 0; i < num_ranks; ++i)
-    {
-      for(int c = 0; c < domain_counts[i]; ++c)
-      {
-        int index = domain_offsets[i] + c;
-        order[index].m_rank = i;
-        order[index].m_domain_index = c;
-        order[index].m_minz = depths[index];
-      }
-    }
-
-    std::sort(order.begin(), order.end(), detail::DepthOrder());
-
-    for(int i = 0; i < depths_size; ++i)
-    {
-      order[i].m_order = i;
-    }
-
-    std::sort(order.begin(), order.end(), detail::RankOrder());
-
-    vis_order = new int[depths_size];
-    for(int i = 0; i < depths_size; ++i)
-    {
-      vis_order[i] = order[i].m_order;
-    }
+    offsets[i] = offsets[i - 1] + counts[i - 1];
   }
+  global_bounds.resize(offsets[num_ranks - 1] + counts[num_ranks - 1]);
+  m_domain_offset = offsets[rank] / 6;
 
-  MPI_Scatterv(vis_order,
-               domain_counts,
-               domain_offsets,
-               MPI_INT,
-               &local_vis_order[0],
-               num_domains,
-               MPI_INT,
-               root,
-               comm);
-
-  if(rank == root)
-  {
-    delete[] domain_counts;
-    delete[] domain_offsets;
-    delete[] vis_order;
-    delete[] depths;
-  }
+  MPI_Allgatherv(local_bounds.data(),
+                 local_count,
+                 MPI_DOUBLE,
+                 global_bounds.data(),
+                 &counts[0],
+                 &offsets[0],
+                 MPI_DOUBLE,
+                 comm);
 #else
+  global_bounds = local_bounds;
+#endif
 
-  std::vector<detail::VisOrdering> order;
-  order.resize(num_domains);
-
-  for(int i = 0; i < num_domains; ++i)
-  {
-      order[i].m_rank = 0;
-      order[i].m_domain_index = i;
-      order[i].m_minz = min_depths[i];
-  }
-  std::sort(order.begin(), order.end(), detail::DepthOrder());
-
-  for(int i = 0; i < num_domains; ++i)
+  const int total_domains = static_cast<int>(global_bounds.size() / 6);
+  std::vector<vtkm::Bounds> bounds(total_domains);
+  for(int i = 0; i < total_domains; ++i)
   {
-    order[i].m_order = i;
+    bounds[i] = vtkm::Bounds(global_bounds[i * 6 + 0],
+                             global_bounds[i * 6 + 1],
+                             global_bounds[i * 6 + 2],
+                             global_bounds[i * 6 + 3],
+                             global_bounds[i * 6 + 4],
+                             global_bounds[i * 6 + 5]);
   }
 
-  std::sort(order.begin(), order.end(), detail::RankOrder());
-
-  for(int i = 0; i < num_domains; ++i)
-  {
-    local_vis_order[i] = order[i].m_order;
-  }
-#endif
+  m_visibility_tree.Build(bounds);
 }
 
 void
@@ -837,38 +713,39 @@ VolumeRenderer::FindVisibilityOrdering()
   const int num_cameras = static_cast<int>(m_renders.size());
   m_visibility_orders.resize(num_cameras);
 
-  for(int i = 0; i < num_cameras; ++i)
-  {
-    m_visibility_orders[i].resize(num_domains);
-  }
-
   //
   // In order for parallel volume rendering to composite correctly,
-  // we nee to establish a visibility ordering to pass to IceT.
-  // We will transform the data extents into camera space and
-  // take the minimum z value. Then sort them while keeping
-  // track of rank, then pass the list in.
+  // we need to establish a visibility ordering to pass to the
+  // compositor. The k-d tree over all domain bounds is built once
+  // per input, and every rank then walks it for each camera without
+  // any further communication.
   //
-  std::vector<float> min_depths;
-  min_depths.resize(num_domains);
+  if(!m_visibility_tree.IsBuilt())
+  {
+    BuildVisibilityTree();
+  }
 
+  std::vector<int> global_order;
   for(int i = 0; i < num_cameras; ++i)
   {
     const vtkm::rendering::Camera &camera = m_renders[i].GetCamera();
+    const vtkm::Vec<vtkm::Float32,3> pos = camera.GetPosition();
+    vtkm::Vec<vtkm::Float64,3> eye(pos[0], pos[1], pos[2]);
+    m_visibility_tree.Order(eye, global_order);
+
+    m_visibility_orders[i].resize(num_domains);
     for(int dom = 0; dom < num_domains; ++dom)
     {
-      vtkm::Bounds bounds = this->m_input->GetDomainBounds(dom);
-      min_depths[dom] = FindMinDepth(camera, bounds);
+      m_visibility_orders[i][dom] = global_order[m_domain_offset + dom];
     }
-
-    DepthSort(num_domains, min_depths, m_visibility_orders[i]);
-
   } // for each camera
 }
+
 void VolumeRenderer::SetInput(DataSet *input)
 {
   Filter::SetInput(input);
   ClearWrappers();
+  m_visibility_tree.Clear();
 
   int num_domains = static_cast<int>(m_input->GetNumberOfDomains());
   m_has_unstructured = false;
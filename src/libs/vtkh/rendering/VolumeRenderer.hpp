@@ -3,6 +3,7 @@
 
 #include <vtkh/vtkh_exports.h>
 #include <vtkh/rendering/Renderer.hpp>
+#include <vtkh/rendering/VisibilityTree.hpp>
 #include <vtkm/rendering/MapperVolume.h>
 
 namespace vtkh {
@@ -36,11 +37,7 @@ protected:
 
   void CorrectOpacity();
   void FindVisibilityOrdering();
-  void DepthSort(int num_domains,
-                 std::vector<float> &min_depths,
-                 std::vector<int> &local_vis_order);
-  float FindMinDepth(const vtkm::rendering::Camera &camera,
-                     const vtkm::Bounds &bounds) const;
+  void BuildVisibilityTree();
 
   int m_num_samples;
   float m_sample_dist;
@@ -48,6 +45,9 @@ protected:
   std::shared_ptr<vtkm::rendering::MapperVolume> m_tracer;
   vtkm::cont::ColorTable m_corrected_color_table;
   std::vector<std::vector<int>> m_visibility_orders;
+  // built once per input, shared by all cameras
+  VisibilityTree m_visibility_tree;
+  int m_domain_offset;
 
   void ClearWrappers();
   std::vector<detail::VolumeWrapper*> m_wrappers;
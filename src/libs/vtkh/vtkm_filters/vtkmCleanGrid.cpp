@@ -10,6 +10,12 @@ vtkmCleanGrid::tolerance(const vtkm::Float64 tol)
   m_tolerance = tol;
 }
 
+void
+vtkmCleanGrid::merge_points(const bool on)
+{
+  m_merge_points = on;
+}
+
 vtkm::cont::DataSet
 vtkmCleanGrid::Run(vtkm::cont::DataSet &input,
                    vtkm::filter::FieldSelection map_fields)
@@ -22,6 +28,7 @@ vtkmCleanGrid::Run(vtkm::cont::DataSet &input,
     cleaner.SetToleranceIsAbsolute(true);
   }
 
+  cleaner.SetMergePoints(m_merge_points);
   cleaner.SetFieldsToPass(map_fields);
   cleaner.SetRemoveDegenerateCells(true);
   auto output = cleaner.Execute(input);
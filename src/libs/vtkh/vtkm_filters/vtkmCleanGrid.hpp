@@ -11,8 +11,10 @@ class vtkmCleanGrid
 {
 protected:
   vtkm::Float64 m_tolerance = -1.;
+  bool m_merge_points = true;
 public:
   void tolerance(const vtkm::Float64 tol);
+  void merge_points(const bool on);
 
   vtkm::cont::DataSet Run(vtkm::cont::DataSet &input,
                           vtkm::filter::FieldSelection map_fields);
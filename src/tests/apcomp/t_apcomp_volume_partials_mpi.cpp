@@ -81,6 +81,65 @@ TEST(apcomp_vpartial_mpi, apcomp_vpartial_mpi)
 
 }
 
+//-----------------------------------------------------------------------------
+TEST(apcomp_vpartial_mpi, apcomp_vpartial_mpi_reduced_color)
+{
+  int par_rank;
+  int par_size;
+  MPI_Comm comm = MPI_COMM_WORLD;
+  MPI_Comm_rank(comm, &par_rank);
+  MPI_Comm_size(comm, &par_size);
+  apcomp::mpi_comm(MPI_Comm_c2f(comm));
+  if(par_size > 4)
+  {
+    EXPECT_TRUE(false);
+  }
+
+  const int width  = 1024;
+  const int height = 1024;
+  const int square_size = 300;
+  const int y = 500;
+  float colors[4][4] = { {1.f, 0.f, 0.f, 0.5f},
+                         {0.f, 1.f, 0.f, 0.5f},
+                         {0.f, 0.f, 1.f, 0.5f},
+                         {0.f, 1.f, 1.f, 0.5f} } ;
+
+  std::vector<apcomp::VolumePartial<float>> outputs[2];
+  const int color_bits[2] = {32, 16};
+  for(int run = 0; run < 2; ++run)
+  {
+    std::vector<std::vector<apcomp::VolumePartial<float>>> in_partials;
+    in_partials.resize(1);
+    gen_float32_partials(in_partials[0],
+                         width,
+                         height,
+                         float(par_rank) * 0.05f,
+                         200 + 100*par_rank,
+                         y - par_rank * 50,
+                         square_size,
+                         colors[par_rank]);
+
+    apcomp::transport_color_bits(color_bits[run]);
+    apcomp::PartialCompositor<apcomp::VolumePartial<float>> compositor;
+    compositor.composite(in_partials, outputs[run]);
+  }
+  apcomp::transport_color_bits(32);
+
+  if(par_rank == 0)
+  {
+    ASSERT_EQ(outputs[0].size(), outputs[1].size());
+    for(size_t i = 0; i < outputs[0].size(); ++i)
+    {
+      ASSERT_EQ(outputs[0][i].m_pixel_id, outputs[1][i].m_pixel_id);
+      for(int c = 0; c < 3; ++c)
+      {
+        ASSERT_NEAR(outputs[0][i].m_pixel[c], outputs[1][i].m_pixel[c], 1e-3f);
+      }
+      ASSERT_NEAR(outputs[0][i].m_alpha, outputs[1][i].m_alpha, 1e-3f);
+    }
+  }
+}
+
 int main(int argc, char* argv[])
 {
     int result = 0;
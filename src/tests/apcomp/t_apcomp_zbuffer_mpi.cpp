@@ -79,6 +79,70 @@ TEST(apcomp_zbuffer_mpi, apcomp_zbuffer_mpi)
 
 }
 
+//-----------------------------------------------------------------------------
+TEST(apcomp_zbuffer_mpi, apcomp_zbuffer_mpi_reduced_depth)
+{
+  int par_rank;
+  int par_size;
+  MPI_Comm comm = MPI_COMM_WORLD;
+  MPI_Comm_rank(comm, &par_rank);
+  MPI_Comm_size(comm, &par_size);
+  apcomp::mpi_comm(MPI_Comm_c2f(comm));
+
+  const int width  = 1024;
+  const int height = 1024;
+  const int square_size = 300;
+  const int y = 400;
+
+  float color[4];
+  color[0] = 0.1f + float(par_rank) * 0.1f;
+  color[1] = 0.1f + float(par_rank) * 0.1f;
+  color[2] = 0.1f + float(par_rank) * 0.1f;
+  color[3] = 1.f;
+  std::vector<float> pixels;
+  std::vector<float> depths;
+  gen_float32_image(pixels,
+                    depths,
+                    width,
+                    height,
+                    float(par_rank) * 0.05f,
+                    200 + 100 * par_rank,
+                    y,
+                    square_size,
+                    color);
+
+  auto mode = apcomp::Compositor::CompositeMode::Z_BUFFER_SURFACE_GL;
+  apcomp::Compositor full_compositor;
+  full_compositor.SetCompositeMode(mode);
+  full_compositor.AddImage(&pixels[0], &depths[0], width, height);
+  apcomp::Image full = full_compositor.Composite();
+
+  apcomp::transport_depth_bits(16);
+  apcomp::Compositor compositor;
+  compositor.SetCompositeMode(mode);
+  compositor.AddImage(&pixels[0], &depths[0], width, height);
+  apcomp::Image reduced = compositor.Composite();
+  apcomp::transport_depth_bits(32);
+
+  if(par_rank == 0)
+  {
+    // the surfaces are far apart compared to the depth quantization
+    EXPECT_TRUE(full.m_pixels == reduced.m_pixels);
+    ASSERT_EQ(full.m_depths.size(), reduced.m_depths.size());
+    for(size_t i = 0; i < full.m_depths.size(); ++i)
+    {
+      if(full.m_depths[i] <= 1.f)
+      {
+        ASSERT_NEAR(full.m_depths[i], reduced.m_depths[i], 1e-4f);
+      }
+      else
+      {
+        ASSERT_GT(reduced.m_depths[i], 1.f);
+      }
+    }
+  }
+}
+
 int main(int argc, char* argv[])
 {
     int result = 0;
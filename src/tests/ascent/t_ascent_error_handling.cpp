@@ -14,6 +14,7 @@
 #include "gtest/gtest.h"
 
 #include <ascent.hpp>
+#include <runtimes/flow_filters/ascent_runtime_blueprint_filters.hpp>
 
 #include <iostream>
 #include <math.h>
@@ -305,6 +306,109 @@ TEST(ascent_error_handling, test_emtpy)
     conduit::utils::set_info_handler(conduit::utils::default_info_handler);
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_error_handling, test_verify_cached_domains)
+{
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("uniform",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing verification of unchanged and changed domains");
+
+    conduit::Node actions;
+    conduit::Node &add_queries = actions.append();
+    add_queries["action"] = "add_queries";
+    add_queries["queries/q1/params/expression"] = "max(field('braid'))";
+    add_queries["queries/q1/params/name"] = "max_braid";
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent_opts["exceptions"] = "forward";
+    ascent_opts["verify/full_frequency"] = 3;
+    ascent.open(ascent_opts);
+
+    // unchanged structure, only the values change
+    float64_array vals = data["fields/braid/values"].value();
+    for(int cycle = 0; cycle < 4; ++cycle)
+    {
+      vals[0] = cycle;
+      ascent.publish(data);
+      ascent.execute(actions);
+    }
+
+    // a structural change must be caught even though
+    // the domain was verified before
+    data["topologies/mesh/type"] = "bananas";
+
+    bool error = false;
+    try
+    {
+      ascent.publish(data);
+      ascent.execute(actions);
+    }
+    catch(conduit::Error &e)
+    {
+      error = true;
+    }
+
+    ASSERT_TRUE(error);
+
+    ascent.close();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_error_handling, test_verify_skips_new_cycles)
+{
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("rectilinear",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing that a new cycle of the same mesh is not verified again");
+
+    conduit::Node actions;
+    conduit::Node &add_queries = actions.append();
+    add_queries["action"] = "add_queries";
+    add_queries["queries/q1/params/expression"] = "max(field('braid'))";
+    add_queries["queries/q1/params/name"] = "max_braid";
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent_opts["exceptions"] = "forward";
+    ascent.open(ascent_opts);
+
+    // a simulation advances the cycle and time every publish
+    data["state/cycle"] = 100;
+    data["state/time"] = 1.0;
+    ascent.publish(data);
+    ascent.execute(actions);
+    EXPECT_EQ(runtime::filters::BlueprintVerify::last_verified_domains(), 1);
+
+    data["state/cycle"] = 101;
+    data["state/time"] = 1.5;
+    ascent.publish(data);
+    ascent.execute(actions);
+    EXPECT_EQ(runtime::filters::BlueprintVerify::last_verified_domains(), 0);
+
+    ascent.close();
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
 {
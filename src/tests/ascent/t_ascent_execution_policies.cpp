@@ -16,6 +16,7 @@
 #include <expressions/ascent_memory_manager.hpp>
 
 #include <cmath>
+#include <cstring>
 #include <iostream>
 
 #include <conduit_blueprint.hpp>
@@ -200,6 +201,40 @@ void test_atomics()
     device_free(dev_vals_ptr);
 }
 
+TEST(ascent_execution_policies, host_memory_pool)
+{
+    const size_t start_in_use = HostMemoryPool::bytes_in_use();
+
+    // sizes are rounded up to a power of two
+    void *a = HostMemoryPool::allocate(100);
+    EXPECT_EQ(HostMemoryPool::bytes_in_use() - start_in_use, 128);
+    HostMemoryPool::deallocate(a);
+    EXPECT_EQ(HostMemoryPool::bytes_in_use(), start_in_use);
+    EXPECT_TRUE(HostMemoryPool::bytes_cached() >= 128);
+
+    // a block of the same size class is reused
+    void *b = HostMemoryPool::allocate(120);
+    EXPECT_EQ(a, b);
+    // the block is usable
+    memset(b, 0, 120);
+    HostMemoryPool::deallocate(b);
+
+    // nothing was in use after the last trim, so two trims
+    // release everything we cached
+    HostMemoryPool::trim();
+    HostMemoryPool::trim();
+    if(start_in_use == 0)
+    {
+        EXPECT_EQ(HostMemoryPool::bytes_cached(), 0);
+    }
+
+    Node info;
+    HostMemoryPool::info(info);
+    info.print();
+    EXPECT_TRUE(info.has_child("high_water"));
+    EXPECT_TRUE(info["hits"].to_uint64() >= 1);
+}
+
 TEST(ascent_execution_policies, forall)
 {
     test_forall();
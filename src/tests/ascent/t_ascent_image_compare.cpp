@@ -19,6 +19,9 @@
 #include <math.h>
 
 #include <conduit_blueprint.hpp>
+#include <png_utils/ascent_image_encoder.hpp>
+#include <png_utils/ascent_png_decoder.hpp>
+#include <png_utils/ascent_qoi_decoder.hpp>
 
 #include "t_config.hpp"
 #include "t_utils.hpp"
@@ -102,6 +105,166 @@ TEST(ascent_image_compare, test_image_diff)
 }
 
 
+//-----------------------------------------------------------------------------
+void
+render_with_encoding(const std::string &output_file,
+                     const conduit::Node &image_encoding)
+{
+    Node data;
+    conduit::blueprint::mesh::examples::braid("uniform",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    conduit::Node actions;
+    conduit::Node &add_plots = actions.append();
+    add_plots["action"] = "add_scenes";
+    add_plots["scenes/s1/plots/p1/type"] = "pseudocolor";
+    add_plots["scenes/s1/plots/p1/field"] = "braid";
+    add_plots["scenes/s1/image_name"] = output_file;
+
+    Ascent ascent;
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent_opts["runtime/backend"] = "serial";
+    ascent_opts["image_encoding"] = image_encoding;
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+}
+
+//-----------------------------------------------------------------------------
+void
+reset_image_encoding()
+{
+    // the encoding options are process wide
+    Node image_encoding;
+    image_encoding["format"] = "png";
+    image_encoding["compression_level"] = 1;
+    image_encoding["filter"] = "minsum";
+    image_encoding["threads"] = 0;
+    ImageEncoder::SetDefaultOptions(image_encoding);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_image_compare, test_png_compression_levels)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent support disabled, skipping 3D serial test");
+        return;
+    }
+
+    ASCENT_INFO("Testing png compression levels");
+
+    string output_path = prepare_output_dir();
+    string stored_file = conduit::utils::join_file_path(output_path,
+                                                        "tout_png_level_0");
+    string default_file = conduit::utils::join_file_path(output_path,
+                                                         "tout_png_level_1");
+    string best_file = conduit::utils::join_file_path(output_path,
+                                                      "tout_png_level_9");
+    remove_test_image_direct(stored_file);
+    remove_test_image_direct(default_file);
+    remove_test_image_direct(best_file);
+
+    Node image_encoding;
+    image_encoding["compression_level"] = 0;
+    image_encoding["filter"] = "none";
+    render_with_encoding(stored_file, image_encoding);
+
+    reset_image_encoding();
+    render_with_encoding(default_file, Node());
+
+    image_encoding["compression_level"] = 9;
+    image_encoding["filter"] = "entropy";
+    image_encoding["threads"] = 2;
+    render_with_encoding(best_file, image_encoding);
+    reset_image_encoding();
+
+    // all levels are lossless
+    ascent::PNGCompare compare;
+    Node info;
+    EXPECT_TRUE(compare.Compare(stored_file + ".png",
+                                default_file + ".png",
+                                info,
+                                0.0f));
+    EXPECT_TRUE(compare.Compare(best_file + ".png",
+                                default_file + ".png",
+                                info,
+                                0.0f));
+
+    EXPECT_GT(conduit::utils::file_size(stored_file + ".png"),
+              conduit::utils::file_size(default_file + ".png"));
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_image_compare, test_qoi_encoding)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent support disabled, skipping 3D serial test");
+        return;
+    }
+
+    ASCENT_INFO("Testing qoi image encoding");
+
+    string output_path = prepare_output_dir();
+    string png_file = conduit::utils::join_file_path(output_path,
+                                                     "tout_qoi_reference");
+    string qoi_file = conduit::utils::join_file_path(output_path,
+                                                     "tout_qoi_image");
+    remove_test_image_direct(png_file);
+    remove_test_file(qoi_file + ".qoi");
+
+    reset_image_encoding();
+    render_with_encoding(png_file, Node());
+
+    Node image_encoding;
+    image_encoding["format"] = "qoi";
+    render_with_encoding(qoi_file, image_encoding);
+    reset_image_encoding();
+
+    EXPECT_TRUE(conduit::utils::is_file(qoi_file + ".qoi"));
+    EXPECT_FALSE(conduit::utils::is_file(qoi_file + ".png"));
+
+    // same pixels as the png
+    std::vector<unsigned char> qoi_pixels;
+    int qoi_width, qoi_height;
+    QOIDecoder qoi_decoder;
+    qoi_decoder.Decode(qoi_pixels, qoi_width, qoi_height, qoi_file + ".qoi");
+
+    unsigned char *png_pixels = NULL;
+    int png_width, png_height;
+    PNGDecoder png_decoder;
+    png_decoder.Decode(png_pixels, png_width, png_height, png_file + ".png");
+
+    EXPECT_EQ(qoi_width, png_width);
+    EXPECT_EQ(qoi_height, png_height);
+    ASSERT_EQ(qoi_pixels.size(), (size_t)png_width * png_height * 4);
+    index_t diff = 0;
+    for(size_t i = 0; i < qoi_pixels.size(); ++i)
+    {
+        diff += qoi_pixels[i] != png_pixels[i] ? 1 : 0;
+    }
+    free(png_pixels);
+    EXPECT_EQ(diff, 0);
+
+    // bad input is an error
+    unsigned char bad[32] = {0};
+    EXPECT_THROW(qoi_decoder.Decode(qoi_pixels, qoi_width, qoi_height, bad, 32),
+                 conduit::Error);
+}
+
+
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
 {
@@ -0,0 +1,151 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: t_ascent_mfem_data_adapter.cpp
+///
+//-----------------------------------------------------------------------------
+
+
+#include "gtest/gtest.h"
+
+#include <ascent.hpp>
+#include <runtimes/ascent_mfem_data_adapter.hpp>
+#include <iostream>
+#include <memory>
+
+#include <conduit_blueprint.hpp>
+#include <conduit_relay.hpp>
+
+#include "t_config.hpp"
+#include "t_utils.hpp"
+
+
+using namespace std;
+using namespace conduit;
+using namespace ascent;
+
+
+//-----------------------------------------------------------------------------
+TEST(ascent_mfem_data_adapter, linearize_domains_match_serial)
+{
+    // a high order mesh with 8 domains
+    Node data, verify_info;
+    conduit::relay::io::blueprint::read_mesh(test_data_file("laghos_tg.cycle_000350.root"),
+                                             data);
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+    ASSERT_GT(data.number_of_children(), 1);
+
+    const int refinement = 3;
+
+    // all domains at once, projected in parallel when openmp is enabled
+    MFEMDataAdapter::ClearLinearizeCache();
+    std::unique_ptr<MFEMDomains> domains(MFEMDataAdapter::BlueprintToMFEMDataSet(data));
+    Node all;
+    MFEMDataAdapter::Linearize(domains.get(), all, refinement);
+    ASSERT_EQ(all.number_of_children(), data.number_of_children());
+
+    // each domain on its own, which is always serial
+    for(index_t i = 0; i < data.number_of_children(); ++i)
+    {
+        Node single_data;
+        single_data.append().set_external(data.child(i));
+
+        MFEMDataAdapter::ClearLinearizeCache();
+        std::unique_ptr<MFEMDomains> single_domain(MFEMDataAdapter::BlueprintToMFEMDataSet(single_data));
+        Node single;
+        MFEMDataAdapter::Linearize(single_domain.get(), single, refinement);
+        ASSERT_EQ(single.number_of_children(), 1);
+
+        Node diff_info;
+        bool different = all.child(i).diff(single.child(0), diff_info);
+        if(different)
+        {
+            diff_info.print();
+        }
+        EXPECT_FALSE(different);
+    }
+
+    MFEMDataAdapter::ClearLinearizeCache();
+}
+
+//-----------------------------------------------------------------------------
+void
+scale_values(Node &node, float64 factor)
+{
+    if(node.dtype().is_float64())
+    {
+        float64_array vals = node.value();
+        for(index_t i = 0; i < vals.number_of_elements(); ++i)
+        {
+            vals[i] *= factor;
+        }
+    }
+    for(index_t i = 0; i < node.number_of_children(); ++i)
+    {
+        scale_values(node.child(i), factor);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_mfem_data_adapter, linearize_moved_mesh)
+{
+    Node data;
+    conduit::relay::io::blueprint::read_mesh(test_data_file("laghos_tg.cycle_000350.root"),
+                                             data);
+    Node moved;
+    Node &moved_data = moved.append();
+    moved_data.set(data.child(0));
+
+    const int refinement = 3;
+    MFEMDataAdapter::ClearLinearizeCache();
+    std::unique_ptr<MFEMDomains> domain(MFEMDataAdapter::BlueprintToMFEMDataSet(moved));
+    Node first;
+    MFEMDataAdapter::Linearize(domain.get(), first, refinement);
+
+    // same connectivity at a different place: the cached layouts are
+    // reused, but the output has to follow the mesh
+    scale_values(moved_data["coordsets"], 2.0);
+    const std::string nodes_field =
+        moved_data["topologies"].child(0).has_child("grid_function") ?
+        moved_data["topologies"].child(0)["grid_function"].as_string() : "";
+    if(!nodes_field.empty())
+    {
+        scale_values(moved_data["fields"][nodes_field]["values"], 2.0);
+    }
+
+    domain.reset(MFEMDataAdapter::BlueprintToMFEMDataSet(moved));
+    Node cached;
+    MFEMDataAdapter::Linearize(domain.get(), cached, refinement);
+
+    MFEMDataAdapter::ClearLinearizeCache();
+    Node fresh;
+    MFEMDataAdapter::Linearize(domain.get(), fresh, refinement);
+
+    Node diff_info;
+    EXPECT_TRUE(first.child(0)["coordsets"].diff(cached.child(0)["coordsets"], diff_info));
+    bool different = cached.child(0).diff(fresh.child(0), diff_info);
+    if(different)
+    {
+        diff_info.print();
+    }
+    EXPECT_FALSE(different);
+
+    MFEMDataAdapter::ClearLinearizeCache();
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    int result = 0;
+
+    ::testing::InitGoogleTest(&argc, argv);
+    result = RUN_ALL_TESTS();
+    return result;
+}
+
+
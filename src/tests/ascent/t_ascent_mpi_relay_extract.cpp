@@ -20,6 +20,7 @@
 
 #include <conduit_blueprint.hpp>
 #include <conduit_relay.hpp>
+#include <conduit_relay_io_blueprint.hpp>
 
 #include "t_config.hpp"
 #include "t_utils.hpp"
@@ -690,6 +691,117 @@ TEST(ascent_relay, test_relay_bp_num_files)
     }
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_relay, test_relay_bp_aggregation)
+{
+    //
+    // Set Up MPI
+    //
+    int par_rank;
+    int par_size;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    MPI_Comm_rank(comm, &par_rank);
+    MPI_Comm_size(comm, &par_size);
+
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+
+    // use spiral , with 7 domains
+    conduit::blueprint::mesh::examples::spiral(7,data);
+
+    // rank 0 gets first 4 domains, rank 1 gets the rest
+    if(par_rank == 0)
+    {
+        data.remove(4);
+        data.remove(4);
+        data.remove(4);
+    }
+    else if(par_rank == 1)
+    {
+        data.remove(0);
+        data.remove(0);
+        data.remove(0);
+        data.remove(0);
+    }
+    else
+    {
+        EXPECT_TRUE(false);
+    }
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing relay extract aggregation option with mpi");
+
+    string output_path = prepare_output_dir();
+    string output_base = conduit::utils::join_file_path(output_path,
+                                                        "tout_relay_mpi_extract_aggregation");
+    string output_dir  = output_base + ".cycle_000000";
+    string output_root = output_base + ".cycle_000000.root";
+
+    if(par_rank == 0)
+    {
+        // remove existing directory
+        utils::remove_directory(output_dir);
+        utils::remove_directory(output_root);
+    }
+
+    MPI_Barrier(comm);
+
+    conduit::Node actions;
+    // add the extracts
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    conduit::Node &extracts = add_extracts["extracts"];
+
+    extracts["e1/type"]  = "relay";
+    extracts["e1/params/path"] = output_base;
+    extracts["e1/params/protocol"] = "blueprint/mesh/hdf5";
+    // both ranks live on the same node, so rank 0 writes everything
+    extracts["e1/params/aggregation/writers_per_node"] = 1;
+
+    //
+    // Run Ascent
+    //
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime"] = "ascent";
+    ascent_opts["mpi_comm"] = MPI_Comm_c2f(comm);
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+
+    Node info;
+    ascent.info(info);
+    ascent.close();
+
+    MPI_Barrier(comm);
+
+    EXPECT_TRUE(conduit::utils::is_file(output_root));
+    EXPECT_TRUE(info.has_path("extracts"));
+    const Node &einfo = info["extracts"].child(0);
+    EXPECT_EQ(einfo["write/num_writers"].to_int(), 1);
+    EXPECT_TRUE(einfo["write/bytes"].to_uint64() > 0);
+    EXPECT_TRUE(einfo.has_path("write/bandwidth"));
+
+    // all domains end up in a single file
+    std::string fcheck = conduit::utils::join_file_path(output_dir,
+                                                        "file_000000.hdf5");
+    EXPECT_TRUE(conduit::utils::is_file(fcheck));
+
+    if(par_rank == 0)
+    {
+        Node reloaded;
+        conduit::relay::io::blueprint::load_mesh(output_root, reloaded);
+        EXPECT_EQ(reloaded.number_of_children(), 7);
+    }
+
+    MPI_Barrier(comm);
+}
+
 //-----------------------------------------------------------------------------
 TEST(ascent_relay, test_relay_mpi_sparse_topos_1)
 {
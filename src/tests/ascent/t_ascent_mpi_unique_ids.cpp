@@ -133,6 +133,54 @@ TEST(ascent_partition, test_global_ranks_non_unique)
     EXPECT_THROW(ascent.publish(data),conduit::Error);
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_partition, test_republish_non_unique)
+{
+    Node data, verify_info;
+
+    int par_rank;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    MPI_Comm_rank(comm, &par_rank);
+
+    conduit::blueprint::mpi::mesh::examples::spiral_round_robin(20,data,comm);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    if(par_rank == 0)
+    	ASCENT_INFO("Testing non unique IDs after publishing the same layout");
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime"] = "ascent";
+    ascent_opts["mpi_comm"] = MPI_Comm_c2f(comm);
+    ascent_opts["exceptions"] = "forward";
+    ascent.open(ascent_opts);
+
+    // the second publish reuses the id checks of the first
+    Node actions, info;
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.info(info);
+    EXPECT_EQ(info["published_mesh_info/checked"].as_string(), "true");
+
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.info(info);
+    EXPECT_EQ(info["published_mesh_info/checked"].as_string(), "false");
+
+    // changing the ids must be caught again
+    int num_domains = data.number_of_children();
+    for(int i = 0; i < num_domains; i++)
+    {
+      conduit::Node &dom = data.child(i);
+      dom["state/domain_id"] = 0;
+    }
+
+    EXPECT_THROW(ascent.publish(data),conduit::Error);
+    ascent.close();
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
 {
@@ -16,6 +16,7 @@
 #include <ascent.hpp>
 
 #include <iostream>
+#include <iomanip>
 #include <math.h>
 
 #include <conduit_blueprint.hpp>
@@ -928,6 +929,91 @@ TEST(ascent_relay, test_relay_bp_num_files)
 }
 
 
+//-----------------------------------------------------------------------------
+TEST(ascent_relay, test_relay_async)
+{
+    Node n;
+    ascent::about(n);
+
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("uniform",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              0,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing relay extract async option");
+
+    string output_path = prepare_output_dir();
+    string output_base = conduit::utils::join_file_path(output_path,
+                                                        "tout_relay_async");
+
+    conduit::Node actions;
+    // add the extracts
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    conduit::Node &extracts = add_extracts["extracts"];
+
+    extracts["e1/type"]  = "relay";
+    extracts["e1/params/path"] = output_base;
+    extracts["e1/params/protocol"] = "blueprint/mesh/yaml";
+    extracts["e1/params/async"] = "true";
+    extracts["e1/params/max_in_flight"] = 1;
+
+    //
+    // Run Ascent
+    //
+
+    Ascent ascent;
+    ascent.open();
+
+    const int num_cycles = 3;
+    for(int cycle = 0; cycle < num_cycles; ++cycle)
+    {
+        std::ostringstream oss;
+        oss << output_base << ".cycle_" << std::setw(6)
+            << std::setfill('0') << cycle << ".root";
+        utils::remove_directory(oss.str());
+        data["state/cycle"] = cycle;
+        float64_array vals = data["fields/braid/values"].value();
+        vals[0] = cycle;
+        ascent.publish(data);
+        ascent.execute(actions);
+
+        Node info;
+        ascent.info(info);
+        EXPECT_EQ(info["extracts"].child(0)["write/async"].as_string(), "true");
+        // the root file is known before it is written
+        EXPECT_EQ(info["extracts"].child(0)["path"].as_string(), oss.str());
+
+        // the extract has its own copy of the data, changing ours
+        // must not affect what gets written
+        vals[0] = -1.0;
+    }
+
+    // close waits for pending writes
+    ascent.close();
+
+    for(int cycle = 0; cycle < num_cycles; ++cycle)
+    {
+        std::ostringstream oss;
+        oss << output_base << ".cycle_" << std::setw(6)
+            << std::setfill('0') << cycle << ".root";
+        EXPECT_TRUE(conduit::utils::is_file(oss.str()));
+
+        // the file holds the data as it was published
+        Node saved;
+        conduit::relay::io::blueprint::load_mesh(oss.str(), saved);
+        float64_array saved_vals = saved.child(0)["fields/braid/values"].value();
+        EXPECT_EQ(saved_vals[0], (float64) cycle);
+    }
+}
+
 //-----------------------------------------------------------------------------
 TEST(ascent_relay, test_relay_sparse_topos)
 {
@@ -19,10 +19,13 @@
 #include <sstream>
 
 #include <conduit_blueprint.hpp>
+#include <conduit_relay.hpp>
 
 #include "t_config.hpp"
 #include "t_utils.hpp"
 
+#include <flow.hpp>
+
 
 using namespace std;
 using namespace conduit;
@@ -385,6 +388,99 @@ TEST(ascent_runtime_options, test_timings_tear_updown)
     EXPECT_TRUE(check_test_file(timings_file));
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_runtime_options, test_trace)
+{
+    // the ascent runtime is currently our only rendering runtime
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent support disabled, skipping trace test");
+        return;
+    }
+
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,"tout_trace_img");
+
+    remove_test_image(output_file);
+
+    Node actions;
+    Node &add_scenes = actions.append();
+    add_scenes["action"] = "add_scenes";
+    add_scenes["scenes/s1/plots/p1/type"] = "pseudocolor";
+    add_scenes["scenes/s1/plots/p1/field"] = "braid";
+    add_scenes["scenes/s1/image_prefix"] = output_file;
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent_opts["trace/enabled"] = "true";
+    ascent_opts["trace/file_prefix"] = "tout_trace";
+    ascent_opts["default_dir"] = output_path;
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+
+    Node info;
+    ascent.info(info);
+    ascent.close();
+
+    EXPECT_TRUE(check_test_image(output_file));
+
+    EXPECT_TRUE(info.has_path("trace/file"));
+    std::string trace_file = info["trace/file"].as_string();
+    EXPECT_TRUE(check_test_file(trace_file));
+
+    info["trace/summary"].print();
+    // one clock for every layer
+    EXPECT_TRUE(info.has_path("trace/summary/ascent/execute"));
+    EXPECT_TRUE(info.has_path("trace/summary/ascent/publish"));
+    EXPECT_TRUE(info.has_path("trace/summary/flow"));
+    EXPECT_TRUE(info.has_path("trace/summary/vtkh"));
+
+    Node trace;
+    conduit::relay::io::load(trace_file, "json", trace);
+    EXPECT_GT(trace["traceEvents"].number_of_children(), 0);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_runtime_options, test_trace_multiple_runtimes)
+{
+    Node tracing_opts;
+    tracing_opts["runtime/type"] = "ascent";
+    tracing_opts["trace/enabled"] = "true";
+
+    Node plain_opts;
+    plain_opts["runtime/type"] = "ascent";
+
+    // tracing is process wide, a runtime without tracing must not
+    // turn it off for one that asked for it
+    Ascent tracing;
+    tracing.open(tracing_opts);
+    EXPECT_TRUE(flow::Trace::enabled());
+
+    Ascent plain;
+    plain.open(plain_opts);
+    EXPECT_TRUE(flow::Trace::enabled());
+    plain.close();
+    EXPECT_TRUE(flow::Trace::enabled());
+
+    tracing.close();
+    EXPECT_FALSE(flow::Trace::enabled());
+}
+
 //-----------------------------------------------------------------------------
 TEST(ascent_runtime_options, test_actions_file)
 {
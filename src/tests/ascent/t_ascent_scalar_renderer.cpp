@@ -17,8 +17,10 @@
 
 #include <iostream>
 #include <math.h>
+#include <cmath>
 
 #include <conduit_blueprint.hpp>
+#include <png_utils/ascent_value_image.hpp>
 
 #include "t_config.hpp"
 #include "t_utils.hpp"
@@ -111,6 +113,174 @@ TEST(ascent_scalar_rendering, test_scalar_rendering)
     ASCENT_ACTIONS_DUMP(actions,output_file,msg);
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_scalar_rendering, test_value_image_extract)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent support disabled, skipping test");
+        return;
+    }
+
+    Node data;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    ASCENT_INFO("Testing value image extract");
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,
+                                                        "tout_value_image");
+    remove_test_file(output_file + ".vimg");
+
+    conduit::Node extracts;
+    extracts["e1/type"]  = "value_image";
+    extracts["e1/params/path"] = output_file;
+    extracts["e1/params/image_width"] = 128;
+    extracts["e1/params/image_height"] = 96;
+    extracts["e1/params/fields"].append() = "braid";
+
+    conduit::Node actions;
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts"] = extracts;
+
+    Ascent ascent;
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+
+    EXPECT_TRUE(conduit::utils::is_file(output_file + ".vimg"));
+
+    Node image;
+    ValueImageDecoder decoder;
+    decoder.Decode(output_file + ".vimg", image);
+
+    EXPECT_EQ(image["width"].to_int32(), 128);
+    EXPECT_EQ(image["height"].to_int32(), 96);
+    EXPECT_EQ(image["fields"].number_of_children(), 1);
+    EXPECT_TRUE(image["fields"].has_child("braid"));
+
+    // the default camera sees the whole mesh, so some pixels are
+    // covered and the corners are background
+    float32_array depth = image["depth"].value();
+    float32_array braid = image["fields/braid"].value();
+    index_t covered = 0;
+    for(index_t i = 0; i < depth.number_of_elements(); ++i)
+    {
+        if(std::isfinite(depth[i]))
+        {
+            covered++;
+            EXPECT_TRUE(std::isfinite(braid[i]));
+        }
+    }
+    EXPECT_GT(covered, 0);
+    EXPECT_FALSE(std::isfinite(depth[0]));
+
+    // the encoding round trips
+    ValueImageEncoder encoder;
+    encoder.Encode(image);
+    Node image2;
+    decoder.Decode((const unsigned char*)encoder.Buffer(),
+                   encoder.BufferSize(),
+                   image2);
+    Node diff_info;
+    EXPECT_FALSE(image["camera"].diff(image2["camera"], diff_info));
+    float32_array braid2 = image2["fields/braid"].value();
+    for(index_t i = 0; i < depth.number_of_elements(); ++i)
+    {
+        if(std::isfinite(depth[i]))
+        {
+            EXPECT_EQ(braid[i], braid2[i]);
+        }
+    }
+
+    // truncated input is an error
+    EXPECT_THROW(decoder.Decode((const unsigned char*)encoder.Buffer(),
+                                encoder.BufferSize() / 2,
+                                image2),
+                 conduit::Error);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_scalar_rendering, test_value_image_field_named_depth)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent support disabled, skipping test");
+        return;
+    }
+
+    Node data;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+    // a user field that shares its name with the depth channel
+    data["fields/depth"].set(data["fields/braid"]);
+    float64_array user_depth = data["fields/depth/values"].value();
+    for(index_t i = 0; i < user_depth.number_of_elements(); ++i)
+    {
+        user_depth[i] = -1.0;
+    }
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,
+                                                        "tout_value_image_depth_field");
+    remove_test_file(output_file + ".vimg");
+
+    conduit::Node actions;
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    conduit::Node &extracts = add_extracts["extracts"];
+    extracts["e1/type"]  = "value_image";
+    extracts["e1/params/path"] = output_file;
+    extracts["e1/params/image_width"] = 64;
+    extracts["e1/params/image_height"] = 64;
+    extracts["e1/params/fields"].append() = "depth";
+
+    Ascent ascent;
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+
+    Node image;
+    ValueImageDecoder decoder;
+    decoder.Decode(output_file + ".vimg", image);
+    ASSERT_TRUE(image["fields"].has_child("depth"));
+
+    // the depth channel still holds distances, the field its own values
+    float32_array depth = image["depth"].value();
+    float32_array field = image["fields/depth"].value();
+    index_t covered = 0;
+    for(index_t i = 0; i < depth.number_of_elements(); ++i)
+    {
+        if(std::isfinite(depth[i]))
+        {
+            covered++;
+            EXPECT_GT(depth[i], 0.f);
+            EXPECT_EQ(field[i], -1.f);
+        }
+    }
+    EXPECT_GT(covered, 0);
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
 {
@@ -390,6 +390,94 @@ TEST(ascent_multi_topo, adapter_test)
     delete collection;
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_data_adapter, lazy_field_conversion)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    std::shared_ptr<Node> data = std::make_shared<Node>();
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data->append());
+    (*data)[0]["state/domain_id"] = 0;
+
+    VTKHCollection* collection
+      = VTKHDataAdapter::BlueprintToLazyVTKHCollection(data,true);
+
+    // nothing converted yet, but the fields are still visible
+    EXPECT_EQ(collection->number_of_lazy_fields(), 3);
+    EXPECT_TRUE(collection->has_field("braid"));
+    EXPECT_TRUE(collection->has_field("vel"));
+    EXPECT_FALSE(collection->has_field("bananas"));
+    EXPECT_EQ(collection->field_topology("radial"), "mesh");
+    EXPECT_EQ(collection->field_names().size(), 3);
+
+    // only convert a single field
+    std::vector<std::string> fields(1, "braid");
+    vtkh::DataSet &dset = collection->dataset_by_topology("mesh", fields);
+    EXPECT_TRUE(dset.FieldExists("braid"));
+    EXPECT_FALSE(dset.FieldExists("radial"));
+    EXPECT_EQ(collection->number_of_lazy_fields(), 2);
+
+    // a filter that keeps the cells can hand the pending fields on
+    VTKHCollection *carried = collection->copy_without_topology("mesh");
+    carried->add(dset, "mesh");
+    carried->carry_lazy_fields(*collection, "mesh");
+    EXPECT_EQ(carried->number_of_lazy_fields(), 2);
+    EXPECT_TRUE(carried->dataset_by_topology("mesh").FieldExists("radial"));
+    EXPECT_EQ(carried->number_of_lazy_fields(), 0);
+    delete carried;
+
+    // asking for the whole dataset converts the rest
+    vtkh::DataSet &full = collection->dataset_by_topology("mesh");
+    EXPECT_TRUE(full.FieldExists("radial"));
+    EXPECT_EQ(full.NumberOfComponents("vel"), 3);
+    EXPECT_EQ(collection->number_of_lazy_fields(), 0);
+
+    Node out_data;
+    VTKHDataAdapter::VTKHCollectionToBlueprintDataSet(collection, out_data);
+
+    Node verify_info;
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(out_data, verify_info));
+    EXPECT_TRUE(out_data[0].has_path("fields/vel"));
+    delete collection;
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_data_adapter, lazy_field_bad_association)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    std::shared_ptr<Node> data = std::make_shared<Node>();
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data->append());
+    (*data)[0]["state/domain_id"] = 0;
+    (*data)[0]["fields/braid/association"] = "face";
+
+    // deferring the conversion must not hide the unsupported field
+    EXPECT_THROW(VTKHDataAdapter::BlueprintToLazyVTKHCollection(data,true),
+                 conduit::Error);
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
 {
@@ -14,6 +14,7 @@
 #include "gtest/gtest.h"
 
 #include <ascent.hpp>
+#include <ascent_web_interface.hpp>
 
 #include <iostream>
 #include <math.h>
@@ -112,6 +113,37 @@ TEST(ascent_web, test_ascent_main_web_launch)
     ascent.close();
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_web, test_ascent_web_message_delta)
+{
+    Node prev;
+    prev["info/cycle"] = 100;
+    prev["info/time"] = 1.0;
+    prev["info/actions"].append() = "add_scenes";
+    prev["info/extracts/e1/path"] = "out_100.root";
+    prev["about/version"] = "0.9";
+
+    Node curr;
+    curr.set(prev);
+    curr["info/cycle"] = 101;
+    curr["info/expressions/max"] = 2.5;
+    curr["info"].remove("extracts");
+
+    Node delta;
+    WebInterface::MessageDelta(curr, prev, delta);
+
+    EXPECT_EQ(delta["update/info/cycle"].to_int64(), 101);
+    EXPECT_EQ(delta["update/info/expressions/max"].to_float64(), 2.5);
+    EXPECT_FALSE(delta.has_path("update/info/time"));
+    EXPECT_FALSE(delta.has_path("update/info/actions"));
+    EXPECT_FALSE(delta.has_path("update/about"));
+    EXPECT_EQ(delta["remove"].number_of_children(), 1);
+    EXPECT_EQ(delta["remove"].child(0).as_string(), "info/extracts");
+
+    // nothing changed, nothing to send
+    WebInterface::MessageDelta(curr, curr, delta);
+    EXPECT_TRUE(delta.dtype().is_empty());
+}
 
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
@@ -0,0 +1,214 @@
+// Copyright 2019 Lawrence Livermore National Security, LLC and other
+// Devil Ray Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "gtest/gtest.h"
+#include "t_utils.hpp"
+
+#include <conduit/conduit.hpp>
+#include <conduit/conduit_blueprint.hpp>
+#include <dray/data_model/collection.hpp>
+#include <dray/filters/adaptive_linearize.hpp>
+#include <dray/data_model/unstructured_mesh.hpp>
+#include <dray/io/blueprint_low_order.hpp>
+#include <dray/synthetic/spiral_sample.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <memory>
+
+// 2x2x1 quadratic hexes covering [0,2]x[0,2]x[0,1] that share their
+// control points. The middle control point of element 0 is moved, so only
+// that element is curved, but the boundary of the grid stays flat.
+dray::Collection make_bent_grid()
+{
+  const int nx = 5, ny = 5, nz = 3;
+  dray::GridFunction<3> gf;
+  gf.resize(4, 27, nx * ny * nz);
+
+  dray::Vec<dray::Float, 3> *val_ptr = gf.m_values.get_host_ptr();
+  for(int k = 0; k < nz; ++k)
+    for(int j = 0; j < ny; ++j)
+      for(int i = 0; i < nx; ++i)
+      {
+        val_ptr[i + nx * (j + ny * k)] = {{0.5f * i, 0.5f * j, 0.5f * k}};
+      }
+  val_ptr[1 + nx * (1 + ny * 1)] += {{0.3f, 0.3f, 0.f}};
+
+  dray::int32 *idx_ptr = gf.m_ctrl_idx.get_host_ptr();
+  for(int el = 0; el < 4; ++el)
+  {
+    const int ex = el % 2, ey = el / 2;
+    for(int dof = 0; dof < 27; ++dof)
+    {
+      const int i = 2 * ex + dof % 3;
+      const int j = 2 * ey + (dof / 3) % 3;
+      const int k = dof / 9;
+      idx_ptr[el * 27 + dof] = i + nx * (j + ny * k);
+    }
+  }
+
+  dray::DataSet domain(std::make_shared<dray::HexMesh>(gf, 2));
+  dray::Collection collection;
+  collection.add_domain(domain);
+  return collection;
+}
+
+// the bent grid with every element in its own domain, so neighbours only
+// share the positions of their control points
+dray::Collection make_split_bent_grid()
+{
+  dray::Collection grid = make_bent_grid();
+  dray::HexMesh *mesh = dynamic_cast<dray::HexMesh*>(grid.domain(0).mesh());
+  dray::GridFunction<3> gf = mesh->get_dof_data();
+  const dray::Vec<dray::Float, 3> *val_ptr = gf.m_values.get_host_ptr_const();
+  const dray::int32 *idx_ptr = gf.m_ctrl_idx.get_host_ptr_const();
+
+  dray::Collection collection;
+  for(int el = 0; el < 4; ++el)
+  {
+    dray::GridFunction<3> el_gf;
+    el_gf.resize(1, 27, 27);
+    dray::Vec<dray::Float, 3> *el_val_ptr = el_gf.m_values.get_host_ptr();
+    dray::int32 *el_idx_ptr = el_gf.m_ctrl_idx.get_host_ptr();
+    for(int dof = 0; dof < 27; ++dof)
+    {
+      el_val_ptr[dof] = val_ptr[idx_ptr[el * 27 + dof]];
+      el_idx_ptr[dof] = dof;
+    }
+    dray::DataSet domain(std::make_shared<dray::HexMesh>(el_gf, 2));
+    domain.domain_id(el);
+    collection.add_domain(domain);
+  }
+  return collection;
+}
+
+TEST(dray_adaptive_linearize, linear_input)
+{
+  // straight sided elements are already exact, nothing gets refined
+  conduit::Node n_input;
+  conduit::blueprint::mesh::examples::braid("hexs",
+                                             4,
+                                             4,
+                                             4,
+                                             n_input);
+
+  dray::Collection input;
+  input.add_domain(dray::BlueprintLowOrder::import(n_input));
+
+  dray::AdaptiveLinearize filter;
+  dray::Collection result = filter.execute(input);
+
+  EXPECT_EQ(filter.number_of_elements(), 27);
+  EXPECT_EQ(result.domain(0).mesh()->cells(), 27);
+  EXPECT_EQ(result.domain(0).mesh()->order(), 1);
+  EXPECT_TRUE(result.domain(0).has_field("braid"));
+}
+
+TEST(dray_adaptive_linearize, curved_input)
+{
+  // a single 10th order hex wound into a spiral
+  dray::Collection input = dray::SynthesizeSpiralSample(1, 0.9, 2, 10).synthesize();
+
+  dray::AdaptiveLinearize filter;
+  filter.max_level(6);
+  dray::Collection result = filter.execute(input);
+
+  const dray::int64 unlimited = filter.number_of_elements();
+  EXPECT_GT(unlimited, 1);
+  EXPECT_LE(unlimited, 6 * 6 * 6);
+  EXPECT_EQ(result.domain(0).mesh()->cells(), unlimited);
+
+  // the budget wins over the tolerance
+  filter.element_budget(unlimited / 2);
+  result = filter.execute(input);
+  EXPECT_LE(filter.number_of_elements(), unlimited / 2);
+  EXPECT_GE(filter.number_of_elements(), 1);
+  EXPECT_GT(filter.used_tolerance(), 0.001f);
+  EXPECT_EQ(result.domain(0).mesh()->cells(), filter.number_of_elements());
+}
+
+TEST(dray_adaptive_linearize, watertight)
+{
+  // only element 0 asks for refinement, but its neighbours have to split
+  // the edges they share with it the same way
+  dray::Collection input = make_bent_grid();
+
+  dray::AdaptiveLinearize filter;
+  filter.max_level(4);
+  dray::Collection result = filter.execute(input);
+
+  // 4^3 + 4*1*4 + 1*4*4 + 1*1*4 linear hexes on a 6x6x5 lattice of points
+  EXPECT_EQ(filter.number_of_elements(), 100);
+  dray::HexMesh_P1 *mesh = dynamic_cast<dray::HexMesh_P1*>(result.domain(0).mesh());
+  ASSERT_TRUE(mesh != nullptr);
+  dray::GridFunction<3> gf = mesh->get_dof_data();
+  EXPECT_EQ(gf.m_values.size(), 6 * 6 * 5);
+
+  // every face is either shared by two hexes or on the outer boundary
+  std::map<std::array<dray::int32, 4>, int> faces;
+  const dray::int32 *conn_ptr = gf.m_ctrl_idx.get_host_ptr_const();
+  for(int el = 0; el < gf.m_size_el; ++el)
+  {
+    for(int face = 0; face < 6; ++face)
+    {
+      const int axis = face % 3, side = face / 3;
+      std::array<dray::int32, 4> key;
+      int n = 0;
+      for(int v = 0; v < 8; ++v)
+      {
+        if(((v >> axis) & 1) == side)
+        {
+          key[n++] = conn_ptr[el * 8 + v];
+        }
+      }
+      std::sort(key.begin(), key.end());
+      faces[key]++;
+    }
+  }
+
+  const dray::Vec<dray::Float, 3> *val_ptr = gf.m_values.get_host_ptr_const();
+  const dray::Float upper[3] = {2.f, 2.f, 1.f};
+  int boundary_faces = 0;
+  for(auto &face : faces)
+  {
+    EXPECT_LE(face.second, 2);
+    if(face.second == 1)
+    {
+      bool on_boundary = false;
+      for(int d = 0; d < 3; ++d)
+      {
+        bool on_min = true, on_max = true;
+        for(int v = 0; v < 4; ++v)
+        {
+          on_min = on_min && std::abs(val_ptr[face.first[v]][d]) < 1e-5f;
+          on_max = on_max && std::abs(val_ptr[face.first[v]][d] - upper[d]) < 1e-5f;
+        }
+        on_boundary = on_boundary || on_min || on_max;
+      }
+      EXPECT_TRUE(on_boundary);
+      boundary_faces++;
+    }
+  }
+  EXPECT_EQ(boundary_faces, 4 * 5 * 4 + 2 * 5 * 5);
+}
+
+TEST(dray_adaptive_linearize, watertight_across_domains)
+{
+  // the neighbours of element 0 are in other domains, but still have to
+  // split the edges they share with it the same way
+  dray::Collection input = make_split_bent_grid();
+
+  dray::AdaptiveLinearize filter;
+  filter.max_level(4);
+  dray::Collection result = filter.execute(input);
+
+  EXPECT_EQ(filter.number_of_elements(), 100);
+  EXPECT_EQ(result.domain(0).mesh()->cells(), 4 * 4 * 4);
+  EXPECT_EQ(result.domain(1).mesh()->cells(), 1 * 4 * 4);
+  EXPECT_EQ(result.domain(2).mesh()->cells(), 4 * 1 * 4);
+  EXPECT_EQ(result.domain(3).mesh()->cells(), 1 * 1 * 4);
+}
@@ -128,3 +128,55 @@ TEST (dray_balance, dray_balancing_giver_taker)
                                           dest_list);
   std::cout<<"Resulting ratio "<<ratio<<"\n";
 }
+
+TEST (dray_balance, dray_balancing_measured_costs)
+{
+  using AABB3 = dray::AABB<3>;
+  AABB3 cheap, expensive, unknown;
+  cheap.include(dray::Vec<float,3>({{0.f, 0.f, 0.f}}));
+  cheap.include(dray::Vec<float,3>({{1.f, 1.f, 1.f}}));
+  expensive.include(dray::Vec<float,3>({{1.f, 0.f, 0.f}}));
+  expensive.include(dray::Vec<float,3>({{2.f, 1.f, 1.f}}));
+  unknown.include(dray::Vec<float,3>({{5.f, 5.f, 5.f}}));
+  unknown.include(dray::Vec<float,3>({{6.f, 6.f, 6.f}}));
+
+  // the histogram covers the data of the last balance
+  AABB3 data_bounds;
+  data_bounds.include(cheap);
+  data_bounds.include(expensive);
+  dray::VolumeBalance::cost_bounds(data_bounds);
+  // nothing is recorded unless a balancer asked for it
+  dray::VolumeBalance::record_cost(cheap, 10.f, 1.f);
+
+  dray::VolumeBalance::recording_costs(true);
+  // same estimate, but the second domain took 3x as long to render
+  dray::VolumeBalance::record_cost(cheap, 10.f, 1.f);
+  dray::VolumeBalance::record_cost(expensive, 10.f, 3.f);
+  dray::VolumeBalance::recording_costs(false);
+
+  dray::VolumeBalance balancer;
+  balancer.use_timings(true);
+  balancer.gather_costs();
+
+  EXPECT_NEAR(balancer.cost_factor(cheap), 0.5f, 1e-5f);
+  EXPECT_NEAR(balancer.cost_factor(expensive), 1.5f, 1e-5f);
+  EXPECT_NEAR(balancer.cost_factor(unknown), 1.0f, 1e-5f);
+
+  // a piece of the expensive domain inherits its cost
+  AABB3 piece;
+  piece.include(dray::Vec<float,3>({{1.2f, 0.2f, 0.2f}}));
+  piece.include(dray::Vec<float,3>({{1.4f, 0.4f, 0.4f}}));
+  EXPECT_NEAR(balancer.cost_factor(piece), 1.5f, 1e-5f);
+
+  // the local record is consumed by the gather
+  dray::VolumeBalance other;
+  other.gather_costs();
+  EXPECT_NEAR(other.cost_factor(expensive), 1.0f, 1e-5f);
+
+  // the renderer's estimate needs the view of a balance
+  dray::VolumeBalance::recording_costs(true);
+  dray::VolumeBalance::record_cost(expensive, 3.f);
+  dray::VolumeBalance::recording_costs(false);
+  other.gather_costs();
+  EXPECT_NEAR(other.cost_factor(expensive), 1.0f, 1e-5f);
+}
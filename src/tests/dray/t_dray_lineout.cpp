@@ -11,6 +11,7 @@
 
 #include <dray/io/blueprint_reader.hpp>
 #include <dray/queries/lineout.hpp>
+#include <dray/queries/point_locator.hpp>
 
 #include <dray/math.hpp>
 
@@ -150,3 +151,73 @@ TEST (dray_locate_2d, dray_lineout_failure)
   }
 
 }
+
+TEST (dray_locate_2d, dray_lineout_persistent_locator)
+{
+  if(!mfem_enabled())
+  {
+    std::cout << "mfem disabled: skipping test that requires high order input " << std::endl;
+    return;
+  }
+
+  std::string root_file = std::string (ASCENT_T_DATA_DIR) + "taylor_green_2d.cycle_000050.root";
+
+  Collection collection = dray::BlueprintReader::load (root_file);
+
+  Lineout lineout;
+
+  lineout.samples(10);
+  lineout.add_var("density");
+  // the data set bounds are [0,1] on each axis
+  Vec<Float,3> start = {{0.01f,0.5f,0.0f}};
+  Vec<Float,3> end = {{0.99f,0.5f,0.0f}};
+  lineout.add_line(start, end);
+
+  Lineout::Result expected = lineout.execute(collection);
+
+  PointLocator locator;
+  lineout.locator(&locator);
+  Lineout::Result first = lineout.execute(collection);
+  EXPECT_EQ(locator.located_domains(), collection.local_size());
+
+  // the mesh and the points did not change
+  Lineout::Result second = lineout.execute(collection);
+  EXPECT_EQ(locator.located_domains(), 0);
+
+  const int size = expected.m_values[0].size();
+  for(int i = 0; i < size; ++i)
+  {
+    EXPECT_EQ(expected.m_values[0].get_value(i), first.m_values[0].get_value(i));
+    EXPECT_EQ(expected.m_values[0].get_value(i), second.m_values[0].get_value(i));
+  }
+
+  // the same geometry loaded again is recognized by its hash
+  Collection reloaded = dray::BlueprintReader::load (root_file);
+  lineout.execute(reloaded);
+  EXPECT_EQ(locator.located_domains(), 0);
+
+  // new points are located again
+  lineout.samples(5);
+  lineout.execute(collection);
+  EXPECT_EQ(locator.located_domains(), collection.local_size());
+}
+
+TEST (dray_lineout, locator_cache_bounded)
+{
+  PointLocator::clear_cache();
+
+  // lineouts that keep moving must not keep their locators forever
+  for(int i = 0; i < 100; ++i)
+  {
+    PointLocator::find("key_" + std::to_string(i));
+    EXPECT_LE(PointLocator::cache_size(), int32(PointLocator::max_cached_locators));
+  }
+  EXPECT_EQ(PointLocator::cache_size(), int32(PointLocator::max_cached_locators));
+
+  // recently used locators stay put
+  PointLocator &last = PointLocator::find("key_99");
+  EXPECT_EQ(&last, &PointLocator::find("key_99"));
+
+  PointLocator::clear_cache();
+  EXPECT_EQ(PointLocator::cache_size(), 0);
+}
@@ -0,0 +1,111 @@
+// Copyright 2019 Lawrence Livermore National Security, LLC and other
+// Devil Ray Developers. See the top-level COPYRIGHT file for details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "gtest/gtest.h"
+
+#include <dray/synthetic/affine_radial.hpp>
+#include <dray/data_model/mesh.hpp>
+
+using namespace dray;
+
+const int32 extent = 4;
+
+// a [-1,1]^3 mesh with 4 cells per side
+Collection
+make_collection()
+{
+  const Vec<int32, 3> extents = {{extent, extent, extent}};
+  const Vec<Float, 3> origin = {{0.0f, 0.0f, 0.0f}};
+  const Vec<Float, 3> radius = {{1.0f, 1.0f, 1.0f}};
+  const Vec<Float, 3> range_radius = {{1.0f, 1.0f, 1.0f}};
+  return SynthesizeAffineRadial(extents, origin, radius)
+         .equip("field", range_radius)
+         .synthesize();
+}
+
+// one point per cell at the same reference point, plus one outside
+Array<Vec<Float, 3>>
+make_points(const Vec<Float, 3> &ref_pt)
+{
+  const Float width = 2.f / extent;
+  const int32 cells = extent * extent * extent;
+  Array<Vec<Float, 3>> points;
+  points.resize(cells + 1);
+  Vec<Float, 3> *points_ptr = points.get_host_ptr();
+  for(int32 c = 0; c < cells; ++c)
+  {
+    const int32 idx[3] = {c % extent, (c / extent) % extent, c / (extent * extent)};
+    for(int32 d = 0; d < 3; ++d)
+    {
+      points_ptr[c][d] = -1.f + width * (Float(idx[d]) + ref_pt[d]);
+    }
+  }
+  points_ptr[cells] = {{2.f, 2.f, 2.f}};
+  return points;
+}
+
+void
+check_locations(const Array<Location> &locations, const Vec<Float, 3> &ref_pt)
+{
+  const int32 cells = extent * extent * extent;
+  ASSERT_EQ(locations.size(), cells + 1);
+  const Location *loc_ptr = locations.get_host_ptr_const();
+  for(int32 c = 0; c < cells; ++c)
+  {
+    EXPECT_EQ(loc_ptr[c].m_cell_id, c);
+    for(int32 d = 0; d < 3; ++d)
+    {
+      EXPECT_NEAR(loc_ptr[c].m_ref_pt[d], ref_pt[d], 1e-3f);
+    }
+  }
+  EXPECT_EQ(loc_ptr[cells].m_cell_id, -1);
+}
+
+TEST (dray_locate, dray_locate_batch)
+{
+  Collection collection = make_collection();
+  Mesh *mesh = collection.domain(0).mesh();
+
+  const Vec<Float, 3> ref_pt = {{0.25f, 0.5f, 0.75f}};
+  Array<Vec<Float, 3>> points = make_points(ref_pt);
+  Array<Location> locations = mesh->locate(points);
+  check_locations(locations, ref_pt);
+}
+
+TEST (dray_locate, dray_locate_guesses)
+{
+  Collection collection = make_collection();
+  Mesh *mesh = collection.domain(0).mesh();
+
+  const Vec<Float, 3> ref_pt = {{0.25f, 0.5f, 0.75f}};
+  Array<Vec<Float, 3>> points = make_points(ref_pt);
+
+  // right cells, wrong cells, no guess and cells from some other mesh
+  const int32 size = points.size();
+  Array<Location> guesses;
+  guesses.resize(size);
+  Location *guess_ptr = guesses.get_host_ptr();
+  for(int32 i = 0; i < size; ++i)
+  {
+    Location guess = {i, {0.5f, 0.5f, 0.5f}};
+    if(i % 4 == 1)
+    {
+      guess.m_cell_id = (i + 1) % (size - 1);
+    }
+    else if(i % 4 == 2)
+    {
+      // any negative id means no guess
+      guess.m_cell_id = i % 8 == 2 ? -1 : -7;
+    }
+    else if(i % 4 == 3)
+    {
+      guess.m_cell_id = 100000;
+    }
+    guess_ptr[i] = guess;
+  }
+
+  Array<Location> locations = mesh->locate(points, guesses);
+  check_locations(locations, ref_pt);
+}
@@ -9,15 +9,21 @@
 #include "t_utils.hpp"
 #include "t_config.hpp"
 
+#include <dray/rendering/colors.hpp>
 #include <dray/rendering/renderer.hpp>
 #include <dray/rendering/volume.hpp>
 #include <dray/io/blueprint_reader.hpp>
+#include <dray/io/blueprint_low_order.hpp>
+#include <dray/data_model/mesh_utils.hpp>
 #include <dray/math.hpp>
 #include <dray/array_registry.hpp>
 
 #include <dray/utils/appstats.hpp>
 
+#include <conduit_blueprint.hpp>
+
 #include <fstream>
+#include <map>
 #include <stdlib.h>
 
 //---------------------------------------------------------------------------//
@@ -183,3 +189,165 @@ TEST (dray_volume_partials, dray_empty_check)
   // note: dray diff tolerance was 0.2f prior to import
   EXPECT_TRUE (check_test_image (output_file,dray_baselines_dir(),0.05));
 }
+
+//---------------------------------------------------------------------------//
+TEST (dray_volume_partials, dray_face_neighbors)
+{
+  // 3x3x3 hexes
+  conduit::Node n_input;
+  conduit::blueprint::mesh::examples::braid("hexs", 4, 4, 4, n_input);
+  dray::DataSet dataset = dray::BlueprintLowOrder::import(n_input);
+
+  dray::HexMesh_P1 *mesh = dynamic_cast<dray::HexMesh_P1*>(dataset.mesh());
+  ASSERT_TRUE(mesh != nullptr);
+
+  dray::Array<dray::int32> neighbors = mesh->get_face_neighbors();
+  ASSERT_EQ(neighbors.size(), 27 * 6);
+
+  const dray::int32 *neighbors_ptr = neighbors.get_host_ptr_const();
+  int shared = 0;
+  for(int i = 0; i < 27 * 6; ++i)
+  {
+    const dray::int32 other = neighbors_ptr[i];
+    if(other == -1)
+    {
+      continue;
+    }
+    shared++;
+    // the neighbor points back
+    bool back = false;
+    for(int f = 0; f < 6; ++f)
+    {
+      back |= neighbors_ptr[other * 6 + f] == i / 6;
+    }
+    EXPECT_TRUE(back);
+  }
+  // 54 interior faces, seen from both sides
+  EXPECT_EQ(shared, 108);
+  // the center hex has no boundary faces
+  for(int f = 0; f < 6; ++f)
+  {
+    EXPECT_NE(neighbors_ptr[13 * 6 + f], -1);
+  }
+}
+
+//---------------------------------------------------------------------------//
+TEST (dray_volume_partials, dray_transparent_skip)
+{
+  conduit::Node n_input;
+  conduit::blueprint::mesh::examples::braid("hexs", 10, 10, 10, n_input);
+  dray::Collection dataset;
+  dataset.add_domain(dray::BlueprintLowOrder::import(n_input));
+
+  dray::Camera camera;
+  camera.set_width (128);
+  camera.set_height (128);
+  camera.reset_to_bounds (dataset.bounds());
+
+  dray::Array<dray::Ray> rays;
+  camera.create_rays (rays);
+
+  dray::Array<dray::PointLight> lights;
+
+  dray::Volume volume(dataset);
+  volume.field("braid");
+  volume.use_lighting(false);
+
+  // nothing is visible, so no ray samples the mesh
+  dray::ColorTable color_table ("Spectral");
+  color_table.add_alpha (0.f, 0.0f);
+  color_table.add_alpha (1.f, 0.0f);
+  volume.color_map().color_table(color_table);
+  dray::Array<dray::VolumePartial> partials = volume.integrate(rays, lights);
+  EXPECT_EQ(partials.size(), 0);
+
+  // only the upper half of the range is visible
+  color_table.clear_alphas();
+  color_table.add_alpha (0.f, 0.0f);
+  color_table.add_alpha (0.5f, 0.0f);
+  color_table.add_alpha (1.f, 0.5f);
+  volume.color_map().color_table(color_table);
+  partials = volume.integrate(rays, lights);
+  EXPECT_GT(partials.size(), 0);
+}
+
+//---------------------------------------------------------------------------//
+// front to back blend of the partials of one domain, which come
+// grouped by pixel and in depth order
+std::map<int, dray::Vec<float,4>>
+composite(dray::Array<dray::VolumePartial> &partials)
+{
+  std::map<int, dray::Vec<float,4>> res;
+  const dray::VolumePartial *partials_ptr = partials.get_host_ptr_const();
+  for(int i = 0; i < partials.size(); ++i)
+  {
+    auto it = res.insert({partials_ptr[i].m_pixel_id, {{0.f, 0.f, 0.f, 0.f}}}).first;
+    dray::pre_mult_alpha_blend_host(it->second, partials_ptr[i].m_color);
+  }
+  return res;
+}
+
+//---------------------------------------------------------------------------//
+TEST (dray_volume_partials, dray_skip_matches_full)
+{
+  // 48^3 hexes with a visible slab every 6 layers along z, so rays
+  // looking down z jump over transparent space between 8 slabs
+  const int dim = 49;
+  conduit::Node n_input;
+  conduit::blueprint::mesh::examples::braid("hexs", dim, dim, dim, n_input);
+  conduit::float64_array values = n_input["fields/braid/values"].value();
+  for(int i = 0; i < values.number_of_elements(); ++i)
+  {
+    values[i] = (i / (dim * dim)) % 6 == 5 ? 1.0 : 0.0;
+  }
+  dray::Collection dataset;
+  dataset.add_domain(dray::BlueprintLowOrder::import(n_input));
+
+  dray::Camera camera;
+  camera.set_width (64);
+  camera.set_height (64);
+  camera.reset_to_bounds (dataset.bounds());
+  dray::Vec<float,3> center = dataset.bounds().center();
+  camera.set_look_at(center);
+  center[2] += 100.f;
+  camera.set_pos(center);
+
+  dray::Array<dray::Ray> rays;
+  camera.create_rays (rays);
+
+  dray::Array<dray::PointLight> lights;
+
+  dray::Volume volume(dataset);
+  volume.field("braid");
+  volume.use_lighting(false);
+
+  dray::ColorTable color_table ("Spectral");
+  color_table.clear_alphas();
+  color_table.add_alpha (0.f, 0.0f);
+  color_table.add_alpha (0.5f, 0.0f);
+  color_table.add_alpha (1.f, 0.05f);
+  volume.color_map().color_table(color_table);
+
+  volume.skip_empty_space(false);
+  dray::Array<dray::VolumePartial> full_partials = volume.integrate(rays, lights);
+  volume.skip_empty_space(true);
+  dray::Array<dray::VolumePartial> skip_partials = volume.integrate(rays, lights);
+
+  // jumps inside the domain don't end segments, and no samples are lost
+  EXPECT_LE(skip_partials.size(), full_partials.size());
+  std::map<int, dray::Vec<float,4>> full = composite(full_partials);
+  std::map<int, dray::Vec<float,4>> skip = composite(skip_partials);
+  EXPECT_GT(full.size(), 0);
+  for(auto &pixel : full)
+  {
+    dray::Vec<float,4> skip_color = {{0.f, 0.f, 0.f, 0.f}};
+    if(skip.count(pixel.first) != 0)
+    {
+      skip_color = skip[pixel.first];
+    }
+    for(int c = 0; c < 4; ++c)
+    {
+      EXPECT_NEAR(skip_color[c], pixel.second[c], 1e-3f);
+    }
+  }
+}
@@ -136,6 +136,143 @@ TEST(flow_python_script_filter, simple_execute_mock_file_source)
 
     Workspace::clear_supported_filter_types();
 }
+//-----------------------------------------------------------------------------
+TEST(flow_python_script_filter, simple_execute_entry)
+{
+    flow::filters::register_builtin();
+
+    Workspace::register_filter_type<SrcFilter>();
+
+    Workspace w;
+
+    Node src_params;
+    src_params["value"] = 21;
+
+    w.graph().add_filter("src","v",src_params);
+
+    Node py_params;
+    // module level code should only run once, the entry runs each execute
+    py_params["source"] = "import sys\n"
+                          "sys._flow_entry_setup = getattr(sys,'_flow_entry_setup',0) + 1\n"
+                          "def run(data):\n"
+                          "    assert sys._flow_entry_setup == 1\n"
+                          "    assert flow_input().value() == data.value()\n"
+                          "    val = data.value() * 2\n"
+                          "    print(val)\n"
+                          "    assert val == 42\n"
+                          "    return val\n";
+    py_params["entry"] = "run";
+
+    w.graph().add_filter("python_script","py", py_params);
+
+    // // src, dest, port
+    w.graph().connect("v","py","in");
+    //
+    w.print();
+    //
+    w.execute();
+    w.execute();
+
+    Workspace::clear_supported_filter_types();
+}
+
+//-----------------------------------------------------------------------------
+TEST(flow_python_script_filter, execute_entry_separate_namespaces)
+{
+    flow::filters::register_builtin();
+
+    Workspace::register_filter_type<SrcFilter>();
+
+    Workspace w;
+
+    Node src_params;
+    src_params["value"] = 21;
+
+    w.graph().add_filter("src","v",src_params);
+
+    // both scripts bind the same module level name, neither
+    // may see the value from the other
+    Node py_params;
+    py_params["source"] = "scale = 2\n"
+                          "def run(data):\n"
+                          "    assert scale == 2\n"
+                          "    return data.value() * scale\n";
+    py_params["entry"] = "run";
+    w.graph().add_filter("python_script","py_a", py_params);
+
+    py_params["source"] = "scale = 3\n"
+                          "def run(data):\n"
+                          "    assert scale == 3\n"
+                          "    return data.value() * scale\n";
+    w.graph().add_filter("python_script","py_b", py_params);
+
+    w.graph().connect("v","py_a","in");
+    w.graph().connect("v","py_b","in");
+
+    w.execute();
+    w.execute();
+
+    Workspace::clear_supported_filter_types();
+}
+
+//-----------------------------------------------------------------------------
+void
+execute_entry_file(const std::string &script_fname, int value)
+{
+    Workspace w;
+
+    Node src_params;
+    src_params["value"] = value;
+    w.graph().add_filter("src","v",src_params);
+
+    Node py_params;
+    py_params["file"] = script_fname;
+    py_params["entry"] = "run";
+    w.graph().add_filter("python_script","py", py_params);
+
+    w.graph().connect("v","py","in");
+    w.execute();
+}
+
+//-----------------------------------------------------------------------------
+TEST(flow_python_script_filter, execute_entry_file_changed)
+{
+    flow::filters::register_builtin();
+
+    Workspace::register_filter_type<SrcFilter>();
+
+    string output_path = prepare_output_dir();
+
+    string script_fname = conduit::utils::join_file_path(output_path,
+                                                         "tout_test_flow_filter_entry.py");
+
+    ofstream ofs;
+    ofs.open(script_fname);
+    ofs << "def run(data):\n"
+        << "    assert data.value() * 2 == 42\n"
+        << "    return data.value()\n";
+    ofs.close();
+
+    execute_entry_file(script_fname, 21);
+    execute_entry_file(script_fname, 21);
+
+    // an edited script is compiled again
+    ofs.open(script_fname);
+    ofs << "def run(data):\n"
+        << "    assert data.value() * 3 == 66\n"
+        << "    # longer than the first version\n"
+        << "    return data.value()\n";
+    ofs.close();
+
+    execute_entry_file(script_fname, 22);
+
+    // and compiled again after the cache is released
+    flow::filters::PythonScript::clear_compiled_scripts();
+    execute_entry_file(script_fname, 22);
+
+    Workspace::clear_supported_filter_types();
+}
+
 //-----------------------------------------------------------------------------
 TEST(flow_python_script_filter, simple_execute_echo)
 {
@@ -0,0 +1,147 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) Lawrence Livermore National Security, LLC and other Ascent
+// Project developers. See top-level LICENSE AND COPYRIGHT files for dates and
+// other details. No copyright assignment is required to contribute to Ascent.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: t_flow_trace.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+
+#include <flow.hpp>
+
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "t_config.hpp"
+
+
+
+using namespace std;
+using namespace conduit;
+using namespace flow;
+
+
+//-----------------------------------------------------------------------------
+TEST(flow_trace, disabled_records_nothing)
+{
+    std::vector<Trace::Event> events;
+    Trace::enable(false);
+    Trace::flush(events);
+
+    Trace::begin("a");
+    Trace::end("a");
+    Trace::counter("c", 1.0);
+
+    Trace::flush(events);
+    EXPECT_EQ(events.size(), (size_t) 0);
+}
+
+//-----------------------------------------------------------------------------
+TEST(flow_trace, threads_and_summary)
+{
+    std::vector<Trace::Event> events;
+    Trace::enable(true);
+    Trace::flush(events);
+
+    {
+        TraceScope scope("outer", "test");
+        std::thread worker([]()
+        {
+            Trace::begin("work", "test", 3, 1024, 10);
+            conduit::utils::sleep(10);
+            Trace::end("work", "test", 3, 1024, 10);
+        });
+        worker.join();
+        Trace::counter("rays", 42.0, "test");
+    }
+
+    Trace::enable(false);
+    Trace::flush(events);
+    EXPECT_EQ(events.size(), (size_t) 5);
+
+    // sorted by time
+    for(size_t i = 1; i < events.size(); ++i)
+    {
+        EXPECT_LE(events[i-1].time, events[i].time);
+    }
+
+    Node summary;
+    Trace::summary(events, summary);
+    summary.print();
+
+    EXPECT_EQ(summary["test/outer/count"].to_int64(), 1);
+    EXPECT_EQ(summary["test/work/count"].to_int64(), 1);
+    EXPECT_EQ(summary["test/work/bytes"].to_int64(), 1024);
+    EXPECT_EQ(summary["test/work/cells"].to_int64(), 10);
+    EXPECT_GT(summary["test/work/total_time"].to_float64(), 0.0);
+    EXPECT_GE(summary["test/outer/total_time"].to_float64(),
+              summary["test/work/total_time"].to_float64());
+    EXPECT_EQ(summary["test/rays/value"].to_float64(), 42.0);
+
+    std::ostringstream oss;
+    Trace::write_chrome_trace(events, 0, oss);
+    const std::string json = oss.str();
+
+    Node parsed;
+    parsed.parse(json, "json");
+    EXPECT_EQ(parsed["displayTimeUnit"].as_string(), "ms");
+    const Node &trace_events = parsed["traceEvents"];
+    EXPECT_EQ(trace_events.number_of_children(), 5);
+    EXPECT_EQ(trace_events.child(0)["ph"].as_string(), "B");
+    EXPECT_EQ(trace_events.child(0)["name"].as_string(), "outer");
+    EXPECT_EQ(trace_events.child(4)["ph"].as_string(), "E");
+    EXPECT_EQ(trace_events.child(4)["name"].as_string(), "outer");
+
+    int num_counters = 0;
+    for(index_t i = 0; i < trace_events.number_of_children(); ++i)
+    {
+        const Node &event = trace_events.child(i);
+        EXPECT_EQ(event["pid"].to_int64(), 0);
+        EXPECT_EQ(event["cat"].as_string(), "test");
+        if(event["name"].as_string() == "work")
+        {
+            EXPECT_EQ(event["args/domain_id"].to_int64(), 3);
+            EXPECT_EQ(event["args/bytes"].to_int64(), 1024);
+            EXPECT_EQ(event["args/cells"].to_int64(), 10);
+            EXPECT_NE(event["tid"].to_int64(),
+                      trace_events.child(0)["tid"].to_int64());
+        }
+        if(event["ph"].as_string() == "C")
+        {
+            num_counters++;
+            EXPECT_EQ(event["name"].as_string(), "rays");
+            EXPECT_EQ(event["args/rays"].to_float64(), 42.0);
+        }
+    }
+    EXPECT_EQ(num_counters, 1);
+}
+
+//-----------------------------------------------------------------------------
+TEST(flow_trace, ring_buffer_drops_oldest)
+{
+    std::vector<Trace::Event> events;
+    Trace::enable(true);
+    Trace::flush(events);
+    const index_t dropped = Trace::number_of_dropped_events();
+
+    const int num_events = 20000;
+    for(int i = 0; i < num_events; ++i)
+    {
+        Trace::counter("c", (double) i, "test");
+    }
+
+    Trace::enable(false);
+    Trace::flush(events);
+
+    EXPECT_GT(events.size(), (size_t) 0);
+    EXPECT_EQ((index_t) events.size() + Trace::number_of_dropped_events() - dropped,
+              (index_t) num_events);
+    // the newest event survives
+    EXPECT_EQ(events.back().value, num_events - 1.0);
+}
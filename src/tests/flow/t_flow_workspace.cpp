@@ -160,6 +160,67 @@ public:
 
 
 
+//-----------------------------------------------------------------------------
+class ArraySrcFilter: public Filter
+{
+public:
+    ArraySrcFilter()
+    : Filter()
+    {}
+
+    virtual ~ArraySrcFilter()
+    {}
+
+    virtual void declare_interface(Node &i)
+    {
+        i["type_name"]   = "array_src";
+        i["output_port"] = "true";
+        i["port_names"] = DataType::empty();
+        i["default_params"]["size"].set((int)1);
+    }
+
+    virtual void execute()
+    {
+        int size = params()["size"].value();
+
+        Node *res = new Node();
+        res->set(DataType::float64(size));
+        float64_array vals = res->value();
+        vals.fill(1.0);
+        set_output<Node>(res);
+    }
+};
+
+//-----------------------------------------------------------------------------
+class SumFilter: public Filter
+{
+public:
+    SumFilter()
+    : Filter()
+    {}
+
+    virtual ~SumFilter()
+    {}
+
+    virtual void declare_interface(Node &i)
+    {
+        i["type_name"]   = "sum";
+        i["output_port"] = "true";
+        i["port_names"].append().set("in");
+    }
+
+    virtual void execute()
+    {
+        Node *in = input<Node>("in");
+        float64_array vals = in->value();
+
+        Node *res = new Node();
+        res->set(vals.sum());
+        set_output<Node>(res);
+    }
+};
+
+
 //-----------------------------------------------------------------------------
 TEST(ascent_flow_workspace, linear_graph)
 {
@@ -752,3 +813,66 @@ TEST(ascent_flow_workspace, dag_graph_missing_input_error)
 
     Workspace::clear_supported_filter_types();
 }
+
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_workspace, memory_aware_schedule)
+{
+    Workspace::register_filter_type<ArraySrcFilter>();
+    Workspace::register_filter_type<SumFilter>();
+
+    const index_t array_bytes = 1000 * sizeof(float64);
+
+    // s1 feeds two sinks, the sink traversals are visited in name order
+    // so by default s2 is created while s1 is still waiting for z_sum1
+    Node p_src;
+    p_src["size"] = 1000;
+
+    Workspace w;
+    w.graph().add_filter("array_src","s1",p_src);
+    w.graph().add_filter("array_src","s2",p_src);
+    w.graph().add_filter("sum","a_sum1");
+    w.graph().add_filter("sum","b_sum2");
+    w.graph().add_filter("sum","z_sum1");
+
+    w.graph().connect("s1","a_sum1","in");
+    w.graph().connect("s1","z_sum1","in");
+    w.graph().connect("s2","b_sum2","in");
+
+    w.execute();
+
+    Node info;
+    w.info(info);
+    info["schedule"].print();
+    EXPECT_EQ(info["schedule/mode"].as_string(), "depth_first");
+    EXPECT_GE(info["schedule/peak_bytes"].to_index_t(), 2 * array_bytes);
+    EXPECT_EQ(info["schedule/output_bytes/s1"].to_index_t(), array_bytes);
+    EXPECT_EQ(w.registry().fetch<Node>("z_sum1")->to_float64(), 1000.0);
+
+    w.enable_memory_aware_schedule(true);
+
+    Node travs;
+    w.traversals(travs);
+    EXPECT_EQ(travs.number_of_children(), 1);
+    EXPECT_EQ(travs[0].number_of_children(), 5);
+
+    // estimates come from the previous execution
+    for(int i = 0; i < 2; i++)
+    {
+        w.registry().reset();
+        w.execute();
+
+        w.info(info);
+        info["schedule"].print();
+        EXPECT_EQ(info["schedule/mode"].as_string(), "memory_aware");
+        EXPECT_LT(info["schedule/peak_bytes"].to_index_t(), 2 * array_bytes);
+        EXPECT_EQ(w.registry().fetch<Node>("a_sum1")->to_float64(), 1000.0);
+        EXPECT_EQ(w.registry().fetch<Node>("b_sum2")->to_float64(), 1000.0);
+        EXPECT_EQ(w.registry().fetch<Node>("z_sum1")->to_float64(), 1000.0);
+    }
+
+    EXPECT_GE(info["schedule/estimated_peak_bytes"].to_index_t(), array_bytes);
+    EXPECT_LT(info["schedule/estimated_peak_bytes"].to_index_t(), 2 * array_bytes);
+
+    Workspace::clear_supported_filter_types();
+}
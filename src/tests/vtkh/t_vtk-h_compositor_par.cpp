@@ -0,0 +1,130 @@
+//-----------------------------------------------------------------------------
+///
+/// file: t_vtk-h_compositor_par.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+
+#include <mpi.h>
+#include <vtkh/vtkh.hpp>
+#include <vtkh/compositing/Compositor.hpp>
+
+#include <iostream>
+#include <vector>
+
+//----------------------------------------------------------------------------
+// deterministic per rank image, with some background pixels
+void make_image(int rank,
+                int width,
+                int height,
+                std::vector<unsigned char> &colors,
+                std::vector<float> &depths)
+{
+  const int size = width * height;
+  colors.resize(size * 4);
+  depths.resize(size);
+  for(int i = 0; i < size; ++i)
+  {
+    const int hash = (i * 7919 + rank * 104729) % 1009;
+    const bool background = hash % 5 == 0;
+    depths[i] = background ? 2.f : hash / 1009.f;
+    for(int c = 0; c < 4; ++c)
+    {
+      colors[i * 4 + c] = background ? 0 : static_cast<unsigned char>((hash + rank * 31 + c) % 256);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+TEST(vtkh_compositor, vtkh_shared_memory_composite)
+{
+  MPI_Init(NULL, NULL);
+  int comm_size, rank;
+  MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  vtkh::SetMPICommHandle(MPI_Comm_c2f(MPI_COMM_WORLD));
+
+  // the second size makes the shared window grow
+  const int widths[2] = {64, 97};
+  const int height = 48;
+  for(int w = 0; w < 2; ++w)
+  {
+    std::vector<unsigned char> colors;
+    std::vector<float> depths;
+    make_image(rank, widths[w], height, colors, depths);
+
+    vtkh::Compositor shared;
+    shared.AddImage(&colors[0], &depths[0], widths[w], height);
+    vtkh::Image shared_result = shared.Composite();
+
+    vtkh::Compositor radix_k;
+    radix_k.SetSharedMemoryCompositing(false);
+    radix_k.AddImage(&colors[0], &depths[0], widths[w], height);
+    vtkh::Image radix_k_result = radix_k.Composite();
+
+    if(rank == 0)
+    {
+      // expected result
+      std::vector<unsigned char> expected_colors;
+      std::vector<float> expected_depths;
+      make_image(0, widths[w], height, expected_colors, expected_depths);
+      for(int r = 1; r < comm_size; ++r)
+      {
+        std::vector<unsigned char> r_colors;
+        std::vector<float> r_depths;
+        make_image(r, widths[w], height, r_colors, r_depths);
+        for(size_t i = 0; i < r_depths.size(); ++i)
+        {
+          if(r_depths[i] <= 1.f && r_depths[i] <= expected_depths[i])
+          {
+            expected_depths[i] = r_depths[i];
+            std::copy(&r_colors[i * 4], &r_colors[i * 4] + 4, &expected_colors[i * 4]);
+          }
+        }
+      }
+
+      EXPECT_EQ(shared_result.m_depths, expected_depths);
+      EXPECT_EQ(shared_result.m_pixels, expected_colors);
+      EXPECT_EQ(shared_result.m_depths, radix_k_result.m_depths);
+      EXPECT_EQ(shared_result.m_pixels, radix_k_result.m_pixels);
+    }
+  }
+
+  // batches of different sized images should give the same results
+  std::vector<vtkh::Image> batch(2);
+  std::vector<vtkh::Image> radix_k_batch(2);
+  std::vector<vtkh::Image> singles(2);
+  for(int w = 0; w < 2; ++w)
+  {
+    std::vector<unsigned char> colors;
+    std::vector<float> depths;
+    make_image(rank, widths[w], height, colors, depths);
+    batch[w].Init(&colors[0], &depths[0], widths[w], height);
+
+    vtkh::Compositor single;
+    single.AddImage(&colors[0], &depths[0], widths[w], height);
+    singles[w] = single.Composite();
+  }
+  radix_k_batch = batch;
+
+  vtkh::Compositor compositor;
+  compositor.CompositeBatch(batch);
+  compositor.SetSharedMemoryCompositing(false);
+  compositor.CompositeBatch(radix_k_batch);
+
+  if(rank == 0)
+  {
+    for(int w = 0; w < 2; ++w)
+    {
+      EXPECT_EQ(batch[w].m_depths, singles[w].m_depths);
+      EXPECT_EQ(batch[w].m_pixels, singles[w].m_pixels);
+      EXPECT_EQ(radix_k_batch[w].m_depths, singles[w].m_depths);
+      EXPECT_EQ(radix_k_batch[w].m_pixels, singles[w].m_pixels);
+    }
+  }
+
+  vtkh::Compositor::ReleaseSharedMemory();
+  MPI_Finalize();
+}
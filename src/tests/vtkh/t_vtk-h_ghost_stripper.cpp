@@ -108,3 +108,87 @@ TEST(vtkh_ghost_stripper, vtkh_ghost_stripper_no_strip)
   assert(before_cells == after_cells);
   delete stripped_output;
 }
+
+//----------------------------------------------------------------------------
+vtkm::Id strip_cells(vtkh::DataSet &data_set,
+                     bool static_ghosts,
+                     bool static_topology = false)
+{
+  vtkh::GhostStripper stripper;
+
+  stripper.SetInput(&data_set);
+  stripper.SetField("ghosts");
+  stripper.SetStaticGhosts(static_ghosts);
+  stripper.SetStaticTopology(static_topology);
+  stripper.AddMapField("point_data_Float64");
+  stripper.Update();
+
+  vtkh::DataSet *stripped_output = stripper.GetOutput();
+  vtkm::Id cells = stripped_output->GetNumberOfCells();
+  delete stripped_output;
+  return cells;
+}
+
+//----------------------------------------------------------------------------
+TEST(vtkh_ghost_stripper, vtkh_ghost_stripper_cached_plans)
+{
+#ifdef VTKM_ENABLE_KOKKOS
+  vtkh::InitializeKokkos();
+#endif
+  vtkh::GhostStripper::ClearPlanCache();
+
+  const int base_size = 16;
+  vtkm::cont::DataSet dom = CreateTestData(0, 1, base_size);
+
+  // a ghost zone in the interior forces the threshold path
+  vtkm::cont::ArrayHandle<vtkm::Int32> ghosts;
+  dom.GetField("ghosts").GetData().AsArrayHandle(ghosts);
+  const vtkm::Id center = (8 * base_size + 8) * base_size + 8;
+  ghosts.WritePortal().Set(center, 1);
+
+  vtkh::DataSet data_set;
+  data_set.AddDomain(dom, 0);
+
+  const vtkm::Id interior = (base_size - 2) * (base_size - 2) * (base_size - 2);
+
+  // the second execution replays the cached plan
+  EXPECT_EQ(strip_cells(data_set, false), interior - 1);
+  EXPECT_EQ(vtkh::GhostStripper::GetNumberOfCachedPlans(), 1);
+  EXPECT_EQ(strip_cells(data_set, false), interior - 1);
+  EXPECT_EQ(vtkh::GhostStripper::GetNumberOfCachedPlans(), 1);
+
+  // changed ghosts are detected and the plan is rebuilt
+  ghosts.WritePortal().Set(center + 1, 1);
+  EXPECT_EQ(strip_cells(data_set, false), interior - 2);
+
+  // unless the ghosts were declared static
+  ghosts.WritePortal().Set(center + 2, 1);
+  EXPECT_EQ(strip_cells(data_set, true), interior - 2);
+
+  // another mesh with the same sizes and domain id does not get the plan
+  vtkm::cont::DataSet moved = CreateTestData(0, 1, base_size);
+  vtkm::cont::CoordinateSystem coords = moved.GetCoordinateSystem();
+  vtkm::cont::ArrayHandleUniformPointCoordinates uniform;
+  coords.GetData().AsArrayHandle(uniform);
+  auto uniform_portal = uniform.ReadPortal();
+  moved.AddCoordinateSystem(vtkm::cont::CoordinateSystem(
+    coords.GetName(),
+    vtkm::cont::ArrayHandleUniformPointCoordinates(uniform_portal.GetDimensions(),
+                                                   uniform_portal.GetOrigin(),
+                                                   vtkm::Vec3f(2.f, 2.f, 2.f))));
+  vtkh::DataSet moved_set;
+  moved_set.AddDomain(moved, 0);
+  // unless the caller promised the mesh never changes
+  EXPECT_EQ(strip_cells(moved_set, true, true), interior - 2);
+  EXPECT_EQ(strip_cells(moved_set, true), interior);
+
+  // the cache is bounded
+  vtkh::GhostStripper::SetMaxCachedPlans(0);
+  EXPECT_EQ(vtkh::GhostStripper::GetNumberOfCachedPlans(), 0);
+  EXPECT_EQ(strip_cells(data_set, false), interior - 3);
+  EXPECT_EQ(vtkh::GhostStripper::GetNumberOfCachedPlans(), 0);
+  vtkh::GhostStripper::SetMaxCachedPlans(256);
+
+  vtkh::GhostStripper::ClearPlanCache();
+  EXPECT_EQ(vtkh::GhostStripper::GetNumberOfCachedPlans(), 0);
+}
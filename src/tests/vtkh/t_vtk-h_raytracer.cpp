@@ -13,6 +13,7 @@
 #include "t_vtkm_test_utils.hpp"
 
 #include <iostream>
+#include <sstream>
 
 
 
@@ -52,3 +53,58 @@ TEST(vtkh_raytracer, vtkh_serial_render)
   scene.AddRenderer(&tracer);
   scene.Render();
 }
+
+//----------------------------------------------------------------------------
+TEST(vtkh_raytracer, vtkh_geometry_cache)
+{
+  vtkh::DataSet data_set;
+
+  const int base_size = 32;
+  const int num_blocks = 2;
+
+  for(int i = 0; i < num_blocks; ++i)
+  {
+    data_set.AddDomain(CreateTestData(i, num_blocks, base_size), i);
+  }
+
+  vtkm::Bounds bounds = data_set.GetGlobalBounds();
+
+  vtkh::RayTracer::ClearGeometryCache();
+
+  // several batches and two scenes, the geometry is built once per domain
+  for(int s = 0; s < 2; ++s)
+  {
+    vtkh::Scene scene;
+    scene.SetRenderBatchSize(1);
+    for(int i = 0; i < 3; ++i)
+    {
+      vtkm::rendering::Camera camera;
+      camera.ResetToBounds(bounds);
+      camera.Azimuth(30.f * i);
+      std::stringstream name;
+      name << "ray_tracer_cache_" << s << "_" << i;
+      vtkh::Render render = vtkh::MakeRender(256,
+                                             256,
+                                             camera,
+                                             data_set,
+                                             name.str());
+      scene.AddRender(render);
+    }
+
+    vtkh::RayTracer tracer;
+    tracer.SetInput(&data_set);
+    tracer.SetField("point_data_Float64");
+    scene.AddRenderer(&tracer);
+    scene.Render();
+
+    EXPECT_EQ(vtkh::RayTracer::GetNumberOfCachedGeometries(), num_blocks);
+  }
+
+  // the least recently used geometry is dropped past the limit
+  vtkh::RayTracer::SetMaxCachedGeometries(1);
+  EXPECT_EQ(vtkh::RayTracer::GetNumberOfCachedGeometries(), 1);
+  vtkh::RayTracer::SetMaxCachedGeometries(256);
+
+  vtkh::RayTracer::ClearGeometryCache();
+  EXPECT_EQ(vtkh::RayTracer::GetNumberOfCachedGeometries(), 0);
+}
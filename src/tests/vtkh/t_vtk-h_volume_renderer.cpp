@@ -11,6 +11,7 @@
 #include <vtkh/filters/IsoVolume.hpp>
 #include <vtkh/rendering/Scene.hpp>
 #include <vtkh/rendering/VolumeRenderer.hpp>
+#include <vtkh/rendering/VisibilityTree.hpp>
 #include "t_vtkm_test_utils.hpp"
 
 #include <iostream>
@@ -121,3 +122,80 @@ TEST(vtkh_volume_renderer, vtkh_parallel_render)
   scene.AddRenderer(&tracer);
   scene.Render();
 }
+
+//----------------------------------------------------------------------------
+TEST(vtkh_volume_renderer, visibility_tree)
+{
+  // 3x3x3 blocks that overlap their neighbors by a ghost layer,
+  // listed in a scrambled order, plus one empty domain
+  const int dims = 3;
+  const double ghost = 0.05;
+  std::vector<vtkm::Bounds> bounds;
+  std::vector<vtkm::Id3> cells;
+  for(int n = 0; n < dims * dims * dims; ++n)
+  {
+    const int idx = (n * 7) % (dims * dims * dims);
+    vtkm::Id3 cell(idx % dims, (idx / dims) % dims, idx / (dims * dims));
+    cells.push_back(cell);
+    bounds.push_back(vtkm::Bounds(cell[0] - ghost, cell[0] + 1 + ghost,
+                                  cell[1] - ghost, cell[1] + 1 + ghost,
+                                  cell[2] - ghost, cell[2] + 1 + ghost));
+  }
+  bounds.push_back(vtkm::Bounds());
+
+  vtkh::VisibilityTree tree;
+  tree.Build(bounds);
+  EXPECT_EQ(tree.GetNumberOfDomains(), 28);
+
+  std::vector<vtkm::Vec<vtkm::Float64,3>> eyes;
+  eyes.push_back(vtkm::Vec<vtkm::Float64,3>(-10., 1.5, 1.5));
+  eyes.push_back(vtkm::Vec<vtkm::Float64,3>(1.7, 1.2, 10.));
+  eyes.push_back(vtkm::Vec<vtkm::Float64,3>(-4., 7., -3.));
+  eyes.push_back(vtkm::Vec<vtkm::Float64,3>(1.5, 1.5, 1.5));
+
+  const int num_blocks = dims * dims * dims;
+  for(size_t e = 0; e < eyes.size(); ++e)
+  {
+    std::vector<int> order;
+    tree.Order(eyes[e], order);
+    ASSERT_EQ(order.size(), 28u);
+    // the empty domain goes last
+    EXPECT_EQ(order[num_blocks], num_blocks);
+
+    std::vector<int> seen(28, 0);
+    for(int i = 0; i < 28; ++i)
+    {
+      seen[order[i]]++;
+    }
+    for(int i = 0; i < 28; ++i)
+    {
+      EXPECT_EQ(seen[i], 1);
+    }
+
+    // a block is in front of its face neighbors on the far side
+    for(int a = 0; a < num_blocks; ++a)
+    {
+      for(int b = 0; b < num_blocks; ++b)
+      {
+        for(int axis = 0; axis < 3; ++axis)
+        {
+          vtkm::Id3 diff = cells[b] - cells[a];
+          if(diff[axis] != 1 || vtkm::Abs(diff[(axis + 1) % 3]) +
+                                vtkm::Abs(diff[(axis + 2) % 3]) != 0)
+          {
+            continue;
+          }
+          const double face = static_cast<double>(cells[b][axis]);
+          if(eyes[e][axis] < face)
+          {
+            EXPECT_LT(order[a], order[b]);
+          }
+          else
+          {
+            EXPECT_GT(order[a], order[b]);
+          }
+        }
+      }
+    }
+  }
+}
@@ -1614,7 +1614,8 @@ static unsigned encodeLZ77(uivector* out, Hash* hash,
 
 /* /////////////////////////////////////////////////////////////////////////// */
 
-static unsigned deflateNoCompression(ucvector* out, const unsigned char* data, size_t datasize)
+static unsigned deflateNoCompression(ucvector* out, const unsigned char* data, size_t datasize,
+                                     unsigned final)
 {
   /*non compressed deflate block data: 1 bit BFINAL,2 bits BTYPE,(5 bits): it jumps to start of next byte,
   2 bytes LEN, 2 bytes NLEN, LEN bytes literal DATA*/
@@ -1626,7 +1627,7 @@ static unsigned deflateNoCompression(ucvector* out, const unsigned char* data, s
     unsigned BFINAL, BTYPE, LEN, NLEN;
     unsigned char firstbyte;
 
-    BFINAL = (i == numdeflateblocks - 1);
+    BFINAL = final && (i == numdeflateblocks - 1);
     BTYPE = 0;
 
     firstbyte = (unsigned char)(BFINAL + ((BTYPE & 1) << 1) + ((BTYPE & 2) << 1));
@@ -1979,7 +1980,7 @@ static unsigned deflateFixed(ucvector* out, size_t* bp, Hash* hash,
 }
 
 static unsigned lodepng_deflatev(ucvector* out, const unsigned char* in, size_t insize,
-                                 const LodePNGCompressSettings* settings)
+                                 const LodePNGCompressSettings* settings, unsigned final)
 {
   unsigned error = 0;
   size_t i, blocksize, numdeflateblocks;
@@ -1987,7 +1988,20 @@ static unsigned lodepng_deflatev(ucvector* out, const unsigned char* in, size_t
   Hash hash;
 
   if(settings->btype > 2) return 61;
-  else if(settings->btype == 0) return deflateNoCompression(out, in, insize);
+  else if(settings->btype == 0)
+  {
+    error = deflateNoCompression(out, in, insize, final);
+    if(!error && !final)
+    {
+      /*empty stored block, the header bits fill a whole byte*/
+      ucvector_push_back(out, 0);
+      ucvector_push_back(out, 0);
+      ucvector_push_back(out, 0);
+      ucvector_push_back(out, 255);
+      ucvector_push_back(out, 255);
+    }
+    return error;
+  }
   else if(settings->btype == 1) blocksize = insize;
   else /*if(settings->btype == 2)*/
   {
@@ -2005,13 +2019,25 @@ static unsigned lodepng_deflatev(ucvector* out, const unsigned char* in, size_t
 
   for(i = 0; i != numdeflateblocks && !error; ++i)
   {
-    unsigned final = (i == numdeflateblocks - 1);
+    unsigned last = final && (i == numdeflateblocks - 1);
     size_t start = i * blocksize;
     size_t end = start + blocksize;
     if(end > insize) end = insize;
 
-    if(settings->btype == 1) error = deflateFixed(out, &bp, &hash, in, start, end, settings, final);
-    else if(settings->btype == 2) error = deflateDynamic(out, &bp, &hash, in, start, end, settings, final);
+    if(settings->btype == 1) error = deflateFixed(out, &bp, &hash, in, start, end, settings, last);
+    else if(settings->btype == 2) error = deflateDynamic(out, &bp, &hash, in, start, end, settings, last);
+  }
+
+  if(!error && !final)
+  {
+    /*empty stored block (BFINAL 0, BTYPE 00), skip to the byte boundary, LEN 0, NLEN 0xffff*/
+    addBitToStream(&bp, out, 0);
+    addBitToStream(&bp, out, 0);
+    addBitToStream(&bp, out, 0);
+    ucvector_push_back(out, 0);
+    ucvector_push_back(out, 0);
+    ucvector_push_back(out, 255);
+    ucvector_push_back(out, 255);
   }
 
   hash_cleanup(&hash);
@@ -2022,11 +2048,18 @@ static unsigned lodepng_deflatev(ucvector* out, const unsigned char* in, size_t
 unsigned lodepng_deflate(unsigned char** out, size_t* outsize,
                          const unsigned char* in, size_t insize,
                          const LodePNGCompressSettings* settings)
+{
+  return lodepng_deflate_part(out, outsize, in, insize, settings, 1);
+}
+
+unsigned lodepng_deflate_part(unsigned char** out, size_t* outsize,
+                              const unsigned char* in, size_t insize,
+                              const LodePNGCompressSettings* settings, unsigned final)
 {
   unsigned error;
   ucvector v;
   ucvector_init_buffer(&v, *out, *outsize);
-  error = lodepng_deflatev(&v, in, insize, settings);
+  error = lodepng_deflatev(&v, in, insize, settings, final);
   *out = v.data;
   *outsize = v.size;
   return error;
@@ -788,6 +788,16 @@ unsigned lodepng_deflate(unsigned char** out, size_t* outsize,
                          const unsigned char* in, size_t insize,
                          const LodePNGCompressSettings* settings);
 
+/*
+Like lodepng_deflate, but when final is 0 no block is marked final and the data
+ends with an empty stored block (like a zlib sync flush). The outputs of several
+calls can then be concatenated into one deflate stream, as long as only the last
+one is final. (Ascent addition, used to deflate image rows in parallel.)
+*/
+unsigned lodepng_deflate_part(unsigned char** out, size_t* outsize,
+                              const unsigned char* in, size_t insize,
+                              const LodePNGCompressSettings* settings, unsigned final);
+
 #endif /*LODEPNG_COMPILE_ENCODER*/
 #endif /*LODEPNG_COMPILE_ZLIB*/
 